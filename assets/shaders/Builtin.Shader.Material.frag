@@ -20,18 +20,33 @@ struct DirectionalLight {
 layout (std430, set = 0, binding = 0) uniform GlobalUBO {
     mat4 projection;
     mat4 view;
-    mat4 depthMVP;
     vec3 viewPosition;
     int mode;
     vec4 ambientColor;
-    PointLight pointLights[5];
     DirectionalLight directionalLights[5];
-    int pointLightCount;
     int directionalLightCount;
+    uvec4 clusterGrid; // tiles x, tiles y, depth slices
+    vec2 clusterDepth; // slice = log(depth) * x + y
+    mat4 cascadeViewProjections[4];
+    vec4 cascadeSplits; // far view depth of each cascade
+    int cascadeCount;
 } globalUBO;
 
 layout (set = 0, binding = 1) uniform sampler2D shadowMap;
 
+layout (std430, set = 0, binding = 2) readonly buffer PointLights {
+    PointLight pointLights[];
+};
+
+// offset and count into the light indices
+layout (std430, set = 0, binding = 3) readonly buffer LightClusters {
+    uvec2 lightClusters[];
+};
+
+layout (std430, set = 0, binding = 4) readonly buffer LightIndices {
+    uint lightIndices[];
+};
+
 layout (set = 1, binding = 0) uniform LocalUBO {
     vec4 diffuseColor;
     float shininess;
@@ -53,7 +68,6 @@ layout (location = 1) in struct DTO {
     vec4 ambient;
     vec4 color;
     vec4 tangent;
-    vec4 shadowCoord;
 } dto;
 
 mat3 TBN;
@@ -107,6 +121,57 @@ vec4 calculatePointLight(PointLight light, vec3 normal, vec3 fragmentPosition, v
     return (ambient + diffuse + specular) * attenuation;
 }
 
+// cascades are tiles of the shadow map, the same layout as in ShadowMapsRenderPass
+// static casters take the first rows of tiles, dynamic ones the rest
+const int shadowAtlasColumns = 2;
+const int shadowAtlasRows = 4;
+const int shadowCascadesPerLayer = 4;
+
+float sampleShadowTile(int tile, vec2 tileCoords) {
+    vec2 offset = vec2(tile % shadowAtlasColumns, tile / shadowAtlasColumns);
+    return texture(shadowMap, (offset + tileCoords) / vec2(shadowAtlasColumns, shadowAtlasRows)).r;
+}
+
+float calculateShadowVisibility(vec3 normal, vec3 lightDirection) {
+    float depth = -(globalUBO.view * vec4(dto.fragmentPosition, 1.0)).z;
+
+    int cascade = 0;
+    while (cascade < globalUBO.cascadeCount && depth > globalUBO.cascadeSplits[cascade])
+        ++cascade;
+
+    // past the shadow distance
+    if (cascade == globalUBO.cascadeCount)
+        return 1.0;
+
+    vec4 shadowCoord = globalUBO.cascadeViewProjections[cascade] * vec4(dto.fragmentPosition, 1.0);
+    vec3 projCoords = shadowCoord.xyz / shadowCoord.w;
+
+    // the shadow pass viewport is flipped, so y goes down in the tile
+    vec2 tileCoords = vec2(projCoords.x * 0.5 + 0.5, 0.5 - projCoords.y * 0.5);
+    float closestDepth = min(
+        sampleShadowTile(cascade, tileCoords),
+        sampleShadowTile(shadowCascadesPerLayer + cascade, tileCoords)
+    );
+
+    float bias = max(0.05 * (1.0 - dot(normal, -lightDirection)), 0.005);
+    return closestDepth < projCoords.z - bias ? 0.3 : 1.0;
+}
+
+uvec2 findCluster() {
+    uvec3 grid = globalUBO.clusterGrid.xyz;
+    vec4 viewPosition = globalUBO.view * vec4(dto.fragmentPosition, 1.0);
+    vec4 clipPosition = globalUBO.projection * viewPosition;
+
+    vec2 ndc = clipPosition.xy / clipPosition.w;
+    ivec2 tile = clamp(ivec2((ndc * 0.5 + 0.5) * vec2(grid.xy)), ivec2(0), ivec2(grid.xy) - 1);
+
+    float depth = max(-viewPosition.z, epsilon);
+    int slice = int(floor(log(depth) * globalUBO.clusterDepth.x + globalUBO.clusterDepth.y));
+    slice = clamp(slice, 0, int(grid.z) - 1);
+
+    return lightClusters[(uint(slice) * grid.y + uint(tile.y)) * grid.x + uint(tile.x)];
+}
+
 void main() { 
     vec3 normal = dto.normal;
 
@@ -126,23 +191,13 @@ void main() {
 
         for (int i = 0; i < globalUBO.directionalLightCount; ++i) {
             DirectionalLight light = globalUBO.directionalLights[i];
-            
-            float bias = max(0.05 * (1.0 - dot(normal, -light.direction)), 0.005); 
-            float visibility = 1.0f;
-            vec3 projCoords = dto.shadowCoord.xyz / dto.shadowCoord.w;
-            vec2 shadowSample = vec2(projCoords.x, 1.0 - projCoords.y);
-            float ss = texture(shadowMap, shadowSample).r;
-            
-            if (ss < projCoords.z - bias) {
-                visibility = 0.3f;
-            }
-
-            // outColor += vec4(ss, 0.0, 0.0, 1.0);
+            float visibility = calculateShadowVisibility(normal, light.direction);
             outColor += visibility * calculateDirectionalLight(light, normal, viewDirection);
         }
         
-        for (int i = 0; i < globalUBO.pointLightCount; ++i)
-            outColor += calculatePointLight(globalUBO.pointLights[i], normal, dto.fragmentPosition, viewDirection);
+        uvec2 cluster = findCluster();
+        for (uint i = cluster.x; i < cluster.x + cluster.y; ++i)
+            outColor += calculatePointLight(pointLights[lightIndices[i]], normal, dto.fragmentPosition, viewDirection);
     } else {
         outColor = vec4(abs(normal), 1.0);
     }
@@ -8,15 +8,20 @@ layout (location = 1) in vec3 inNormal;
 layout (location = 2) in vec2 inTextureCoordinates;
 layout (location = 3) in vec4 inColor;
 layout (location = 4) in vec4 inTangent;
+// per instance, takes locations 5 to 8
+layout (location = 5) in mat4 inInstanceModel;
 
 layout (std430, set = 0, binding = 0) uniform GlobalUBO {
-    mat4 depthMVP;
+    mat4 cascadeViewProjections[4];
 } globalUBO;
 
-layout (push_constant) uniform pushConstants_t { 
-    mat4 model; 
+layout (push_constant) uniform PushConstants {
+    int cascade;
 } pushConstants;
 
 void main() {
-    gl_Position = globalUBO.depthMVP * pushConstants.model * vec4(inPosition, 1.0);
+    gl_Position = globalUBO.cascadeViewProjections[pushConstants.cascade] *
+        inInstanceModel * vec4(inPosition, 1.0);
+    // casters between the light and the cascade are flattened onto its near plane
+    gl_Position.z = max(gl_Position.z, 0.0);
 }
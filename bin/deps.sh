@@ -12,5 +12,7 @@ sudo apt-get install -y python3
 sudo apt-get install -y cppcheck 
 sudo apt-get install -y libboost-dev
 sudo apt-get install -y libfreetype-dev 
+# lavapipe and a virtual display for the gpu tests
+sudo apt-get install -y mesa-vulkan-drivers xvfb
 
 pip install conan && conan profile detect --force
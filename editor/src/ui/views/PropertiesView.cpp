@@ -140,6 +140,18 @@ void PropertiesView::RendererTab::render() {
             }
         });
 
+        const auto stats = m_renderGraph->getDrawStats();
+
+        sl::ui::separator();
+        sl::ui::text(
+          "Draw calls: {} ({} instances)", stats.drawCalls, stats.instances
+        );
+        sl::ui::text(
+          "Binds: {} vertex, {} index, {} descriptor, {} skipped",
+          stats.vertexBufferBinds, stats.indexBufferBinds, stats.descriptorSetBinds,
+          stats.skippedBinds
+        );
+
         if (changed) {
             // sl::TaskQueue::get().callPostFrame([&]() {
             //     m_renderGraph->rebuildChain();
@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include "starlight/app/scene/ecs/ComponentContainer.hh"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Position {
+    float x;
+    float y;
+    float z;
+};
+
+std::vector<sl::u64> shuffledIds(sl::u64 n) {
+    std::vector<sl::u64> ids(n);
+    std::iota(ids.begin(), ids.end(), 0u);
+    std::shuffle(ids.begin(), ids.end(), std::mt19937{ 1337u });
+    return ids;
+}
+
+}  // namespace
+
+static void component_container_add(benchmark::State& state) {
+    const auto n = static_cast<sl::u64>(state.range(0));
+
+    for (auto _ : state) {
+        sl::ComponentContainer<Position> container;
+        for (sl::u64 i = 0; i < n; ++i) container.add(i, 1.0f, 2.0f, 3.0f);
+        benchmark::DoNotOptimize(container);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void component_container_get(benchmark::State& state) {
+    const auto n   = static_cast<sl::u64>(state.range(0));
+    const auto ids = shuffledIds(n);
+
+    sl::ComponentContainer<Position> container;
+    for (sl::u64 i = 0; i < n; ++i) container.add(i, 1.0f, 2.0f, 3.0f);
+
+    for (auto _ : state) {
+        float sum = 0.0f;
+        for (const auto id : ids) sum += container.get(id).data().x;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void component_container_iterate(benchmark::State& state) {
+    const auto n = static_cast<sl::u64>(state.range(0));
+
+    sl::ComponentContainer<Position> container;
+    for (sl::u64 i = 0; i < n; ++i) container.add(i, 1.0f, 2.0f, 3.0f);
+
+    for (auto _ : state) {
+        container.forEach([](sl::Component<Position>& component) {
+            component.data().x += 1.0f;
+        });
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(component_container_add)->Arg(1'000)->Arg(100'000)->Arg(1'000'000);
+BENCHMARK(component_container_get)->Arg(1'000)->Arg(100'000)->Arg(1'000'000);
+BENCHMARK(component_container_iterate)->Arg(1'000)->Arg(100'000)->Arg(1'000'000);
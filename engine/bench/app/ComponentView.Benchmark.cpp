@@ -0,0 +1,108 @@
+#include <benchmark/benchmark.h>
+
+#include "starlight/app/scene/ecs/ComponentManager.hh"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Position {
+    float x;
+};
+
+struct Velocity {
+    float x;
+};
+
+struct Mass {
+    float value;
+};
+
+// every entity has a position, every second a velocity and every third a mass,
+// added in shuffled order so the pools are not aligned with each other
+void populate(sl::ComponentManager& manager, sl::u64 n) {
+    std::vector<sl::u64> ids(n);
+    std::iota(ids.begin(), ids.end(), 0u);
+
+    std::mt19937 generator{ 1337u };
+
+    std::ranges::shuffle(ids, generator);
+    for (const auto id : ids) manager.add<Position>(id, 0.0f);
+
+    std::ranges::shuffle(ids, generator);
+    for (const auto id : ids)
+        if (id % 2 == 0) manager.add<Velocity>(id, 1.0f);
+
+    std::ranges::shuffle(ids, generator);
+    for (const auto id : ids)
+        if (id % 3 == 0) manager.add<Mass>(id, 2.0f);
+}
+
+}  // namespace
+
+static void component_join_manual(benchmark::State& state) {
+    const auto n = static_cast<sl::u64>(state.range(0));
+
+    sl::ComponentManager manager;
+    populate(manager, n);
+
+    for (auto _ : state) {
+        manager.getComponentContainer<Position>().forEach(
+          [&](sl::Component<Position>& position) {
+              const auto entityId = position.getEntityId();
+              if (not manager.has<Velocity>(entityId) || not manager.has<Mass>(entityId))
+                  return;
+
+              position.data().x += manager.get<Velocity>(entityId).data().x
+                                   * manager.get<Mass>(entityId).data().value;
+          }
+        );
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void component_join_view(benchmark::State& state) {
+    const auto n = static_cast<sl::u64>(state.range(0));
+
+    sl::ComponentManager manager;
+    populate(manager, n);
+
+    for (auto _ : state) {
+        manager.view<Position, Velocity, Mass>().forEach(
+          [](auto& position, auto& velocity, auto& mass) {
+              position.data().x += velocity.data().x * mass.data().value;
+          }
+        );
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void component_join_view_rebuild(benchmark::State& state) {
+    const auto n = static_cast<sl::u64>(state.range(0));
+
+    sl::ComponentManager manager;
+    populate(manager, n);
+
+    // membership changes every frame, so the cached join is rebuilt each time
+    for (auto _ : state) {
+        manager.remove<Mass>(0u);
+        manager.add<Mass>(0u, 2.0f);
+
+        manager.view<Position, Velocity, Mass>().forEach(
+          [](auto& position, auto& velocity, auto& mass) {
+              position.data().x += velocity.data().x * mass.data().value;
+          }
+        );
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(component_join_manual)->Arg(100'000);
+BENCHMARK(component_join_view)->Arg(100'000);
+BENCHMARK(component_join_view_rebuild)->Arg(100'000);
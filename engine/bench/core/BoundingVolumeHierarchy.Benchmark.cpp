@@ -0,0 +1,159 @@
+#include <benchmark/benchmark.h>
+
+#include "starlight/core/math/BoundingVolumeHierarchy.hh"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+// boxes spread over a cube whose volume grows with the count, so the density and
+// the number of hits per query stay comparable between sizes
+std::vector<sl::Aabb> makeBoxes(sl::u64 count) {
+    std::mt19937 generator{ 42u };
+    const auto side = 10.0f * std::cbrt(static_cast<sl::f32>(count));
+    std::uniform_real_distribution<sl::f32> position{ -side, side };
+    std::uniform_real_distribution<sl::f32> size{ 0.5f, 2.0f };
+
+    std::vector<sl::Aabb> boxes(count);
+    for (auto& box : boxes) {
+        for (sl::u32 axis = 0; axis < 3u; ++axis) {
+            box.min[axis] = position(generator);
+            box.max[axis] = box.min[axis] + size(generator);
+        }
+    }
+    return boxes;
+}
+
+void move(std::vector<sl::Aabb>& boxes, sl::f32 offset) {
+    for (sl::u64 i = 0; i < boxes.size(); ++i) {
+        const auto delta = (i % 2u == 0u) ? offset : -offset;
+        boxes[i].min[i % 3u] += delta;
+        boxes[i].max[i % 3u] += delta;
+    }
+}
+
+// a 60 degree, 100 units deep view looking down +Z from the origin
+sl::FrustumPlanes makeFrustum() {
+    const auto side = std::sqrt(0.75f);
+    return sl::FrustumPlanes{
+        sl::Plane{ side, 0.0f, 0.5f, 0.0f },
+        sl::Plane{ -side, 0.0f, 0.5f, 0.0f },
+        sl::Plane{ 0.0f, side, 0.5f, 0.0f },
+        sl::Plane{ 0.0f, -side, 0.5f, 0.0f },
+        sl::Plane{ 0.0f, 0.0f, 1.0f, -0.1f },
+        sl::Plane{ 0.0f, 0.0f, -1.0f, 100.0f },
+    };
+}
+
+}  // namespace
+
+static void bvh_build(benchmark::State& state) {
+    const auto boxes = makeBoxes(state.range(0));
+    sl::BoundingVolumeHierarchy bvh;
+
+    for (auto _ : state) {
+        bvh.build(boxes);
+        benchmark::DoNotOptimize(bvh.getNodeCount());
+    }
+    state.SetItemsProcessed(state.iterations() * boxes.size());
+}
+
+static void bvh_refit(benchmark::State& state) {
+    auto boxes = makeBoxes(state.range(0));
+    sl::BoundingVolumeHierarchy bvh;
+    bvh.build(boxes);
+
+    sl::f32 offset = 0.01f;
+    for (auto _ : state) {
+        move(boxes, offset);
+        offset = -offset;
+        bvh.refit(boxes);
+        benchmark::DoNotOptimize(bvh.getCost());
+    }
+    state.SetItemsProcessed(state.iterations() * boxes.size());
+}
+
+static void bvh_query_frustum(benchmark::State& state) {
+    const auto boxes = makeBoxes(state.range(0));
+    sl::BoundingVolumeHierarchy bvh;
+    bvh.build(boxes);
+
+    const auto planes = makeFrustum();
+    for (auto _ : state) {
+        sl::u64 visible = 0u;
+        bvh.queryFrustum(planes, [&](sl::u32) { ++visible; });
+        benchmark::DoNotOptimize(visible);
+    }
+}
+
+// linear SIMD culling of every box, as a baseline for the frustum query
+static void linear_cull_boxes(benchmark::State& state) {
+    const auto boxes = makeBoxes(state.range(0));
+    const auto count = boxes.size();
+
+    std::vector<sl::f32> soa(count * 6u);
+    for (sl::u64 i = 0; i < count; ++i) {
+        for (sl::u32 axis = 0; axis < 3u; ++axis) {
+            soa[axis * count + i] = (boxes[i].min[axis] + boxes[i].max[axis]) * 0.5f;
+            soa[(axis + 3u) * count + i] =
+              (boxes[i].max[axis] - boxes[i].min[axis]) * 0.5f;
+        }
+    }
+
+    const sl::BoxesView view{
+        .centerX = soa.data(),
+        .centerY = soa.data() + count,
+        .centerZ = soa.data() + count * 2u,
+        .extentX = soa.data() + count * 3u,
+        .extentY = soa.data() + count * 4u,
+        .extentZ = soa.data() + count * 5u,
+        .count   = count,
+    };
+
+    const auto planes = makeFrustum();
+    std::vector<sl::u8> visible(count);
+    for (auto _ : state) {
+        sl::cullBoxes(planes, view, visible.data());
+        benchmark::DoNotOptimize(visible.data());
+    }
+}
+
+static void bvh_query_sphere(benchmark::State& state) {
+    const auto boxes = makeBoxes(state.range(0));
+    sl::BoundingVolumeHierarchy bvh;
+    bvh.build(boxes);
+
+    const sl::f32 center[3] = { 0.0f, 0.0f, 0.0f };
+    for (auto _ : state) {
+        sl::u64 touched = 0u;
+        bvh.querySphere(center, 15.0f, [&](sl::u32) { ++touched; });
+        benchmark::DoNotOptimize(touched);
+    }
+}
+
+static void bvh_cast_ray(benchmark::State& state) {
+    const auto boxes = makeBoxes(state.range(0));
+    sl::BoundingVolumeHierarchy bvh;
+    bvh.build(boxes);
+
+    std::mt19937 generator{ 7u };
+    std::uniform_real_distribution<sl::f32> direction{ -1.0f, 1.0f };
+
+    for (auto _ : state) {
+        const sl::Ray ray{
+            .origin      = { 0.0f, 0.0f, 0.0f },
+            .direction   = { direction(generator), direction(generator), 1.0f },
+            .maxDistance = 1e6f,
+        };
+        benchmark::DoNotOptimize(bvh.castRay(ray));
+    }
+}
+
+BENCHMARK(bvh_build)->Arg(10'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(bvh_refit)->Arg(10'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(bvh_query_frustum)->Arg(10'000)->Arg(1'000'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(linear_cull_boxes)->Arg(10'000)->Arg(1'000'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(bvh_query_sphere)->Arg(10'000)->Arg(1'000'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(bvh_cast_ray)->Arg(10'000)->Arg(1'000'000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,137 @@
+#include <benchmark/benchmark.h>
+
+#include "starlight/core/containers/FreeList.hh"
+
+#include <list>
+#include <optional>
+#include <random>
+#include <vector>
+
+namespace {
+
+// first-fit list with linear search, equivalent of the previous FreeList
+// implementation, kept here as a baseline
+class LinearFreeList {
+    struct Node {
+        sl::u64 offset;
+        sl::u64 size;
+    };
+
+public:
+    explicit LinearFreeList(sl::u64 size) { m_nodes.push_back(Node{ 0u, size }); }
+
+    std::optional<sl::u64> allocateBlock(sl::u64 size) {
+        for (auto node = m_nodes.begin(); node != m_nodes.end(); ++node) {
+            if (node->size < size) continue;
+
+            const auto offset = node->offset;
+            node->offset += size;
+            node->size -= size;
+            if (node->size == 0) m_nodes.erase(node);
+            return offset;
+        }
+        return {};
+    }
+
+    void freeBlock(sl::u64 size, sl::u64 offset) {
+        auto next = m_nodes.begin();
+        while (next != m_nodes.end() && next->offset < offset) ++next;
+
+        auto node = m_nodes.insert(next, Node{ offset, size });
+
+        if (next != m_nodes.end() && node->offset + node->size == next->offset) {
+            node->size += next->size;
+            m_nodes.erase(next);
+        }
+        if (node != m_nodes.begin()) {
+            auto previous = std::prev(node);
+            if (previous->offset + previous->size == node->offset) {
+                previous->size += node->size;
+                m_nodes.erase(node);
+            }
+        }
+    }
+
+private:
+    std::list<Node> m_nodes;
+};
+
+struct Allocation {
+    sl::u64 offset;
+    sl::u64 size;
+};
+
+// fills the list with randomly sized blocks and frees every second one so the
+// free space is spread over many small holes, then measures alloc/free churn
+template <typename List> void fragmentedChurn(benchmark::State& state) {
+    const auto n = static_cast<sl::u64>(state.range(0));
+
+    std::mt19937 generator{ 1337u };
+    std::uniform_int_distribution<sl::u64> sizes{ 16u, 4096u };
+
+    List list{ n * 4096u * 2u };
+    std::vector<Allocation> allocations;
+    allocations.reserve(n);
+
+    for (sl::u64 i = 0; i < n; ++i) {
+        const auto size = sizes(generator);
+        allocations.emplace_back(*list.allocateBlock(size), size);
+    }
+    for (sl::u64 i = 0; i < n; i += 2) {
+        list.freeBlock(allocations[i].size, allocations[i].offset);
+        allocations[i].size = 0u;
+    }
+
+    std::uniform_int_distribution<sl::u64> indices{ 0u, n - 1u };
+
+    for (auto _ : state) {
+        auto& allocation = allocations[indices(generator)];
+
+        if (allocation.size > 0u) {
+            list.freeBlock(allocation.size, allocation.offset);
+            allocation.size = 0u;
+        } else {
+            const auto size = sizes(generator);
+            if (auto offset = list.allocateBlock(size); offset) {
+                allocation.offset = *offset;
+                allocation.size   = size;
+            }
+        }
+        benchmark::DoNotOptimize(allocation);
+    }
+}
+
+template <typename List> void allocateFreeSequence(benchmark::State& state) {
+    const auto n = static_cast<sl::u64>(state.range(0));
+
+    List list{ n * 256u };
+    std::vector<sl::u64> offsets(n);
+
+    for (auto _ : state) {
+        for (sl::u64 i = 0; i < n; ++i) offsets[i] = *list.allocateBlock(256u);
+        for (sl::u64 i = 0; i < n; ++i) list.freeBlock(256u, offsets[i]);
+    }
+}
+
+}  // namespace
+
+static void churn_linear_free_list(benchmark::State& state) {
+    fragmentedChurn<LinearFreeList>(state);
+}
+
+static void churn_tlsf_free_list(benchmark::State& state) {
+    fragmentedChurn<sl::FreeList>(state);
+}
+
+static void sequence_linear_free_list(benchmark::State& state) {
+    allocateFreeSequence<LinearFreeList>(state);
+}
+
+static void sequence_tlsf_free_list(benchmark::State& state) {
+    allocateFreeSequence<sl::FreeList>(state);
+}
+
+BENCHMARK(churn_linear_free_list)->RangeMultiplier(8)->Range(64, 1024 * 32);
+BENCHMARK(churn_tlsf_free_list)->RangeMultiplier(8)->Range(64, 1024 * 32);
+BENCHMARK(sequence_linear_free_list)->RangeMultiplier(8)->Range(64, 1024 * 8);
+BENCHMARK(sequence_tlsf_free_list)->RangeMultiplier(8)->Range(64, 1024 * 8);
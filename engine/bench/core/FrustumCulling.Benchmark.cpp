@@ -0,0 +1,112 @@
+#include <benchmark/benchmark.h>
+
+#include "starlight/core/math/Culling.hh"
+
+#include "mock/RawMatrix.hh"
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+// instances scattered around the camera, roughly a fifth of them is visible
+struct Instances {
+    explicit Instances(sl::u64 count) : worlds(count), bounds(count * 6u) {
+        std::mt19937 generator{ 1337u };
+        std::uniform_real_distribution<sl::f32> positions{ -200.0f, 200.0f };
+        std::uniform_real_distribution<sl::f32> scales{ 0.5f, 2.0f };
+
+        for (auto& world : worlds) {
+            world     = RawMatrix{};
+            world[0]  = scales(generator);
+            world[5]  = scales(generator);
+            world[10] = scales(generator);
+            world[15] = 1.0f;
+            world[12] = positions(generator);
+            world[13] = positions(generator) * 0.1f;
+            world[14] = positions(generator);
+        }
+    }
+
+    sl::BoxesView getBoxes() const {
+        const auto count = worlds.size();
+        return sl::BoxesView{
+            .centerX = bounds.data(),
+            .centerY = bounds.data() + count,
+            .centerZ = bounds.data() + count * 2u,
+            .extentX = bounds.data() + count * 3u,
+            .extentY = bounds.data() + count * 4u,
+            .extentZ = bounds.data() + count * 5u,
+            .count   = count,
+        };
+    }
+
+    void transform() {
+        const std::array<sl::f32, 3> min{ -1.0f, -1.0f, -1.0f };
+        const std::array<sl::f32, 3> max{ 1.0f, 1.0f, 1.0f };
+        const auto count = worlds.size();
+
+        for (sl::u64 i = 0; i < count; ++i) {
+            sl::f32 center[3];
+            sl::f32 extent[3];
+            sl::transformBox(worlds[i].data(), min.data(), max.data(), center, extent);
+
+            for (sl::u64 axis = 0; axis < 3; ++axis) {
+                bounds[axis * count + i]        = center[axis];
+                bounds[(axis + 3u) * count + i] = extent[axis];
+            }
+        }
+    }
+
+    std::vector<RawMatrix> worlds;
+    std::vector<sl::f32> bounds;
+};
+
+constexpr sl::u64 instanceCount = 100'000;
+
+template <typename Cull> void cull(benchmark::State& state, Cull&& cullBoxes) {
+    Instances instances{ instanceCount };
+    instances.transform();
+
+    const auto camera = perspective(1.0f, 16.0f / 9.0f, 0.1f, 1000.0f);
+    const auto planes = sl::extractFrustumPlanes(camera.data());
+
+    std::vector<sl::u8> visible(instanceCount);
+
+    for (auto _ : state) {
+        cullBoxes(planes, instances.getBoxes(), visible.data());
+        benchmark::DoNotOptimize(visible.data());
+    }
+    state.SetItemsProcessed(state.iterations() * instanceCount);
+}
+
+}  // namespace
+
+static void cull_boxes_scalar(benchmark::State& state) {
+    cull(state, sl::cullBoxesScalar);
+}
+
+static void cull_boxes_simd(benchmark::State& state) { cull(state, sl::cullBoxes); }
+
+// whole stage as run by the scene: world space boxes and the plane tests
+static void transform_and_cull_boxes(benchmark::State& state) {
+    Instances instances{ instanceCount };
+
+    const auto camera = perspective(1.0f, 16.0f / 9.0f, 0.1f, 1000.0f);
+    const auto planes = sl::extractFrustumPlanes(camera.data());
+
+    std::vector<sl::u8> visible(instanceCount);
+
+    for (auto _ : state) {
+        instances.transform();
+        sl::cullBoxes(planes, instances.getBoxes(), visible.data());
+        benchmark::DoNotOptimize(visible.data());
+    }
+    state.SetItemsProcessed(state.iterations() * instanceCount);
+}
+
+BENCHMARK(cull_boxes_scalar);
+BENCHMARK(cull_boxes_simd);
+BENCHMARK(transform_and_cull_boxes);
@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+
+#include "starlight/core/Id.hh"
+
+#include <mutex>
+#include <queue>
+#include <vector>
+
+namespace {
+
+// global mutex and FIFO of free ids, equivalent of the previous Identificable
+// implementation, kept here as a baseline
+template <typename T> class LockedIdentificable {
+public:
+    explicit LockedIdentificable() : id(createId()) {}
+
+    ~LockedIdentificable() {
+        std::scoped_lock guard{ s_mutex };
+        s_freeIds.push(id);
+    }
+
+    sl::u64 id;
+
+private:
+    static sl::u64 createId() {
+        std::scoped_lock guard{ s_mutex };
+
+        if (not s_freeIds.empty()) {
+            const auto id = s_freeIds.front();
+            s_freeIds.pop();
+            return id;
+        }
+        return s_generator++;
+    }
+
+    inline static sl::u64 s_generator = 0;
+    inline static std::queue<sl::u64> s_freeIds;
+    inline static std::mutex s_mutex;
+};
+
+struct LockedObject : LockedIdentificable<LockedObject> {};
+struct RecycledObject : sl::Identificable<RecycledObject> {};
+
+// every thread creates a batch of objects and destroys it, like components of a
+// scene chunk being loaded and unloaded by workers
+template <typename Object> void createDestroy(benchmark::State& state) {
+    const auto n = static_cast<sl::u64>(state.range(0));
+
+    for (auto _ : state) {
+        std::vector<Object> objects(n);
+        benchmark::DoNotOptimize(objects.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+}  // namespace
+
+static void create_destroy_locked_ids(benchmark::State& state) {
+    createDestroy<LockedObject>(state);
+}
+
+static void create_destroy_recycled_ids(benchmark::State& state) {
+    createDestroy<RecycledObject>(state);
+}
+
+BENCHMARK(create_destroy_locked_ids)->Arg(1024)->ThreadRange(1, 8);
+BENCHMARK(create_destroy_recycled_ids)->Arg(1024)->ThreadRange(1, 8);
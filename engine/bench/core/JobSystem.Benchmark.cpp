@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+
+#include "starlight/core/JobSystem.hh"
+
+#include <atomic>
+#include <vector>
+
+namespace {
+
+constexpr sl::u64 workerCount = 4;
+
+}  // namespace
+
+// round trip of a single empty job, spawn + wake up + wait
+static void job_system_spawn_wait(benchmark::State& state) {
+    sl::JobSystem jobSystem{ workerCount };
+
+    for (auto _ : state) jobSystem.wait(jobSystem.spawn([]() {}));
+}
+
+// jobs spawned from the main thread go through the shared queue
+static void job_system_spawn_external(benchmark::State& state) {
+    const auto n = static_cast<sl::u64>(state.range(0));
+
+    sl::JobSystem jobSystem{ workerCount };
+    std::vector<sl::JobHandle> jobs;
+    jobs.reserve(n);
+
+    for (auto _ : state) {
+        jobs.clear();
+        for (sl::u64 i = 0; i < n; ++i) jobs.push_back(jobSystem.spawn([]() {}));
+        jobSystem.wait(jobs);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// jobs spawned by a worker land in its own deque, other workers have to steal
+static void job_system_spawn_steal(benchmark::State& state) {
+    const auto n = static_cast<sl::u64>(state.range(0));
+
+    sl::JobSystem jobSystem{ workerCount };
+    std::atomic<sl::u64> counter = 0u;
+
+    for (auto _ : state) {
+        auto root = jobSystem.spawn([&]() {
+            std::vector<sl::JobHandle> jobs;
+            jobs.reserve(n);
+            for (sl::u64 i = 0; i < n; ++i)
+                jobs.push_back(jobSystem.spawn([&]() {
+                    counter.fetch_add(1u, std::memory_order_relaxed);
+                }));
+            jobSystem.wait(jobs);
+        });
+        jobSystem.wait(root);
+    }
+    benchmark::DoNotOptimize(counter.load());
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void job_system_dependency_chain(benchmark::State& state) {
+    const auto n = static_cast<sl::u64>(state.range(0));
+
+    sl::JobSystem jobSystem{ workerCount };
+
+    for (auto _ : state) {
+        sl::JobHandle previous;
+        for (sl::u64 i = 0; i < n; ++i) previous = jobSystem.then(previous, []() {});
+        jobSystem.wait(previous);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void job_system_parallel_for(benchmark::State& state) {
+    const auto n = static_cast<sl::u64>(state.range(0));
+
+    sl::JobSystem jobSystem{ workerCount };
+    std::vector<float> values(n, 1.0f);
+
+    for (auto _ : state) {
+        jobSystem.parallelFor(0u, n, 4096u, [&](sl::u64 begin, sl::u64 end) {
+            for (auto i = begin; i < end; ++i) values[i] = values[i] * 0.5f + 1.0f;
+        });
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void serial_for(benchmark::State& state) {
+    const auto n = static_cast<sl::u64>(state.range(0));
+
+    std::vector<float> values(n, 1.0f);
+
+    for (auto _ : state) {
+        for (sl::u64 i = 0; i < n; ++i) values[i] = values[i] * 0.5f + 1.0f;
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(job_system_spawn_wait)->UseRealTime();
+BENCHMARK(job_system_spawn_external)->Arg(1'000)->Arg(100'000)->UseRealTime();
+BENCHMARK(job_system_spawn_steal)->Arg(1'000)->Arg(100'000)->UseRealTime();
+BENCHMARK(job_system_dependency_chain)->Arg(1'000)->UseRealTime();
+BENCHMARK(job_system_parallel_for)->Arg(1'000'000)->UseRealTime();
+BENCHMARK(serial_for)->Arg(1'000'000)->UseRealTime();
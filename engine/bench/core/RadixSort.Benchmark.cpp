@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+
+#include "starlight/core/RadixSort.hh"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+
+// shaped like draw sort keys: a few materials and meshes, random depth bits
+std::vector<sl::u64> makeKeys(sl::u64 count) {
+    std::mt19937_64 generator{ 1337u };
+    std::vector<sl::u64> keys(count);
+
+    for (auto& key : keys) {
+        const auto material = generator() % 64u;
+        const auto mesh     = generator() % 256u;
+        const auto depth    = generator() & ((1u << 19u) - 1u);
+        key                 = (material << 35u) | (mesh << 19u) | depth;
+    }
+    return keys;
+}
+
+struct KeyIndex {
+    sl::u64 key;
+    sl::u32 index;
+};
+
+}  // namespace
+
+static void std_sort_draw_keys(benchmark::State& state) {
+    const auto source = makeKeys(state.range(0));
+    std::vector<KeyIndex> draws(source.size());
+
+    for (auto _ : state) {
+        for (sl::u32 i = 0; i < source.size(); ++i) draws[i] = { source[i], i };
+        std::ranges::sort(draws, [](const auto& lhs, const auto& rhs) {
+            return lhs.key < rhs.key;
+        });
+        benchmark::DoNotOptimize(draws.data());
+    }
+    state.SetItemsProcessed(state.iterations() * source.size());
+}
+
+static void radix_sort_draw_keys(benchmark::State& state) {
+    const auto source = makeKeys(state.range(0));
+
+    std::vector<sl::u64> keys(source.size());
+    std::vector<sl::u32> indices(source.size());
+    std::vector<sl::u64> keysScratch(source.size());
+    std::vector<sl::u32> indicesScratch(source.size());
+
+    for (auto _ : state) {
+        std::ranges::copy(source, keys.begin());
+        std::iota(indices.begin(), indices.end(), 0u);
+        sl::radixSort(keys, indices, keysScratch, indicesScratch);
+        benchmark::DoNotOptimize(indices.data());
+    }
+    state.SetItemsProcessed(state.iterations() * source.size());
+}
+
+BENCHMARK(std_sort_draw_keys)->Arg(1024)->Arg(16384)->Arg(131072);
+BENCHMARK(radix_sort_draw_keys)->Arg(1024)->Arg(16384)->Arg(131072);
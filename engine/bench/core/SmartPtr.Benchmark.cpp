@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+
+#include "starlight/core/memory/UniquePtr.hh"
+#include "starlight/core/memory/SharedPtr.hh"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+// size of a typical small engine object, e.g. a handle with a couple of fields
+struct Object {
+    explicit Object(sl::u64 value) : values{ value, value, value, value } {}
+
+    sl::u64 values[4];
+};
+
+}  // namespace
+
+static void create_destroy_std_unique_ptr(benchmark::State& state) {
+    for (auto _ : state) {
+        auto object = std::make_unique<Object>(42u);
+        benchmark::DoNotOptimize(object.get());
+    }
+}
+
+static void create_destroy_sl_unique_ptr(benchmark::State& state) {
+    for (auto _ : state) {
+        auto object = sl::UniquePtr<Object>::create(42u);
+        benchmark::DoNotOptimize(object.get());
+    }
+}
+
+static void create_destroy_std_shared_ptr(benchmark::State& state) {
+    for (auto _ : state) {
+        auto object = std::make_shared<Object>(42u);
+        benchmark::DoNotOptimize(object.get());
+    }
+}
+
+static void create_destroy_sl_shared_ptr(benchmark::State& state) {
+    for (auto _ : state) {
+        auto object = sl::SharedPtr<Object>::create(42u);
+        benchmark::DoNotOptimize(object.get());
+    }
+}
+
+// creates a batch of objects before destroying any, so freed blocks are not
+// simply handed back to the next allocation
+template <typename Factory> void createDestroyBatch(benchmark::State& state, Factory&& create) {
+    const auto n = static_cast<sl::u64>(state.range(0));
+
+    using Pointer = decltype(create());
+    std::vector<Pointer> objects;
+    objects.reserve(n);
+
+    for (auto _ : state) {
+        for (sl::u64 i = 0; i < n; ++i) objects.push_back(create());
+        objects.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void batch_std_unique_ptr(benchmark::State& state) {
+    createDestroyBatch(state, []() { return std::make_unique<Object>(42u); });
+}
+
+static void batch_sl_unique_ptr(benchmark::State& state) {
+    createDestroyBatch(state, []() { return sl::UniquePtr<Object>::create(42u); });
+}
+
+static void batch_std_shared_ptr(benchmark::State& state) {
+    createDestroyBatch(state, []() { return std::make_shared<Object>(42u); });
+}
+
+static void batch_sl_shared_ptr(benchmark::State& state) {
+    createDestroyBatch(state, []() { return sl::SharedPtr<Object>::create(42u); });
+}
+
+BENCHMARK(create_destroy_std_unique_ptr)->ThreadRange(1, 4);
+BENCHMARK(create_destroy_sl_unique_ptr)->ThreadRange(1, 4);
+BENCHMARK(create_destroy_std_shared_ptr)->ThreadRange(1, 4);
+BENCHMARK(create_destroy_sl_shared_ptr)->ThreadRange(1, 4);
+
+BENCHMARK(batch_std_unique_ptr)->Arg(10'000);
+BENCHMARK(batch_sl_unique_ptr)->Arg(10'000);
+BENCHMARK(batch_std_shared_ptr)->Arg(10'000);
+BENCHMARK(batch_sl_shared_ptr)->Arg(10'000);
@@ -0,0 +1,125 @@
+#include <benchmark/benchmark.h>
+
+#include "starlight/core/containers/SparseSet.hh"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+
+// about the size of a transform component
+struct Value {
+    explicit Value(float seed) { std::fill(std::begin(data), std::end(data), seed); }
+
+    float data[16];
+};
+
+// values in fixed size pages reached through a dense array of pointers, layout
+// of the previous SparseSet implementation, kept here as a baseline
+class PagedSparseSet {
+    static constexpr sl::u64 pageSize = 1024u;
+
+    struct Page {
+        Page() {}
+
+        alignas(Value) std::byte storage[sizeof(Value) * pageSize];
+    };
+
+public:
+    void emplace(sl::u64 key, float seed) {
+        Value* slot = nullptr;
+        if (not m_freeSlots.empty()) {
+            slot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        } else {
+            const auto slotInPage = m_slotCount++ % pageSize;
+            if (slotInPage == 0u) m_pages.push_back(std::make_unique<Page>());
+            slot = reinterpret_cast<Value*>(m_pages.back()->storage) + slotInPage;
+        }
+        m_values.emplace(key, std::construct_at(slot, seed));
+    }
+
+    void erase(sl::u64 key) {
+        auto value = m_values.get(key);
+        std::destroy_at(value);
+        m_freeSlots.push_back(value);
+        m_values.erase(key);
+    }
+
+    template <typename C> void forEach(C&& callback) {
+        m_values.forEach([&](Value* value) { callback(*value); });
+    }
+
+private:
+    sl::SparseSet<Value*> m_values;
+    std::vector<std::unique_ptr<Page>> m_pages;
+    std::vector<Value*> m_freeSlots;
+    sl::u64 m_slotCount = 0u;
+};
+
+// a third of the values erased and added again in random order, as entities
+// come and go in a scene
+template <typename Set> void fill(Set& set, sl::u64 count) {
+    for (sl::u64 i = 0; i < count; ++i) set.emplace(i, static_cast<float>(i));
+
+    std::vector<sl::u64> churned(count / 3u);
+    std::iota(churned.begin(), churned.end(), 0u);
+    std::ranges::shuffle(churned, std::mt19937{ 42u });
+
+    for (const auto key : churned) set.erase(key * 3u);
+    for (const auto key : churned) set.emplace(key * 3u, static_cast<float>(key));
+}
+
+template <typename Set> void iterate(benchmark::State& state) {
+    const auto count = static_cast<sl::u64>(state.range(0));
+
+    Set set;
+    fill(set, count);
+
+    for (auto _ : state) {
+        float sum = 0.0f;
+        set.forEach([&](Value& value) { sum += value.data[0] + value.data[15]; });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+template <typename Set> void churn(benchmark::State& state) {
+    const auto count = static_cast<sl::u64>(state.range(0));
+
+    Set set;
+    fill(set, count);
+
+    sl::u64 key = 0u;
+    for (auto _ : state) {
+        set.erase(key);
+        set.emplace(key, static_cast<float>(key));
+        key = (key + 7u) % count;
+    }
+}
+
+}  // namespace
+
+static void iterate_contiguous_sparse_set(benchmark::State& state) {
+    iterate<sl::SparseSet<Value>>(state);
+}
+
+static void iterate_paged_sparse_set(benchmark::State& state) {
+    iterate<PagedSparseSet>(state);
+}
+
+static void churn_contiguous_sparse_set(benchmark::State& state) {
+    churn<sl::SparseSet<Value>>(state);
+}
+
+static void churn_paged_sparse_set(benchmark::State& state) {
+    churn<PagedSparseSet>(state);
+}
+
+BENCHMARK(iterate_contiguous_sparse_set)->RangeMultiplier(8)->Range(64, 1024 * 64);
+BENCHMARK(iterate_paged_sparse_set)->RangeMultiplier(8)->Range(64, 1024 * 64);
+BENCHMARK(churn_contiguous_sparse_set)->RangeMultiplier(8)->Range(64, 1024 * 64);
+BENCHMARK(churn_paged_sparse_set)->RangeMultiplier(8)->Range(64, 1024 * 64);
@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+
+#include "starlight/core/math/Transform.hh"
+
+#include <vector>
+
+namespace {
+
+constexpr sl::u64 objectCount = 100'000;
+
+// previous Transform layout: matrix rotation plus a cached model, ~150 bytes
+struct MatrixTransform {
+    sl::Mat4<sl::f32> model{ 1.0f };
+    sl::Vec3<sl::f32> position{ 0.0f };
+    sl::Vec3<sl::f32> scale{ 1.0f };
+    sl::Mat4<sl::f32> rotation{ 1.0f };
+    bool updated            = true;
+    MatrixTransform* parent = nullptr;
+
+    const sl::Mat4<sl::f32>& getModel() {
+        if (updated) {
+            model = glm::scale(rotation * glm::translate(rotation, position), scale);
+            updated = false;
+        }
+        return model;
+    }
+};
+
+const sl::Vec3<sl::f32> axis{ 0.0f, 1.0f, 0.0f };
+
+}  // namespace
+
+static void matrix_transform_update(benchmark::State& state) {
+    std::vector<MatrixTransform> transforms(objectCount);
+    std::vector<sl::Mat4<sl::f32>> models(objectCount);
+
+    for (auto _ : state) {
+        for (sl::u64 i = 0; i < objectCount; ++i) {
+            auto& transform    = transforms[i];
+            transform.rotation = glm::rotate(transform.rotation, 0.01f, axis);
+            transform.position += sl::Vec3<sl::f32>{ 0.01f, 0.0f, 0.0f };
+            transform.updated = true;
+            models[i]         = transform.getModel();
+        }
+        benchmark::DoNotOptimize(models.data());
+    }
+    state.SetItemsProcessed(state.iterations() * objectCount);
+}
+
+static void quaternion_transform_update(benchmark::State& state) {
+    std::vector<sl::Transform> transforms(objectCount);
+    std::vector<sl::Mat4<sl::f32>> models(objectCount);
+
+    for (auto _ : state) {
+        for (sl::u64 i = 0; i < objectCount; ++i) {
+            auto& transform = transforms[i];
+            transform.rotate(axis, 0.01f);
+            transform.translate(sl::Vec3<sl::f32>{ 0.01f, 0.0f, 0.0f });
+            models[i] = transform.getModel();
+        }
+        benchmark::DoNotOptimize(models.data());
+    }
+    state.SetItemsProcessed(state.iterations() * objectCount);
+}
+
+static void quaternion_transform_compose(benchmark::State& state) {
+    std::vector<sl::Transform> transforms(objectCount);
+    std::vector<sl::Mat4<sl::f32>> models(objectCount);
+
+    for (auto _ : state) {
+        for (sl::u64 i = 0; i < objectCount; ++i)
+            models[i] = transforms[i].getModel();
+        benchmark::DoNotOptimize(models.data());
+    }
+    state.SetItemsProcessed(state.iterations() * objectCount);
+}
+
+BENCHMARK(matrix_transform_update)->Unit(benchmark::kMillisecond);
+BENCHMARK(quaternion_transform_update)->Unit(benchmark::kMillisecond);
+BENCHMARK(quaternion_transform_compose)->Unit(benchmark::kMillisecond);
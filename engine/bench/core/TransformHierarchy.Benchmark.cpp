@@ -0,0 +1,133 @@
+#include <benchmark/benchmark.h>
+
+#include "starlight/core/math/TransformHierarchy.hh"
+
+#include <array>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr sl::u64 nodeCount = 50'000;
+constexpr sl::u64 levels    = 10;
+
+using Mat4 = std::array<sl::f32, 16>;
+
+Mat4 multiply(const Mat4& lhs, const Mat4& rhs) {
+    Mat4 out{};
+    for (int column = 0; column < 4; ++column)
+        for (int row = 0; row < 4; ++row)
+            for (int k = 0; k < 4; ++k)
+                out[column * 4 + row] += lhs[k * 4 + row] * rhs[column * 4 + k];
+    return out;
+}
+
+Mat4 identity() { return { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 }; }
+
+// mirrors sl::Transform: cached local matrix, world recomputed recursively
+struct LegacyTransform {
+    Mat4 getWorld() const {
+        return parent ? multiply(parent->getWorld(), getModel()) : getModel();
+    }
+
+    const Mat4& getModel() const {
+        if (needsUpdate) {
+            auto translation = identity();
+            translation[12]  = position[0];
+            translation[13]  = position[1];
+            translation[14]  = position[2];
+
+            auto scaleMatrix = identity();
+            scaleMatrix[0]   = scale[0];
+            scaleMatrix[5]   = scale[1];
+            scaleMatrix[10]  = scale[2];
+
+            model = multiply(
+              multiply(rotation, multiply(rotation, translation)), scaleMatrix
+            );
+            needsUpdate = false;
+        }
+        return model;
+    }
+
+    void setPosition(sl::f32 x, sl::f32 y, sl::f32 z) {
+        position    = { x, y, z };
+        needsUpdate = true;
+    }
+
+    std::array<sl::f32, 3> position{};
+    std::array<sl::f32, 3> scale{ 1.0f, 1.0f, 1.0f };
+    Mat4 rotation = identity();
+    mutable Mat4 model;
+    mutable bool needsUpdate = true;
+    const LegacyTransform* parent = nullptr;
+};
+
+// parent of each node, every node below the first level hangs off a random
+// node of the level above
+std::vector<sl::u32> makeParents() {
+    std::mt19937 generator{ 7u };
+    std::vector<sl::u32> parents(nodeCount, ~0u);
+
+    const auto perLevel = nodeCount / levels;
+    for (sl::u64 i = perLevel; i < nodeCount; ++i) {
+        const auto levelStart = (i / perLevel - 1u) * perLevel;
+        parents[i] = static_cast<sl::u32>(levelStart + generator() % perLevel);
+    }
+    return parents;
+}
+
+}  // namespace
+
+static void legacy_recursive_world(benchmark::State& state) {
+    const auto parents = makeParents();
+    const auto stride  = static_cast<sl::u64>(state.range(0));
+
+    std::vector<LegacyTransform> transforms(nodeCount);
+    for (sl::u64 i = 0; i < nodeCount; ++i)
+        if (parents[i] != ~0u) transforms[i].parent = &transforms[parents[i]];
+
+    std::vector<Mat4> worlds(nodeCount);
+    sl::f32 offset = 0.0f;
+
+    for (auto _ : state) {
+        offset += 1.0f;
+        for (sl::u64 i = 0; i < nodeCount; i += stride)
+            transforms[i].setPosition(offset, 0.0f, 0.0f);
+
+        // what the scene does every frame, one getWorld() per node
+        for (sl::u64 i = 0; i < nodeCount; ++i) worlds[i] = transforms[i].getWorld();
+        benchmark::DoNotOptimize(worlds.data());
+    }
+    state.SetItemsProcessed(state.iterations() * nodeCount);
+}
+
+static void transform_hierarchy_update(benchmark::State& state) {
+    const auto parents = makeParents();
+    const auto stride  = static_cast<sl::u64>(state.range(0));
+
+    sl::TransformHierarchy hierarchy{ nodeCount };
+    std::vector<sl::TransformHierarchy::Handle> handles(nodeCount);
+    for (sl::u64 i = 0; i < nodeCount; ++i) {
+        handles[i] = hierarchy.create(
+          parents[i] == ~0u ? sl::TransformHierarchy::invalidHandle
+                            : handles[parents[i]]
+        );
+    }
+    hierarchy.update();
+
+    sl::f32 offset = 0.0f;
+
+    for (auto _ : state) {
+        offset += 1.0f;
+        for (sl::u64 i = 0; i < nodeCount; i += stride)
+            hierarchy.setPosition(handles[i], offset, 0.0f, 0.0f);
+
+        benchmark::DoNotOptimize(hierarchy.update());
+    }
+    state.SetItemsProcessed(state.iterations() * nodeCount);
+}
+
+// argument is the stride of modified nodes: 1 - everything moves, 100 - ~1%
+BENCHMARK(legacy_recursive_world)->Arg(1)->Arg(100)->Unit(benchmark::kMillisecond);
+BENCHMARK(transform_hierarchy_update)->Arg(1)->Arg(100)->Unit(benchmark::kMillisecond);
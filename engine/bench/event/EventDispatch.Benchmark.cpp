@@ -0,0 +1,129 @@
+#include <benchmark/benchmark.h>
+
+#include "starlight/event/EventBroker.hh"
+
+#include <functional>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr sl::u64 eventsPerFrame   = 10'000;
+constexpr sl::u64 eventTypeCount   = 10;
+constexpr sl::u64 handlersPerEvent = 5;
+
+template <sl::u64 N> struct BenchEvent {
+    sl::u64 value;
+};
+
+// type_index keyed map of std::function chains with a handled callback created
+// for every call, equivalent of the previous EventBroker, kept as a baseline
+class LegacyBroker {
+    using HandledCallback = std::function<void()>;
+    using Callback        = std::function<void(const void*, HandledCallback&&)>;
+
+    struct EventStorageBase {
+        virtual ~EventStorageBase()             = default;
+        virtual std::type_index getType() const = 0;
+        virtual const void* getEvent() const    = 0;
+    };
+
+    template <typename T> struct EventStorage : EventStorageBase {
+        explicit EventStorage(const T& event) : event(event) {}
+
+        std::type_index getType() const override { return typeid(T); }
+        const void* getEvent() const override { return &event; }
+
+        T event;
+    };
+
+public:
+    template <typename T> void emit(const T& event) {
+        m_events.push_back(std::make_unique<EventStorage<T>>(event));
+    }
+
+    template <typename T, typename Handler> void pushEventHandler(Handler&& handler) {
+        m_handlers[typeid(T)].emplace_back(
+          [handler = std::forward<Handler>(handler
+           )](const void* event, HandledCallback&&) {
+              handler(*static_cast<const T*>(event));
+          }
+        );
+    }
+
+    void dispatch() {
+        for (auto& event : m_events) {
+            auto chain = m_handlers.find(event->getType());
+            if (chain == m_handlers.end()) continue;
+
+            bool handled = false;
+            for (auto& handler : chain->second) {
+                handler(event->getEvent(), [&handled]() { handled = true; });
+                if (handled) break;
+            }
+        }
+        m_events.clear();
+    }
+
+private:
+    std::vector<std::unique_ptr<EventStorageBase>> m_events;
+    std::unordered_map<std::type_index, std::vector<Callback>> m_handlers;
+};
+
+template <typename Broker, sl::u64... N>
+void pushHandlers(Broker& broker, sl::u64& sink, std::index_sequence<N...>) {
+    for (sl::u64 i = 0; i < handlersPerEvent; ++i) {
+        (broker.template pushEventHandler<BenchEvent<N>>(
+           [&sink](const BenchEvent<N>& event) { sink += event.value; }
+         ),
+         ...);
+    }
+}
+
+template <typename Emitter, sl::u64... N>
+void emitFrame(Emitter&& emit, std::index_sequence<N...>) {
+    for (sl::u64 i = 0; i < eventsPerFrame / eventTypeCount; ++i)
+        (emit(BenchEvent<N>{ i }), ...);
+}
+
+}  // namespace
+
+static void dispatch_legacy_broker(benchmark::State& state) {
+    constexpr auto types = std::make_index_sequence<eventTypeCount>{};
+
+    LegacyBroker broker;
+    sl::u64 sink = 0u;
+    pushHandlers(broker, sink, types);
+
+    for (auto _ : state) {
+        emitFrame([&](const auto& event) { broker.emit(event); }, types);
+        broker.dispatch();
+    }
+
+    benchmark::DoNotOptimize(sink);
+    state.SetItemsProcessed(state.iterations() * eventsPerFrame);
+}
+
+static void dispatch_event_broker(benchmark::State& state) {
+    constexpr auto types = std::make_index_sequence<eventTypeCount>{};
+
+    sl::EventBroker broker{ static_cast<sl::u64>(state.range(0)) };
+    auto& proxy  = broker.getProxy();
+    sl::u64 sink = 0u;
+    pushHandlers(proxy, sink, types);
+
+    for (auto _ : state) {
+        emitFrame([&]<typename T>(const T& event) { proxy.emit<T>(event); }, types);
+        broker.dispatch();
+    }
+
+    benchmark::DoNotOptimize(sink);
+    state.SetItemsProcessed(state.iterations() * eventsPerFrame);
+}
+
+BENCHMARK(dispatch_legacy_broker);
+// a queue smaller than the frame load shows the cost of the overflow path
+BENCHMARK(dispatch_event_broker)->Arg(1024)->Arg(16384);
@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include "starlight/renderer/light/LightClusters.hh"
+
+#include <random>
+#include <vector>
+
+namespace {
+
+// same detection as LightClusters.cpp, SL_ENABLE_AVX only passes -mavx
+constexpr auto instructionSet =
+#if defined(__AVX__)
+  "AVX";
+#elif defined(__SSE2__) || defined(_M_X64)
+  "SSE";
+#else
+  "scalar";
+#endif
+
+// 45 degree, 16:9 perspective
+const sl::LightClusters::Properties properties{
+    .tilesX           = 16u,
+    .tilesY           = 9u,
+    .slices           = 24u,
+    .projectionScaleX = 1.358f,
+    .projectionScaleY = 2.414f,
+    .nearZ            = 0.1f,
+    .farZ             = 200.0f,
+};
+
+// lights inside of the view frustum, ranges typical for local lights
+std::vector<sl::LightSphere> makeLights(sl::u64 count) {
+    std::mt19937 generator{ 42u };
+    std::uniform_real_distribution<sl::f32> depth{ 1.0f, properties.farZ };
+    std::uniform_real_distribution<sl::f32> side{ -1.0f, 1.0f };
+    std::uniform_real_distribution<sl::f32> radius{ 1.0f, 10.0f };
+
+    std::vector<sl::LightSphere> lights(count);
+    for (auto& light : lights) {
+        const auto z = depth(generator);
+        light        = sl::LightSphere{
+                   .position = { side(generator) * z / properties.projectionScaleX,
+                                 side(generator) * z / properties.projectionScaleY, -z },
+                   .radius   = radius(generator),
+        };
+    }
+    return lights;
+}
+
+}  // namespace
+
+static void light_clusters_build(benchmark::State& state) {
+    const auto lights = makeLights(state.range(0));
+    sl::LightClusters clusters{ properties };
+
+    for (auto _ : state) {
+        clusters.build(lights);
+        benchmark::DoNotOptimize(clusters.getLightIndices().data());
+    }
+    state.SetItemsProcessed(state.iterations() * lights.size());
+    state.SetLabel(instructionSet);
+    state.counters["indices"] = clusters.getLightIndices().size();
+}
+
+BENCHMARK(light_clusters_build)
+  ->Arg(64)
+  ->Arg(256)
+  ->Arg(1024)
+  ->Arg(4096)
+  ->Unit(benchmark::kMicrosecond);
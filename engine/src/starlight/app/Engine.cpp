@@ -3,8 +3,13 @@
 namespace sl {
 
 Engine::Engine(const Config& config) :
-    m_globals(config), m_isRunning(true), m_eventProxy(m_eventBroker.getProxy()),
+    m_globals(config), m_isRunning(true),
+    m_eventBroker(config.events.queueCapacity.value_or(
+      EventBroker::defaultEventQueueCapacity
+    )),
+    m_eventProxy(m_eventBroker.getProxy()),
     m_eventSentinel(m_eventProxy), m_input(m_window.getImpl()),
+    m_frameAllocator(m_renderer.getMaxFramesInFlight()),
     m_defaultScene(&m_defaultCamera), m_defaultRenderGraph(m_renderer),
     m_camera(&m_defaultCamera), m_scene(&m_defaultScene),
     m_renderGraph(&m_defaultRenderGraph),
@@ -29,6 +34,7 @@ void Engine::render() {
 }
 
 float Engine::beginFrame() {
+    m_frameAllocator.beginFrame();
     m_taskQueue.dispatchQueue(TaskQueue::Type::preFrame);
 
     m_window.getImpl().update();
@@ -53,6 +59,7 @@ RenderGraph* Engine::getRenderGraph() { return m_renderGraph; }
 void Engine::updateFrame(float frameTime) {
     m_camera->update(frameTime);
     update(frameTime);
+    m_scene->update(frameTime);
 }
 
 void Engine::initEvents() {
@@ -7,6 +7,7 @@
 #include "starlight/core/Time.hh"
 #include "starlight/core/Globals.hh"
 #include "starlight/core/TaskQueue.hh"
+#include "starlight/core/memory/FrameAllocator.hh"
 #include "starlight/event/EventBroker.hh"
 #include "starlight/event/EventHandlerSentinel.hh"
 #include "starlight/window/Window.hh"
@@ -64,6 +65,7 @@ private:
 
     Device m_device;
     Renderer m_renderer;
+    FrameAllocator m_frameAllocator;
 
     EulerCamera m_defaultCamera;
     Scene m_defaultScene;
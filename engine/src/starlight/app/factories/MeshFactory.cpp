@@ -2,6 +2,8 @@
 
 namespace sl {
 
+static constexpr u32 defaultSphereLODCount = 2u;
+
 MeshFactory::MeshFactory(Buffer& vertexBuffer, Buffer& indexBuffer) :
     m_vertexBuffer(vertexBuffer), m_indexBuffer(indexBuffer) {
     createDefaults();
@@ -14,9 +16,94 @@ SharedPtr<Mesh> MeshFactory::create(
 }
 
 SharedPtr<Mesh> MeshFactory::create(
-  const std::string& name, const Mesh::Properties3D& config
+  const std::string& name, const Mesh::Properties3D& config, u32 lodCount
 ) {
-    return save(createMesh(config.toMeshData(), name));
+    auto mesh = save(createMesh(config.toMeshData(), name));
+    if (lodCount > 0u) {
+        LODSource source{ .geometry = config, .level = 0u };
+        std::vector<SharedPtr<Mesh>> lods;
+        appendLODs(name, source, lodCount, lods);
+        m_lodSources.insert_or_assign(name, std::move(source));
+    }
+    return mesh;
+}
+
+void MeshFactory::erase(const std::string& name) {
+    for (u32 level = 1; find(getLODName(name, level)); ++level)
+        Factory::erase(getLODName(name, level));
+
+    m_lodSources.erase(name);
+    Factory::erase(name);
+}
+
+std::vector<SharedPtr<Mesh>> MeshFactory::createLODs(
+  const std::string& name, const Mesh::Properties3D& config, u32 count
+) {
+    std::vector<SharedPtr<Mesh>> lods;
+    lods.reserve(count);
+
+    LODSource source{ .geometry = config, .level = 0u };
+    appendLODs(name, source, count, lods);
+    return lods;
+}
+
+std::vector<SharedPtr<Mesh>> MeshFactory::getLODs(
+  const std::string& name, u32 count
+) {
+    std::vector<SharedPtr<Mesh>> lods;
+    lods.reserve(count);
+
+    for (u32 level = 1; level <= count; ++level) {
+        auto lod = find(getLODName(name, level));
+        if (not lod) break;
+        lods.push_back(lod);
+    }
+    if (lods.size() == count) return lods;
+
+    const auto source = m_lodSources.find(name);
+    if (source == m_lodSources.end()) {
+        log::warn(
+          "Mesh '{}' was created without levels of detail, found {} of {}", name,
+          lods.size(), count
+        );
+        return lods;
+    }
+
+    // levels are erased only together with the mesh, so the kept geometry is the
+    // one of the last level found
+    if (source->second.level != lods.size()) {
+        log::warn(
+          "Levels of detail of mesh '{}' were erased, found {} of {}", name,
+          lods.size(), count
+        );
+        return lods;
+    }
+
+    appendLODs(name, source->second, count, lods);
+    return lods;
+}
+
+void MeshFactory::appendLODs(
+  const std::string& name, LODSource& source, u32 count,
+  std::vector<SharedPtr<Mesh>>& lods
+) {
+    // empty once the error limit kept the mesh as it is, nothing more to simplify
+    while (source.level < count && not source.geometry.vertices.empty()) {
+        auto simplified = source.geometry.simplify(0.5f);
+        if (simplified.indices.size() >= source.geometry.indices.size()) {
+            source.geometry = Mesh::Properties3D{};
+            break;
+        }
+
+        ++source.level;
+        const auto lodName = getLODName(name, source.level);
+        lods.push_back(save(createMesh(simplified.toMeshData(), lodName)));
+        source.geometry = std::move(simplified);
+    }
+}
+
+std::string MeshFactory::getLODName(const std::string& name, u32 level) {
+    return fmt::format("{}.LOD{}", name, level);
 }
 
 SharedPtr<Mesh> MeshFactory::getCube() { return m_cube; }
@@ -27,17 +114,18 @@ void MeshFactory::createDefaults() {
     Mesh::Properties3D unitSphere{
         SphereProperties{ 16, 16, 1.0f }
     };
-    m_unitSphere = save(createMesh(unitSphere.toMeshData(), "UnitSphere"));
+    // the only default with enough triangles to simplify
+    m_unitSphere = create("UnitSphere", unitSphere, defaultSphereLODCount);
 
     Mesh::Properties3D plane{
         PlaneProperties{ 5.0f, 5.0f, 2, 2 }
     };
-    m_plane = save(createMesh(plane.toMeshData(), "Plane"));
+    m_plane = create("Plane", plane);
 
     Mesh::Properties3D cube{
         CubeProperties{ 1.0f, 1.0f, 1.0f, 1, 1 }
     };
-    m_cube = save(createMesh(cube.toMeshData(), "Cube"));
+    m_cube = create("Cube", cube);
 }
 
 SharedPtr<Mesh> MeshFactory::createMesh(
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "starlight/core/Factory.hh"
 #include "starlight/renderer/Mesh.hh"
 
@@ -11,22 +15,52 @@ public:
 
     template <typename T>
     requires std::is_constructible_v<Mesh::Properties3D, const T&>
-    SharedPtr<Mesh> create(const std::string& name, const T& properties) {
-        return create(name, Mesh::Properties3D{ properties });
+    SharedPtr<Mesh> create(
+      const std::string& name, const T& properties, u32 lodCount = 0u
+    ) {
+        return create(name, Mesh::Properties3D{ properties }, lodCount);
     }
 
     SharedPtr<Mesh> create(
       const std::string& name, const Mesh::Properties2D& config
     );
+    // with a level of detail count the levels are created right away and the
+    // geometry of the coarsest one is kept, so getLODs() can extend them later
     SharedPtr<Mesh> create(
-      const std::string& name, const Mesh::Properties3D& config
+      const std::string& name, const Mesh::Properties3D& config, u32 lodCount = 0u
+    );
+
+    // the levels of detail and the geometry kept for them go with the mesh
+    void erase(const std::string& name);
+
+    // coarser levels of detail for a mesh, each with about half of the triangles
+    // of the one before; stops early once the error limit keeps the mesh as it is
+    std::vector<SharedPtr<Mesh>> createLODs(
+      const std::string& name, const Mesh::Properties3D& config, u32 count
     );
+    // same for a 3D mesh created by this factory with a level of detail count,
+    // levels created before are reused
+    std::vector<SharedPtr<Mesh>> getLODs(const std::string& name, u32 count);
+
+    static std::string getLODName(const std::string& name, u32 level);
 
     SharedPtr<Mesh> getCube();
     SharedPtr<Mesh> getUnitSphere();
     SharedPtr<Mesh> getPlane();
 
 private:
+    // geometry of the coarsest level of detail created so far, 0 for the mesh
+    struct LODSource {
+        Mesh::Properties3D geometry;
+        u32 level;
+    };
+
+    // simplifies the source further, appending levels until there are count
+    void appendLODs(
+      const std::string& name, LODSource& source, u32 count,
+      std::vector<SharedPtr<Mesh>>& lods
+    );
+
     SharedPtr<Mesh> createMesh(const Mesh::Data& meshData, const std::string& name);
 
     void createDefaults();
@@ -34,6 +68,10 @@ private:
     Buffer& m_vertexBuffer;
     Buffer& m_indexBuffer;
 
+    // of meshes created with levels of detail, to simplify more of them when a
+    // scene asks for it
+    std::unordered_map<std::string, LODSource> m_lodSources;
+
     SharedPtr<Mesh> m_unitSphere;
     SharedPtr<Mesh> m_plane;
     SharedPtr<Mesh> m_cube;
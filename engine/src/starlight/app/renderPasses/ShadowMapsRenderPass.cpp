@@ -1,18 +1,32 @@
 #include "ShadowMapsRenderPass.hh"
 
 #include "starlight/window/Window.hh"
+#include "starlight/core/Utils.hh"
+#include "starlight/core/math/Culling.hh"
 #include "starlight/app/factories/ShaderFactory.hh"
 #include "starlight/renderer/Renderer.hh"
+#include "starlight/renderer/Instancing.hh"
+#include "starlight/renderer/DrawList.hh"
 
 namespace sl {
 
-static constexpr u64 shadowMapResolution = 1024;
+static constexpr u32 cascadeResolution = 1024;
+static constexpr u32 shadowMapWidth =
+  cascadeResolution * ShadowMapsRenderPass::atlasTilesPerRow;
+static constexpr u32 shadowMapHeight =
+  cascadeResolution * ShadowMapsRenderPass::atlasRows;
+
+static_assert(
+  ShadowMapsRenderPass::atlasTilesPerRow * ShadowMapsRenderPass::atlasRows
+  == ShadowMapsRenderPass::layerCount * ShadowCascades::maxCascades
+);
 
 ShadowMapsRenderPass::ShadowMapsRenderPass(Renderer& renderer) :
     RenderPass(
       renderer, ShaderFactory::get().load("Builtin.Shader.ShadowMaps"),
       { 0.0f, 0.0f }, "ShadowMapsRenderPass"
-    ) {}
+    ),
+    m_cascades(ShadowCascades::Properties{ .resolution = cascadeResolution }) {}
 
 RenderPassBackend::Properties ShadowMapsRenderPass::createRenderPassProperties(
   [[maybe_unused]] bool hasPreviousPass, [[maybe_unused]] bool hasNextPass
@@ -20,22 +34,25 @@ RenderPassBackend::Properties ShadowMapsRenderPass::createRenderPassProperties(
     auto& swapchain      = m_renderer.getSwapchain();
     auto depthProperties = swapchain.getDepthBuffer()->getImageData();
 
-    depthProperties.width  = shadowMapResolution;
-    depthProperties.height = shadowMapResolution;
+    depthProperties.width  = shadowMapWidth;
+    depthProperties.height = shadowMapHeight;
     depthProperties.usage |= Texture::Usage::sampled;
 
     const auto swapchainImageCount = swapchain.getImageCount();
 
+    m_shadowMaps.clear();
     for (u32 i = 0; i < swapchainImageCount; ++i)
         m_shadowMaps.push_back(Texture::create(depthProperties));
 
+    // new maps, nothing is cached in them yet
+    m_staticTileHashes.assign(swapchainImageCount, TileHashes{});
+
     RenderPassBackend::Properties props;
 
-    props.clearFlags = ClearFlags::depth;
-    props.rect       = Rect2<u32>{
-        Vec2<u32>{ 0u,                  0u                  },
-        Vec2<u32>{ shadowMapResolution, shadowMapResolution }
-    };
+    // cached static tiles have to survive, tiles are cleared one by one instead;
+    // new depth textures start in the general layout the load expects
+    props.clearFlags = ClearFlags::none;
+    props.rect       = getViewport();
 
     props.renderTargets.reserve(swapchainImageCount);
 
@@ -53,29 +70,197 @@ void ShadowMapsRenderPass::render(
 ) {
     if (packet.directionalLights.empty()) return;
 
-    auto depthMVP =
-      math::ortho<float>(-5.0f, 5.0f, -5.0f, 5.0f, -5.0f, 20.0f)
-      * math::lookAt(
-        -packet.directionalLights[0].direction, Vec3<f32>(0.0f, 0.0f, 0.0f),
-        Vec3<f32>(0.0f, 1.0f, 0.0f)
-      );
+    updateCascades(packet);
+    const auto cascades = m_cascades.getCascades();
 
     setGlobalUniforms(commandBuffer, frameNumber, imageIndex, [&](auto& setter) {
-        setter.set("depthMVP", depthMVP);
+        std::array<Mat4<f32>, ShadowCascades::maxCascades> viewProjections;
+        for (u32 i = 0; i < cascades.size(); ++i)
+            viewProjections[i] = math::make_mat4(cascades[i].viewProjection);
+        setter.set("cascadeViewProjections", viewProjections);
     });
 
-    for (auto& [worldTransform, mesh, _] : packet.entities) {
-        setPushConstant(commandBuffer, "model", worldTransform);
-        drawMesh(*mesh, commandBuffer);
+    auto& frameAllocator = FrameAllocator::get();
+    const auto& casters  = packet.shadowCasters;
+    const auto count     = casters.size();
+
+    // world space boxes as structure of arrays, culled against every cascade
+    auto boxes = frameAllocator.makeVector<f32>(count * 6u);
+    boxes.resize(count * 6u);
+
+    for (u64 i = 0; i < count; ++i) {
+        const auto& extent = casters[i].mesh->getExtent();
+
+        f32 center[3];
+        f32 halfSize[3];
+        transformBox(
+          math::value_ptr(casters[i].worldTransform), math::value_ptr(extent.min),
+          math::value_ptr(extent.max), center, halfSize
+        );
+        for (u64 axis = 0; axis < 3; ++axis) {
+            boxes[axis * count + i]       = center[axis];
+            boxes[(axis + 3) * count + i] = halfSize[axis];
+        }
+    }
+
+    const BoxesView boxesView{
+        .centerX = boxes.data(),
+        .centerY = boxes.data() + count,
+        .centerZ = boxes.data() + count * 2u,
+        .extentX = boxes.data() + count * 3u,
+        .extentY = boxes.data() + count * 4u,
+        .extentZ = boxes.data() + count * 5u,
+        .count   = count,
+    };
+
+    // depth only, so entities sharing a mesh go into one draw whatever the material
+    DrawList drawList{ count };
+    for (u32 i = 0; i < count; ++i) {
+        drawList.add(
+          DrawList::makeKey({
+            .pass     = 0u,
+            .layer    = DrawList::Layer::opaque,
+            .pipeline = 0u,
+            .material = 0u,
+            .mesh     = Mesh::getIndex(casters[i].mesh->id),
+            .depth    = 0.0f,
+          }),
+          i
+        );
+    }
+    drawList.sort();
+    const auto order = drawList.getIndices();
+
+    struct TileDraw {
+        Rect2<u32> viewport;
+        u32 cascade;
+        u64 firstBatch;
+        u64 endBatch;
+    };
+
+    // instances of all tiles share the instance buffer
+    auto visible    = frameAllocator.makeVector<u8>(count);
+    auto sorted     = frameAllocator.makeVector<RenderEntity>(count);
+    auto transforms = frameAllocator.makeVector<Mat4<f32>>(count);
+    auto batches    = frameAllocator.makeVector<InstanceBatch>();
+
+    auto tiles = frameAllocator.makeVector<TileDraw>(layerCount * cascades.size());
+    visible.resize(count);
+    auto& staticHashes = m_staticTileHashes[imageIndex];
+
+    for (u32 i = 0; i < cascades.size(); ++i) {
+        auto planes = extractFrustumPlanes(cascades[i].viewProjection);
+        // extruded towards the light, the shader flattens casters in front of the
+        // near plane onto it
+        planes[4] = Plane{ .a = 0.0f, .b = 0.0f, .c = 0.0f, .d = 1.0f };
+        cullBoxes(planes, boxesView, visible.data());
+
+        // the light direction and the camera movement are part of the matrix
+        auto hash = hashFloats(fnvOffset, cascades[i].viewProjection, 16u);
+        for (const auto index : order) {
+            const auto& caster = casters[index];
+            if (not visible[index] || not caster.isStatic) continue;
+
+            hash = (hash ^ Mesh::getIndex(caster.mesh->id)) * fnvPrime;
+            hash = hashFloats(hash, math::value_ptr(caster.worldTransform), 16u);
+        }
+        const bool isStaticTileValid = staticHashes[i] == hash;
+        staticHashes[i]              = hash;
+
+        for (const auto layer : { Layer::staticCasters, Layer::dynamicCasters }) {
+            const bool isStatic = layer == Layer::staticCasters;
+            if (isStatic && isStaticTileValid) continue;
+
+            const auto firstEntity = sorted.size();
+            for (const auto index : order) {
+                const auto& caster = casters[index];
+                if (not visible[index] || caster.isStatic != isStatic) continue;
+
+                sorted.push_back(caster);
+                transforms.push_back(caster.worldTransform);
+            }
+
+            const auto firstBatch = batches.size();
+            appendInstanceBatches<RenderEntity>(
+              std::span<const RenderEntity>{ sorted }.subspan(firstEntity),
+              InstanceGrouping::mesh, batches
+            );
+            tiles.push_back(TileDraw{
+              .viewport   = getTileViewport(layer, i),
+              .cascade    = i,
+              .firstBatch = firstBatch,
+              .endBatch   = batches.size(),
+            });
+        }
     }
+    setInstanceTransforms(commandBuffer, imageIndex, transforms);
+
+    for (const auto& [viewport, cascade, firstBatch, endBatch] : tiles) {
+        commandBuffer.execute(SetViewportCommand{
+          .offset = viewport.offset,
+          .size   = viewport.size,
+        });
+        commandBuffer.execute(SetScissorsCommand{
+          .offset = viewport.offset,
+          .size   = viewport.size,
+        });
+        commandBuffer.execute(ClearDepthCommand{
+          .offset = viewport.offset,
+          .size   = viewport.size,
+        });
+        setPushConstant(commandBuffer, "cascade", static_cast<i32>(cascade));
+
+        for (auto batch = firstBatch; batch < endBatch; ++batch) {
+            const auto& [mesh, _, firstInstance, instanceCount] = batches[batch];
+            drawMesh(*mesh, commandBuffer, firstInstance, instanceCount);
+        }
+    }
+
+    // the passes after this one draw with the scissors set at the frame start
+    commandBuffer.execute(SetScissorsCommand{
+      .offset = Vec2<u32>{ 0u, 0u },
+      .size   = Window::get().getFramebufferSize(),
+    });
+
     packet.shadowMaps.push_back(m_shadowMaps[imageIndex].get());
+    packet.shadowCascades.assign(cascades.begin(), cascades.end());
 }
 
 Rect2<u32> ShadowMapsRenderPass::getViewport() {
     return Rect2<u32>{
-        Vec2<u32>{ 0u,                  0u                  },
-        Vec2<u32>{ shadowMapResolution, shadowMapResolution }
+        Vec2<u32>{ 0u,             0u              },
+        Vec2<u32>{ shadowMapWidth, shadowMapHeight }
     };
 }
 
+Rect2<u32> ShadowMapsRenderPass::getTileViewport(Layer layer, u32 cascade) const {
+    const auto tile =
+      static_cast<u32>(layer) * ShadowCascades::maxCascades + cascade;
+    const auto column = tile % atlasTilesPerRow;
+    const auto row    = tile / atlasTilesPerRow;
+
+    return Rect2<u32>{
+        Vec2<u32>{ column * cascadeResolution, row * cascadeResolution },
+        Vec2<u32>{ cascadeResolution,          cascadeResolution       }
+    };
+}
+
+void ShadowMapsRenderPass::updateCascades(const RenderPacket& packet) {
+    const auto camera                = packet.camera;
+    const auto& projection           = camera->getProjectionMatrix();
+    const auto& projectionProperties = camera->getProjectionProperties();
+    const Mat4<f32> inverseView      = math::inverse(camera->getViewMatrix());
+
+    m_cascades.update(
+      ShadowCascades::View{
+        .inverseView      = math::value_ptr(inverseView),
+        .projectionScaleX = projection[0][0],
+        .projectionScaleY = projection[1][1],
+        .nearZ            = projectionProperties.nearZ,
+        .farZ             = projectionProperties.farZ,
+      },
+      math::value_ptr(packet.directionalLights[0].direction)
+    );
+}
+
 }  // namespace sl
@@ -1,14 +1,34 @@
 #pragma once
 
+#include <array>
+
 #include "starlight/renderer/RenderPass.hh"
+#include "starlight/renderer/light/ShadowCascades.hh"
 
 namespace sl {
 
+/*
+    Renders the cascades of the first directional light into tiles of a depth atlas,
+    one atlas per swapchain image. Static and dynamic casters are kept in separate
+    layers of tiles: dynamic tiles are redrawn every frame, a static tile only when
+    its cascade moved or the static casters inside of it changed. Casters are culled
+    against every cascade extruded towards the light.
+*/
 class ShadowMapsRenderPass : public RenderPass {
 public:
+    enum class Layer : u8 { staticCasters = 0, dynamicCasters };
+
+    static constexpr u32 layerCount = 2u;
+    // the material shader assumes the same layout of the atlas
+    static constexpr u32 atlasTilesPerRow = 2u;
+    static constexpr u32 atlasRows =
+      layerCount * ShadowCascades::maxCascades / atlasTilesPerRow;
+
     explicit ShadowMapsRenderPass(Renderer& renderer);
 
 private:
+    using TileHashes = std::array<u64, ShadowCascades::maxCascades>;
+
     RenderPassBackend::Properties createRenderPassProperties(
       bool hasPreviousPass, bool hasNextPass
     ) override;
@@ -19,8 +39,14 @@ private:
     ) override;
 
     Rect2<u32> getViewport() override;
+    Rect2<u32> getTileViewport(Layer layer, u32 cascade) const;
+
+    void updateCascades(const RenderPacket& packet);
 
+    ShadowCascades m_cascades;
     std::vector<SharedPtr<Texture>> m_shadowMaps;
+    // per swapchain image, what the static tiles were drawn with, 0 if never
+    std::vector<TileHashes> m_staticTileHashes;
 };
 
 }  // namespace sl
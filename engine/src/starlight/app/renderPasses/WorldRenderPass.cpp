@@ -4,6 +4,8 @@
 
 #include "starlight/app/factories/ShaderFactory.hh"
 #include "starlight/renderer/Core.hh"
+#include "starlight/renderer/Instancing.hh"
+#include "starlight/renderer/DrawList.hh"
 
 namespace sl {
 
@@ -13,7 +15,8 @@ WorldRenderPass::WorldRenderPass(
     RenderPass(
       renderer, ShaderFactory::get().load("Builtin.Shader.Material"), viewportOffset,
       "WorldRenderPass"
-    ) {}
+    ),
+    m_lightClusters(LightClusters::Properties{}) {}
 
 RenderPassBackend::Properties WorldRenderPass::createRenderPassProperties(
   [[maybe_unused]] bool hasPreviousPass, [[maybe_unused]] bool hasNextPass
@@ -23,84 +26,107 @@ RenderPassBackend::Properties WorldRenderPass::createRenderPassProperties(
     );
 }
 
-struct MeshRenderData {
-    Mesh* mesh;
-    Material* material;
-    Mat4<f32> modelMatrix;
-    float cameraDistance;
-};
-
 void WorldRenderPass::render(
   RenderPacket& packet, CommandBuffer& commandBuffer, u32 imageIndex, u64 frameNumber
 ) {
     Vec4<f32> ambientColor(0.05f, 0.05f, 0.05f, 1.0f);
     auto camera               = packet.camera;
     const auto cameraPosition = camera->getPosition();
+    auto& frameAllocator      = FrameAllocator::get();
 
-    setGlobalUniforms(commandBuffer, frameNumber, imageIndex, [&](auto& setter) {
-        auto depthMVP =
-          math::ortho<float>(-5.0f, 5.0f, -5.0f, 5.0f, -5.0f, 20.0f)
-          * math::lookAt(
-            -packet.directionalLights[0].direction, Vec3<f32>(0.0f, 0.0f, 0.0f),
-            Vec3<f32>(0.0f, 1.0f, 0.0f)
-          );
+    buildLightClusters(packet);
 
+    setGlobalUniforms(commandBuffer, frameNumber, imageIndex, [&](auto& setter) {
         setter.set("view", camera->getViewMatrix());
         setter.set("projection", camera->getProjectionMatrix());
-        setter.set("depthMVP", depthMVP);
         setter.set("viewPosition", cameraPosition);
         setter.set("ambientColor", ambientColor);
         setter.set("mode", static_cast<int>(RenderMode::standard));
         setter.set("shadowMap", packet.shadowMaps[0]);
 
-        const auto pointLightCount = packet.pointLights.size();
+        const auto& cascades    = packet.shadowCascades;
+        const auto cascadeCount = static_cast<i32>(cascades.size());
 
-        if (pointLightCount > 0) {
-            const auto shaderBulk = transform<PointLight::ShaderData>(
-              packet.pointLights,
-              [](const auto& light) { return light.getShaderData(); }
-            );
-            setter.set("pointLights", shaderBulk);
+        std::array<Mat4<f32>, ShadowCascades::maxCascades> cascadeViewProjections;
+        Vec4<f32> cascadeSplits{ 0.0f };
+        for (i32 i = 0; i < cascadeCount; ++i) {
+            cascadeViewProjections[i] = math::make_mat4(cascades[i].viewProjection);
+            cascadeSplits[i]          = cascades[i].splitDepth;
         }
+        setter.set("cascadeViewProjections", cascadeViewProjections);
+        setter.set("cascadeSplits", cascadeSplits);
+        setter.set("cascadeCount", &cascadeCount);
+
+        auto pointLights = frameAllocator.makeVector<PointLight::ShaderData>(
+          packet.pointLights.size()
+        );
+        std::ranges::transform(
+          packet.pointLights, into(pointLights),
+          [](const auto& light) { return light.getShaderData(); }
+        );
+        setter.setStorageBuffer("PointLights", pointLights);
+        setter.setStorageBuffer("LightClusters", m_lightClusters.getClusters());
+        setter.setStorageBuffer("LightIndices", m_lightClusters.getLightIndices());
+
+        const auto& clusterProperties = m_lightClusters.getProperties();
+        const std::array<u32, 4> clusterGrid{
+            clusterProperties.tilesX, clusterProperties.tilesY,
+            clusterProperties.slices, 0u
+        };
+        const std::array<f32, 2> clusterDepth{
+            m_lightClusters.getDepthScale(), m_lightClusters.getDepthBias()
+        };
+        setter.set("clusterGrid", clusterGrid);
+        setter.set("clusterDepth", clusterDepth);
 
         const auto directionalLightCount = packet.directionalLights.size();
 
         if (directionalLightCount > 0)
             setter.set("directionalLights", packet.directionalLights);
 
-        setter.set("pointLightCount", &pointLightCount);
         setter.set("directionalLightCount", &directionalLightCount);
     });
 
-    std::vector<MeshRenderData> meshes;
-    std::vector<MeshRenderData> transparentGeometries;
-    meshes.reserve(256);
-    transparentGeometries.reserve(128);
-
-    for (auto& [worldTransform, mesh, material] : packet.entities) {
-        if (material->isTransparent()) {
-            auto center         = worldTransform * mesh->getExtent().center;
-            auto cameraDistance = glm::distance2(cameraPosition, center);
-            transparentGeometries
-              .emplace_back(mesh, material, worldTransform, cameraDistance);
-        } else {
-            meshes.emplace_back(mesh, material, worldTransform);
-        }
+    // a single pass and pipeline for now, both key fields stay at zero
+    const auto& entities = packet.entities;
+    DrawList drawList{ entities.size() };
+
+    for (u32 i = 0; i < entities.size(); ++i) {
+        const auto& [worldTransform, mesh, material, _] = entities[i];
+
+        const auto center = worldTransform * mesh->getExtent().center;
+        drawList.add(
+          DrawList::makeKey({
+            .pass  = 0u,
+            .layer = material->isTransparent() ? DrawList::Layer::transparent
+                                               : DrawList::Layer::opaque,
+            .pipeline = 0u,
+            .material = Material::getIndex(material->id),
+            .mesh     = Mesh::getIndex(mesh->id),
+            .depth    = glm::distance2(cameraPosition, center),
+          }),
+          i
+        );
     }
+    drawList.sort();
 
-    std::sort(
-      transparentGeometries.begin(), transparentGeometries.end(),
-      [](auto& lhs, auto& rhs) -> bool {
-          return lhs.cameraDistance < rhs.cameraDistance;
-      }
-    );
-    std::move(
-      transparentGeometries.begin(), transparentGeometries.end(),
-      std::back_inserter(meshes)
+    auto sorted     = frameAllocator.makeVector<RenderEntity>(entities.size());
+    auto transforms = frameAllocator.makeVector<Mat4<f32>>(entities.size());
+
+    for (const auto index : drawList.getIndices()) {
+        sorted.push_back(entities[index]);
+        transforms.push_back(entities[index].worldTransform);
+    }
+    setInstanceTransforms(commandBuffer, imageIndex, transforms);
+
+    // sorted draws sharing mesh and material are adjacent, transparent ones only
+    // when nothing lies between them
+    auto batches = frameAllocator.makeVector<InstanceBatch>();
+    appendInstanceBatches<RenderEntity>(
+      sorted, InstanceGrouping::meshAndMaterial, batches
     );
-    transparentGeometries.clear();
 
-    for (auto& [mesh, material, model, _] : meshes) {
+    for (const auto& [mesh, material, firstInstance, instanceCount] : batches) {
         setLocalUniforms(
           commandBuffer, frameNumber, getLocalDescriporSetId(material->id),
           imageIndex,
@@ -112,9 +138,34 @@ void WorldRenderPass::render(
               setter.set("normalMap", material->normalMap.get());
           }
         );
-        setPushConstant(commandBuffer, "model", model);
-        drawMesh(*mesh, commandBuffer);
+        drawMesh(*mesh, commandBuffer, firstInstance, instanceCount);
+    }
+}
+
+void WorldRenderPass::buildLightClusters(const RenderPacket& packet) {
+    const auto camera      = packet.camera;
+    const auto& projection = camera->getProjectionMatrix();
+    const auto& properties = camera->getProjectionProperties();
+
+    m_lightClusters.setProperties(LightClusters::Properties{
+      .projectionScaleX = projection[0][0],
+      .projectionScaleY = projection[1][1],
+      .nearZ            = properties.nearZ,
+      .farZ             = properties.farZ,
+    });
+
+    const auto view = camera->getViewMatrix();
+    auto spheres =
+      FrameAllocator::get().makeVector<LightSphere>(packet.pointLights.size());
+
+    for (const auto& light : packet.pointLights) {
+        const auto position = view * light.position;
+        spheres.push_back(LightSphere{
+          .position = { position.x, position.y, position.z },
+          .radius   = light.getRadius(),
+        });
     }
+    m_lightClusters.build(spheres);
 }
 
 }  // namespace sl
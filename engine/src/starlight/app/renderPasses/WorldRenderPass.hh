@@ -1,6 +1,7 @@
 #pragma once
 
 #include "starlight/renderer/RenderPass.hh"
+#include "starlight/renderer/light/LightClusters.hh"
 
 namespace sl {
 
@@ -17,6 +18,11 @@ private:
       RenderPacket& packet, CommandBuffer& commandBuffer, u32 imageIndex,
       u64 frameNumber
     ) override;
+
+    void buildLightClusters(const RenderPacket& packet);
+
+    // point lights reach the material shader through per cluster light lists
+    LightClusters m_lightClusters;
 };
 
 }  // namespace sl
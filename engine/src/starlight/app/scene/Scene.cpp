@@ -1,35 +1,106 @@
 #include "Scene.hh"
 
+#include "starlight/core/TaskQueue.hh"
+#include "starlight/core/Utils.hh"
+#include "starlight/core/math/Culling.hh"
 #include "starlight/renderer/MeshComposite.hh"
+#include "starlight/renderer/LevelOfDetail.hh"
 #include "starlight/renderer/light/PointLight.hh"
 
 namespace sl {
 
-static constexpr u32 maxPointLights       = 5;
+// clustered shading has no hard limit, this is only the initial capacity
+static constexpr u32 maxPointLights       = 256;
 static constexpr u32 maxDirectionalLights = 5;
 
-Scene::Scene(Camera* camera
-) : camera(camera), skybox(nullptr), m_entities(maxEntities) {}
+Scene::Scene(Camera* camera) :
+    camera(camera), skybox(nullptr),
+    m_systemScheduler(TaskQueue::get().getJobSystem()), m_entities(maxEntities) {}
+
+// of the world space box around the mesh, bounded by a sphere
+static f32 calculateEntityScreenSize(
+  const Mat4<f32>& world, const Mesh& mesh, const Vec3<f32>& cameraPosition,
+  f32 projectionScaleY
+) {
+    const auto& extent = mesh.getExtent();
+
+    Vec3<f32> center;
+    Vec3<f32> halfSize;
+    transformBox(
+      math::value_ptr(world), math::value_ptr(extent.min),
+      math::value_ptr(extent.max), math::value_ptr(center), math::value_ptr(halfSize)
+    );
+
+    return calculateScreenSize(
+      math::length(halfSize), math::distance(center, cameraPosition),
+      projectionScaleY
+    );
+}
 
 RenderPacket Scene::getRenderPacket() {
+    auto& frameAllocator = FrameAllocator::get();
+
     RenderPacket packet{};
     packet.camera = camera;
 
-    packet.directionalLights.reserve(maxDirectionalLights);
-    packet.pointLights.reserve(maxPointLights);
+    packet.directionalLights =
+      frameAllocator.makeVector<DirectionalLight>(maxDirectionalLights);
+    packet.pointLights = frameAllocator.makeVector<PointLight>(maxPointLights);
+    packet.entities    = frameAllocator.makeVector<RenderEntity>();
+    packet.shadowMaps  = frameAllocator.makeVector<Texture*>();
+
+    packet.shadowCascades =
+      frameAllocator.makeVector<ShadowCascade>(ShadowCascades::maxCascades);
+
+    const auto cameraPosition = camera ? camera->getPosition() : Vec3<f32>{ 0.0f };
+    const auto projectionScaleY =
+      camera ? camera->getProjectionMatrix()[1][1] : 1.0f;
+
+    // owner of every static render entity in order, swapped or reordered entities
+    // change it even if the count stays the same
+    auto staticMembership = fnvOffset;
 
     m_componentManager.getComponentContainer<MeshComposite>().forEach(
       [&](Component<MeshComposite>& meshComposite) {
-          meshComposite.data().traverse([&](MeshComposite::Node& node) {
-              for (auto& instance : node.getInstances()) {
+          auto& composite     = meshComposite.data();
+          const auto isStatic = composite.isStatic;
+
+          // only the instances changed since the last frame get new worlds
+          composite.updateTransforms();
+
+          composite.traverse([&](MeshComposite::Node& node) {
+              const auto instanceCount = node.getInstances().size();
+              const bool hasLODs       = camera && not node.getLODs().empty();
+
+              for (u64 i = 0; i < instanceCount; ++i) {
+                  const auto world = composite.getWorld(node, i);
+                  auto mesh        = node.mesh.get();
+
+                  if (hasLODs) {
+                      const auto screenSize = calculateEntityScreenSize(
+                        world, *node.mesh, cameraPosition, projectionScaleY
+                      );
+                      mesh = node.selectLOD(i, screenSize);
+                  }
                   packet.entities.emplace_back(
-                    instance.getWorld(), node.mesh.get(), node.material.get()
+                    world, mesh, node.material.get(), isStatic
                   );
+                  if (isStatic) {
+                      staticMembership =
+                        (staticMembership ^ meshComposite.getEntityId()) * fnvPrime;
+                  }
               }
           });
       }
     );
 
+    // casters outside of the view can still throw shadows into it
+    packet.shadowCasters =
+      frameAllocator.makeVector<RenderEntity>(packet.entities.size());
+    packet.shadowCasters.assign(packet.entities.begin(), packet.entities.end());
+
+    if (camera) cullEntities(packet.entities, staticMembership);
+
     m_componentManager.getComponentContainer<PointLight>().forEach(
       [&](Component<PointLight>& light) {
           packet.pointLights.push_back(light.data());
@@ -62,9 +133,16 @@ RenderPacket Scene::getRenderPacket() {
     return packet;
 }
 
+void Scene::update(float deltaTime) {
+    m_systemScheduler.run(m_componentManager, deltaTime);
+}
+
 void Scene::clear() {
     skybox = nullptr;
     m_entities.clear();
+    m_bvh.build({});
+    m_staticMembership = 0u;
+    m_staticBoxes      = 0u;
 }
 
 Entity& Scene::addEntity(std::optional<std::string> name) {
@@ -73,4 +151,107 @@ Entity& Scene::addEntity(std::optional<std::string> name) {
     return *record;
 }
 
+SystemScheduler& Scene::getSystemScheduler() { return m_systemScheduler; }
+
+static void calculateEntityBox(
+  const RenderEntity& entity, f32* center, f32* halfSize
+) {
+    const auto& extent = entity.mesh->getExtent();
+    transformBox(
+      math::value_ptr(entity.worldTransform), math::value_ptr(extent.min),
+      math::value_ptr(extent.max), center, halfSize
+    );
+}
+
+// drops entities whose world space bounding box is outside of the camera frustum;
+// static ones are queried from the hierarchy, which is refitted when their boxes
+// change and rebuilt when the entities do, moving ones are tested linearly as
+// refitting every frame costs more than that
+void Scene::cullEntities(FrameVector<RenderEntity>& entities, u64 staticMembership) {
+    auto& frameAllocator = FrameAllocator::get();
+    const auto count     = entities.size();
+
+    auto staticEntities  = frameAllocator.makeVector<u32>(count);
+    auto dynamicEntities = frameAllocator.makeVector<u32>(count);
+    for (u32 i = 0; i < count; ++i)
+        (entities[i].isStatic ? staticEntities : dynamicEntities).push_back(i);
+
+    const Mat4<f32> viewProjection =
+      camera->getProjectionMatrix() * camera->getViewMatrix();
+    const auto planes = extractFrustumPlanes(math::value_ptr(viewProjection));
+
+    auto visible = frameAllocator.makeVector<u8>(count);
+    visible.resize(count, 0u);
+
+    // static entities can still be moved by hand or switch their level of detail
+    auto boxes     = frameAllocator.makeVector<Aabb>(staticEntities.size());
+    auto boxesHash = fnvOffset;
+    for (const auto index : staticEntities) {
+        f32 center[3];
+        f32 halfSize[3];
+        calculateEntityBox(entities[index], center, halfSize);
+
+        auto& box = boxes.emplace_back();
+        for (u64 axis = 0; axis < 3; ++axis) {
+            box.min[axis] = center[axis] - halfSize[axis];
+            box.max[axis] = center[axis] + halfSize[axis];
+        }
+        boxesHash = hashFloats(boxesHash, box.min, 3u);
+        boxesHash = hashFloats(boxesHash, box.max, 3u);
+    }
+
+    if (staticMembership != m_staticMembership
+        || m_bvh.getPrimitiveCount() != boxes.size()) {
+        m_bvh.build(boxes);
+    } else if (boxesHash != m_staticBoxes) {
+        m_bvh.refit(boxes);
+        if (m_bvh.needsRebuild()) m_bvh.build(boxes);
+    }
+    m_staticMembership = staticMembership;
+    m_staticBoxes      = boxesHash;
+
+    m_bvh.queryFrustum(planes, [&](u32 primitive) {
+        visible[staticEntities[primitive]] = 1u;
+    });
+
+    // boxes in structure of arrays layout, 6 streams of dynamicCount floats
+    const auto dynamicCount = dynamicEntities.size();
+    auto bounds             = frameAllocator.makeVector<f32>(dynamicCount * 6u);
+    bounds.resize(dynamicCount * 6u);
+
+    const BoxesView boxes{
+        .centerX = bounds.data(),
+        .centerY = bounds.data() + dynamicCount,
+        .centerZ = bounds.data() + dynamicCount * 2u,
+        .extentX = bounds.data() + dynamicCount * 3u,
+        .extentY = bounds.data() + dynamicCount * 4u,
+        .extentZ = bounds.data() + dynamicCount * 5u,
+        .count   = dynamicCount,
+    };
+
+    for (u64 i = 0; i < dynamicCount; ++i) {
+        f32 center[3];
+        f32 halfSize[3];
+        calculateEntityBox(entities[dynamicEntities[i]], center, halfSize);
+
+        for (u64 axis = 0; axis < 3; ++axis) {
+            bounds[axis * dynamicCount + i]        = center[axis];
+            bounds[(axis + 3u) * dynamicCount + i] = halfSize[axis];
+        }
+    }
+
+    auto dynamicVisible = frameAllocator.makeVector<u8>(dynamicCount);
+    dynamicVisible.resize(dynamicCount);
+    cullBoxes(planes, boxes, dynamicVisible.data());
+
+    for (u64 i = 0; i < dynamicCount; ++i)
+        if (dynamicVisible[i]) visible[dynamicEntities[i]] = 1u;
+
+    u64 visibleCount = 0u;
+    for (u64 i = 0; i < count; ++i)
+        if (visible[i]) entities[visibleCount++] = entities[i];
+
+    entities.erase(entities.begin() + visibleCount, entities.end());
+}
+
 }  // namespace sl
@@ -8,10 +8,12 @@
 #include "starlight/renderer/camera/Camera.hh"
 #include "starlight/renderer/RenderPacket.hh"
 #include "starlight/core/Concepts.hh"
+#include "starlight/core/math/BoundingVolumeHierarchy.hh"
 #include "starlight/renderer/Skybox.hh"
 
 #include "ecs/Entity.hh"
 #include "ecs/ComponentManager.hh"
+#include "ecs/SystemScheduler.hh"
 
 namespace sl {
 
@@ -23,6 +25,8 @@ public:
 
     RenderPacket getRenderPacket();
 
+    void update(float deltaTime);
+
     void clear();
 
     template <typename C>
@@ -33,13 +37,23 @@ public:
 
     Entity& addEntity(std::optional<std::string> name = {});
 
+    SystemScheduler& getSystemScheduler();
+
 public:
     Camera* camera;
     SharedPtr<Skybox> skybox;
 
 private:
+    void cullEntities(FrameVector<RenderEntity>& entities, u64 staticMembership);
+
     ComponentManager m_componentManager;
+    SystemScheduler m_systemScheduler;
     StaticVector<Entity> m_entities;
+    // world space boxes of the static render entities, refitted when only the
+    // boxes changed and rebuilt when the entities did
+    BoundingVolumeHierarchy m_bvh;
+    u64 m_staticMembership = 0u;
+    u64 m_staticBoxes      = 0u;
 };
 
 }  // namespace sl
@@ -1,55 +1,76 @@
 #pragma once
 
-#include <vector>
+#include <span>
+#include <optional>
 
 #include "starlight/core/Core.hh"
 #include "starlight/core/Concepts.hh"
-#include "starlight/core/containers/FlatMap.hh"
+#include "starlight/core/containers/SparseSet.hh"
 
 #include "Component.hh"
 
 namespace sl {
 
 struct ComponentContainerBase {
-    virtual ~ComponentContainerBase()  = default;
-    virtual void* getRaw(u64 entityId) = 0;
+    virtual ~ComponentContainerBase()    = default;
+    virtual void* getRaw(u64 entityId)   = 0;
+    virtual bool remove(u64 entityId)    = 0;
+    virtual bool has(u64 entityId) const = 0;
+
+    // bumped whenever a component is added or removed, used to invalidate views
+    u64 getVersion() const { return m_version; }
+
+protected:
+    u64 m_version = 0u;
 };
 
 template <typename T> class ComponentContainer : public ComponentContainerBase {
-    using ComponentBuffer              = FlatMap<u64, Component<T>>;
-    static constexpr u64 maxComponents = 1024;
+    using ComponentBuffer = SparseSet<Component<T>>;
 
 public:
-    explicit ComponentContainer() : m_components(maxComponents) {}
-
     template <typename... Args> Component<T>& add(u64 entityId, Args&&... args) {
-        // entityId is a key for the map but also Component<T> ctor argument
-        auto record =
-          m_components.emplace(entityId, entityId, std::forward<Args>(args)...);
-        log::expect(record, "Could not add component");
-        return *record;
+        ++m_version;
+        // entityId is a key for the set but also Component<T> ctor argument
+        return m_components.emplace(entityId, entityId, std::forward<Args>(args)...);
     }
 
-    bool has(u64 entityId) { return m_components.has(entityId); }
+    bool has(u64 entityId) const override { return m_components.has(entityId); }
+
+    Component<T>& get(u64 entityId) { return m_components.get(entityId); }
+
+    Component<T>* find(u64 entityId) { return m_components.find(entityId); }
 
-    Component<T>& get(u64 entityId) { return *m_components.get(entityId); }
+    bool remove(u64 entityId) override {
+        if (not m_components.erase(entityId)) return false;
+
+        ++m_version;
+        return true;
+    }
+
+    std::optional<u32> findIndex(u64 entityId) const {
+        return m_components.findDenseIndex(entityId);
+    }
+
+    u64 size() const { return m_components.size(); }
+
+    // invalidated by adding or removing components, like the dense indices
+    std::span<Component<T>> getComponents() { return m_components.values(); }
+    std::span<const u64> getEntityIds() const { return m_components.keys(); }
 
     template <typename C>
     requires Callable<C, void, Component<T>&>
     void forEach(C&& callback) {
-        m_components.forEach([&]([[maybe_unused]] const auto& k, auto& v) {
-            callback(v);
-        });
-    }
-
-    void* getRaw(u64 entityId) override {
-        return static_cast<void*>(&m_components.get(entityId)->data());
+        m_components.forEach(std::forward<C>(callback));
     }
 
     template <typename C>
     requires Callable<C, void, const u64&, Component<T>&>
     void forEach(C&& callback) {
-        m_components.forEach(std::move(callback));
+        m_components.forEach(std::forward<C>(callback));
+    }
+
+    void* getRaw(u64 entityId) override {
+        return static_cast<void*>(&m_components.get(entityId).data());
     }
 
 private:
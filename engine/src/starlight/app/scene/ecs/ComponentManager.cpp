@@ -2,6 +2,9 @@
 
 namespace sl {
 
-void ComponentManager::clear() { m_componentContainers.clear(); }
+void ComponentManager::clear() {
+    m_queryCaches.clear();
+    m_componentContainers.clear();
+}
 
 }  // namespace sl
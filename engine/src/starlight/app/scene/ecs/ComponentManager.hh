@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutex>
 #include <typeindex>
 #include <unordered_map>
 
@@ -7,12 +8,14 @@
 
 #include "Component.hh"
 #include "ComponentContainer.hh"
+#include "View.hh"
 
 namespace sl {
 
 class ComponentManager {
     using ComponentContainers =
       std::unordered_map<std::type_index, UniquePtr<ComponentContainerBase>>;
+    using QueryCaches = std::unordered_map<std::type_index, detail::QueryCache>;
 
 public:
     template <typename T, typename... Args>
@@ -28,6 +31,10 @@ public:
         return getComponentContainer<T>().get(entityId);
     }
 
+    template <typename T> bool remove(u64 entityId) {
+        return getComponentContainer<T>().remove(entityId);
+    }
+
     void* getComponent(std::type_index type, u64 entityId) {
         log::expect(
           m_componentContainers.contains(type),
@@ -37,21 +44,35 @@ public:
     }
 
     template <typename T> ComponentContainer<T>& getComponentContainer() {
-        auto& type = typeid(T);
-        // we could calculate hash once but iterator version is very long and hard to
-        // read, in case of under-performance - rewrite
-        if (not m_componentContainers.contains(type)) [[unlikely]] {
-            m_componentContainers.insert(
-              { type, UniquePtr<ComponentContainer<T>>::create() }
-            );
+        // lookup of an existing container has to stay read-only, systems access
+        // the manager concurrently
+        const std::type_index type = typeid(T);
+
+        auto container = m_componentContainers.find(type);
+        if (container == m_componentContainers.end()) [[unlikely]] {
+            container = m_componentContainers
+                          .emplace(type, UniquePtr<ComponentContainer<T>>::create())
+                          .first;
         }
-        return static_cast<ComponentContainer<T>&>(*m_componentContainers[type]);
+        return static_cast<ComponentContainer<T>&>(*container->second);
+    }
+
+    template <typename... Ts>
+    requires(sizeof...(Ts) > 0)
+    View<Ts...> view() {
+        // concurrent readers of the same types share and possibly rebuild the cache
+        std::scoped_lock guard{ m_queryCachesMutex };
+        return View<Ts...>{
+            m_queryCaches[typeid(View<Ts...>)], getComponentContainer<Ts>()...
+        };
     }
 
     void clear();
 
 private:
     ComponentContainers m_componentContainers;
+    QueryCaches m_queryCaches;
+    std::mutex m_queryCachesMutex;
 };
 
 }  // namespace sl
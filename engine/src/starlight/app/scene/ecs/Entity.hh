@@ -26,6 +26,11 @@ public:
         return m_componentManager.get<T>(id);
     }
 
+    template <typename T> void removeComponent() {
+        if (m_componentManager.remove<T>(id))
+            std::erase(m_componentTypes, std::type_index{ typeid(T) });
+    }
+
     template <typename T> bool hasComponent() {
         return std::find(m_componentTypes.begin(), m_componentTypes.end(), typeid(T))
                != m_componentTypes.end();
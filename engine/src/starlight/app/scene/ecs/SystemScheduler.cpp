@@ -0,0 +1,92 @@
+#include "SystemScheduler.hh"
+
+#include <algorithm>
+
+#include "starlight/core/Log.hh"
+
+namespace sl {
+
+static bool intersects(
+  const std::vector<std::type_index>& lhs, const std::vector<std::type_index>& rhs
+) {
+    return std::ranges::any_of(lhs, [&](const auto& type) -> bool {
+        return std::ranges::find(rhs, type) != rhs.end();
+    });
+}
+
+bool SystemScheduler::System::conflictsWith(const System& other) const {
+    return intersects(writes, other.writes) || intersects(writes, other.reads)
+           || intersects(reads, other.writes);
+}
+
+SystemScheduler::SystemScheduler(JobSystem& jobSystem, Mode mode) :
+    m_jobSystem(jobSystem), m_mode(mode) {}
+
+void SystemScheduler::run(ComponentManager& manager, float deltaTime) {
+    if (m_systems.empty()) return;
+
+    // containers are created lazily, make sure that no system inserts one while
+    // others are running
+    for (auto& system : m_systems)
+        for (auto initializer : system.initializers) initializer(manager);
+
+    if (m_mode == Mode::serial || m_jobSystem.getWorkerCount() == 0u)
+        runSerial(manager, deltaTime);
+    else
+        runParallel(manager, deltaTime);
+}
+
+void SystemScheduler::setMode(Mode mode) { m_mode = mode; }
+
+SystemScheduler::Mode SystemScheduler::getMode() const { return m_mode; }
+
+u64 SystemScheduler::getSystemCount() const { return m_systems.size(); }
+
+void SystemScheduler::clear() {
+    m_systems.clear();
+    m_dependencies.clear();
+}
+
+void SystemScheduler::buildGraph() {
+    const auto systemCount = m_systems.size();
+    m_dependencies.assign(systemCount, {});
+
+    for (u32 i = 0; i < systemCount; ++i) {
+        for (u32 j = 0; j < i; ++j)
+            if (m_systems[i].conflictsWith(m_systems[j]))
+                m_dependencies[i].push_back(j);
+    }
+
+    log::trace("Built system graph with {} systems", systemCount);
+}
+
+void SystemScheduler::runSerial(ComponentManager& manager, float deltaTime) {
+    for (auto& system : m_systems) system.callback(manager, deltaTime);
+}
+
+void SystemScheduler::runParallel(ComponentManager& manager, float deltaTime) {
+    if (m_dependencies.size() != m_systems.size()) buildGraph();
+
+    m_jobs.clear();
+    m_jobs.reserve(m_systems.size());
+
+    std::vector<JobHandle> dependencies;
+
+    // registration order is a topological order, dependencies are spawned first
+    for (u32 i = 0; i < m_systems.size(); ++i) {
+        dependencies.clear();
+        for (const auto dependency : m_dependencies[i])
+            dependencies.push_back(m_jobs[dependency]);
+
+        m_jobs.push_back(m_jobSystem.spawn(
+          [&system = m_systems[i], &manager, deltaTime]() {
+              system.callback(manager, deltaTime);
+          },
+          dependencies
+        ));
+    }
+
+    m_jobSystem.wait(m_jobs);
+}
+
+}  // namespace sl
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <typeindex>
+#include <vector>
+
+#include "starlight/core/Core.hh"
+#include "starlight/core/Concepts.hh"
+#include "starlight/core/JobSystem.hh"
+
+#include "ComponentManager.hh"
+
+namespace sl {
+
+// component access declarations, used as template arguments of addSystem
+template <typename... Ts> struct Read {};
+template <typename... Ts> struct Write {};
+
+/*
+    Runs systems over the component manager once per frame. Every system declares
+    the component types it reads and writes, a system is ordered after all earlier
+    registered systems it conflicts with (write/read or write/write of the same
+    type) and systems without a path between them in the resulting graph are run
+    concurrently as jobs.
+
+    Systems may only touch component types they declared, adding or removing a
+    component counts as a write. In serial mode systems are run on the calling
+    thread in registration order, which is a valid order of the graph, so the
+    results are deterministic.
+*/
+class SystemScheduler : public NonMovable {
+public:
+    using Callback = std::function<void(ComponentManager&, float)>;
+
+    enum class Mode : u8 { parallel, serial };
+
+private:
+    using ContainerInitializer = void (*)(ComponentManager&);
+
+    struct System {
+        std::string name;
+        Callback callback;
+
+        std::vector<std::type_index> reads;
+        std::vector<std::type_index> writes;
+        std::vector<ContainerInitializer> initializers;
+
+        bool conflictsWith(const System& other) const;
+    };
+
+    template <typename Access> struct AccessTraits;
+
+    template <typename... Ts> struct AccessTraits<Read<Ts...>> {
+        static void declare(System& system) {
+            (system.reads.emplace_back(typeid(Ts)), ...);
+            (system.initializers.push_back(&initializeContainer<Ts>), ...);
+        }
+    };
+
+    template <typename... Ts> struct AccessTraits<Write<Ts...>> {
+        static void declare(System& system) {
+            (system.writes.emplace_back(typeid(Ts)), ...);
+            (system.initializers.push_back(&initializeContainer<Ts>), ...);
+        }
+    };
+
+    template <typename T> static void initializeContainer(ComponentManager& manager) {
+        manager.getComponentContainer<T>();
+    }
+
+public:
+    explicit SystemScheduler(JobSystem& jobSystem, Mode mode = Mode::parallel);
+
+    template <typename... Access, typename C>
+    requires Callable<C, void, ComponentManager&, float>
+    void addSystem(std::string name, C&& callback) {
+        System system;
+        system.name     = std::move(name);
+        system.callback = std::forward<C>(callback);
+        (AccessTraits<Access>::declare(system), ...);
+
+        m_systems.push_back(std::move(system));
+        m_dependencies.clear();
+    }
+
+    void run(ComponentManager& manager, float deltaTime);
+
+    void setMode(Mode mode);
+    Mode getMode() const;
+
+    u64 getSystemCount() const;
+    void clear();
+
+private:
+    void buildGraph();
+
+    void runSerial(ComponentManager& manager, float deltaTime);
+    void runParallel(ComponentManager& manager, float deltaTime);
+
+    JobSystem& m_jobSystem;
+    Mode m_mode;
+
+    std::vector<System> m_systems;
+    // indices of earlier systems that each system has to wait for
+    std::vector<std::vector<u32>> m_dependencies;
+    std::vector<JobHandle> m_jobs;
+};
+
+}  // namespace sl
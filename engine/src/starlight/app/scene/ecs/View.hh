@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <tuple>
+#include <span>
+#include <vector>
+#include <algorithm>
+
+#include "starlight/core/Core.hh"
+#include "starlight/core/Concepts.hh"
+
+#include "ComponentContainer.hh"
+
+namespace sl {
+
+namespace detail {
+
+// entities matching a query stored as packed dense indices, one per container
+struct QueryCache {
+    std::vector<u64> versions;
+    std::vector<u32> indices;
+};
+
+}  // namespace detail
+
+/*
+    Joined iteration over entities that own all of the given components. Matching
+    entities are resolved once, by walking the smallest container and probing the
+    others, and reused until any of the containers changes its membership. Adding
+    or removing components of the viewed types during iteration is not allowed.
+*/
+template <typename... Ts>
+requires(sizeof...(Ts) > 0)
+class View {
+    static constexpr u64 componentCount = sizeof...(Ts);
+
+public:
+    explicit View(detail::QueryCache& cache, ComponentContainer<Ts>&... containers) :
+        m_cache(cache), m_containers(&containers...) {
+        if (isStale()) rebuild();
+    }
+
+    template <typename C>
+    requires Callable<C, void, Component<Ts>&...>
+    void forEach(C&& callback) {
+        forEachImpl(callback, std::index_sequence_for<Ts...>{});
+    }
+
+    u64 size() const { return m_cache.indices.size() / componentCount; }
+    bool empty() const { return m_cache.indices.empty(); }
+
+private:
+    template <typename C, u64... I>
+    void forEachImpl(C& callback, std::index_sequence<I...>) {
+        const std::tuple components{ std::get<I>(m_containers)->getComponents()... };
+        const auto& indices = m_cache.indices;
+
+        for (u64 i = 0; i < indices.size(); i += componentCount)
+            callback(std::get<I>(components)[indices[i + I]]...);
+    }
+
+    std::array<u64, componentCount> getVersions() const {
+        return std::apply(
+          [](auto*... containers) {
+              return std::array<u64, componentCount>{ containers->getVersion()... };
+          },
+          m_containers
+        );
+    }
+
+    bool isStale() const {
+        const auto versions = getVersions();
+        return not std::ranges::equal(m_cache.versions, versions);
+    }
+
+    void rebuild() {
+        const auto versions = getVersions();
+        m_cache.versions.assign(versions.begin(), versions.end());
+        m_cache.indices.clear();
+
+        const auto entityIds = std::apply(
+          [](auto*... containers) {
+              return std::array<std::span<const u64>, componentCount>{
+                  containers->getEntityIds()...
+              };
+          },
+          m_containers
+        );
+
+        const auto smallest = std::ranges::min_element(
+          entityIds, [](const auto& lhs, const auto& rhs) -> bool {
+              return lhs.size() < rhs.size();
+          }
+        );
+
+        std::array<u32, componentCount> indices;
+
+        for (const auto entityId : *smallest) {
+            const bool matches = std::apply(
+              [&](auto*... containers) -> bool {
+                  u64 i = 0u;
+                  return (probe(*containers, entityId, indices[i++]) && ...);
+              },
+              m_containers
+            );
+
+            if (matches)
+                m_cache.indices.insert(
+                  m_cache.indices.end(), indices.begin(), indices.end()
+                );
+        }
+    }
+
+    template <typename T>
+    static bool probe(ComponentContainer<T>& container, u64 entityId, u32& index) {
+        const auto denseIndex = container.findIndex(entityId);
+        if (denseIndex) index = *denseIndex;
+        return denseIndex.has_value();
+    }
+
+    detail::QueryCache& m_cache;
+    std::tuple<ComponentContainer<Ts>*...> m_containers;
+};
+
+}  // namespace sl
@@ -5,6 +5,18 @@
 
 namespace sl {
 
+// switch size of the first generated level, every further one takes half of it
+static constexpr f32 defaultLODScreenSize = 0.25f;
+
+static bool areGeneratedLODs(const MeshComposite::Node& node) {
+    const auto lods = node.getLODs();
+    for (u32 i = 0; i < lods.size(); ++i) {
+        if (lods[i].mesh->name != MeshFactory::getLODName(node.mesh->name, i + 1))
+            return false;
+    }
+    return not lods.empty();
+}
+
 std::string MeshCompositeSerializer::getName() const { return "MeshComposite"; }
 
 nlohmann::json MeshCompositeSerializer::serialize(MeshComposite& component) const {
@@ -15,6 +27,18 @@ nlohmann::json MeshCompositeSerializer::serialize(MeshComposite& component) cons
 
     json["material"] = root.material->name;
     json["mesh"]     = root.mesh->name;
+    json["static"]   = component.isStatic;
+
+    // generated levels are created again on load instead of being looked up
+    if (areGeneratedLODs(root)) {
+        json["lodCount"]  = root.getLODs().size();
+        auto& screenSizes = json["lodScreenSizes"] = nlohmann::json::array();
+        for (const auto& lod : root.getLODs()) screenSizes.push_back(lod.screenSize);
+    } else {
+        auto& lods = json["lods"] = nlohmann::json::array();
+        for (const auto& [mesh, screenSize] : root.getLODs())
+            lods.push_back({ { "mesh", mesh->name }, { "screenSize", screenSize } });
+    }
 
     return json;
 }
@@ -24,10 +48,35 @@ std::string MeshCompositeDeserializer::getName() const { return "MeshComposite";
 void MeshCompositeDeserializer::deserialize(
   Entity& entity, const nlohmann::json& json
 ) const {
-    auto mesh     = getMesh(json.at("mesh").get<std::string>());
+    const auto meshName = json.at("mesh").get<std::string>();
+
+    auto mesh     = getMesh(meshName);
     auto material = getMaterial(json.at("material").get<std::string>());
 
-    entity.addComponent<MeshComposite>(mesh, material);
+    auto& component = entity.addComponent<MeshComposite>(mesh, material).data();
+    // optional, scenes saved before it was added have no such field
+    component.isStatic = json.value("static", false);
+
+    if (json.contains("lodCount")) {
+        const auto lods = MeshFactory::get().getLODs(
+          meshName, json.at("lodCount").get<u32>()
+        );
+        const auto screenSizes = json.value("lodScreenSizes", std::vector<f32>{});
+
+        auto screenSize = defaultLODScreenSize;
+        for (u32 i = 0; i < lods.size(); ++i) {
+            if (i < screenSizes.size()) screenSize = screenSizes[i];
+            component.getRoot().addLOD(lods[i], screenSize);
+            screenSize *= 0.5f;
+        }
+    } else if (json.contains("lods")) {
+        for (const auto& lod : json.at("lods")) {
+            component.getRoot().addLOD(
+              getMesh(lod.at("mesh").get<std::string>()),
+              lod.at("screenSize").get<f32>()
+            );
+        }
+    }
 }
 
 // TODO: store default materials/meshes/shaders/textures in some lookup table
@@ -23,6 +23,7 @@ std::optional<SPIRVParser::Output> SPIRVParser::process(Shader::Stage::Type stag
     if (stage == Shader::Stage::Type::vertex) processInputs();
 
     processUniforms();
+    processStorageBuffers();
     processSamplers();
     processPushConstants();
 
@@ -52,6 +53,13 @@ static std::pair<Shader::DataType, u64> getTypeInfo(
     }
 };
 
+// inputs named inInstance* are advanced per instance instead of per vertex
+static Shader::InputAttribute::Rate getInputRate(const std::string& name) {
+    static const std::string instancePrefix = "inInstance";
+    return name.starts_with(instancePrefix) ? Shader::InputAttribute::Rate::instance
+                                            : Shader::InputAttribute::Rate::vertex;
+}
+
 void SPIRVParser::processInputs() {
     for (auto& res : m_resources.stage_inputs) {
         const auto [type, size] =
@@ -62,6 +70,7 @@ void SPIRVParser::processInputs() {
           .offset   = 0u,
           .type     = type,
           .size     = size,
+          .rate     = getInputRate(res.name),
           .name     = res.name,
         });
     }
@@ -94,6 +103,24 @@ void SPIRVParser::processUniforms() {
     }
 }
 
+// storage buffers are set as a whole, the size excludes a trailing runtime array
+void SPIRVParser::processStorageBuffers() {
+    for (auto& res : m_resources.storage_buffers) {
+        const auto& type = m_compiler.get_type(res.base_type_id);
+
+        m_output.uniforms.push_back(Shader::Uniform{
+          .offset  = 0u,
+          .binding = m_compiler.get_decoration(res.id, spv::DecorationBinding),
+          .type    = Shader::DataType::storageBuffer,
+          .size    = m_compiler.get_declared_struct_size(type),
+          .scope   = getScope(
+            m_compiler.get_decoration(res.id, spv::DecorationDescriptorSet)
+          ),
+          .name = m_compiler.get_name(res.base_type_id),
+        });
+    }
+}
+
 void SPIRVParser::processPushConstants() {
     for (auto& res : m_resources.push_constant_buffers) {
         auto type = m_compiler.get_type(res.base_type_id);
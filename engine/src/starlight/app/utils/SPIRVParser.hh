@@ -24,6 +24,7 @@ public:
 private:
     void processInputs();
     void processUniforms();
+    void processStorageBuffers();
     void processSamplers();
     void processPushConstants();
 
@@ -21,6 +21,12 @@ void deserialize(const nlohmann::json& j, Config& out) {
     paths.at("shaders").get_to(out.paths.shaders);
     paths.at("materials").get_to(out.paths.materials);
     paths.at("fonts").get_to(out.paths.fonts);
+
+    if (j.contains("events")) {
+        const auto& events = j.at("events");
+        if (events.contains("queueCapacity"))
+            out.events.queueCapacity = events.at("queueCapacity").get<u64>();
+    }
 }
 
 std::optional<Config> Config::fromJson(
@@ -31,6 +31,11 @@ struct Config {
         std::string materials;
         std::string fonts;
     } paths;
+
+    struct Events {
+        // slots of the event ring, see EventBroker for the default
+        std::optional<u64> queueCapacity;
+    } events;
 };
 
 }  // namespace sl
\ No newline at end of file
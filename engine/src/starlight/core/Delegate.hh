@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "starlight/core/Core.hh"
+#include "starlight/core/Log.hh"
+
+namespace sl {
+
+template <typename Signature, u64 InlineSize = 48> class Delegate;
+
+/*
+    Move-only type erased callable, callables that fit into the inline buffer are
+    stored in place so creating, moving and invoking the delegate doesn't touch the
+    heap, bigger ones are allocated. Invocation is a single indirect call.
+*/
+template <typename R, typename... Args, u64 InlineSize>
+class Delegate<R(Args...), InlineSize> {
+    static constexpr u64 inlineAlignment = alignof(std::max_align_t);
+
+    enum class Operation { move, destroy };
+
+    using Invoker = R (*)(void* storage, Args&&... args);
+    using Manager = void (*)(Operation operation, void* storage, void* other);
+
+    template <typename F>
+    static constexpr bool fitsInline =
+      sizeof(F) <= InlineSize && alignof(F) <= inlineAlignment
+      && std::is_nothrow_move_constructible_v<F>;
+
+public:
+    Delegate() = default;
+
+    template <typename F>
+    requires(not std::is_same_v<std::decay_t<F>, Delegate>
+             && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+    Delegate(F&& callable) {
+        using Callable = std::decay_t<F>;
+
+        if constexpr (fitsInline<Callable>) {
+            new (m_storage) Callable(std::forward<F>(callable));
+            m_invoker = [](void* storage, Args&&... args) -> R {
+                return (*std::launder(static_cast<Callable*>(storage))
+                )(std::forward<Args>(args)...);
+            };
+        } else {
+            new (m_storage) Callable*(new Callable(std::forward<F>(callable)));
+            m_invoker = [](void* storage, Args&&... args) -> R {
+                return (**static_cast<Callable**>(storage))(std::forward<Args>(args)...);
+            };
+        }
+        m_manager = &manage<Callable>;
+    }
+
+    Delegate(Delegate&& oth) noexcept { moveFrom(oth); }
+
+    Delegate& operator=(Delegate&& oth) noexcept {
+        if (this != &oth) {
+            reset();
+            moveFrom(oth);
+        }
+        return *this;
+    }
+
+    Delegate(const Delegate&)            = delete;
+    Delegate& operator=(const Delegate&) = delete;
+
+    ~Delegate() { reset(); }
+
+    R operator()(Args... args) const {
+        log::expect(m_invoker != nullptr, "Calling an empty delegate");
+        return m_invoker(m_storage, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const { return m_invoker != nullptr; }
+
+    void reset() {
+        if (m_manager) m_manager(Operation::destroy, m_storage, nullptr);
+        m_invoker = nullptr;
+        m_manager = nullptr;
+    }
+
+private:
+    template <typename Callable>
+    static void manage(Operation operation, void* storage, void* other) {
+        if constexpr (fitsInline<Callable>) {
+            auto callable = std::launder(static_cast<Callable*>(storage));
+            if (operation == Operation::move)
+                new (other) Callable(std::move(*callable));
+            std::destroy_at(callable);
+        } else {
+            auto callable = *static_cast<Callable**>(storage);
+            if (operation == Operation::move)
+                new (other) Callable*(callable);
+            else
+                delete callable;
+        }
+    }
+
+    void moveFrom(Delegate& oth) {
+        if (oth.m_manager) oth.m_manager(Operation::move, oth.m_storage, m_storage);
+
+        m_invoker = std::exchange(oth.m_invoker, nullptr);
+        m_manager = std::exchange(oth.m_manager, nullptr);
+    }
+
+    Invoker m_invoker = nullptr;
+    Manager m_manager = nullptr;
+    alignas(inlineAlignment) mutable std::byte m_storage[InlineSize];
+};
+
+}  // namespace sl
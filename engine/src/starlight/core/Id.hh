@@ -1,51 +1,50 @@
 #pragma once
 
-#include <mutex>
 #include <limits>
 #include <concepts>
 #include <optional>
-#include <queue>
+#include <utility>
 
 #include <fmt/core.h>
 
 #include "starlight/core/Core.hh"
 #include "starlight/core/Log.hh"
 #include "starlight/core/Utils.hh"
+#include "starlight/core/IdRecycler.hh"
 
 namespace sl {
 
 template <typename T, typename Id = u64>
-requires std::is_arithmetic_v<Id>
+requires std::is_unsigned_v<Id>
 class Identificable : public virtual NonCopyable {
+    using Recycler = IdRecycler<T, Id>;
+
 public:
-    explicit Identificable() : id(createId()) {}
+    explicit Identificable() : id(Recycler::acquire()) {}
 
-    Identificable(Identificable&& oth)            = default;
-    Identificable& operator=(Identificable&& oth) = default;
+    // moved-from object gives up its id, otherwise it would be released twice
+    Identificable(Identificable&& oth) : id(std::exchange(oth.id, invalidId)) {}
 
-    ~Identificable() {
-        std::scoped_lock guard{ s_mutex };
-        s_freeIds.push(id);
+    Identificable& operator=(Identificable&& oth) {
+        std::swap(id, oth.id);
+        return *this;
     }
 
-    Id id;
+    ~Identificable() {
+        if (id != invalidId) Recycler::release(id);
+    }
 
-private:
-    static Id createId() {
-        std::scoped_lock guard{ s_mutex };
+    // ids carry a generation, so an id kept after its object died is not alive
+    // even when the index has been given to a new object
+    static bool isAlive(Id id) { return id != invalidId && Recycler::isAlive(id); }
 
-        if (not s_freeIds.empty()) {
-            const auto id = s_freeIds.front();
-            s_freeIds.pop();
-            return id;
-        }
+    // dense while few objects are alive, e.g. for packing into sort keys
+    static Id getIndex(Id id) { return Recycler::getIndex(id); }
 
-        return s_generator++;
-    }
+    Id id;
 
-    inline static Id s_generator = 0;
-    inline static std::queue<Id> s_freeIds;
-    inline static std::mutex s_mutex;
+private:
+    static constexpr Id invalidId = Recycler::invalidId;
 };
 
 template <typename T, StringLiteral NameGenerator>
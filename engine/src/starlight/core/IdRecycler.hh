@@ -0,0 +1,240 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <limits>
+
+#include "starlight/core/Core.hh"
+#include "starlight/core/Log.hh"
+
+namespace sl {
+
+/*
+    Lock-free source of recycled ids, one per Owner type. An id is made of an index
+    (low bits) and a generation (high bits) which is bumped every time the index is
+    released, so a stale copy of an id can be told apart from the live one. Every
+    thread keeps a small cache of free indices and only touches shared state to move
+    a batch of them: fresh indices are reserved with a single fetch_add, released
+    ones go through a Treiber stack linked through a per index table. The table
+    grows in segments that never move, so lookups don't need a lock.
+*/
+template <typename Owner, typename Id>
+requires(std::is_unsigned_v<Id> && std::numeric_limits<Id>::digits >= 16)
+class IdRecycler {
+public:
+    static constexpr u64 idBits         = std::numeric_limits<Id>::digits;
+    static constexpr u64 indexBits      = idBits >= 64 ? 32 : idBits - idBits / 4;
+    static constexpr u64 generationBits = idBits - indexBits;
+    static constexpr Id invalidId       = std::numeric_limits<Id>::max();
+
+    static constexpr Id getIndex(Id id) { return id & indexMask; }
+    static constexpr Id getGeneration(Id id) { return id >> indexBits; }
+
+    static Id acquire() {
+        auto cache = getThreadCache();
+        if (not cache) [[unlikely]]
+            return makeId(acquireShared());
+
+        if (cache->count == 0u) [[unlikely]]
+            refill(*cache);
+
+        return makeId(cache->indices[--cache->count]);
+    }
+
+    static void release(Id id) {
+        const auto index = static_cast<u32>(getIndex(id));
+        auto& entry      = getEntry(index);
+
+        log::expect(
+          entry.generation.load(std::memory_order_relaxed) == getGeneration(id),
+          "Id {} released twice", id
+        );
+        entry.generation.store(
+          (getGeneration(id) + 1u) & generationMask, std::memory_order_relaxed
+        );
+
+        auto cache = getThreadCache();
+        if (not cache) [[unlikely]] {
+            getInstance().push(&index, 1u);
+            return;
+        }
+
+        cache->indices[cache->count++] = index;
+        if (cache->count == cache->indices.size()) {
+            cache->count -= batchSize;
+            getInstance().push(&cache->indices[cache->count], batchSize);
+        }
+    }
+
+    // false once the id has been released, even if its index was reused since
+    static bool isAlive(Id id) {
+        const auto index = static_cast<u32>(getIndex(id));
+        return index < getInstance().m_nextIndex.load(std::memory_order_relaxed)
+               && getEntry(index).generation.load(std::memory_order_relaxed)
+                    == getGeneration(id);
+    }
+
+private:
+    static constexpr Id indexMask      = (Id{ 1 } << indexBits) - 1u;
+    static constexpr Id generationMask = (Id{ 1 } << generationBits) - 1u;
+    // the last index is reserved, otherwise it could produce invalidId
+    static constexpr u64 maxIndexCount = indexMask;
+
+    static constexpr u32 batchSize        = 32;
+    static constexpr u64 firstSegmentBits = 10;
+    static constexpr u64 segmentCount     = indexBits - firstSegmentBits + 1u;
+    // stack links are stored as index + 1 so zero can mark the end
+    static constexpr u32 endOfStack = 0u;
+
+    struct Entry {
+        std::atomic<u32> next;
+        std::atomic<u32> generation;
+    };
+
+    struct ThreadCache {
+        ~ThreadCache() {
+            getInstance().push(indices.data(), count);
+            t_cacheDestroyed = true;
+        }
+
+        std::array<u32, batchSize * 2u> indices;
+        u32 count = 0u;
+    };
+
+    IdRecycler() = default;
+
+    // intentionally leaked, ids may be released during static destruction
+    static IdRecycler& getInstance() {
+        static auto* instance = new IdRecycler{};
+        return *instance;
+    }
+
+    static ThreadCache* getThreadCache() {
+        if (t_cacheDestroyed) [[unlikely]]
+            return nullptr;
+
+        thread_local ThreadCache cache;
+        return &cache;
+    }
+
+    static Id makeId(u32 index) {
+        const Id generation = getEntry(index).generation.load(std::memory_order_relaxed);
+        return (generation << indexBits) | index;
+    }
+
+    static void refill(ThreadCache& cache) {
+        auto& instance = getInstance();
+
+        cache.count = instance.pop(cache.indices.data(), batchSize);
+        if (cache.count > 0u) return;
+
+        const auto first = instance.reserve(batchSize);
+        // handed out from the back, reverse so the lowest index goes first
+        for (u32 i = 0; i < batchSize; ++i)
+            cache.indices[i] = first + batchSize - 1u - i;
+        cache.count = batchSize;
+    }
+
+    static u32 acquireShared() {
+        auto& instance = getInstance();
+
+        u32 index;
+        if (instance.pop(&index, 1u) == 1u) return index;
+        return instance.reserve(1u);
+    }
+
+    static Entry& getEntry(u32 index) {
+        const auto segment = getSegment(index);
+        const auto offset  = segment == 0u ? index : index - getSegmentStart(segment);
+
+        auto& slot   = getInstance().m_segments[segment];
+        auto entries = slot.load(std::memory_order_acquire);
+
+        if (not entries) [[unlikely]] {
+            auto fresh = new Entry[getSegmentSize(segment)]{};
+            if (slot.compare_exchange_strong(entries, fresh, std::memory_order_acq_rel))
+                entries = fresh;
+            else
+                delete[] fresh;
+        }
+        return entries[offset];
+    }
+
+    static u64 getSegment(u32 index) {
+        return std::bit_width(static_cast<u64>(index) >> firstSegmentBits);
+    }
+
+    static u64 getSegmentStart(u64 segment) {
+        return segment == 0u ? 0u : (1ull << (firstSegmentBits + segment - 1u));
+    }
+
+    static u64 getSegmentSize(u64 segment) {
+        return segment == 0u ? (1ull << firstSegmentBits)
+                             : (1ull << (firstSegmentBits + segment - 1u));
+    }
+
+    u32 reserve(u32 count) {
+        const auto first = m_nextIndex.fetch_add(count, std::memory_order_relaxed);
+        log::expect(
+          first + count <= maxIndexCount, "Ran out of {} bit id indices", indexBits
+        );
+        return static_cast<u32>(first);
+    }
+
+    static u64 packHead(u64 tag, u32 link) { return (tag << 32u) | link; }
+    static u32 getLink(u64 head) { return static_cast<u32>(head); }
+    static u64 getTag(u64 head) { return head >> 32u; }
+
+    void push(const u32* indices, u32 count) {
+        if (count == 0u) return;
+
+        // chain the batch first, only its tail has to be patched on retries
+        for (u32 i = 0; i + 1u < count; ++i) {
+            getEntry(indices[i])
+              .next.store(indices[i + 1u] + 1u, std::memory_order_relaxed);
+        }
+
+        auto& tail = getEntry(indices[count - 1u]);
+        auto head  = m_head.load(std::memory_order_relaxed);
+
+        do {
+            tail.next.store(getLink(head), std::memory_order_relaxed);
+        } while (not m_head.compare_exchange_weak(
+          head, packHead(getTag(head) + 1u, indices[0] + 1u), std::memory_order_release,
+          std::memory_order_relaxed
+        ));
+    }
+
+    u32 pop(u32* indices, u32 maxCount) {
+        auto head = m_head.load(std::memory_order_acquire);
+
+        while (true) {
+            auto link = getLink(head);
+            if (link == endOfStack) return 0u;
+
+            // links may change under our feet, the tag makes the CAS fail then
+            u32 count = 0u;
+            u32 next  = link;
+            while (next != endOfStack && count < maxCount) {
+                indices[count++] = next - 1u;
+                next = getEntry(next - 1u).next.load(std::memory_order_relaxed);
+            }
+
+            if (m_head.compare_exchange_weak(
+                  head, packHead(getTag(head) + 1u, next), std::memory_order_acquire,
+                  std::memory_order_acquire
+                ))
+                return count;
+        }
+    }
+
+    std::array<std::atomic<Entry*>, segmentCount> m_segments{};
+    alignas(64) std::atomic<u64> m_head      = packHead(0u, endOfStack);
+    alignas(64) std::atomic<u64> m_nextIndex = 0u;
+
+    // trivially destructible, so it can be checked after the cache itself is gone
+    inline static thread_local bool t_cacheDestroyed = false;
+};
+
+}  // namespace sl
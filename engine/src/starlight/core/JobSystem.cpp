@@ -0,0 +1,240 @@
+#include "JobSystem.hh"
+
+#include "Log.hh"
+
+namespace sl {
+
+namespace detail {
+
+struct Job {
+    explicit Job(JobSystem::Task&& task) :
+        task(std::move(task)), references(1u), pendingDependencies(1u),
+        finished(false) {}
+
+    JobSystem::Task task;
+
+    std::atomic<u32> references;
+    // unfinished dependencies + 1, the extra one is held by spawn until all
+    // dependencies are registered
+    std::atomic<u32> pendingDependencies;
+    std::atomic_bool finished;
+
+    std::mutex mutex;
+    std::vector<Job*> continuations;
+};
+
+static Job* acquire(Job* job) {
+    if (job) job->references.fetch_add(1u, std::memory_order_relaxed);
+    return job;
+}
+
+static void release(Job* job) {
+    if (job && job->references.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+        delete job;
+}
+
+}  // namespace detail
+
+// set for worker threads only
+static thread_local JobSystem* s_currentSystem = nullptr;
+static thread_local u64 s_currentWorker        = 0u;
+
+JobHandle::JobHandle() : m_job(nullptr) {}
+
+JobHandle::JobHandle(detail::Job* job) : m_job(job) {}
+
+JobHandle::~JobHandle() { detail::release(m_job); }
+
+JobHandle::JobHandle(const JobHandle& oth) : m_job(detail::acquire(oth.m_job)) {}
+
+JobHandle& JobHandle::operator=(const JobHandle& oth) {
+    if (this != &oth) {
+        detail::release(m_job);
+        m_job = detail::acquire(oth.m_job);
+    }
+    return *this;
+}
+
+JobHandle::JobHandle(JobHandle&& oth) : m_job(std::exchange(oth.m_job, nullptr)) {}
+
+JobHandle& JobHandle::operator=(JobHandle&& oth) {
+    std::swap(m_job, oth.m_job);
+    return *this;
+}
+
+bool JobHandle::isFinished() const {
+    return m_job == nullptr || m_job->finished.load(std::memory_order_acquire);
+}
+
+JobSystem::JobSystem(u64 workerCount) :
+    m_queuedJobs(0u), m_sleepingWorkers(0u), m_stopping(false) {
+    log::trace("Starting job system with {} workers", workerCount);
+
+    m_workers.reserve(workerCount);
+    for (u64 i = 0; i < workerCount; ++i)
+        m_workers.push_back(UniquePtr<Worker>::create());
+
+    // all queues have to exist before anyone tries to steal
+    for (u64 i = 0; i < workerCount; ++i)
+        m_workers[i]->thread = std::thread{ [this, i]() { work(i); } };
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::scoped_lock guard{ m_sleepMutex };
+        m_stopping = true;
+    }
+    m_wakeUp.notify_all();
+
+    for (auto& worker : m_workers) worker->thread.join();
+
+    // jobs that were never waited for
+    while (auto job = findJob()) execute(job);
+}
+
+void JobSystem::wait(const JobHandle& job) {
+    while (not job.isFinished())
+        if (not executeOne()) std::this_thread::yield();
+}
+
+void JobSystem::wait(std::span<const JobHandle> jobs) {
+    for (const auto& job : jobs) wait(job);
+}
+
+u64 JobSystem::getWorkerCount() const { return m_workers.size(); }
+
+u64 JobSystem::getDefaultWorkerCount() {
+    // the main thread takes part in the work while waiting for jobs
+    const u64 threads = std::thread::hardware_concurrency();
+    return threads > 1u ? threads - 1u : 1u;
+}
+
+JobHandle JobSystem::spawnTask(Task&& task, std::span<const JobHandle> dependencies) {
+    auto job = new detail::Job{ std::move(task) };
+    JobHandle handle{ detail::acquire(job) };
+
+    for (const auto& dependency : dependencies) {
+        auto parent = dependency.m_job;
+        if (parent == nullptr) continue;
+
+        std::scoped_lock guard{ parent->mutex };
+        if (parent->finished) continue;
+
+        job->pendingDependencies.fetch_add(1u, std::memory_order_relaxed);
+        parent->continuations.push_back(detail::acquire(job));
+    }
+
+    // the initial reference is passed to the queue once the job is ready
+    if (job->pendingDependencies.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+        schedule(job);
+    else
+        detail::release(job);
+
+    return handle;
+}
+
+void JobSystem::schedule(detail::Job* job) {
+    if (m_workers.empty()) {
+        execute(job);
+        return;
+    }
+
+    // counted before the push, so a worker that sees zero can't miss the job
+    m_queuedJobs.fetch_add(1u);
+
+    if (s_currentSystem != this || not m_workers[s_currentWorker]->queue.push(job)) {
+        std::scoped_lock guard{ m_sharedQueueMutex };
+        m_sharedQueue.push_back(job);
+    }
+
+    if (m_sleepingWorkers.load() > 0u) {
+        { std::scoped_lock guard{ m_sleepMutex }; }
+        m_wakeUp.notify_one();
+    }
+}
+
+void JobSystem::execute(detail::Job* job) {
+    job->task();
+    // release captured state as soon as possible
+    job->task = nullptr;
+
+    std::vector<detail::Job*> continuations;
+    {
+        std::scoped_lock guard{ job->mutex };
+        job->finished.store(true, std::memory_order_release);
+        continuations.swap(job->continuations);
+    }
+
+    for (auto continuation : continuations) {
+        if (continuation->pendingDependencies.fetch_sub(1u, std::memory_order_acq_rel)
+            == 1u)
+            schedule(continuation);
+        else
+            detail::release(continuation);
+    }
+
+    detail::release(job);
+}
+
+detail::Job* JobSystem::findJob() {
+    const bool isWorker = s_currentSystem == this;
+
+    if (isWorker) {
+        if (auto job = m_workers[s_currentWorker]->queue.pop(); job) return *job;
+    }
+
+    {
+        std::scoped_lock guard{ m_sharedQueueMutex };
+        if (not m_sharedQueue.empty()) {
+            auto job = m_sharedQueue.front();
+            m_sharedQueue.pop_front();
+            return job;
+        }
+    }
+
+    const auto workerCount = m_workers.size();
+    const auto firstVictim = isWorker ? s_currentWorker + 1u : 0u;
+
+    for (u64 i = 0; i < workerCount; ++i) {
+        const auto victim = (firstVictim + i) % workerCount;
+        if (isWorker && victim == s_currentWorker) continue;
+
+        if (auto job = m_workers[victim]->queue.steal(); job) return *job;
+    }
+
+    return nullptr;
+}
+
+bool JobSystem::executeOne() {
+    auto job = findJob();
+    if (job == nullptr) return false;
+
+    m_queuedJobs.fetch_sub(1u);
+    execute(job);
+    return true;
+}
+
+void JobSystem::work(u64 workerIndex) {
+    s_currentSystem = this;
+    s_currentWorker = workerIndex;
+
+    while (not m_stopping) {
+        if (executeOne()) continue;
+
+        // counted job might be still on its way to a queue
+        if (m_queuedJobs.load() > 0u)
+            std::this_thread::yield();
+        else
+            sleep();
+    }
+}
+
+void JobSystem::sleep() {
+    std::unique_lock lock{ m_sleepMutex };
+
+    m_sleepingWorkers.fetch_add(1u);
+    while (not m_stopping && m_queuedJobs.load() == 0u) m_wakeUp.wait(lock);
+    m_sleepingWorkers.fetch_sub(1u);
+}
+
+}  // namespace sl
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "Core.hh"
+#include "Concepts.hh"
+#include "containers/WorkStealingQueue.hh"
+#include "memory/Memory.hh"
+
+namespace sl {
+
+namespace detail {
+
+struct Job;
+
+}  // namespace detail
+
+/*
+    Reference to a spawned job, empty handle is treated as already finished.
+*/
+class JobHandle {
+    friend class JobSystem;
+
+public:
+    JobHandle();
+    ~JobHandle();
+
+    JobHandle(const JobHandle& oth);
+    JobHandle& operator=(const JobHandle& oth);
+
+    JobHandle(JobHandle&& oth);
+    JobHandle& operator=(JobHandle&& oth);
+
+    bool isFinished() const;
+
+private:
+    // takes over a reference that was already acquired
+    explicit JobHandle(detail::Job* job);
+
+    detail::Job* m_job;
+};
+
+/*
+    Worker threads with per-thread work-stealing deques. Jobs spawned from a worker
+    go to its own deque and are taken in LIFO order, idle workers steal the oldest
+    jobs of others. Jobs spawned from other threads go to a shared queue. A job is
+    scheduled once all of its dependencies are finished, waiting for a job executes
+    other jobs in the meantime so waiting from inside of a job is allowed.
+
+    With zero workers ready jobs are executed immediately on the spawning thread.
+*/
+class JobSystem : public NonMovable {
+    static constexpr u64 queueCapacity = 4096;
+
+    using Queue = WorkStealingQueue<detail::Job*, queueCapacity>;
+
+    struct Worker {
+        Queue queue;
+        std::thread thread;
+    };
+
+public:
+    using Task = std::function<void()>;
+
+    explicit JobSystem(u64 workerCount = getDefaultWorkerCount());
+    ~JobSystem();
+
+    template <typename C>
+    requires Callable<C>
+    JobHandle spawn(C&& callback, std::span<const JobHandle> dependencies = {}) {
+        return spawnTask(Task{ std::forward<C>(callback) }, dependencies);
+    }
+
+    template <typename C>
+    requires Callable<C>
+    JobHandle spawn(C&& callback, std::initializer_list<JobHandle> dependencies) {
+        return spawnTask(
+          Task{ std::forward<C>(callback) },
+          std::span{ dependencies.begin(), dependencies.size() }
+        );
+    }
+
+    // continuation, runs after the given job finishes
+    template <typename C>
+    requires Callable<C>
+    JobHandle then(const JobHandle& job, C&& callback) {
+        return spawn(std::forward<C>(callback), std::span{ &job, 1u });
+    }
+
+    void wait(const JobHandle& job);
+    void wait(std::span<const JobHandle> jobs);
+
+    // splits [begin, end) into chunks of grainSize and calls the callback with
+    // [chunkBegin, chunkEnd) of each chunk, returns when the whole range is done
+    template <typename C>
+    requires Callable<C, void, u64, u64>
+    void parallelFor(u64 begin, u64 end, u64 grainSize, C&& callback) {
+        if (begin >= end) return;
+
+        grainSize             = std::max(grainSize, u64{ 1u });
+        const auto chunkCount = (end - begin + grainSize - 1) / grainSize;
+
+        if (chunkCount == 1u || m_workers.empty()) {
+            callback(begin, end);
+            return;
+        }
+
+        std::vector<JobHandle> jobs;
+        jobs.reserve(chunkCount - 1u);
+
+        for (auto chunkBegin = begin + grainSize; chunkBegin < end;
+             chunkBegin += grainSize) {
+            const auto chunkEnd = std::min(chunkBegin + grainSize, end);
+            jobs.push_back(spawn([&callback, chunkBegin, chunkEnd]() {
+                callback(chunkBegin, chunkEnd);
+            }));
+        }
+
+        // first chunk is processed by the caller
+        callback(begin, std::min(begin + grainSize, end));
+        wait(jobs);
+    }
+
+    u64 getWorkerCount() const;
+
+    static u64 getDefaultWorkerCount();
+
+private:
+    JobHandle spawnTask(Task&& task, std::span<const JobHandle> dependencies);
+
+    void schedule(detail::Job* job);
+    void execute(detail::Job* job);
+
+    detail::Job* findJob();
+    bool executeOne();
+
+    void work(u64 workerIndex);
+    void sleep();
+
+    std::vector<UniquePtr<Worker>> m_workers;
+
+    std::mutex m_sharedQueueMutex;
+    std::deque<detail::Job*> m_sharedQueue;
+
+    // jobs pushed to any of the queues and not taken yet
+    std::atomic<u64> m_queuedJobs;
+    std::atomic<u64> m_sleepingWorkers;
+    std::atomic_bool m_stopping;
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wakeUp;
+};
+
+}  // namespace sl
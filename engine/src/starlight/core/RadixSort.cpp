@@ -0,0 +1,106 @@
+#include "RadixSort.hh"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include "starlight/core/Log.hh"
+
+namespace sl {
+
+static constexpr u64 digitBits   = 8;
+static constexpr u64 bucketCount = 1u << digitBits;
+static constexpr u64 digitCount  = 64 / digitBits;
+// up to it comparisons beat the histogram passes, see the RadixSort benchmark
+static constexpr u64 comparisonSortLimit = 1024;
+
+using Histogram = std::array<u32, bucketCount>;
+
+static u64 getDigit(u64 key, u64 digit) {
+    return (key >> (digit * digitBits)) & (bucketCount - 1u);
+}
+
+// small inputs are sorted by comparisons, in a buffer on the stack; ties broken by
+// the position keep it stable without the memory std::stable_sort would allocate
+static void comparisonSort(std::span<u64> keys, std::span<u32> values) {
+    struct Entry {
+        u64 key;
+        u32 value;
+        u32 position;
+    };
+
+    std::array<Entry, comparisonSortLimit> entries;
+    const auto count = keys.size();
+
+    for (u32 i = 0; i < count; ++i) entries[i] = Entry{ keys[i], values[i], i };
+    std::sort(
+      entries.begin(), entries.begin() + count,
+      [](const auto& lhs, const auto& rhs) {
+          return lhs.key < rhs.key
+                 || (lhs.key == rhs.key && lhs.position < rhs.position);
+      }
+    );
+
+    for (u64 i = 0; i < count; ++i) {
+        keys[i]   = entries[i].key;
+        values[i] = entries[i].value;
+    }
+}
+
+void radixSort(
+  std::span<u64> keys, std::span<u32> values, std::span<u64> keysScratch,
+  std::span<u32> valuesScratch
+) {
+    const auto count = keys.size();
+
+    log::expect(values.size() == count, "Radix sort keys and values differ in size");
+    log::expect(
+      keysScratch.size() >= count && valuesScratch.size() >= count,
+      "Radix sort scratch too small, {} < {}",
+      std::min(keysScratch.size(), valuesScratch.size()), count
+    );
+
+    if (count < 2u) return;
+
+    if (count <= comparisonSortLimit) {
+        comparisonSort(keys, values);
+        return;
+    }
+
+    std::array<Histogram, digitCount> histograms{};
+    for (const auto key : keys) {
+        for (u64 digit = 0; digit < digitCount; ++digit)
+            ++histograms[digit][getDigit(key, digit)];
+    }
+
+    auto* sourceKeys        = keys.data();
+    auto* sourceValues      = values.data();
+    auto* destinationKeys   = keysScratch.data();
+    auto* destinationValues = valuesScratch.data();
+
+    for (u64 digit = 0; digit < digitCount; ++digit) {
+        auto& histogram = histograms[digit];
+
+        // every key has the same digit here, the pass wouldn't change the order
+        if (histogram[getDigit(sourceKeys[0], digit)] == count) continue;
+
+        u32 offset = 0u;
+        for (auto& bucket : histogram) offset += std::exchange(bucket, offset);
+
+        for (u64 i = 0; i < count; ++i) {
+            const auto position = histogram[getDigit(sourceKeys[i], digit)]++;
+            destinationKeys[position]   = sourceKeys[i];
+            destinationValues[position] = sourceValues[i];
+        }
+
+        std::swap(sourceKeys, destinationKeys);
+        std::swap(sourceValues, destinationValues);
+    }
+
+    if (sourceKeys != keys.data()) {
+        std::copy_n(sourceKeys, count, keys.data());
+        std::copy_n(sourceValues, count, values.data());
+    }
+}
+
+}  // namespace sl
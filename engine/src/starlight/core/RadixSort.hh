@@ -0,0 +1,22 @@
+#pragma once
+
+#include <span>
+
+#include "starlight/core/Core.hh"
+
+namespace sl {
+
+/*
+    Stable least significant digit radix sort of 64 bit keys, values are permuted
+    along with them. Works on 8 bit digits, all histograms are built in a single
+    read of the keys and passes on digits shared by every key are skipped, so keys
+    with unused bits cost less. Inputs of up to about a thousand keys are sorted by
+    comparisons instead, which is faster there. The scratch spans must be at least
+    as long as the input, the result always ends up in keys and values.
+*/
+void radixSort(
+  std::span<u64> keys, std::span<u32> values, std::span<u64> keysScratch,
+  std::span<u32> valuesScratch
+);
+
+}  // namespace sl
@@ -2,10 +2,19 @@
 
 namespace sl {
 
+TaskQueue::TaskQueue(u64 workerCount) : m_jobSystem(workerCount) {}
+
+void TaskQueue::wait(const JobHandle& job) { m_jobSystem.wait(job); }
+
 void TaskQueue::dispatchQueue(Type type) {
-    auto& queue = m_queues[type];
+    Queue queue;
+    {
+        std::scoped_lock guard{ m_mutex };
+        queue.swap(m_queues[type]);
+    }
     for (auto& task : queue) task();
-    queue.clear();
 }
 
+JobSystem& TaskQueue::getJobSystem() { return m_jobSystem; }
+
 }  // namespace sl
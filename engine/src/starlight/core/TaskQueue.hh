@@ -1,24 +1,35 @@
 #pragma once
 
 #include <functional>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
 #include "Singleton.hh"
 #include "Core.hh"
 #include "Concepts.hh"
+#include "JobSystem.hh"
 
 namespace sl {
 
+/*
+    Entry point for deferred and background work. Pre/post frame callbacks are
+    executed on the main thread at the frame boundaries and may be pushed from any
+    thread, e.g. to publish results of a job. Everything else goes through the job
+    system.
+*/
 class TaskQueue : public Singleton<TaskQueue> {
     using Queue = std::vector<std::function<void()>>;
 
 public:
     enum class Type { preFrame, postFrame };
 
+    explicit TaskQueue(u64 workerCount = JobSystem::getDefaultWorkerCount());
+
     template <typename C>
     requires Callable<C>
     void push(Type type, C&& callback) {
+        std::scoped_lock guard{ m_mutex };
         m_queues[type].emplace_back(std::move(callback));
     }
 
@@ -34,9 +45,29 @@ public:
         push(Type::preFrame, std::move(callback));
     }
 
+    template <typename C>
+    requires Callable<C>
+    JobHandle spawn(C&& callback, std::span<const JobHandle> dependencies = {}) {
+        return m_jobSystem.spawn(std::forward<C>(callback), dependencies);
+    }
+
+    template <typename C>
+    requires Callable<C, void, u64, u64>
+    void parallelFor(u64 begin, u64 end, u64 grainSize, C&& callback) {
+        m_jobSystem.parallelFor(begin, end, grainSize, std::forward<C>(callback));
+    }
+
+    void wait(const JobHandle& job);
+
+    // callbacks pushed while dispatching are executed in the next dispatch
     void dispatchQueue(Type type);
 
+    JobSystem& getJobSystem();
+
 private:
+    JobSystem m_jobSystem;
+
+    std::mutex m_mutex;
     std::unordered_map<Type, Queue> m_queues;
 };
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <bit>
 #include <vector>
 #include <algorithm>
 #include <unordered_set>
@@ -71,6 +72,17 @@ template <typename T> inline void clearMemory(T* target) {
     std::memset(target, 0, sizeof(T));
 }
 
+// FNV-1a, cheap enough to tell if data changed since the previous frame
+constexpr u64 fnvOffset = 14695981039346656037ull;
+constexpr u64 fnvPrime  = 1099511628211ull;
+
+// over whole floats, not their bytes
+inline u64 hashFloats(u64 hash, const f32* values, u64 count) {
+    for (u64 i = 0; i < count; ++i)
+        hash = (hash ^ std::bit_cast<u32>(values[i])) * fnvPrime;
+    return hash;
+}
+
 struct Range {
     u64 offset;
     u64 size;
@@ -78,9 +90,9 @@ struct Range {
     static Range aligned(u64 offset, u64 size, u64 granularity);
 };
 
-template <typename T, typename V, typename C>
+template <typename T, typename V, typename A, typename C>
 requires Callable<C, T, const V&>
-std::vector<T> transform(const std::vector<V>& in, C&& callback) {
+std::vector<T> transform(const std::vector<V, A>& in, C&& callback) {
     std::vector<T> out;
     out.reserve(in.size());
 
@@ -1,156 +1,332 @@
 #include "FreeList.hh"
 
+#include <algorithm>
+#include <bit>
+
+#include "starlight/core/Utils.hh"
+
 namespace sl {
 
-FreeList::Node::Node() { invalidate(); }
+FreeList::Block::Block(u64 offset, u64 size) :
+    offset(offset), size(size), isFree(false), previousPhysical(invalidBlock),
+    nextPhysical(invalidBlock), previousFree(invalidBlock), nextFree(invalidBlock) {}
 
-// TODO: ugly, refactor
-static constexpr auto invalidId = std::numeric_limits<u64>::max();
+FreeList::FreeList(u64 size) : m_totalSize(size) {
+    clear();
 
-void FreeList::Node::invalidate() {
-    offset = invalidId;
-    size   = invalidId;
-    next   = nullptr;
+    log::trace("Creating free list with {}b capacity", m_totalSize);
 }
 
-FreeList::FreeList(u64 size) :
-    m_totalSize(size), m_maxEntries(size / sizeof(void*)), m_nodes(m_maxEntries),
-    m_head(&m_nodes[0]) {
-    m_head->offset = 0;
-    m_head->size   = m_totalSize;
-
-    log::trace(
-      "Creating free list with {}b capacity, maxEntries={}", m_totalSize,
-      m_maxEntries
+void FreeList::resize(u64 newSize) {
+    log::expect(
+      newSize > m_totalSize,
+      "New size of the list must be greater than the actual one: {} <= {}", newSize,
+      m_totalSize
     );
+
+    const auto sizeDiff = newSize - m_totalSize;
+
+    if (m_lastPhysical != invalidBlock && m_blocks[m_lastPhysical].isFree) {
+        removeFreeBlock(m_lastPhysical);
+        m_blocks[m_lastPhysical].size += sizeDiff;
+        insertFreeBlock(m_lastPhysical);
+    } else {
+        const auto index = createBlock(m_totalSize, sizeDiff);
+        auto& block      = m_blocks[index];
+
+        block.previousPhysical = m_lastPhysical;
+        if (m_lastPhysical != invalidBlock)
+            m_blocks[m_lastPhysical].nextPhysical = index;
+
+        m_lastPhysical = index;
+        insertFreeBlock(index);
+    }
+
+    log::trace("Resizing free list {}b -> {}b", m_totalSize, newSize);
+
+    m_freeSpace += sizeDiff;
+    m_totalSize = newSize;
 }
 
-void FreeList::resize(u64 newSize) {
-    m_maxEntries = newSize / sizeof(void*);
+void FreeList::freeBlock(u64 size, u64 offset) {
+    const auto record = m_allocatedBlocks.find(offset);
+
+    if (record == m_allocatedBlocks.end()) {
+        log::warn(
+          "Unable to find block to free at offset={}, that's unexpected", offset
+        );
+        return;
+    }
+
+    const auto index = record->second;
+    m_allocatedBlocks.erase(record);
+
+    const auto blockSize = m_blocks[index].size;
+    if (blockSize != size) {
+        log::warn(
+          "Freeing block at offset={} with size={} but {}b was allocated", offset,
+          size, blockSize
+        );
+    }
+
+    m_freeSpace += blockSize;
+    insertFreeBlock(mergeWithNeighbours(index));
+}
 
-    u64 sizeDiff = newSize - m_totalSize;
+std::optional<u64> FreeList::allocateBlock(u64 size, u64 alignment) {
+    log::expect(size > 0, "Could not allocate block with size less or equal 0");
     log::expect(
-      sizeDiff > 0, "New size of the list must be greater than the actual one"
+      std::has_single_bit(alignment), "Alignment must be a power of 2: {}",
+      alignment
     );
 
-    m_totalSize = newSize;
+    auto index = findSuitableBlock(size, alignment);
 
-    m_nodes.clear();
-    m_nodes.resize(newSize);
+    if (index == invalidBlock) {
+        log::warn(
+          "Could not find block with enough memory {} bytes requested, total space left: {}",
+          size, spaceLeft()
+        );
+        return {};
+    }
 
-    m_head = &m_nodes[0];
-    log::panic("NOT IMPLEMENTED YET!");
+    return takeBlock(index, size, alignment);
 }
 
-void FreeList::freeBlock(u64 size, u64 offset) {
+std::optional<u64> FreeList::allocateBlockBelow(u64 size, u64 limit, u64 alignment) {
+    log::expect(size > 0, "Could not allocate block with size less or equal 0");
     log::expect(
-      size > 0 && offset > 0,
-      "Could not free block with invalid offset ({}) or size ({})", offset, size
+      std::has_single_bit(alignment), "Alignment must be a power of 2: {}",
+      alignment
     );
 
-    Node* previous = nullptr;
-    Node* node     = m_head;
+    auto lowest = invalidBlock;
 
-    while (node != nullptr) {
-        if (node->offset == offset) {
-            node->size += size;
+    for (auto index = m_lastPhysical; index != invalidBlock;
+         index      = m_blocks[index].previousPhysical) {
+        const auto& block = m_blocks[index];
+        if (not block.isFree || block.offset >= limit) continue;
 
-            if (node->next && node->next->offset == node->offset + node->size) {
-                node->size += node->next->size;
-                auto next  = node->next;
-                node->next = next->next;
-                next->invalidate();
-            }
-        } else if (node->offset > offset) {
-            Node* newNode = getFreeNode();
-
-            newNode->offset = offset;
-            newNode->size   = size;
-            newNode->next   = node;
-
-            if (previous)
-                previous->next = newNode;
-            else
-                m_head = newNode;
-
-            if (newNode->next
-                && newNode->offset + newNode->size == newNode->next->offset) {
-                newNode->size += newNode->next->size;
-                auto rubbish  = newNode->next;
-                newNode->next = rubbish->next;
-                rubbish->invalidate();
-            }
-            if (previous && previous->offset + previous->size == newNode->offset) {
-                previous->size += newNode->size;
-                previous->next = newNode->next;
-                newNode->invalidate();
+        const auto alignedOffset = getAlignedValue(block.offset, alignment);
+        const auto end           = std::min(block.offset + block.size, limit);
+
+        if (alignedOffset + size <= end) lowest = index;
+    }
+
+    if (lowest == invalidBlock) return {};
+    return takeBlock(lowest, size, alignment);
+}
+
+u64 FreeList::spaceLeft() const { return m_freeSpace; }
+
+u64 FreeList::getSize() const { return m_totalSize; }
+
+void FreeList::clear() {
+    m_blocks.clear();
+    m_unusedBlocks.clear();
+    m_allocatedBlocks.clear();
+
+    m_firstLevelBitmap = 0u;
+    m_secondLevelBitmaps.fill(0u);
+    for (auto& heads : m_freeHeads) heads.fill(invalidBlock);
+
+    m_lastPhysical = invalidBlock;
+    m_freeSpace    = m_totalSize;
+
+    if (m_totalSize > 0) {
+        m_lastPhysical = createBlock(0u, m_totalSize);
+        insertFreeBlock(m_lastPhysical);
+    }
+}
+
+FreeList::Mapping FreeList::mapInsert(u64 size) {
+    if (size < smallBlockSize)
+        return Mapping{ .firstLevel = 0u, .secondLevel = size };
+
+    const u64 mostSignificantBit = std::bit_width(size) - 1u;
+
+    return Mapping{
+        .firstLevel  = mostSignificantBit - secondLevelBits + 1u,
+        .secondLevel = (size >> (mostSignificantBit - secondLevelBits))
+                       ^ secondLevelCount,
+    };
+}
+
+FreeList::Mapping FreeList::mapSearch(u64 size) {
+    // round up to the next list so that any block found there is big enough
+    if (size >= smallBlockSize) {
+        const u64 mostSignificantBit = std::bit_width(size) - 1u;
+        size += (1ull << (mostSignificantBit - secondLevelBits)) - 1u;
+    }
+    return mapInsert(size);
+}
+
+FreeList::BlockIndex FreeList::findSuitableBlock(u64 size, u64 alignment) {
+    const auto [firstLevel, secondLevel] = mapSearch(size + alignment - 1u);
+
+    if (firstLevel < firstLevelCount) {
+        u64 fl = firstLevel;
+        u32 secondLevelMap = m_secondLevelBitmaps[fl] & (~0u << secondLevel);
+
+        if (secondLevelMap == 0u) {
+            const auto firstLevelMap =
+              fl + 1u < 64u ? m_firstLevelBitmap & (~0ull << (fl + 1u)) : 0ull;
+
+            if (firstLevelMap != 0u) {
+                fl             = std::countr_zero(firstLevelMap);
+                secondLevelMap = m_secondLevelBitmaps[fl];
             }
         }
-        previous = node;
-        node     = node->next;
+
+        if (secondLevelMap != 0u)
+            return m_freeHeads[fl][std::countr_zero(secondLevelMap)];
+    }
+
+    // rounding up skips the list that may still hold an exact fit, which matters
+    // when the range is almost full, walk only that single list as a fallback
+    const auto [exactFirstLevel, exactSecondLevel] = mapInsert(size);
+
+    for (auto index = m_freeHeads[exactFirstLevel][exactSecondLevel];
+         index != invalidBlock; index = m_blocks[index].nextFree) {
+        const auto& block = m_blocks[index];
+        const auto padding =
+          getAlignedValue(block.offset, alignment) - block.offset;
+
+        if (block.size >= size + padding) return index;
     }
-    log::warn("Unable to find block to free, that's unexpected");
+
+    return invalidBlock;
 }
 
-std::optional<u64> FreeList::allocateBlock(u64 size) {
-    log::expect(size > 0, "Could not allocate block with size less or equal 0");
+u64 FreeList::takeBlock(BlockIndex index, u64 size, u64 alignment) {
+    removeFreeBlock(index);
 
-    Node* previous = nullptr;
-    Node* node     = m_head;
+    const auto offset        = m_blocks[index].offset;
+    const auto alignedOffset = getAlignedValue(offset, alignment);
 
-    while (node != nullptr) {
-        if (node->size == size) {
-            u64 offset = node->offset;
+    if (const auto padding = alignedOffset - offset; padding > 0) {
+        // previous physical block of a free block is always in use, so the padding
+        // can't be merged with anything and goes straight back to the free lists
+        const auto alignedIndex = split(index, padding);
+        insertFreeBlock(index);
+        index = alignedIndex;
+    }
 
-            if (previous) {
-                previous->next = node->next;
-                node->invalidate();
-            } else {
-                m_head->invalidate();
-                m_head = node->next;
-            }
+    if (m_blocks[index].size > size) insertFreeBlock(split(index, size));
 
-            return offset;
-        } else if (node->size > size) {
-            u64 offset = node->offset;
+    m_allocatedBlocks[alignedOffset] = index;
+    m_freeSpace -= size;
 
-            node->size -= size;
-            node->offset += size;
+    return alignedOffset;
+}
 
-            return offset;
-        }
-        previous = node;
-        node     = node->next;
+FreeList::BlockIndex FreeList::createBlock(u64 offset, u64 size) {
+    if (not m_unusedBlocks.empty()) {
+        const auto index = m_unusedBlocks.back();
+        m_unusedBlocks.pop_back();
+        m_blocks[index] = Block{ offset, size };
+        return index;
     }
 
-    log::warn(
-      "Could not find block with enough memory {} bytes requested, total space left: {}",
-      size, spaceLeft()
-    );
-    return {};
+    m_blocks.emplace_back(offset, size);
+    return static_cast<BlockIndex>(m_blocks.size() - 1u);
+}
+
+void FreeList::releaseBlock(BlockIndex index) { m_unusedBlocks.push_back(index); }
+
+void FreeList::insertFreeBlock(BlockIndex index) {
+    auto& block                          = m_blocks[index];
+    const auto [firstLevel, secondLevel] = mapInsert(block.size);
+    auto& head                           = m_freeHeads[firstLevel][secondLevel];
+
+    block.isFree       = true;
+    block.previousFree = invalidBlock;
+    block.nextFree     = head;
+
+    if (head != invalidBlock) m_blocks[head].previousFree = index;
+    head = index;
+
+    m_firstLevelBitmap |= (1ull << firstLevel);
+    m_secondLevelBitmaps[firstLevel] |= (1u << secondLevel);
 }
 
-u64 FreeList::spaceLeft() {
-    u64 totalSpace = 0u;
+void FreeList::removeFreeBlock(BlockIndex index) {
+    auto& block                          = m_blocks[index];
+    const auto [firstLevel, secondLevel] = mapInsert(block.size);
+    auto& head                           = m_freeHeads[firstLevel][secondLevel];
+
+    if (block.previousFree != invalidBlock)
+        m_blocks[block.previousFree].nextFree = block.nextFree;
+    if (block.nextFree != invalidBlock)
+        m_blocks[block.nextFree].previousFree = block.previousFree;
 
-    for (Node* node = m_head; node != nullptr; node = node->next)
-        totalSpace += node->size;
+    if (head == index) {
+        head = block.nextFree;
 
-    return totalSpace;
+        if (head == invalidBlock) {
+            m_secondLevelBitmaps[firstLevel] &= ~(1u << secondLevel);
+            if (m_secondLevelBitmaps[firstLevel] == 0u)
+                m_firstLevelBitmap &= ~(1ull << firstLevel);
+        }
+    }
+
+    block.isFree       = false;
+    block.previousFree = invalidBlock;
+    block.nextFree     = invalidBlock;
 }
 
-void FreeList::clear() {
-    for (u64 i = 0; i < m_maxEntries; ++i) m_nodes[i].invalidate();
+FreeList::BlockIndex FreeList::split(BlockIndex index, u64 size) {
+    // createBlock may reallocate the storage, don't keep references across it
+    const auto remainderIndex =
+      createBlock(m_blocks[index].offset + size, m_blocks[index].size - size);
+
+    auto& block     = m_blocks[index];
+    auto& remainder = m_blocks[remainderIndex];
 
-    m_head->offset = 0;
-    m_head->size   = m_totalSize;
-    m_head->next   = nullptr;
+    remainder.previousPhysical = index;
+    remainder.nextPhysical     = block.nextPhysical;
+
+    if (block.nextPhysical != invalidBlock)
+        m_blocks[block.nextPhysical].previousPhysical = remainderIndex;
+    else
+        m_lastPhysical = remainderIndex;
+
+    block.nextPhysical = remainderIndex;
+    block.size         = size;
+
+    return remainderIndex;
 }
 
-FreeList::Node* FreeList::getFreeNode() {
-    for (u64 i = 0; i < m_maxEntries; ++i)
-        if (m_nodes[i].offset == invalidId) return &m_nodes[i];
-    return nullptr;
+FreeList::BlockIndex FreeList::mergeWithNeighbours(BlockIndex index) {
+    const auto absorbNext = [&](BlockIndex target) {
+        auto& block     = m_blocks[target];
+        const auto next = block.nextPhysical;
+
+        block.size += m_blocks[next].size;
+        block.nextPhysical = m_blocks[next].nextPhysical;
+
+        if (block.nextPhysical != invalidBlock)
+            m_blocks[block.nextPhysical].previousPhysical = target;
+        else
+            m_lastPhysical = target;
+
+        releaseBlock(next);
+    };
+
+    if (const auto previous = m_blocks[index].previousPhysical;
+        previous != invalidBlock && m_blocks[previous].isFree) {
+        removeFreeBlock(previous);
+        absorbNext(previous);
+        index = previous;
+    }
+
+    if (const auto next = m_blocks[index].nextPhysical;
+        next != invalidBlock && m_blocks[next].isFree) {
+        removeFreeBlock(next);
+        absorbNext(index);
+    }
+
+    return index;
 }
 
 }  // namespace sl
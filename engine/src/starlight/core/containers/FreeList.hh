@@ -3,21 +3,47 @@
 #include <vector>
 #include <cstdint>
 #include <optional>
+#include <limits>
+#include <array>
+#include <unordered_map>
 
 #include "starlight/core/Core.hh"
 #include "starlight/core/Log.hh"
 
 namespace sl {
 
+/*
+    Two-level segregated fit (TLSF) allocator of offsets within a linear range,
+    block metadata is kept outside of the managed range so it can be used for
+    memory that is not directly addressable (e.g. gpu buffers). Allocation and
+    freeing are O(1).
+*/
 class FreeList {
-    struct Node {
-        explicit Node();
+    using BlockIndex = u32;
 
-        void invalidate();
+    static constexpr BlockIndex invalidBlock = std::numeric_limits<u32>::max();
+
+    static constexpr u64 secondLevelBits  = 5u;
+    static constexpr u64 secondLevelCount = 1u << secondLevelBits;
+    static constexpr u64 firstLevelCount  = 64u - secondLevelBits + 1u;
+    static constexpr u64 smallBlockSize   = secondLevelCount;
+
+    struct Block {
+        explicit Block(u64 offset, u64 size);
 
         u64 offset;
         u64 size;
-        Node* next;
+        bool isFree;
+
+        BlockIndex previousPhysical;
+        BlockIndex nextPhysical;
+        BlockIndex previousFree;
+        BlockIndex nextFree;
+    };
+
+    struct Mapping {
+        u64 firstLevel;
+        u64 secondLevel;
     };
 
 public:
@@ -25,21 +51,44 @@ public:
 
     void freeBlock(u64 size, u64 offset);
 
-    std::optional<u64> allocateBlock(u64 size);
-    u64 spaceLeft();
+    std::optional<u64> allocateBlock(u64 size, u64 alignment = 1u);
+    // lowest free space ending at or before the limit, for compaction, O(blocks)
+    std::optional<u64> allocateBlockBelow(u64 size, u64 limit, u64 alignment = 1u);
+    u64 spaceLeft() const;
+    u64 getSize() const;
 
     void resize(u64 newSize);
 
     void clear();
 
 private:
-    Node* getFreeNode();
+    static Mapping mapInsert(u64 size);
+    static Mapping mapSearch(u64 size);
+
+    BlockIndex findSuitableBlock(u64 size, u64 alignment);
+    u64 takeBlock(BlockIndex index, u64 size, u64 alignment);
+    BlockIndex createBlock(u64 offset, u64 size);
+    void releaseBlock(BlockIndex index);
+
+    void insertFreeBlock(BlockIndex index);
+    void removeFreeBlock(BlockIndex index);
+
+    BlockIndex split(BlockIndex index, u64 size);
+    BlockIndex mergeWithNeighbours(BlockIndex index);
 
     u64 m_totalSize;
-    u64 m_maxEntries;
+    u64 m_freeSpace;
+
+    std::vector<Block> m_blocks;
+    std::vector<BlockIndex> m_unusedBlocks;
+    std::unordered_map<u64, BlockIndex> m_allocatedBlocks;
+
+    BlockIndex m_lastPhysical;
 
-    std::vector<Node> m_nodes;
-    Node* m_head;
+    u64 m_firstLevelBitmap;
+    std::array<u32, firstLevelCount> m_secondLevelBitmaps;
+    std::array<std::array<BlockIndex, secondLevelCount>, firstLevelCount>
+      m_freeHeads;
 };
 
 }  // namespace sl
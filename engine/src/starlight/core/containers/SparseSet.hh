@@ -0,0 +1,144 @@
+#pragma once
+
+#include <vector>
+#include <span>
+#include <memory>
+#include <optional>
+#include <limits>
+
+#include "starlight/core/Core.hh"
+#include "starlight/core/Log.hh"
+#include "starlight/core/Concepts.hh"
+
+namespace sl {
+
+/*
+    Dense array of values with a sparse index, keys are split into index (low 32
+    bits) and generation (high 32 bits), a key with a stale generation is treated as
+    not present. Lookup is O(1), removal swaps the last value into the hole. Values
+    are kept contiguous for iteration, so both growth and removal move them:
+    references, pointers and dense indices are valid only until the next emplace or
+    erase, anything kept longer has to hold the key instead.
+*/
+template <typename T>
+requires std::is_move_constructible_v<T>
+class SparseSet {
+    using DenseIndex = u32;
+
+    static constexpr DenseIndex invalidIndex = std::numeric_limits<u32>::max();
+    static constexpr u64 indexBits           = 32u;
+    static constexpr u64 indexMask           = (1ull << indexBits) - 1u;
+
+    struct SparseEntry {
+        DenseIndex denseIndex = invalidIndex;
+        u32 generation        = 0u;
+    };
+
+public:
+    using Key = u64;
+
+    static constexpr u32 getIndex(Key key) { return key & indexMask; }
+    static constexpr u32 getGeneration(Key key) { return key >> indexBits; }
+
+    explicit SparseSet(u64 capacity = 0u) { reserve(capacity); }
+
+    void reserve(u64 capacity) {
+        m_keys.reserve(capacity);
+        m_values.reserve(capacity);
+    }
+
+    template <typename... Args>
+    requires std::is_constructible_v<T, Args...>
+    T& emplace(Key key, Args&&... args) {
+        log::expect(not has(key), "Key {} already present in sparse set", key);
+
+        const auto index = getIndex(key);
+        if (index >= m_sparse.size()) m_sparse.resize(index + 1u);
+
+        m_sparse[index] = SparseEntry{
+            .denseIndex = static_cast<DenseIndex>(m_values.size()),
+            .generation = getGeneration(key),
+        };
+
+        m_keys.push_back(key);
+        return m_values.emplace_back(std::forward<Args>(args)...);
+    }
+
+    bool has(Key key) const {
+        const auto index = getIndex(key);
+        return index < m_sparse.size()
+               && m_sparse[index].denseIndex != invalidIndex
+               && m_sparse[index].generation == getGeneration(key);
+    }
+
+    T* find(Key key) {
+        return has(key) ? &m_values[m_sparse[getIndex(key)].denseIndex] : nullptr;
+    }
+
+    std::optional<u32> findDenseIndex(Key key) const {
+        if (has(key)) return m_sparse[getIndex(key)].denseIndex;
+        return {};
+    }
+
+    T& get(Key key) {
+        auto value = find(key);
+        log::expect(value != nullptr, "Key {} not found in sparse set", key);
+        return *value;
+    }
+
+    bool erase(Key key) {
+        if (not has(key)) return false;
+
+        auto& entry           = m_sparse[getIndex(key)];
+        const auto denseIndex = entry.denseIndex;
+        entry.denseIndex      = invalidIndex;
+
+        if (denseIndex != m_values.size() - 1u) {
+            const auto movedKey = m_keys.back();
+
+            // values don't have to be assignable, replace the hole in place
+            std::destroy_at(&m_values[denseIndex]);
+            std::construct_at(&m_values[denseIndex], std::move(m_values.back()));
+
+            m_keys[denseIndex]                      = movedKey;
+            m_sparse[getIndex(movedKey)].denseIndex = denseIndex;
+        }
+
+        m_values.pop_back();
+        m_keys.pop_back();
+
+        return true;
+    }
+
+    void clear() {
+        m_sparse.clear();
+        m_keys.clear();
+        m_values.clear();
+    }
+
+    u64 size() const { return m_values.size(); }
+    bool empty() const { return m_values.empty(); }
+
+    std::span<T> values() { return m_values; }
+    std::span<const T> values() const { return m_values; }
+    std::span<const Key> keys() const { return m_keys; }
+
+    template <typename C>
+    requires Callable<C, void, T&>
+    void forEach(C&& callback) {
+        for (auto& value : m_values) callback(value);
+    }
+
+    template <typename C>
+    requires Callable<C, void, const Key&, T&>
+    void forEach(C&& callback) {
+        for (u64 i = 0; i < m_values.size(); ++i) callback(m_keys[i], m_values[i]);
+    }
+
+private:
+    std::vector<SparseEntry> m_sparse;
+    std::vector<Key> m_keys;
+    std::vector<T> m_values;
+};
+
+}  // namespace sl
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <optional>
+#include <type_traits>
+
+#include "starlight/core/Core.hh"
+
+namespace sl {
+
+/*
+    Fixed capacity Chase-Lev deque. The owning thread pushes and pops at the bottom
+    (LIFO), any other thread may steal from the top (FIFO). Values have to be
+    trivially copyable, in practice pointers to jobs.
+*/
+template <typename T, u64 Capacity>
+requires(std::is_trivially_copyable_v<T> && (Capacity & (Capacity - 1)) == 0)
+class WorkStealingQueue : public NonMovable {
+    static constexpr i64 mask = Capacity - 1;
+
+public:
+    explicit WorkStealingQueue() : m_top(0), m_bottom(0) {}
+
+    // owner only, returns false if the queue is full
+    bool push(T value) {
+        const auto bottom = m_bottom.load(std::memory_order_relaxed);
+        const auto top    = m_top.load(std::memory_order_acquire);
+
+        if (bottom - top >= static_cast<i64>(Capacity)) return false;
+
+        m_buffer[bottom & mask].store(value, std::memory_order_relaxed);
+        m_bottom.store(bottom + 1, std::memory_order_seq_cst);
+        return true;
+    }
+
+    // owner only
+    std::optional<T> pop() {
+        const auto bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        m_bottom.store(bottom, std::memory_order_seq_cst);
+
+        auto top = m_top.load(std::memory_order_seq_cst);
+
+        if (top > bottom) {
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return {};
+        }
+
+        const auto value = m_buffer[bottom & mask].load(std::memory_order_relaxed);
+        if (top == bottom) {
+            // last element, race with thieves for it
+            const bool won = m_top.compare_exchange_strong(
+              top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed
+            );
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            if (not won) return {};
+        }
+        return value;
+    }
+
+    // any thread
+    std::optional<T> steal() {
+        auto top          = m_top.load(std::memory_order_seq_cst);
+        const auto bottom = m_bottom.load(std::memory_order_seq_cst);
+
+        if (top >= bottom) return {};
+
+        const auto value = m_buffer[top & mask].load(std::memory_order_relaxed);
+        if (not m_top.compare_exchange_strong(
+              top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed
+            ))
+            return {};
+
+        return value;
+    }
+
+    u64 size() const {
+        const auto bottom = m_bottom.load(std::memory_order_relaxed);
+        const auto top    = m_top.load(std::memory_order_relaxed);
+        return bottom > top ? bottom - top : 0u;
+    }
+
+    bool empty() const { return size() == 0u; }
+
+private:
+    alignas(64) std::atomic<i64> m_top;
+    alignas(64) std::atomic<i64> m_bottom;
+    std::array<std::atomic<T>, Capacity> m_buffer;
+};
+
+}  // namespace sl
@@ -0,0 +1,501 @@
+#include "BoundingVolumeHierarchy.hh"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace sl {
+
+namespace {
+
+constexpr u32 binCount = 16u;
+// deeper than this the build falls back to median splits, which bounds the
+// height even for degenerate inputs: 30 more levels hold 2^32 primitives
+constexpr u32 maxSahDepth = 32u;
+
+constexpr f32 infinity = std::numeric_limits<f32>::infinity();
+
+constexpr Aabb emptyBox() {
+    return Aabb{
+        .min = { infinity, infinity, infinity },
+        .max = { -infinity, -infinity, -infinity },
+    };
+}
+
+// selects on values instead of std::min references, so it compiles to minss and
+// maxss rather than branches that mispredict on unsorted input
+void grow(Aabb& box, const Aabb& other) {
+    for (u32 axis = 0; axis < 3u; ++axis) {
+        const auto min = other.min[axis], max = other.max[axis];
+        box.min[axis]  = min < box.min[axis] ? min : box.min[axis];
+        box.max[axis]  = max > box.max[axis] ? max : box.max[axis];
+    }
+}
+
+Aabb merge(const Aabb& lhs, const Aabb& rhs) {
+    auto box = lhs;
+    grow(box, rhs);
+    return box;
+}
+
+f32 surfaceArea(const Aabb& box) {
+    const auto x = box.max[0] - box.min[0];
+    const auto y = box.max[1] - box.min[1];
+    const auto z = box.max[2] - box.min[2];
+    // empty boxes have negative sizes
+    if (x < 0.0f || y < 0.0f || z < 0.0f) return 0.0f;
+    return 2.0f * (x * y + y * z + z * x);
+}
+
+// entry distance of the ray into the box, if it hits within the given range
+std::optional<f32> intersect(
+  const Aabb& box, const f32* origin, const f32* inverseDirection, f32 maxDistance
+) {
+    auto enter = 0.0f;
+    auto leave = maxDistance;
+
+    for (u32 axis = 0; axis < 3u; ++axis) {
+        const auto t0 = (box.min[axis] - origin[axis]) * inverseDirection[axis];
+        const auto t1 = (box.max[axis] - origin[axis]) * inverseDirection[axis];
+
+        enter = std::max(enter, std::min(t0, t1));
+        leave = std::min(leave, std::max(t0, t1));
+    }
+
+    if (enter > leave) return {};
+    return enter;
+}
+
+}  // namespace
+
+void BoundingVolumeHierarchy::build(std::span<const Aabb> boxes) {
+    const auto count = static_cast<u32>(boxes.size());
+
+    m_nodes.clear();
+    m_primitives.resize(count);
+
+    if (count == 0u) {
+        m_boxes.clear();
+        m_heights.clear();
+        m_cost      = 0.0f;
+        m_builtCost = 0.0f;
+        return;
+    }
+
+    std::vector<BuildPrimitive> primitives(count);
+    for (u32 i = 0; i < count; ++i) {
+        primitives[i].box = boxes[i];
+        primitives[i].id  = i;
+        for (u32 axis = 0; axis < 3u; ++axis) {
+            primitives[i].centroid[axis] =
+              (boxes[i].min[axis] + boxes[i].max[axis]) * 0.5f;
+        }
+    }
+
+    m_nodes.reserve(2u * count / maxLeafSize + 1u);
+    m_nodes.push_back(Node{ .bounds = emptyBox(), .first = 0u, .count = count });
+
+    std::vector<std::pair<u32, u32>> pending{
+        { 0u, 0u }
+    };
+
+    while (not pending.empty()) {
+        const auto [index, depth] = pending.back();
+        pending.pop_back();
+
+        if (split(index, depth, primitives)) {
+            const auto first = m_nodes[index].first;
+            pending.emplace_back(first + 1u, depth + 1u);
+            pending.emplace_back(first, depth + 1u);
+        }
+    }
+
+    for (u32 i = 0; i < count; ++i) m_primitives[i] = primitives[i].id;
+
+    m_boxes.resize(count);
+    m_heights.resize(m_nodes.size());
+    refit(boxes);
+    m_builtCost = m_cost;
+}
+
+bool BoundingVolumeHierarchy::split(
+  u32 index, u32 depth, std::span<BuildPrimitive> allPrimitives
+) {
+    const auto first = m_nodes[index].first;
+    const auto count = m_nodes[index].count;
+
+    if (count <= maxLeafSize) return false;
+
+    const auto primitives = allPrimitives.subspan(first, count);
+
+    auto bounds         = emptyBox();
+    auto centroidBounds = emptyBox();
+    for (const auto& primitive : primitives) {
+        grow(bounds, primitive.box);
+        const auto& centroid = primitive.centroid;
+        grow(
+          centroidBounds,
+          Aabb{
+            .min = { centroid[0], centroid[1], centroid[2] },
+            .max = { centroid[0], centroid[1], centroid[2] },
+          }
+        );
+    }
+
+    auto bestAxis = 0u;
+    auto bestBin  = 0u;
+    auto bestCost = infinity;
+
+    std::array<f32, 3> binScales{};
+    for (u32 axis = 0; axis < 3u; ++axis) {
+        const auto extent = centroidBounds.max[axis] - centroidBounds.min[axis];
+        binScales[axis]   = extent > 0.0f ? binCount / extent : 0.0f;
+    }
+
+    const auto binOf = [&](const BuildPrimitive& primitive, u32 axis) {
+        const auto offset = primitive.centroid[axis] - centroidBounds.min[axis];
+        const auto bin    = static_cast<u32>(offset * binScales[axis]);
+        return std::min(bin, binCount - 1u);
+    };
+
+    if (depth < maxSahDepth) {
+        // all three axes binned in a single pass over the primitives
+        std::array<std::array<Aabb, binCount>, 3> binBounds;
+        std::array<std::array<u32, binCount>, 3> binCounts{};
+        for (auto& axisBounds : binBounds) axisBounds.fill(emptyBox());
+
+        for (const auto& primitive : primitives) {
+            for (u32 axis = 0; axis < 3u; ++axis) {
+                const auto bin = binOf(primitive, axis);
+                grow(binBounds[axis][bin], primitive.box);
+                ++binCounts[axis][bin];
+            }
+        }
+
+        for (u32 axis = 0; axis < 3u; ++axis) {
+            if (binScales[axis] == 0.0f) continue;
+
+            const auto& axisBounds = binBounds[axis];
+            const auto& axisCounts = binCounts[axis];
+
+            // sweep from the right to get the cost of every right hand side
+            std::array<f32, binCount> rightCosts{};
+            auto right     = emptyBox();
+            u32 rightCount = 0u;
+            for (u32 bin = binCount - 1u; bin > 0u; --bin) {
+                grow(right, axisBounds[bin]);
+                rightCount += axisCounts[bin];
+                rightCosts[bin - 1u] = surfaceArea(right) * rightCount;
+            }
+
+            auto left     = emptyBox();
+            u32 leftCount = 0u;
+            for (u32 bin = 0; bin < binCount - 1u; ++bin) {
+                grow(left, axisBounds[bin]);
+                leftCount += axisCounts[bin];
+                if (leftCount == 0u || leftCount == count) continue;
+
+                const auto cost = surfaceArea(left) * leftCount + rightCosts[bin];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin  = bin;
+                }
+            }
+        }
+    }
+
+    u32 leftCount = 0u;
+
+    if (bestCost < infinity) {
+        // not worth splitting when a leaf is cheaper, as long as it stays small
+        const auto leafCost = surfaceArea(bounds) * count;
+        if (bestCost >= leafCost && count <= 4u * maxLeafSize) return false;
+
+        const auto middle = std::partition(
+          primitives.begin(), primitives.end(),
+          [&](const auto& primitive) {
+              return binOf(primitive, bestAxis) <= bestBin;
+          }
+        );
+        leftCount = static_cast<u32>(middle - primitives.begin());
+    } else {
+        // coincident centroids or too deep, halve along the widest axis
+        u32 axis = 0u;
+        for (u32 i = 1; i < 3u; ++i) {
+            if (centroidBounds.max[i] - centroidBounds.min[i]
+                > centroidBounds.max[axis] - centroidBounds.min[axis])
+                axis = i;
+        }
+
+        leftCount = count / 2u;
+        std::nth_element(
+          primitives.begin(), primitives.begin() + leftCount, primitives.end(),
+          [&](const auto& lhs, const auto& rhs) {
+              return lhs.centroid[axis] < rhs.centroid[axis];
+          }
+        );
+    }
+
+    const auto children = static_cast<u32>(m_nodes.size());
+    m_nodes.push_back(
+      Node{ .bounds = emptyBox(), .first = first, .count = leftCount }
+    );
+    m_nodes.push_back(Node{
+      .bounds = emptyBox(),
+      .first  = first + leftCount,
+      .count  = count - leftCount,
+    });
+
+    m_nodes[index].first = children;
+    m_nodes[index].count = 0u;
+    return true;
+}
+
+void BoundingVolumeHierarchy::refit(std::span<const Aabb> boxes) {
+    if (m_nodes.empty()) return;
+
+    for (u64 i = 0; i < m_primitives.size(); ++i)
+        m_boxes[i] = boxes[m_primitives[i]];
+
+    struct Visit {
+        u32 index;
+        u32 depth;
+        bool childrenDone;
+    };
+
+    // post order, children are final before their parent gets rotated and merged;
+    // every level keeps its parent and at most one sibling on the stack
+    std::array<Visit, 2u * maxDepth> stack;
+    u32 size      = 0u;
+    stack[size++] = Visit{ .index = 0u, .depth = 0u, .childrenDone = false };
+
+    while (size > 0u) {
+        const auto [index, depth, childrenDone] = stack[--size];
+
+        auto& node = m_nodes[index];
+
+        if (node.isLeaf()) {
+            updateLeaf(node);
+            m_heights[index] = 0u;
+        } else if (not childrenDone) {
+            stack[size++] = Visit{ index, depth, true };
+            stack[size++] = Visit{ node.first + 1u, depth + 1u, false };
+            stack[size++] = Visit{ node.first, depth + 1u, false };
+        } else {
+            rotate(index, depth);
+            node.bounds =
+              merge(m_nodes[node.first].bounds, m_nodes[node.first + 1u].bounds);
+            m_heights[index] =
+              1u + std::max(m_heights[node.first], m_heights[node.first + 1u]);
+        }
+    }
+
+    m_cost = computeCost();
+}
+
+void BoundingVolumeHierarchy::updateLeaf(Node& node) const {
+    node.bounds = emptyBox();
+    for (u32 i = node.first; i < node.first + node.count; ++i)
+        grow(node.bounds, m_boxes[i]);
+}
+
+void BoundingVolumeHierarchy::rotate(u32 index, u32 depth) {
+    // Kensler's tree rotations: swap a child with one of its sibling's children
+    // when that shrinks the sibling, the node itself keeps the same bounds
+    const auto leftIndex  = m_nodes[index].first;
+    const auto rightIndex = leftIndex + 1u;
+
+    auto bestGain      = 0.0f;
+    u32 bestChild      = 0u;
+    u32 bestGrandchild = 0u;
+
+    const std::array<std::pair<u32, u32>, 2> pairs{
+        std::pair{ leftIndex, rightIndex },
+        std::pair{ rightIndex, leftIndex },
+    };
+
+    for (const auto& [child, sibling] : pairs) {
+        const auto& siblingNode = m_nodes[sibling];
+        if (siblingNode.isLeaf()) continue;
+
+        const auto siblingArea = surfaceArea(siblingNode.bounds);
+
+        for (u32 i = 0; i < 2u; ++i) {
+            const auto grandchild = siblingNode.first + i;
+            const auto other      = siblingNode.first + 1u - i;
+
+            // the sibling would then hold the child and its other child
+            const auto rotatedArea =
+              surfaceArea(merge(m_nodes[child].bounds, m_nodes[other].bounds));
+            const auto gain = siblingArea - rotatedArea;
+
+            // the child moves a level down, which must not outgrow maxDepth
+            const auto siblingHeight =
+              1u + std::max(m_heights[child], m_heights[other]);
+            const auto height =
+              1u + std::max<u32>(m_heights[grandchild], siblingHeight);
+            if (depth + height >= maxDepth) continue;
+
+            if (gain > bestGain) {
+                bestGain       = gain;
+                bestChild      = child;
+                bestGrandchild = grandchild;
+            }
+        }
+    }
+
+    if (bestGain <= 0.0f) return;
+
+    std::swap(m_nodes[bestChild], m_nodes[bestGrandchild]);
+    std::swap(m_heights[bestChild], m_heights[bestGrandchild]);
+
+    const auto sibling = bestChild == leftIndex ? rightIndex : leftIndex;
+    auto& siblingNode  = m_nodes[sibling];
+    siblingNode.bounds = merge(
+      m_nodes[siblingNode.first].bounds, m_nodes[siblingNode.first + 1u].bounds
+    );
+    m_heights[sibling] = 1u + std::max(
+                                m_heights[siblingNode.first],
+                                m_heights[siblingNode.first + 1u]
+                              );
+}
+
+std::optional<RayHit> BoundingVolumeHierarchy::castRay(const Ray& ray) const {
+    if (m_nodes.empty()) return {};
+
+    // divisions by zero give infinities, which the slab test handles
+    f32 inverseDirection[3];
+    for (u32 axis = 0; axis < 3u; ++axis)
+        inverseDirection[axis] = 1.0f / ray.direction[axis];
+
+    std::optional<RayHit> closest;
+    auto maxDistance = ray.maxDistance;
+
+    std::array<std::pair<u32, f32>, maxDepth + 1u> stack;
+    u32 size = 0u;
+    if (const auto distance =
+          intersect(m_nodes[0].bounds, ray.origin, inverseDirection, maxDistance))
+        stack[size++] = { 0u, *distance };
+
+    while (size > 0u) {
+        const auto [index, entry] = stack[--size];
+
+        // something closer was found since this node got pushed
+        if (entry > maxDistance) continue;
+
+        const auto& node = m_nodes[index];
+
+        if (node.isLeaf()) {
+            for (u32 i = node.first; i < node.first + node.count; ++i) {
+                const auto distance =
+                  intersect(m_boxes[i], ray.origin, inverseDirection, maxDistance);
+                if (distance && (not closest || *distance < closest->distance)) {
+                    closest = RayHit{
+                        .primitive = m_primitives[i],
+                        .distance  = *distance,
+                    };
+                    maxDistance = *distance;
+                }
+            }
+            continue;
+        }
+
+        const auto left = intersect(
+          m_nodes[node.first].bounds, ray.origin, inverseDirection, maxDistance
+        );
+        const auto right = intersect(
+          m_nodes[node.first + 1u].bounds, ray.origin, inverseDirection, maxDistance
+        );
+
+        // the closer child goes on top so it is visited first
+        if (left && right) {
+            const auto leftFirst = *left <= *right;
+            const auto nearest   = leftFirst ? node.first : node.first + 1u;
+            const auto farthest  = leftFirst ? node.first + 1u : node.first;
+
+            stack[size++] = { farthest, leftFirst ? *right : *left };
+            stack[size++] = { nearest, leftFirst ? *left : *right };
+        } else if (left) {
+            stack[size++] = { node.first, *left };
+        } else if (right) {
+            stack[size++] = { node.first + 1u, *right };
+        }
+    }
+
+    return closest;
+}
+
+u64 BoundingVolumeHierarchy::getPrimitiveCount() const {
+    return m_primitives.size();
+}
+
+u64 BoundingVolumeHierarchy::getNodeCount() const { return m_nodes.size(); }
+
+u32 BoundingVolumeHierarchy::getHeight() const {
+    return m_heights.empty() ? 0u : m_heights[0];
+}
+
+f32 BoundingVolumeHierarchy::getCost() const { return m_cost; }
+
+bool BoundingVolumeHierarchy::needsRebuild() const {
+    return m_cost > m_builtCost * rebuildThreshold;
+}
+
+f32 BoundingVolumeHierarchy::computeCost() const {
+    if (m_nodes.empty()) return 0.0f;
+
+    auto cost = 0.0f;
+    for (const auto& node : m_nodes) {
+        const auto area = surfaceArea(node.bounds);
+        cost += node.isLeaf() ? area * node.count : area;
+    }
+
+    const auto rootArea = surfaceArea(m_nodes[0].bounds);
+    return rootArea > 0.0f ? cost / rootArea : cost;
+}
+
+BoundingVolumeHierarchy::Overlap BoundingVolumeHierarchy::testFrustum(
+  const FrustumPlanes& planes, const Aabb& box
+) {
+    auto overlap = Overlap::inside;
+
+    for (const auto& plane : planes) {
+        const auto distance =
+          plane.a * (box.min[0] + box.max[0]) + plane.b * (box.min[1] + box.max[1])
+          + plane.c * (box.min[2] + box.max[2]);
+        const auto radius = std::abs(plane.a) * (box.max[0] - box.min[0])
+                            + std::abs(plane.b) * (box.max[1] - box.min[1])
+                            + std::abs(plane.c) * (box.max[2] - box.min[2]);
+
+        // both doubled, the plane offset has to be as well
+        const auto center = distance + 2.0f * plane.d;
+
+        if (not(center + radius >= 0.0f)) return Overlap::outside;
+        if (center - radius < 0.0f) overlap = Overlap::partial;
+    }
+    return overlap;
+}
+
+bool BoundingVolumeHierarchy::overlaps(const Aabb& lhs, const Aabb& rhs) {
+    for (u32 axis = 0; axis < 3u; ++axis) {
+        if (lhs.max[axis] < rhs.min[axis] || rhs.max[axis] < lhs.min[axis])
+            return false;
+    }
+    return true;
+}
+
+f32 BoundingVolumeHierarchy::distanceSquared(const Aabb& box, const f32* point) {
+    auto distance = 0.0f;
+    for (u32 axis = 0; axis < 3u; ++axis) {
+        const auto delta = std::max(
+          { box.min[axis] - point[axis], 0.0f, point[axis] - box.max[axis] }
+        );
+        distance += delta * delta;
+    }
+    return distance;
+}
+
+}  // namespace sl
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <array>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "starlight/core/Core.hh"
+#include "starlight/core/Concepts.hh"
+
+#include "Culling.hh"
+
+namespace sl {
+
+struct Aabb {
+    f32 min[3];
+    f32 max[3];
+};
+
+struct Ray {
+    f32 origin[3];
+    f32 direction[3];
+    f32 maxDistance;
+};
+
+struct RayHit {
+    u32 primitive;
+    f32 distance;
+};
+
+/*
+    Bounding volume hierarchy over world space boxes, built top down with the binned
+    surface area heuristic. When the boxes move refit() recomputes the bounds bottom
+    up and applies the tree rotations that shrink them, so a scene in motion keeps a
+    usable tree without rebuilding every frame. Rotations only fix local damage,
+    needsRebuild() tells when the tree got too far from its built quality; adding
+    or removing primitives needs a new build() as well. Queries report primitive
+    indices, that is positions in the span given to build(). Neither queries nor
+    refit() allocate, both walk the tree with fixed size stacks as build() and the
+    rotations keep the depth within maxDepth.
+*/
+class BoundingVolumeHierarchy {
+    enum class Overlap : u8 { outside, partial, inside };
+
+public:
+    static constexpr u32 maxLeafSize = 4u;
+    // refitted trees costing more than this times the built one ask for a rebuild
+    static constexpr f32 rebuildThreshold = 2.0f;
+    static constexpr u32 maxDepth         = 64u;
+
+    void build(std::span<const Aabb> boxes);
+    // boxes are expected in the same order and count as in the last build()
+    void refit(std::span<const Aabb> boxes);
+
+    template <typename C>
+    requires Callable<C, void, u32>
+    void queryFrustum(const FrustumPlanes& planes, C&& callback) const {
+        traverse(
+          [&](const Aabb& box) { return testFrustum(planes, box); },
+          std::forward<C>(callback)
+        );
+    }
+
+    template <typename C>
+    requires Callable<C, void, u32>
+    void queryBox(const Aabb& query, C&& callback) const {
+        traverse(
+          [&](const Aabb& box) {
+              return overlaps(query, box) ? Overlap::partial : Overlap::outside;
+          },
+          std::forward<C>(callback)
+        );
+    }
+
+    template <typename C>
+    requires Callable<C, void, u32>
+    void querySphere(const f32* center, f32 radius, C&& callback) const {
+        traverse(
+          [&](const Aabb& box) {
+              return distanceSquared(box, center) <= radius * radius
+                       ? Overlap::partial
+                       : Overlap::outside;
+          },
+          std::forward<C>(callback)
+        );
+    }
+
+    // closest primitive whose box is hit by the ray
+    std::optional<RayHit> castRay(const Ray& ray) const;
+
+    u64 getPrimitiveCount() const;
+    u64 getNodeCount() const;
+    // edges from the root to the deepest leaf
+    u32 getHeight() const;
+    // surface area heuristic cost of the whole tree, relative to the root area
+    f32 getCost() const;
+    bool needsRebuild() const;
+
+private:
+    struct Node {
+        bool isLeaf() const { return count != 0u; }
+
+        Aabb bounds;
+        // inner nodes store their first child, the second one follows it,
+        // leaves the first of their primitives
+        u32 first;
+        u32 count;
+    };
+
+    // build input kept together so partitioning moves through memory linearly
+    struct BuildPrimitive {
+        Aabb box;
+        f32 centroid[3];
+        u32 id;
+    };
+
+    static Overlap testFrustum(const FrustumPlanes& planes, const Aabb& box);
+    static bool overlaps(const Aabb& lhs, const Aabb& rhs);
+    static f32 distanceSquared(const Aabb& box, const f32* point);
+
+    template <typename Test, typename C>
+    void traverse(Test&& test, C&& callback) const {
+        if (m_nodes.empty()) return;
+
+        // every level leaves at most one sibling behind
+        std::array<u32, maxDepth + 1u> stack;
+        u32 size      = 0u;
+        stack[size++] = 0u;
+
+        while (size > 0u) {
+            const auto& node = m_nodes[stack[--size]];
+
+            const auto overlap = test(node.bounds);
+            if (overlap == Overlap::outside) continue;
+
+            if (overlap == Overlap::inside) {
+                reportSubtree(node, callback);
+            } else if (node.isLeaf()) {
+                for (u32 i = node.first; i < node.first + node.count; ++i) {
+                    if (test(m_boxes[i]) != Overlap::outside)
+                        callback(m_primitives[i]);
+                }
+            } else {
+                stack[size++] = node.first + 1u;
+                stack[size++] = node.first;
+            }
+        }
+    }
+
+    template <typename C> void reportSubtree(const Node& root, C&& callback) const {
+        std::array<const Node*, maxDepth + 1u> stack;
+        u32 size      = 0u;
+        stack[size++] = &root;
+
+        while (size > 0u) {
+            const auto node = stack[--size];
+
+            if (node->isLeaf()) {
+                for (u32 i = node->first; i < node->first + node->count; ++i)
+                    callback(m_primitives[i]);
+            } else {
+                stack[size++] = &m_nodes[node->first + 1u];
+                stack[size++] = &m_nodes[node->first];
+            }
+        }
+    }
+
+    bool split(u32 index, u32 depth, std::span<BuildPrimitive> primitives);
+    void updateLeaf(Node& node) const;
+    void rotate(u32 index, u32 depth);
+    f32 computeCost() const;
+
+    std::vector<Node> m_nodes;
+    // primitive ids and their boxes, ordered so every leaf owns a contiguous range
+    std::vector<u32> m_primitives;
+    std::vector<Aabb> m_boxes;
+    // per node, height of its subtree, so rotations can't grow the tree too deep
+    std::vector<u8> m_heights;
+
+    f32 m_cost      = 0.0f;
+    f32 m_builtCost = 0.0f;
+};
+
+}  // namespace sl
@@ -12,6 +12,7 @@
 namespace sl {
 
 const Mat4<f32> identityMatrix = Mat4<f32>{ 1.0f };
+const Quat<f32> identityQuat   = Quat<f32>{ 1.0f, 0.0f, 0.0f, 0.0f };  // w, x, y, z
 const float pi                 = std::numbers::pi_v<float>;
 
 template <typename T> constexpr u64 getSize() { return 0u; }
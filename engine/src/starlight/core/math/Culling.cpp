@@ -0,0 +1,189 @@
+#include "Culling.hh"
+
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define SL_CULLING_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SL_CULLING_SSE 1
+#endif
+
+namespace sl {
+
+namespace {
+
+Plane normalize(Plane plane) {
+    const auto length =
+      std::sqrt(plane.a * plane.a + plane.b * plane.b + plane.c * plane.c);
+    return Plane{
+        .a = plane.a / length,
+        .b = plane.b / length,
+        .c = plane.c / length,
+        .d = plane.d / length,
+    };
+}
+
+bool isBoxVisible(const FrustumPlanes& planes, const BoxesView& boxes, u64 i) {
+    for (const auto& plane : planes) {
+        // summed in the same order as the SIMD path, so both give equal results
+        const auto distance =
+          (plane.a * boxes.centerX[i] + plane.b * boxes.centerY[i])
+          + (plane.c * boxes.centerZ[i] + plane.d);
+        const auto radius = (std::abs(plane.a) * boxes.extentX[i]
+                             + std::abs(plane.b) * boxes.extentY[i])
+                            + std::abs(plane.c) * boxes.extentZ[i];
+
+        // written this way so NaNs are culled, same as the SIMD comparison
+        if (not(distance + radius >= 0.0f)) return false;
+    }
+    return true;
+}
+
+void cullTail(
+  const FrustumPlanes& planes, const BoxesView& boxes, u8* visible, u64 begin
+) {
+    for (u64 i = begin; i < boxes.count; ++i)
+        visible[i] = isBoxVisible(planes, boxes, i) ? 1u : 0u;
+}
+
+#if defined(SL_CULLING_AVX)
+
+constexpr u64 batchSize = 8;
+
+void cullBatches(const FrustumPlanes& planes, const BoxesView& boxes, u8* visible) {
+    const auto signMask = _mm256_set1_ps(-0.0f);
+    const auto zero     = _mm256_setzero_ps();
+    const auto batches  = boxes.count / batchSize * batchSize;
+
+    for (u64 i = 0; i < batches; i += batchSize) {
+        const auto cx = _mm256_loadu_ps(boxes.centerX + i);
+        const auto cy = _mm256_loadu_ps(boxes.centerY + i);
+        const auto cz = _mm256_loadu_ps(boxes.centerZ + i);
+        const auto ex = _mm256_loadu_ps(boxes.extentX + i);
+        const auto ey = _mm256_loadu_ps(boxes.extentY + i);
+        const auto ez = _mm256_loadu_ps(boxes.extentZ + i);
+
+        auto inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+        for (const auto& plane : planes) {
+            const auto a = _mm256_set1_ps(plane.a);
+            const auto b = _mm256_set1_ps(plane.b);
+            const auto c = _mm256_set1_ps(plane.c);
+
+            auto distance = _mm256_add_ps(
+              _mm256_add_ps(_mm256_mul_ps(a, cx), _mm256_mul_ps(b, cy)),
+              _mm256_add_ps(_mm256_mul_ps(c, cz), _mm256_set1_ps(plane.d))
+            );
+            auto radius = _mm256_add_ps(
+              _mm256_add_ps(
+                _mm256_mul_ps(_mm256_andnot_ps(signMask, a), ex),
+                _mm256_mul_ps(_mm256_andnot_ps(signMask, b), ey)
+              ),
+              _mm256_mul_ps(_mm256_andnot_ps(signMask, c), ez)
+            );
+
+            inside = _mm256_and_ps(
+              inside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), zero, _CMP_GE_OQ)
+            );
+        }
+
+        const auto mask = _mm256_movemask_ps(inside);
+        for (u64 lane = 0; lane < batchSize; ++lane)
+            visible[i + lane] = (mask >> lane) & 1;
+    }
+}
+
+#elif defined(SL_CULLING_SSE)
+
+constexpr u64 batchSize = 4;
+
+void cullBatches(const FrustumPlanes& planes, const BoxesView& boxes, u8* visible) {
+    const auto signMask = _mm_set1_ps(-0.0f);
+    const auto zero     = _mm_setzero_ps();
+    const auto batches  = boxes.count / batchSize * batchSize;
+
+    for (u64 i = 0; i < batches; i += batchSize) {
+        const auto cx = _mm_loadu_ps(boxes.centerX + i);
+        const auto cy = _mm_loadu_ps(boxes.centerY + i);
+        const auto cz = _mm_loadu_ps(boxes.centerZ + i);
+        const auto ex = _mm_loadu_ps(boxes.extentX + i);
+        const auto ey = _mm_loadu_ps(boxes.extentY + i);
+        const auto ez = _mm_loadu_ps(boxes.extentZ + i);
+
+        auto inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+        for (const auto& plane : planes) {
+            const auto a = _mm_set1_ps(plane.a);
+            const auto b = _mm_set1_ps(plane.b);
+            const auto c = _mm_set1_ps(plane.c);
+
+            auto distance = _mm_add_ps(
+              _mm_add_ps(_mm_mul_ps(a, cx), _mm_mul_ps(b, cy)),
+              _mm_add_ps(_mm_mul_ps(c, cz), _mm_set1_ps(plane.d))
+            );
+            auto radius = _mm_add_ps(
+              _mm_add_ps(
+                _mm_mul_ps(_mm_andnot_ps(signMask, a), ex),
+                _mm_mul_ps(_mm_andnot_ps(signMask, b), ey)
+              ),
+              _mm_mul_ps(_mm_andnot_ps(signMask, c), ez)
+            );
+
+            inside =
+              _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), zero));
+        }
+
+        const auto mask = _mm_movemask_ps(inside);
+        for (u64 lane = 0; lane < batchSize; ++lane)
+            visible[i + lane] = (mask >> lane) & 1;
+    }
+}
+
+#else
+
+constexpr u64 batchSize = 1;
+
+void cullBatches(const FrustumPlanes& planes, const BoxesView& boxes, u8* visible) {
+    cullTail(planes, boxes, visible, 0u);
+}
+
+#endif
+
+}  // namespace
+
+FrustumPlanes extractFrustumPlanes(const f32* m) {
+    // i-th row of a column major matrix
+    const auto row = [m](u64 i) -> Plane {
+        return Plane{ .a = m[i], .b = m[4 + i], .c = m[8 + i], .d = m[12 + i] };
+    };
+    const auto add = [](const Plane& lhs, const Plane& rhs) -> Plane {
+        return Plane{ lhs.a + rhs.a, lhs.b + rhs.b, lhs.c + rhs.c, lhs.d + rhs.d };
+    };
+    const auto subtract = [](const Plane& lhs, const Plane& rhs) -> Plane {
+        return Plane{ lhs.a - rhs.a, lhs.b - rhs.b, lhs.c - rhs.c, lhs.d - rhs.d };
+    };
+
+    const auto x = row(0), y = row(1), z = row(2), w = row(3);
+
+    return FrustumPlanes{
+        normalize(add(w, x)),       // left
+        normalize(subtract(w, x)),  // right
+        normalize(add(w, y)),       // bottom
+        normalize(subtract(w, y)),  // top
+        normalize(z),               // near, depth is in 0..1
+        normalize(subtract(w, z)),  // far
+    };
+}
+
+void cullBoxes(const FrustumPlanes& planes, const BoxesView& boxes, u8* visible) {
+    cullBatches(planes, boxes, visible);
+    cullTail(planes, boxes, visible, boxes.count / batchSize * batchSize);
+}
+
+void cullBoxesScalar(const FrustumPlanes& planes, const BoxesView& boxes, u8* visible) {
+    cullTail(planes, boxes, visible, 0u);
+}
+
+}  // namespace sl
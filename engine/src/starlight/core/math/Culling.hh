@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+
+#include "starlight/core/Core.hh"
+
+namespace sl {
+
+/*
+    Frustum culling kernels. They work on plain column major matrices and structure
+    of arrays box data, so the plane tests run on 8 (AVX) or 4 (SSE) boxes at once;
+    builds without either fall back to the scalar path.
+*/
+
+// points with a*x + b*y + c*z + d >= 0 are on the inner side of the plane
+struct Plane {
+    f32 a;
+    f32 b;
+    f32 c;
+    f32 d;
+};
+
+using FrustumPlanes = std::array<Plane, 6>;
+
+// world space boxes as centers and half sizes, every array holds count values
+struct BoxesView {
+    const f32* centerX;
+    const f32* centerY;
+    const f32* centerZ;
+    const f32* extentX;
+    const f32* extentY;
+    const f32* extentZ;
+    u64 count;
+};
+
+// Gribb-Hartmann extraction for the 0..1 clip space depth used by the renderer
+FrustumPlanes extractFrustumPlanes(const f32* viewProjection);
+
+// local space box given by its corners, transformed by a column major matrix;
+// inline as it runs for every instance of every mesh each frame
+inline void transformBox(
+  const f32* matrix, const f32* localMin, const f32* localMax, f32* center,
+  f32* extent
+) {
+    f32 localCenter[3];
+    f32 localExtent[3];
+    for (u64 i = 0; i < 3; ++i) {
+        localCenter[i] = (localMin[i] + localMax[i]) * 0.5f;
+        localExtent[i] = (localMax[i] - localMin[i]) * 0.5f;
+    }
+
+    // Arvo: the extent of a transformed box is the extent projected on the
+    // absolute values of the matrix
+    for (u64 row = 0; row < 3; ++row) {
+        center[row] = matrix[12 + row];
+        extent[row] = 0.0f;
+
+        for (u64 column = 0; column < 3; ++column) {
+            const auto value = matrix[column * 4 + row];
+            center[row] += value * localCenter[column];
+            extent[row] += std::abs(value) * localExtent[column];
+        }
+    }
+}
+
+// writes 1 to visible[i] if the i-th box intersects the frustum, 0 otherwise
+void cullBoxes(const FrustumPlanes& planes, const BoxesView& boxes, u8* visible);
+void cullBoxesScalar(const FrustumPlanes& planes, const BoxesView& boxes, u8* visible);
+
+}  // namespace sl
@@ -13,9 +13,9 @@ concept ExtentType = requires(T lhs, T rhs) {
 };
 
 template <ExtentType T> struct Extent {
-    explicit Extent() : min(0.0f), max(0.0f) {}
+    explicit Extent() : min(0.0f), max(0.0f), center(0.0f) {}
     explicit Extent(const T& min, const T& max) :
-        min(min), max(max), center((min - max) / 2.0f) {}
+        min(min), max(max), center((min + max) / 2.0f) {}
 
     T min;
     T max;
@@ -2,22 +2,32 @@
 
 namespace sl {
 
-Transform::Transform() :
-    Transform(Vec3<f32>{ 0.0f }, Vec3<f32>{ 1.0f }, identityMatrix) {}
+static_assert(sizeof(Vec3<f32>) * 2u + sizeof(Quat<f32>) == 40u);
+
+static Quat<f32> toQuat(const Mat4<f32>& rotation) {
+    return glm::normalize(glm::quat_cast(Mat3<f32>{ rotation }));
+}
+
+Transform::Transform() : Transform(Vec3<f32>{ 0.0f }, Vec3<f32>{ 1.0f }) {}
+
+Transform::Transform(
+  const Vec3<f32>& position, const Vec3<f32>& scale, const Quat<f32>& rotation
+) : m_position(position), m_rotation(rotation), m_scale(scale), m_parent(nullptr),
+    m_dirty(true) {}
 
 Transform::Transform(
   const Vec3<f32>& position, const Vec3<f32>& scale, const Mat4<f32>& rotation
-) :
-    m_model(identityMatrix),
-    m_position(position), m_scale(scale), m_rotation(rotation), m_updated(false),
-    m_parent(nullptr) {}
+) : Transform(position, scale, toQuat(rotation)) {}
 
 Transform* Transform::getParent() const { return m_parent; }
 
-void Transform::setParent(Transform* parent) { m_parent = parent; }
+void Transform::setParent(Transform* parent) {
+    m_parent = parent;
+    setAsDirty();
+}
 
 Transform Transform::fromScale(const Vec3<f32>& scale) {
-    return Transform(Vec3<f32>{ 0.0f }, scale, identityMatrix);
+    return Transform(Vec3<f32>{ 0.0f }, scale);
 }
 
 Transform Transform::fromPosition(const Vec3<f32>& position) {
@@ -25,34 +35,47 @@ Transform Transform::fromPosition(const Vec3<f32>& position) {
 }
 
 Transform Transform::fromRotation(const Vec3<f32>& axis, const float angle) {
-    return Transform::fromRotation(glm::rotate(identityMatrix, angle, axis));
+    return Transform::fromRotation(glm::angleAxis(angle, glm::normalize(axis)));
 }
 
-Transform Transform::fromRotation(const Mat4<f32>& rotation) {
+Transform Transform::fromRotation(const Quat<f32>& rotation) {
     return Transform(Vec3<f32>{ 0.0f }, Vec3<f32>{ 1.0f }, rotation);
 }
 
+Transform Transform::fromRotation(const Mat4<f32>& rotation) {
+    return Transform::fromRotation(toQuat(rotation));
+}
+
 Vec3<f32> Transform::getPosition() const { return m_position; }
 
 Vec3<f32> Transform::getScale() const { return m_scale; }
 
-Mat4<f32> Transform::getRotation() const { return m_rotation; }
+Quat<f32> Transform::getOrientation() const { return m_rotation; }
+
+Mat4<f32> Transform::getRotation() const { return glm::mat4_cast(m_rotation); }
 
 Transform& Transform::translate(const Vec3<f32>& position) {
     m_position += position;
-    m_updated = true;
+    setAsDirty();
     return *this;
 }
 
-Transform& Transform::rotate(const Mat4<f32>& rotation) {
-    m_rotation = rotation * m_rotation;
-    m_updated  = true;
+Transform& Transform::rotate(const Quat<f32>& rotation) {
+    // renormalize so drift does not accumulate over many small rotations
+    m_rotation = glm::normalize(rotation * m_rotation);
+    setAsDirty();
     return *this;
 }
 
+Transform& Transform::rotate(const Mat4<f32>& rotation) {
+    return rotate(toQuat(rotation));
+}
+
 Transform& Transform::rotate(const Vec3<f32>& axis, const float angle) {
-    m_rotation = glm::rotate(m_rotation, angle, axis);
-    m_updated  = true;
+    // local space rotation, as glm::rotate applied to the rotation matrix
+    m_rotation =
+      glm::normalize(m_rotation * glm::angleAxis(angle, glm::normalize(axis)));
+    setAsDirty();
     return *this;
 }
 
@@ -60,47 +83,66 @@ Transform& Transform::scale(float scale) { return this->scale(Vec3<f32>{ scale }
 
 Transform& Transform::scale(const Vec3<f32>& scale) {
     m_scale *= scale;
-    m_updated = true;
+    setAsDirty();
     return *this;
 }
 
 Transform& Transform::setPosition(const Vec3<f32>& position) {
     m_position = position;
-    m_updated  = true;
+    setAsDirty();
     return *this;
 }
 
 Transform& Transform::setScale(const Vec3<f32>& scale) {
-    m_scale   = scale;
-    m_updated = true;
+    m_scale = scale;
+    setAsDirty();
     return *this;
 }
 
-Transform& Transform::setRotation(const Mat4<f32>& rotation) {
+Transform& Transform::setOrientation(const Quat<f32>& rotation) {
     m_rotation = rotation;
-    m_updated  = true;
+    setAsDirty();
     return *this;
 }
 
-Mat4<f32> Transform::getModel() {
-    if (m_updated) {
-        calculateModelMatrix();
-        m_updated = false;
-    }
-    return m_model;
+Transform& Transform::setRotation(const Mat4<f32>& rotation) {
+    return setOrientation(toQuat(rotation));
 }
 
-Mat4<f32> Transform::getWorld() {
+Mat4<f32> Transform::getModel() const {
+    // T * R * S written out directly, the rotation columns come straight from the
+    // quaternion and get scaled, no matrix products involved
+    const auto x = m_rotation.x, y = m_rotation.y, z = m_rotation.z;
+    const auto w = m_rotation.w;
+
+    const auto xx = x * x, yy = y * y, zz = z * z;
+    const auto xy = x * y, xz = x * z, yz = y * z;
+    const auto wx = w * x, wy = w * y, wz = w * z;
+
+    Mat4<f32> model;
+    model[0] = Vec4<f32>{ 1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz),
+                          2.0f * (xz - wy), 0.0f }
+               * m_scale.x;
+    model[1] = Vec4<f32>{ 2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz),
+                          2.0f * (yz + wx), 0.0f }
+               * m_scale.y;
+    model[2] = Vec4<f32>{ 2.0f * (xz + wy), 2.0f * (yz - wx),
+                          1.0f - 2.0f * (xx + yy), 0.0f }
+               * m_scale.z;
+    model[3] = Vec4<f32>{ m_position, 1.0f };
+    return model;
+}
+
+Mat4<f32> Transform::getWorld() const {
     auto model = getModel();
     if (m_parent) model = m_parent->getWorld() * model;
     return model;
 }
 
-void Transform::setAsDirty() { m_updated = true; }
+void Transform::setAsDirty() { m_dirty = true; }
 
-void Transform::calculateModelMatrix() {
-    m_model =
-      glm::scale(m_rotation * glm::translate(m_rotation, m_position), m_scale);
-}
+void Transform::setAsClean() { m_dirty = false; }
+
+bool Transform::isDirty() const { return m_dirty; }
 
 }  // namespace sl
@@ -4,13 +4,25 @@
 
 namespace sl {
 
+/*
+    Translation, rotation and scale kept as 40 bytes: two vectors and a unit
+    quaternion. The model matrix is composed on demand as T * R * S, which is
+    cheaper than keeping a 64 byte cached copy in sync. The matrix based rotation
+    functions are kept for compatibility and convert to quaternions. Every change
+    marks the transform as dirty, so owners caching world matrices in a
+    TransformHierarchy only push the transforms which changed.
+*/
 class Transform {
 public:
     Transform();
 
     explicit Transform(
       const Vec3<f32>& position, const Vec3<f32>& scale = Vec3<f32>{ 1.0f },
-      const Mat4<f32>& rotation = identityMatrix
+      const Quat<f32>& rotation = identityQuat
+    );
+
+    explicit Transform(
+      const Vec3<f32>& position, const Vec3<f32>& scale, const Mat4<f32>& rotation
     );
 
     void setParent(Transform* parent);
@@ -18,39 +30,41 @@ public:
 
     static Transform fromScale(const Vec3<f32>& scale);
     static Transform fromPosition(const Vec3<f32>& position);
+    static Transform fromRotation(const Quat<f32>& rotation);
     static Transform fromRotation(const Mat4<f32>& rotation);
     static Transform fromRotation(const Vec3<f32>& axis, const float angle);
 
     Vec3<f32> getPosition() const;
     Vec3<f32> getScale() const;
+    Quat<f32> getOrientation() const;
     Mat4<f32> getRotation() const;
 
     Transform& scale(float scale);
     Transform& scale(const Vec3<f32>& scale);
+    Transform& rotate(const Quat<f32>& rotation);
     Transform& rotate(const Mat4<f32>& rotation);
     Transform& rotate(const Vec3<f32>& axis, const float angle);
     Transform& translate(const Vec3<f32>& position);
 
     Transform& setPosition(const Vec3<f32>& position);
     Transform& setScale(const Vec3<f32>& scale);
+    Transform& setOrientation(const Quat<f32>& rotation);
     Transform& setRotation(const Mat4<f32>& rotation);
 
-    Mat4<f32> getModel();
-    Mat4<f32> getWorld();
+    Mat4<f32> getModel() const;
+    Mat4<f32> getWorld() const;
 
     void setAsDirty();
+    void setAsClean();
+    bool isDirty() const;
 
 private:
-    void calculateModelMatrix();
-
-    Mat4<f32> m_model;
-
     Vec3<f32> m_position;
+    Quat<f32> m_rotation;
     Vec3<f32> m_scale;
-    Mat4<f32> m_rotation;
 
-    bool m_updated;
     Transform* m_parent;
+    bool m_dirty;
 };
 
-}  // namespace sl
\ No newline at end of file
+}  // namespace sl
@@ -0,0 +1,368 @@
+#include "TransformHierarchy.hh"
+
+#include <algorithm>
+
+#include "starlight/core/Log.hh"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SL_TRANSFORM_SSE 1
+#endif
+
+namespace sl {
+
+namespace {
+
+constexpr u32 unknownDepth = std::numeric_limits<u32>::max();
+
+template <typename T>
+void permute(
+  std::vector<T>& values, const std::vector<u32>& order, std::vector<T>& scratch,
+  u64 stride = 1u
+) {
+    scratch.resize(order.size() * stride);
+    for (u64 i = 0; i < order.size(); ++i) {
+        const auto source = values.begin() + order[i] * stride;
+        std::copy(source, source + stride, scratch.begin() + i * stride);
+    }
+    values.swap(scratch);
+}
+
+struct LocalColumns {
+    // rotation * scale columns, translation as the last one
+    f32 c[4][3];
+};
+
+LocalColumns composeLocal(
+  f32 px, f32 py, f32 pz, f32 qx, f32 qy, f32 qz, f32 qw, f32 sx, f32 sy, f32 sz
+) {
+    const auto xx = qx * qx, yy = qy * qy, zz = qz * qz;
+    const auto xy = qx * qy, xz = qx * qz, yz = qy * qz;
+    const auto wx = qw * qx, wy = qw * qy, wz = qw * qz;
+
+    return LocalColumns{ .c = {
+                           { (1.0f - 2.0f * (yy + zz)) * sx, 2.0f * (xy + wz) * sx,
+                             2.0f * (xz - wy) * sx },
+                           { 2.0f * (xy - wz) * sy, (1.0f - 2.0f * (xx + zz)) * sy,
+                             2.0f * (yz + wx) * sy },
+                           { 2.0f * (xz + wy) * sz, 2.0f * (yz - wx) * sz,
+                             (1.0f - 2.0f * (xx + yy)) * sz },
+                           { px, py, pz },
+                         } };
+}
+
+// out = parent * local, local has an implicit (0, 0, 0, 1) bottom row
+void composeWorld(const f32* parent, const LocalColumns& local, f32* out) {
+#if defined(SL_TRANSFORM_SSE)
+    const auto p0 = _mm_loadu_ps(parent);
+    const auto p1 = _mm_loadu_ps(parent + 4);
+    const auto p2 = _mm_loadu_ps(parent + 8);
+    const auto p3 = _mm_loadu_ps(parent + 12);
+
+    for (u32 column = 0; column < 4u; ++column) {
+        const auto& c = local.c[column];
+        auto result   = _mm_add_ps(
+          _mm_add_ps(
+            _mm_mul_ps(p0, _mm_set1_ps(c[0])), _mm_mul_ps(p1, _mm_set1_ps(c[1]))
+          ),
+          _mm_mul_ps(p2, _mm_set1_ps(c[2]))
+        );
+        if (column == 3u) result = _mm_add_ps(result, p3);
+        _mm_storeu_ps(out + column * 4u, result);
+    }
+#else
+    for (u32 column = 0; column < 4u; ++column) {
+        const auto& c = local.c[column];
+        for (u32 row = 0; row < 4u; ++row) {
+            out[column * 4u + row] =
+              parent[row] * c[0] + parent[4u + row] * c[1] + parent[8u + row] * c[2]
+              + (column == 3u ? parent[12u + row] : 0.0f);
+        }
+    }
+#endif
+}
+
+void storeLocal(const LocalColumns& local, f32* out) {
+    for (u32 column = 0; column < 4u; ++column) {
+        out[column * 4u + 0u] = local.c[column][0];
+        out[column * 4u + 1u] = local.c[column][1];
+        out[column * 4u + 2u] = local.c[column][2];
+        out[column * 4u + 3u] = column == 3u ? 1.0f : 0.0f;
+    }
+}
+
+}  // namespace
+
+TransformHierarchy::TransformHierarchy(u64 capacity) :
+    m_deadCount(0u), m_needsReorder(false) {
+    m_parents.reserve(capacity);
+    m_depths.reserve(capacity);
+    m_childCounts.reserve(capacity);
+    m_handles.reserve(capacity);
+    m_dirty.reserve(capacity);
+    m_positionX.reserve(capacity);
+    m_positionY.reserve(capacity);
+    m_positionZ.reserve(capacity);
+    m_rotationX.reserve(capacity);
+    m_rotationY.reserve(capacity);
+    m_rotationZ.reserve(capacity);
+    m_rotationW.reserve(capacity);
+    m_scaleX.reserve(capacity);
+    m_scaleY.reserve(capacity);
+    m_scaleZ.reserve(capacity);
+    m_worlds.reserve(capacity * 16u);
+    m_slots.reserve(capacity);
+}
+
+TransformHierarchy::Handle TransformHierarchy::create(Handle parent) {
+    const auto position = static_cast<u32>(m_parents.size());
+
+    u32 parentPosition = noParent;
+    u32 depth          = 0u;
+
+    if (parent != invalidHandle) {
+        parentPosition = getPosition(parent);
+        depth          = m_depths[parentPosition] + 1u;
+        ++m_childCounts[parentPosition];
+    }
+    // appending keeps parents first, depth order only matters for locality
+    if (not m_depths.empty() && depth < m_depths.back()) m_needsReorder = true;
+
+    Handle handle = 0u;
+    if (m_freeHandles.empty()) {
+        handle = static_cast<Handle>(m_slots.size());
+        m_slots.push_back(position);
+    } else {
+        handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+        m_slots[handle] = position;
+    }
+
+    m_parents.push_back(parentPosition);
+    m_depths.push_back(depth);
+    m_childCounts.push_back(0u);
+    m_handles.push_back(handle);
+    m_dirty.push_back(1u);
+
+    m_positionX.push_back(0.0f);
+    m_positionY.push_back(0.0f);
+    m_positionZ.push_back(0.0f);
+    m_rotationX.push_back(0.0f);
+    m_rotationY.push_back(0.0f);
+    m_rotationZ.push_back(0.0f);
+    m_rotationW.push_back(1.0f);
+    m_scaleX.push_back(1.0f);
+    m_scaleY.push_back(1.0f);
+    m_scaleZ.push_back(1.0f);
+
+    m_worlds.resize(m_worlds.size() + 16u, 0.0f);
+
+    return handle;
+}
+
+void TransformHierarchy::destroy(Handle handle) {
+    const auto position = getPosition(handle);
+    log::expect(
+      m_childCounts[position] == 0u, "Cannot destroy transform {} with children",
+      handle
+    );
+
+    if (const auto parent = m_parents[position]; parent != noParent)
+        --m_childCounts[parent];
+
+    // the slot stays in storage until the next reorder compacts it away
+    m_parents[position] = noParent;
+    m_handles[position] = invalidHandle;
+    m_dirty[position]   = 0u;
+    m_slots[handle]     = noParent;
+    m_freeHandles.push_back(handle);
+
+    ++m_deadCount;
+    m_needsReorder = true;
+}
+
+void TransformHierarchy::setParent(Handle handle, Handle parent) {
+    const auto position = getPosition(handle);
+    const auto parentPosition =
+      parent == invalidHandle ? noParent : getPosition(parent);
+
+    if (m_parents[position] == parentPosition) return;
+
+    for (auto ancestor = parentPosition; ancestor != noParent;
+         ancestor      = m_parents[ancestor]) {
+        log::expect(
+          ancestor != position, "Cannot parent transform {} to its descendant {}",
+          handle, parent
+        );
+    }
+
+    if (const auto oldParent = m_parents[position]; oldParent != noParent)
+        --m_childCounts[oldParent];
+    if (parentPosition != noParent) ++m_childCounts[parentPosition];
+
+    m_parents[position] = parentPosition;
+    m_dirty[position]   = 1u;
+    m_needsReorder      = true;
+}
+
+TransformHierarchy::Handle TransformHierarchy::getParent(Handle handle) const {
+    const auto parent = m_parents[getPosition(handle)];
+    return parent == noParent ? invalidHandle : m_handles[parent];
+}
+
+void TransformHierarchy::setPosition(Handle handle, f32 x, f32 y, f32 z) {
+    const auto position  = getPosition(handle);
+    m_positionX[position] = x;
+    m_positionY[position] = y;
+    m_positionZ[position] = z;
+    markDirty(position);
+}
+
+void TransformHierarchy::setRotation(Handle handle, f32 x, f32 y, f32 z, f32 w) {
+    const auto position  = getPosition(handle);
+    m_rotationX[position] = x;
+    m_rotationY[position] = y;
+    m_rotationZ[position] = z;
+    m_rotationW[position] = w;
+    markDirty(position);
+}
+
+void TransformHierarchy::setScale(Handle handle, f32 x, f32 y, f32 z) {
+    const auto position = getPosition(handle);
+    m_scaleX[position]  = x;
+    m_scaleY[position]  = y;
+    m_scaleZ[position]  = z;
+    markDirty(position);
+}
+
+u64 TransformHierarchy::update() {
+    if (m_needsReorder) reorder();
+
+    const auto count = m_parents.size();
+
+    // parents come first so a single sweep reaches every descendant
+    for (u64 i = 0; i < count; ++i) {
+        if (const auto parent = m_parents[i]; parent != noParent)
+            m_dirty[i] |= m_dirty[parent];
+    }
+
+    u64 updated = 0u;
+    for (u64 i = 0; i < count; ++i) {
+        if (not m_dirty[i]) continue;
+
+        const auto local = composeLocal(
+          m_positionX[i], m_positionY[i], m_positionZ[i], m_rotationX[i],
+          m_rotationY[i], m_rotationZ[i], m_rotationW[i], m_scaleX[i], m_scaleY[i],
+          m_scaleZ[i]
+        );
+
+        auto world = m_worlds.data() + i * 16u;
+        if (const auto parent = m_parents[i]; parent != noParent)
+            composeWorld(m_worlds.data() + parent * 16u, local, world);
+        else
+            storeLocal(local, world);
+
+        ++updated;
+    }
+    std::fill(m_dirty.begin(), m_dirty.end(), 0u);
+
+    return updated;
+}
+
+const f32* TransformHierarchy::getWorld(Handle handle) const {
+    return m_worlds.data() + getPosition(handle) * 16u;
+}
+
+u64 TransformHierarchy::size() const { return m_parents.size() - m_deadCount; }
+
+u32 TransformHierarchy::getPosition(Handle handle) const {
+    log::expect(
+      handle < m_slots.size() && m_slots[handle] != noParent,
+      "Invalid transform handle {}", handle
+    );
+    return m_slots[handle];
+}
+
+void TransformHierarchy::markDirty(u32 position) { m_dirty[position] = 1u; }
+
+void TransformHierarchy::computeDepths() {
+    const auto count = m_parents.size();
+    std::fill(m_depths.begin(), m_depths.end(), unknownDepth);
+
+    std::vector<u32> chain;
+    for (u64 i = 0; i < count; ++i) {
+        if (m_handles[i] == invalidHandle || m_depths[i] != unknownDepth) continue;
+
+        // walk up until a node with known depth, then unwind the chain
+        auto position = static_cast<u32>(i);
+        while (position != noParent && m_depths[position] == unknownDepth) {
+            chain.push_back(position);
+            position = m_parents[position];
+        }
+
+        auto depth = position == noParent ? 0u : m_depths[position] + 1u;
+        for (auto node = chain.rbegin(); node != chain.rend(); ++node)
+            m_depths[*node] = depth++;
+        chain.clear();
+    }
+}
+
+void TransformHierarchy::reorder() {
+    computeDepths();
+
+    const auto count = m_parents.size();
+    u32 maxDepth     = 0u;
+
+    for (u64 i = 0; i < count; ++i) {
+        if (m_handles[i] != invalidHandle)
+            maxDepth = std::max(maxDepth, m_depths[i]);
+    }
+
+    // counting sort by depth, stable so siblings stay close together
+    std::vector<u32> offsets(maxDepth + 2u, 0u);
+    for (u64 i = 0; i < count; ++i)
+        if (m_handles[i] != invalidHandle) ++offsets[m_depths[i] + 1u];
+    for (u64 i = 1; i < offsets.size(); ++i) offsets[i] += offsets[i - 1];
+
+    std::vector<u32> order(count - m_deadCount);
+    std::vector<u32> newPositions(count, noParent);
+
+    for (u64 i = 0; i < count; ++i) {
+        if (m_handles[i] == invalidHandle) continue;
+        const auto newPosition = offsets[m_depths[i]]++;
+        order[newPosition]     = static_cast<u32>(i);
+        newPositions[i]        = newPosition;
+    }
+
+    std::vector<u32> u32Scratch;
+    std::vector<u8> u8Scratch;
+    std::vector<f32> f32Scratch;
+
+    permute(m_parents, order, u32Scratch);
+    for (auto& parent : m_parents)
+        if (parent != noParent) parent = newPositions[parent];
+
+    permute(m_depths, order, u32Scratch);
+    permute(m_childCounts, order, u32Scratch);
+    permute(m_handles, order, u32Scratch);
+    permute(m_dirty, order, u8Scratch);
+
+    permute(m_positionX, order, f32Scratch);
+    permute(m_positionY, order, f32Scratch);
+    permute(m_positionZ, order, f32Scratch);
+    permute(m_rotationX, order, f32Scratch);
+    permute(m_rotationY, order, f32Scratch);
+    permute(m_rotationZ, order, f32Scratch);
+    permute(m_rotationW, order, f32Scratch);
+    permute(m_scaleX, order, f32Scratch);
+    permute(m_scaleY, order, f32Scratch);
+    permute(m_scaleZ, order, f32Scratch);
+    permute(m_worlds, order, f32Scratch, 16u);
+
+    for (u32 i = 0; i < m_handles.size(); ++i) m_slots[m_handles[i]] = i;
+
+    m_deadCount    = 0u;
+    m_needsReorder = false;
+}
+
+}  // namespace sl
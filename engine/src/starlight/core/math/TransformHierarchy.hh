@@ -0,0 +1,84 @@
+#pragma once
+
+#include <limits>
+#include <vector>
+
+#include "starlight/core/Core.hh"
+
+namespace sl {
+
+/*
+    Scene wide transform storage. Local translation, rotation (unit quaternion) and
+    scale live in structure of arrays form, ordered by hierarchy depth so every
+    parent comes before its children. update() first pushes dirty flags down the
+    hierarchy and then computes world matrices in a single linear pass, each dirty
+    node reading the already final world matrix of its parent. Nodes are addressed
+    by handles which stay valid while the storage gets reordered; structural
+    changes (new parents, destroyed nodes) are applied lazily on the next update.
+*/
+class TransformHierarchy {
+public:
+    using Handle = u32;
+
+    static constexpr Handle invalidHandle = std::numeric_limits<Handle>::max();
+
+    explicit TransformHierarchy(u64 capacity = 0u);
+
+    Handle create(Handle parent = invalidHandle);
+    // only leaves can be destroyed, children have to be detached or destroyed first
+    void destroy(Handle handle);
+
+    void setParent(Handle handle, Handle parent);
+    Handle getParent(Handle handle) const;
+
+    void setPosition(Handle handle, f32 x, f32 y, f32 z);
+    void setRotation(Handle handle, f32 x, f32 y, f32 z, f32 w);
+    void setScale(Handle handle, f32 x, f32 y, f32 z);
+
+    // returns how many world matrices were recomputed
+    u64 update();
+
+    // column major 4x4 matrix, up to date after update()
+    const f32* getWorld(Handle handle) const;
+
+    u64 size() const;
+
+private:
+    static constexpr u32 noParent = std::numeric_limits<u32>::max();
+
+    u32 getPosition(Handle handle) const;
+    void markDirty(u32 position);
+
+    void reorder();
+    void computeDepths();
+
+    // storage positions, parents first
+    std::vector<u32> m_parents;
+    std::vector<u32> m_depths;
+    std::vector<u32> m_childCounts;
+    std::vector<Handle> m_handles;
+    std::vector<u8> m_dirty;
+
+    std::vector<f32> m_positionX;
+    std::vector<f32> m_positionY;
+    std::vector<f32> m_positionZ;
+    std::vector<f32> m_rotationX;
+    std::vector<f32> m_rotationY;
+    std::vector<f32> m_rotationZ;
+    std::vector<f32> m_rotationW;
+    std::vector<f32> m_scaleX;
+    std::vector<f32> m_scaleY;
+    std::vector<f32> m_scaleZ;
+
+    // 16 floats per node
+    std::vector<f32> m_worlds;
+
+    // handle to storage position
+    std::vector<u32> m_slots;
+    std::vector<Handle> m_freeHandles;
+
+    u64 m_deadCount;
+    bool m_needsReorder;
+};
+
+}  // namespace sl
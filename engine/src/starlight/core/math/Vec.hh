@@ -79,6 +79,11 @@ template <> struct Mat4Picker<f32> {
     using Type = math::mat4;
 };
 
+template <typename T> struct QuatPicker {};
+template <> struct QuatPicker<f32> {
+    using Type = math::quat;
+};
+
 template <typename T> struct Vec2Picker {
     using Type = Vec2Base<T>;
 };
@@ -110,6 +115,8 @@ template <typename T> using Mat2 = detail::Mat2Picker<T>::Type;
 template <typename T> using Mat3 = detail::Mat3Picker<T>::Type;
 template <typename T> using Mat4 = detail::Mat4Picker<T>::Type;
 
+template <typename T> using Quat = detail::QuatPicker<T>::Type;
+
 inline Vec2<u32> operator+(const Vec2<u32>& lhs, const Vec2<u32>& rhs) {
     return Vec2<u32>{ lhs.x + rhs.x, lhs.y + rhs.y };
 }
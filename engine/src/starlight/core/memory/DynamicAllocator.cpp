@@ -8,10 +8,11 @@ DynamicAllocator::DynamicAllocator(uint64_t size) :
     log::expect(size > 0, "Could not created allocator with size=0");
 }
 
-void* DynamicAllocator::allocate(uint64_t size) {
+void* DynamicAllocator::allocate(uint64_t size, uint64_t alignment) {
     log::expect(size > 0, "Could not allocate memory block of size 0");
 
-    if (auto offset = m_freeList.allocateBlock(size); offset.has_value()) {
+    if (auto offset = m_freeList.allocateBlock(size, alignment);
+        offset.has_value()) {
         void* block = static_cast<void*>(m_memoryAlias + *offset);
         log::trace("Allocating block of size {} at {}", size, block);
         return block;
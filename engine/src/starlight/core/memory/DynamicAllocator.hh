@@ -12,7 +12,7 @@ class DynamicAllocator {
 public:
     explicit DynamicAllocator(uint64_t size);
 
-    void* allocate(uint64_t size);
+    void* allocate(uint64_t size, uint64_t alignment = 1u);
     void free(void* block, uint64_t size);
 
     uint64_t spaceLeft();
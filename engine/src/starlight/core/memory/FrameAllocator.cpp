@@ -0,0 +1,24 @@
+#include "FrameAllocator.hh"
+
+#include "starlight/core/Log.hh"
+
+namespace sl {
+
+FrameAllocator::FrameAllocator(u64 framesInFlight, u64 capacity) : m_currentArena(0u) {
+    log::expect(framesInFlight > 0, "Frame allocator requires at least 1 arena");
+
+    m_arenas.reserve(framesInFlight);
+    for (u64 i = 0; i < framesInFlight; ++i)
+        m_arenas.push_back(UniquePtr<LinearAllocator>::create(capacity));
+}
+
+void FrameAllocator::beginFrame() {
+    m_currentArena = (m_currentArena + 1) % m_arenas.size();
+    m_arenas[m_currentArena]->reset();
+}
+
+LinearAllocator& FrameAllocator::getArena() { return *m_arenas[m_currentArena]; }
+
+u64 FrameAllocator::getFramesInFlight() const { return m_arenas.size(); }
+
+}  // namespace sl
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+
+#include "starlight/core/Core.hh"
+#include "starlight/core/Singleton.hh"
+
+#include "UniquePtr.hh"
+#include "LinearAllocator.hh"
+#include "StlAllocator.hh"
+
+namespace sl {
+
+template <typename T> using FrameVector = std::vector<T, StlAllocator<T>>;
+
+/*
+    Arenas for transient per frame data, one per frame in flight. beginFrame moves
+    to the next arena and resets it, so data allocated in a frame stays valid until
+    the same arena comes around again. Main thread only.
+*/
+class FrameAllocator : public Singleton<FrameAllocator> {
+public:
+    static constexpr u64 defaultCapacity = 1024 * 1024;
+
+    explicit FrameAllocator(u64 framesInFlight, u64 capacity = defaultCapacity);
+
+    void beginFrame();
+
+    LinearAllocator& getArena();
+
+    template <typename T> FrameVector<T> makeVector() {
+        return FrameVector<T>{ StlAllocator<T>{ getArena() } };
+    }
+
+    template <typename T> FrameVector<T> makeVector(u64 capacity) {
+        auto vector = makeVector<T>();
+        vector.reserve(capacity);
+        return vector;
+    }
+
+    u64 getFramesInFlight() const;
+
+private:
+    std::vector<UniquePtr<LinearAllocator>> m_arenas;
+    u64 m_currentArena;
+};
+
+}  // namespace sl
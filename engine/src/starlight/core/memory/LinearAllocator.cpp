@@ -0,0 +1,81 @@
+#include "LinearAllocator.hh"
+
+#include <new>
+
+#include "starlight/core/Log.hh"
+#include "starlight/core/Utils.hh"
+
+namespace sl {
+
+LinearAllocator::LinearAllocator(u64 capacity) :
+    m_offset(0u), m_usedInPreviousBlocks(0u) {
+    log::expect(capacity > 0, "Could not create linear allocator with size=0");
+    addBlock(capacity);
+}
+
+LinearAllocator::~LinearAllocator() { releaseBlocks(); }
+
+void* LinearAllocator::allocate(u64 size) { return allocate(size, defaultAlignment); }
+
+void* LinearAllocator::allocate(u64 size, u64 alignment) {
+    auto* block = &m_blocks.back();
+
+    const auto address = reinterpret_cast<std::uintptr_t>(block->memory) + m_offset;
+    auto padding       = getAlignedValue<std::uintptr_t>(address, alignment) - address;
+
+    if (m_offset + padding + size > block->size) [[unlikely]] {
+        log::trace(
+          "Linear allocator block of {} bytes exhausted, adding new one", block->size
+        );
+        m_usedInPreviousBlocks += m_offset;
+        addBlock(std::max(block->size * 2u, size + alignment));
+
+        block = &m_blocks.back();
+        const auto blockAddress = reinterpret_cast<std::uintptr_t>(block->memory);
+        padding = getAlignedValue<std::uintptr_t>(blockAddress, alignment) - blockAddress;
+    }
+
+    auto memory = block->memory + m_offset + padding;
+    m_offset += padding + size;
+
+    return memory;
+}
+
+void LinearAllocator::deallocate(
+  [[maybe_unused]] void* ptr, [[maybe_unused]] u64 size
+) noexcept {}
+
+void LinearAllocator::reset() {
+    if (m_blocks.size() > 1u) {
+        const auto capacity = getCapacity();
+        log::debug("Merging linear allocator blocks into one of {} bytes", capacity);
+
+        releaseBlocks();
+        addBlock(capacity);
+    }
+
+    m_offset               = 0u;
+    m_usedInPreviousBlocks = 0u;
+}
+
+u64 LinearAllocator::getCapacity() const {
+    u64 capacity = 0u;
+    for (const auto& block : m_blocks) capacity += block.size;
+    return capacity;
+}
+
+u64 LinearAllocator::getUsedSpace() const { return m_usedInPreviousBlocks + m_offset; }
+
+u64 LinearAllocator::getBlockCount() const { return m_blocks.size(); }
+
+void LinearAllocator::addBlock(u64 size) {
+    m_blocks.emplace_back(static_cast<std::byte*>(::operator new(size)), size);
+    m_offset = 0u;
+}
+
+void LinearAllocator::releaseBlocks() {
+    for (auto& block : m_blocks) ::operator delete(block.memory);
+    m_blocks.clear();
+}
+
+}  // namespace sl
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "starlight/core/Core.hh"
+#include "Allocator.hh"
+
+namespace sl {
+
+/*
+    Bump allocator, deallocation is a no-op and the memory is reclaimed all at once
+    by reset. If the current block runs out, another one is taken from the heap; on
+    reset all blocks are merged into a single one big enough for the whole previous
+    usage, so a steady workload stops hitting the heap after the first reset.
+    Not thread safe.
+*/
+class LinearAllocator : public Allocator, public NonMovable {
+    struct Block {
+        std::byte* memory;
+        u64 size;
+    };
+
+public:
+    static constexpr u64 defaultAlignment = alignof(std::max_align_t);
+
+    explicit LinearAllocator(u64 capacity);
+    ~LinearAllocator();
+
+    // size is given in bytes
+    [[nodiscard]] void* allocate(u64 size) override;
+    [[nodiscard]] void* allocate(u64 size, u64 alignment);
+
+    void deallocate(void* ptr, u64 size) noexcept override;
+
+    void reset();
+
+    u64 getCapacity() const;
+    u64 getUsedSpace() const;
+    u64 getBlockCount() const;
+
+private:
+    void addBlock(u64 size);
+    void releaseBlocks();
+
+    std::vector<Block> m_blocks;
+    u64 m_offset;
+    // bytes taken from blocks that are already full
+    u64 m_usedInPreviousBlocks;
+};
+
+}  // namespace sl
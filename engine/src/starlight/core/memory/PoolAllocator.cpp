@@ -0,0 +1,183 @@
+#include "PoolAllocator.hh"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <mutex>
+
+#include "starlight/core/Log.hh"
+
+namespace sl {
+
+namespace {
+
+// 16 byte steps up to 128, powers of two above
+constexpr std::array<u64, 12> sizeClasses{ 16,  32,  48,  64,  80,   96,
+                                           112, 128, 256, 512, 1024, 2048 };
+constexpr u64 sizeClassCount = sizeClasses.size();
+constexpr u64 slabSize       = 64 * 1024;
+
+static_assert(sizeClasses.back() == BlockPool::maxBlockSize);
+
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+u64 getSizeClass(u64 size) {
+    if (size <= 128u) return size == 0u ? 0u : (size - 1u) / 16u;
+    return 8u + std::bit_width(size - 1u) - 8u;
+}
+
+// blocks moved between a thread cache and the shared pool at once
+constexpr u64 getBatchSize(u64 sizeClass) {
+    return std::clamp<u64>(8192u / sizeClasses[sizeClass], 4u, 64u);
+}
+
+struct BlockChain {
+    FreeBlock* head = nullptr;
+    FreeBlock* tail = nullptr;
+    u64 count       = 0u;
+
+    void push(FreeBlock* block) {
+        block->next = head;
+        head        = block;
+        if (not tail) tail = block;
+        ++count;
+    }
+};
+
+class SizeClassPool {
+public:
+    BlockChain take(u64 sizeClass, u64 count) {
+        std::scoped_lock guard{ m_mutex };
+
+        BlockChain chain;
+        while (m_freeBlocks && chain.count < count) {
+            auto block   = m_freeBlocks;
+            m_freeBlocks = block->next;
+            chain.push(block);
+        }
+
+        const auto blockSize = sizeClasses[sizeClass];
+        while (chain.count < count) {
+            if (m_slabCursor + blockSize > m_slabEnd) addSlab();
+
+            chain.push(reinterpret_cast<FreeBlock*>(m_slabCursor));
+            m_slabCursor += blockSize;
+        }
+        return chain;
+    }
+
+    void give(const BlockChain& chain) {
+        if (chain.count == 0u) return;
+
+        std::scoped_lock guard{ m_mutex };
+        chain.tail->next = m_freeBlocks;
+        m_freeBlocks     = chain.head;
+    }
+
+private:
+    void addSlab() {
+        log::trace("Adding {} bytes slab to block pool", slabSize);
+        // slabs are never released, see BlockPool
+        m_slabCursor = static_cast<std::byte*>(::operator new(slabSize));
+        m_slabEnd    = m_slabCursor + slabSize;
+    }
+
+    std::mutex m_mutex;
+    FreeBlock* m_freeBlocks = nullptr;
+    std::byte* m_slabCursor = nullptr;
+    std::byte* m_slabEnd    = nullptr;
+};
+
+// intentionally leaked, blocks may be freed during static destruction
+std::array<SizeClassPool, sizeClassCount>& getPools() {
+    static auto* pools = new std::array<SizeClassPool, sizeClassCount>{};
+    return *pools;
+}
+
+struct ThreadCache {
+    ~ThreadCache();
+
+    std::array<BlockChain, sizeClassCount> bins;
+};
+
+// trivially destructible, so it can be checked after the cache itself is gone
+thread_local bool t_cacheDestroyed = false;
+
+ThreadCache::~ThreadCache() {
+    auto& pools = getPools();
+    for (u64 i = 0; i < sizeClassCount; ++i) pools[i].give(bins[i]);
+
+    t_cacheDestroyed = true;
+}
+
+ThreadCache* getThreadCache() {
+    if (t_cacheDestroyed) [[unlikely]]
+        return nullptr;
+
+    thread_local ThreadCache cache;
+    return &cache;
+}
+
+}  // namespace
+
+void* BlockPool::allocate(u64 size) {
+    if (size > maxBlockSize) [[unlikely]]
+        return ::operator new(size);
+
+    const auto sizeClass = getSizeClass(size);
+    auto cache           = getThreadCache();
+
+    if (not cache) [[unlikely]]
+        return getPools()[sizeClass].take(sizeClass, 1u).head;
+
+    auto& bin = cache->bins[sizeClass];
+    if (not bin.head) [[unlikely]]
+        bin = getPools()[sizeClass].take(sizeClass, getBatchSize(sizeClass));
+
+    auto block = bin.head;
+    bin.head   = block->next;
+    if (--bin.count == 0u) bin.tail = nullptr;
+
+    return block;
+}
+
+void BlockPool::deallocate(void* ptr, u64 size) noexcept {
+    if (not ptr) [[unlikely]]
+        return;
+
+    if (size > maxBlockSize) [[unlikely]] {
+        ::operator delete(ptr, size);
+        return;
+    }
+
+    const auto sizeClass = getSizeClass(size);
+    auto block           = static_cast<FreeBlock*>(ptr);
+    auto cache           = getThreadCache();
+
+    if (not cache) [[unlikely]] {
+        BlockChain chain;
+        chain.push(block);
+        getPools()[sizeClass].give(chain);
+        return;
+    }
+
+    auto& bin = cache->bins[sizeClass];
+    bin.push(block);
+
+    // hand a batch back so a thread that only frees doesn't hoard blocks
+    const auto batchSize = getBatchSize(sizeClass);
+    if (bin.count > 2u * batchSize) {
+        BlockChain released;
+        while (released.count < batchSize) {
+            auto next = bin.head->next;
+            released.push(bin.head);
+            bin.head = next;
+            --bin.count;
+        }
+        getPools()[sizeClass].give(released);
+    }
+}
+
+}  // namespace sl
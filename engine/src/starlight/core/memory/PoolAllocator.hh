@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+#include "starlight/core/Core.hh"
+#include "Allocator.hh"
+
+namespace sl {
+
+/*
+    Process wide pools of fixed size blocks, one per size class. Every thread keeps
+    a small cache of free blocks per class and only takes the class lock to move a
+    batch of blocks between its cache and the shared pool, so a steady create and
+    destroy workload never touches the heap or a lock. Blocks are carved out of
+    slabs that are never returned to the system, which keeps objects freed during
+    static destruction valid. Requests above the largest class, or with alignment
+    above alignof(std::max_align_t), go straight to operator new.
+*/
+class BlockPool {
+public:
+    static constexpr u64 maxBlockSize = 2048;
+    static constexpr u64 alignment    = alignof(std::max_align_t);
+
+    [[nodiscard]] static void* allocate(u64 size);
+    static void deallocate(void* ptr, u64 size) noexcept;
+
+    static constexpr bool isPooled(u64 size, u64 requiredAlignment) {
+        return size <= maxBlockSize && requiredAlignment <= alignment;
+    }
+};
+
+template <typename T> class PoolAllocator : public Allocator {
+    static constexpr bool pooled = BlockPool::isPooled(sizeof(T), alignof(T));
+
+public:
+    using ValueType = T;
+
+    explicit PoolAllocator() = default;
+
+    [[nodiscard]] void* allocate(u64 n) override {
+        if (n > std::numeric_limits<u64>::max() / sizeof(T)) [[unlikely]]
+            throw std::bad_alloc();
+
+        if constexpr (pooled) {
+            return BlockPool::allocate(n * sizeof(T));
+        } else {
+            return ::operator new(n * sizeof(T), std::align_val_t{ alignof(T) });
+        }
+    }
+
+    void deallocate(void* ptr, u64 n) noexcept override {
+        if constexpr (pooled) {
+            BlockPool::deallocate(ptr, n * sizeof(T));
+        } else {
+            ::operator delete(ptr, n * sizeof(T), std::align_val_t{ alignof(T) });
+        }
+    }
+};
+
+}  // namespace sl
@@ -0,0 +1,52 @@
+#include "RingAllocator.hh"
+
+#include "starlight/core/Log.hh"
+#include "starlight/core/Utils.hh"
+
+namespace sl {
+
+RingAllocator::RingAllocator(u64 capacity) :
+    m_capacity(capacity), m_head(0u), m_tail(0u) {
+    log::expect(capacity > 0, "Could not create ring allocator with size=0");
+}
+
+std::optional<u64> RingAllocator::allocate(u64 size, u64 alignment) {
+    if (size == 0u || size > m_capacity) return {};
+
+    // nothing in use, starting over at the beginning leaves the whole ring free
+    if (m_head == m_tail) {
+        m_head = (m_head + m_capacity - 1u) / m_capacity * m_capacity;
+        m_tail = m_head;
+    }
+
+    const auto offset = m_head % m_capacity;
+    auto padding      = getAlignedValue(offset, alignment) - offset;
+
+    // does not fit before the end, starts over from the beginning
+    if (offset + padding + size > m_capacity) padding = m_capacity - offset;
+
+    if (getUsedSpace() + padding + size > m_capacity) return {};
+
+    m_head += padding;
+    const auto blockOffset = m_head % m_capacity;
+    m_head += size;
+
+    return blockOffset;
+}
+
+u64 RingAllocator::getHead() const { return m_head; }
+
+void RingAllocator::release(u64 head) {
+    log::expect(
+      head >= m_tail && head <= m_head,
+      "Ring allocator release out of order, head={}, allocated=[{}, {})", head,
+      m_tail, m_head
+    );
+    m_tail = head;
+}
+
+u64 RingAllocator::getCapacity() const { return m_capacity; }
+
+u64 RingAllocator::getUsedSpace() const { return m_head - m_tail; }
+
+}  // namespace sl
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <optional>
+
+#include "starlight/core/Core.hh"
+
+namespace sl {
+
+/*
+    Allocator of offsets within a ring, like FreeList the managed memory is kept
+    elsewhere (e.g. a mapped gpu buffer). Blocks are taken in order and freed in the
+    same order: the owner remembers the head after a group of allocations and
+    releases up to it once the memory is no longer in use, e.g. when the fence of
+    the work reading it got signaled. A block never wraps around the end, the space
+    left there is skipped instead. Not thread safe.
+*/
+class RingAllocator {
+public:
+    explicit RingAllocator(u64 capacity);
+
+    // alignment must be a power of two dividing the capacity
+    std::optional<u64> allocate(u64 size, u64 alignment = 1u);
+
+    // marks everything allocated so far, for a later release
+    u64 getHead() const;
+    // frees all blocks allocated before the head was taken
+    void release(u64 head);
+
+    u64 getCapacity() const;
+    u64 getUsedSpace() const;
+
+private:
+    u64 m_capacity;
+    // positions grow without wrapping, the offset is the position modulo capacity
+    u64 m_head;
+    u64 m_tail;
+};
+
+}  // namespace sl
@@ -2,23 +2,47 @@
 
 #include <atomic>
 #include <concepts>
+#include <cstddef>
+#include <new>
+#include <utility>
 
 #include "Allocator.hh"
+#include "PoolAllocator.hh"
 #include "starlight/core/Core.hh"
 
 /*
     TODOs:
-        - support for allocators
-        - allocate both control block and resource in a single allocation
+        - support for custom allocators
 */
 
 namespace sl {
 namespace detail {
 
 struct ControlBlock {
+    // destroys the object and releases the whole block, set by the owner
+    void (*destroy)(ControlBlock* self);
     std::atomic<i64> referenceCounter = 1;
 };
 
+// control block and object live in a single allocation taken from the block pool
+template <typename T> struct SharedBlock : ControlBlock {
+    template <typename... Args> explicit SharedBlock(Args&&... args) {
+        new (storage) T(std::forward<Args>(args)...);
+        destroy = [](ControlBlock* self) {
+            auto block = static_cast<SharedBlock*>(self);
+            block->get()->~T();
+            block->~SharedBlock();
+            s_allocator.deallocate(block, 1);
+        };
+    }
+
+    T* get() { return std::launder(reinterpret_cast<T*>(storage)); }
+
+    alignas(T) std::byte storage[sizeof(T)];
+
+    inline static PoolAllocator<SharedBlock> s_allocator;
+};
+
 }  // namespace detail
 
 template <typename T> class SharedPtr {
@@ -74,10 +98,8 @@ public:
     }
 
     void reset() {
-        if (m_controlBlock && m_controlBlock->referenceCounter.fetch_sub(1) == 1) {
-            delete m_controlBlock;
-            delete m_buffer;
-        }
+        if (m_controlBlock && releaseReference(*m_controlBlock))
+            m_controlBlock->destroy(m_controlBlock);
         m_controlBlock = nullptr;
         m_buffer       = nullptr;
     }
@@ -101,11 +123,28 @@ public:
     }
 
 private:
+    static bool releaseReference(detail::ControlBlock& controlBlock) {
+        // the only owner can't race with anyone, skip the read-modify-write
+        if (controlBlock.referenceCounter.load(std::memory_order_acquire) == 1)
+            return true;
+        return controlBlock.referenceCounter.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
     template <typename... Args>
     requires std::constructible_from<T, Args...>
-    explicit SharedPtr(PrivateConstructorTag, Args&&... args) :
-        m_controlBlock(new detail::ControlBlock),
-        m_buffer(new T(std::forward<Args>(args)...)) {}
+    explicit SharedPtr(PrivateConstructorTag, Args&&... args) {
+        using Block = detail::SharedBlock<T>;
+
+        auto memory = Block::s_allocator.allocate(1);
+        try {
+            auto block     = new (memory) Block(std::forward<Args>(args)...);
+            m_controlBlock = block;
+            m_buffer       = block->get();
+        } catch (...) {
+            Block::s_allocator.deallocate(memory, 1);
+            throw;
+        }
+    }
 
     detail::ControlBlock* m_controlBlock;
     T* m_buffer;
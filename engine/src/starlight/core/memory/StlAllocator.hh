@@ -0,0 +1,53 @@
+#pragma once
+
+#include <new>
+#include <type_traits>
+
+#include "starlight/core/Core.hh"
+#include "Allocator.hh"
+
+namespace sl {
+
+/*
+    Adapts sl::Allocator to the standard allocator requirements so it can back STL
+    containers. Default constructed adaptor uses the global heap.
+*/
+template <typename T> class StlAllocator {
+    template <typename U> friend class StlAllocator;
+
+public:
+    using value_type = T;
+
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+
+    StlAllocator() noexcept : m_upstream(nullptr) {}
+    StlAllocator(Allocator& upstream) noexcept : m_upstream(&upstream) {}
+
+    template <typename U>
+    StlAllocator(const StlAllocator<U>& oth) noexcept : m_upstream(oth.m_upstream) {}
+
+    [[nodiscard]] T* allocate(u64 n) {
+        if (m_upstream == nullptr) [[unlikely]]
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        return static_cast<T*>(m_upstream->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, u64 n) noexcept {
+        if (m_upstream == nullptr) [[unlikely]]
+            ::operator delete(ptr);
+        else
+            m_upstream->deallocate(ptr, n * sizeof(T));
+    }
+
+    Allocator* getUpstream() const { return m_upstream; }
+
+    template <typename U> bool operator==(const StlAllocator<U>& oth) const noexcept {
+        return m_upstream == oth.m_upstream;
+    }
+
+private:
+    Allocator* m_upstream;
+};
+
+}  // namespace sl
@@ -6,7 +6,7 @@
 #include "starlight/core/Core.hh"
 
 #include "Allocator.hh"
-#include "Mallocator.hh"
+#include "PoolAllocator.hh"
 
 namespace sl {
 
@@ -88,7 +88,7 @@ private:
         new (m_buffer) T(std::forward<Args>(args)...);
     }
 
-    inline static Mallocator<T> s_defaultAllocator;
+    inline static PoolAllocator<T> s_defaultAllocator;
 
     Allocator* m_allocator;
     T* m_buffer;
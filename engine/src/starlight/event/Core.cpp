@@ -3,6 +3,6 @@
 namespace sl::details {
 
 EventHandlerRecord::EventHandlerRecord(EventCallback&& callback) :
-    callback(std::forward<EventCallback>(callback)) {}
+    callback(std::move(callback)) {}
 
 }  // namespace sl::details
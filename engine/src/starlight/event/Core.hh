@@ -1,40 +1,32 @@
 #pragma once
 
-#include <typeindex>
-#include <functional>
 #include <vector>
 
 #include "starlight/core/Id.hh"
+#include "starlight/core/Delegate.hh"
 #include "starlight/core/memory/Memory.hh"
 
+#include "EventQueue.hh"
+
 namespace sl {
 
 using EventHandlerId = u32;
 
 namespace details {
 
-struct EventStorageBase {
-    virtual void* getEvent()                = 0;
-    virtual std::type_index getType() const = 0;
-
-    template <typename T> T& as() { return *static_cast<T*>(getEvent()); }
-};
-
-template <typename T> class EventStorage : public EventStorageBase {
+// passed to handlers which may stop the propagation of an event
+class HandledCallback {
 public:
-    template <typename... Args>
-    explicit EventStorage(Args&&... args) : m_event(std::forward<Args>(args)...) {}
+    explicit HandledCallback(bool& handled) : m_handled(handled) {}
 
-    void* getEvent() override { return static_cast<void*>(&m_event); }
-    std::type_index getType() const override { return typeid(T); }
+    void operator()() const { m_handled = true; }
 
 private:
-    T m_event;
+    bool& m_handled;
 };
 
-using HandledCallback = std::function<void()>;
-using EventCallback   = std::function<void(EventStorageBase&, HandledCallback&&)>;
-using Events          = std::vector<UniquePtr<EventStorageBase>>;
+using EventCallback = Delegate<void(const void*, bool&)>;
+using Events        = EventQueue;
 
 struct EventHandlerRecord : Identificable<EventHandlerRecord, EventHandlerId> {
     explicit EventHandlerRecord(EventCallback&& callback);
@@ -42,8 +34,8 @@ struct EventHandlerRecord : Identificable<EventHandlerRecord, EventHandlerId> {
     EventCallback callback;
 };
 
-using EventHandlers =
-  std::unordered_map<std::type_index, std::vector<EventHandlerRecord>>;
+// handler chains indexed by EventTypeId
+using EventHandlers = std::vector<std::vector<EventHandlerRecord>>;
 
 }  // namespace details
 }  // namespace sl
@@ -2,25 +2,21 @@
 
 namespace sl {
 
-EventBroker::EventBroker() : m_proxy(m_events, m_handlers) {
-    m_events.reserve(defaultEventCapacity);
-}
+EventBroker::EventBroker(u64 eventQueueCapacity) :
+    m_events(eventQueueCapacity), m_proxy(m_events, m_handlers) {}
 
 EventProxy& EventBroker::getProxy() { return m_proxy; }
 
 void EventBroker::dispatch() {
-    for (auto& event : std::exchange(m_events, {})) {
-        if (auto handlerRecord = m_handlers.find(event->getType());
-            handlerRecord == m_handlers.end()) {
-            break;
-        } else {
-            bool handled = false;
-            for (auto& handler : handlerRecord->second) {
-                handler.callback(*event, [&handled]() -> void { handled = true; });
-                if (handled) break;
-            }
+    m_events.drain([&](const details::EventTypeInfo& type, void* event) {
+        if (type.id >= m_handlers.size()) return;
+
+        bool handled = false;
+        for (auto& handler : m_handlers[type.id]) {
+            handler.callback(event, handled);
+            if (handled) break;
         }
-    }
+    });
 }
 
 }  // namespace sl
@@ -1,8 +1,5 @@
 #pragma once
 
-#include <typeindex>
-#include <unordered_map>
-
 #include "starlight/core/Core.hh"
 #include "Core.hh"
 #include "EventProxy.hh"
@@ -11,10 +8,12 @@
 namespace sl {
 
 class EventBroker {
-    static constexpr u8 defaultEventCapacity = 128;
-
 public:
-    explicit EventBroker();
+    static constexpr u64 defaultEventQueueCapacity =
+      details::EventQueue::defaultCapacity;
+
+    // events above the capacity still work but go through a slower locked path
+    explicit EventBroker(u64 eventQueueCapacity = defaultEventQueueCapacity);
 
     EventProxy& getProxy();
 
@@ -18,7 +18,7 @@ public:
     EventHandlerSentinel& add(Handler&& handler)
     requires(Callable<Handler, void, const T&> || Callable<Handler, void, const T&, details::HandledCallback>)
     {
-        const auto id = m_eventProxy.pushEventHandler<T>(std::move(handler));
+        const auto id = m_eventProxy.pushEventHandler<T>(std::forward<Handler>(handler));
         m_handlerIds.push_back(id);
         return *this;
     }
@@ -1,7 +1,6 @@
 #include "EventProxy.hh"
 
 #include <algorithm>
-#include <ranges>
 
 namespace sl {
 
@@ -13,16 +12,18 @@ void EventProxy::popEventHandler(const EventHandlerId id) {
         return record.id == id;
     };
 
-    for (auto& chain : m_handlers | std::views::values)
+    for (auto& chain : m_handlers)
         if (std::erase_if(chain, condition) != 0) return;
 
     log::warn("Event handler with id='{}' not found", id);
 }
 
 EventHandlerId EventProxy::pushEventHandlerImpl(
-  const std::type_index& type, details::EventCallback&& wrapper
+  details::EventTypeId type, details::EventCallback&& wrapper
 ) {
     // TODO: ensure thread safety
+    if (type >= m_handlers.size()) m_handlers.resize(type + 1u);
+
     auto& chain = m_handlers[type];
     chain.emplace_back(std::move(wrapper));
     return chain.back().id;
@@ -3,6 +3,7 @@
 #include "starlight/core/Singleton.hh"
 #include "starlight/core/memory/Memory.hh"
 #include "starlight/core/Log.hh"
+#include "starlight/core/Concepts.hh"
 #include "Core.hh"
 
 namespace sl {
@@ -11,33 +12,32 @@ class EventProxy : public Singleton<EventProxy> {
 public:
     explicit EventProxy(details::Events& events, details::EventHandlers& handlers);
 
+    // safe to call from any thread
     template <typename T, typename... Args> void emit(Args&&... args) {
-        m_events.push_back(
-          UniquePtr<details::EventStorage<T>>::create(std::forward<Args>(args)...)
-        );
+        m_events.push<T>(std::forward<Args>(args)...);
     }
 
-    template <typename T>
-    EventHandlerId pushEventHandler(
-      std::function<void(const T&, details::HandledCallback&&)>&& handler
-    ) {
+    template <typename T, typename Handler>
+    requires Callable<Handler, void, const T&, details::HandledCallback>
+    EventHandlerId pushEventHandler(Handler&& handler) {
         return pushEventHandlerImpl(
-          typeid(T),
-          [handler = std::move(handler
-           )](details::EventStorageBase& event, details::HandledCallback&& handled) {
-              handler(event.as<T>(), std::move(handled));
+          details::getEventTypeInfo<T>().id,
+          [handler = std::forward<Handler>(handler
+           )](const void* event, bool& handled) mutable {
+              handler(*static_cast<const T*>(event), details::HandledCallback{ handled });
           }
         );
     }
 
-    template <typename T>
-    EventHandlerId pushEventHandler(std::function<void(const T&)>&& handler) {
+    template <typename T, typename Handler>
+    requires Callable<Handler, void, const T&>
+    EventHandlerId pushEventHandler(Handler&& handler) {
         return pushEventHandlerImpl(
-          typeid(T),
-          [handler = std::move(handler)](
-            details::EventStorageBase& event,
-            [[maybe_unused]] details::HandledCallback&& handled
-          ) { handler(event.as<T>()); }
+          details::getEventTypeInfo<T>().id,
+          [handler = std::forward<Handler>(handler
+           )](const void* event, [[maybe_unused]] bool& handled) mutable {
+              handler(*static_cast<const T*>(event));
+          }
         );
     }
 
@@ -45,7 +45,7 @@ public:
 
 private:
     EventHandlerId pushEventHandlerImpl(
-      const std::type_index& type, details::EventCallback&& wraper
+      details::EventTypeId type, details::EventCallback&& wrapper
     );
 
     details::Events& m_events;
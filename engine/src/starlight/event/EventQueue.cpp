@@ -0,0 +1,77 @@
+#include "EventQueue.hh"
+
+#include "starlight/core/Log.hh"
+
+namespace sl::details {
+
+EventTypeId nextEventTypeId() {
+    static std::atomic<EventTypeId> s_generator = 0u;
+    return s_generator.fetch_add(1u, std::memory_order_relaxed);
+}
+
+EventQueue::EventQueue(u64 capacity) :
+    m_slots(capacity), m_mask(capacity - 1u), m_enqueuePosition(0u),
+    m_dequeuePosition(0u), m_overflowing(false) {
+    log::expect(
+      capacity > 0 && (capacity & (capacity - 1u)) == 0,
+      "Event queue capacity must be a power of 2, got {}", capacity
+    );
+
+    for (u64 i = 0; i < capacity; ++i)
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+EventQueue::~EventQueue() {
+    // events that were never dispatched still have to be destroyed
+    drain([](const EventTypeInfo&, void*) {});
+}
+
+u64 EventQueue::getCapacity() const { return m_slots.size(); }
+
+bool EventQueue::isOverflowing() const {
+    return m_overflowing.load(std::memory_order_acquire);
+}
+
+EventQueue::Slot* EventQueue::claimSlot(u64& position) {
+    position = m_enqueuePosition.load(std::memory_order_relaxed);
+
+    while (true) {
+        auto& slot          = m_slots[position & m_mask];
+        const auto sequence = slot.sequence.load(std::memory_order_acquire);
+        const auto diff     = static_cast<i64>(sequence) - static_cast<i64>(position);
+
+        if (diff == 0) {
+            if (m_enqueuePosition.compare_exchange_weak(
+                  position, position + 1u, std::memory_order_relaxed
+                ))
+                return &slot;
+        } else if (diff < 0) {
+            // not released by the consumer yet, ring is full
+            return nullptr;
+        } else {
+            position = m_enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void EventQueue::moveOverflowToRing() {
+    u64 moved = 0u;
+    for (; moved < m_overflow.size(); ++moved) {
+        u64 position;
+        auto slot = claimSlot(position);
+        if (not slot) break;
+
+        // overflowed events live in the pool, never in the slot storage
+        slot->type  = m_overflow[moved].type;
+        slot->event = m_overflow[moved].event;
+        slot->sequence.store(position + 1u, std::memory_order_release);
+    }
+    m_overflow.erase(m_overflow.begin(), m_overflow.begin() + moved);
+}
+
+void EventQueue::destroy(const EventTypeInfo& type, void* event, const void* storage) {
+    type.destroy(event);
+    if (event != storage) m_pool.deallocate(event, type.size, type.alignment);
+}
+
+}  // namespace sl::details
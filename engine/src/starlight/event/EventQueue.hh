@@ -0,0 +1,198 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "starlight/core/Core.hh"
+#include "starlight/core/Concepts.hh"
+
+namespace sl::details {
+
+using EventTypeId = u32;
+
+// ids are dense and handed out on the first use of a type, so they can index
+// flat tables instead of hashing type_index
+EventTypeId nextEventTypeId();
+
+struct EventTypeInfo {
+    EventTypeId id;
+    u64 size;
+    u64 alignment;
+    void (*destroy)(void* event);
+};
+
+template <typename T> const EventTypeInfo& getEventTypeInfo() {
+    static const EventTypeInfo info{
+        .id        = nextEventTypeId(),
+        .size      = sizeof(T),
+        .alignment = alignof(T),
+        .destroy   = [](void* event) { static_cast<T*>(event)->~T(); },
+    };
+    return info;
+}
+
+/*
+    Bounded multi-producer single-consumer ring of type erased events. Producers
+    claim slots with a CAS on the enqueue position and publish them with a per
+    slot sequence number, events small enough are constructed inline in the slot,
+    bigger ones in a synchronized pool. When the ring is full events go to a
+    locked overflow list, which keeps the order of events from a single producer.
+    Once a drain consumed the ring, the events still in the overflow are moved
+    back into it, so producers return to the ring even if they never stop pushing.
+    Only one thread may drain the queue at a time.
+*/
+class EventQueue : public NonMovable {
+    static constexpr u64 inlineSize      = 64;
+    static constexpr u64 inlineAlignment = alignof(std::max_align_t);
+
+    struct Slot {
+        std::atomic<u64> sequence;
+        const EventTypeInfo* type;
+        void* event;
+        alignas(inlineAlignment) std::byte storage[inlineSize];
+    };
+
+    struct OverflowEvent {
+        const EventTypeInfo* type;
+        void* event;
+    };
+
+    template <typename T>
+    static constexpr bool fitsInline =
+      sizeof(T) <= inlineSize && alignof(T) <= inlineAlignment;
+
+public:
+    // holds a frame of 10k events without going through the locked overflow
+    static constexpr u64 defaultCapacity = 16 * 1024;
+
+    explicit EventQueue(u64 capacity = defaultCapacity);
+    ~EventQueue();
+
+    template <typename T, typename... Args> void push(Args&&... args) {
+        const auto& type = getEventTypeInfo<T>();
+
+        u64 position;
+        Slot* slot = nullptr;
+
+        // once anything overflowed, the rest follows until the next drain, so
+        // events of a single producer are never reordered
+        if (not m_overflowing.load(std::memory_order_acquire)) slot = claimSlot(position);
+
+        if (slot) [[likely]] {
+            void* memory =
+              fitsInline<T> ? slot->storage : m_pool.allocate(sizeof(T), alignof(T));
+
+            slot->type  = nullptr;
+            slot->event = memory;
+
+            // a claimed slot has to be published even if the event can't be
+            // created, otherwise the consumer would wait for it forever
+            try {
+                new (memory) T(std::forward<Args>(args)...);
+                slot->type = &type;
+            } catch (...) {
+                if (not fitsInline<T>) m_pool.deallocate(memory, sizeof(T), alignof(T));
+                slot->sequence.store(position + 1u, std::memory_order_release);
+                throw;
+            }
+            slot->sequence.store(position + 1u, std::memory_order_release);
+            return;
+        }
+
+        void* memory = m_pool.allocate(sizeof(T), alignof(T));
+        try {
+            new (memory) T(std::forward<Args>(args)...);
+        } catch (...) {
+            m_pool.deallocate(memory, sizeof(T), alignof(T));
+            throw;
+        }
+
+        std::scoped_lock guard{ m_overflowMutex };
+        m_overflow.emplace_back(&type, memory);
+        m_overflowing.store(true, std::memory_order_release);
+    }
+
+    // calls the callback with every event pushed before the drain started, events
+    // pushed from inside of the callback are left for the next drain; overflowed
+    // events wait until every ring slot claimed before them was consumed
+    template <typename C>
+    requires Callable<C, void, const EventTypeInfo&, void*>
+    void drain(C&& callback) {
+        // producers with overflowed events don't claim slots until the overflow is
+        // empty again, so these events only follow ring slots below the end
+        u64 overflowCount = 0u;
+        if (m_overflowing.load(std::memory_order_acquire)) {
+            std::scoped_lock guard{ m_overflowMutex };
+            overflowCount = m_overflow.size();
+        }
+        const auto end = m_enqueuePosition.load(std::memory_order_acquire);
+
+        while (m_dequeuePosition < end) {
+            auto& slot = m_slots[m_dequeuePosition & m_mask];
+
+            // claimed but not published yet, the rest is taken in the next drain
+            if (slot.sequence.load(std::memory_order_acquire) != m_dequeuePosition + 1u)
+                break;
+
+            if (slot.type) {
+                callback(*slot.type, slot.event);
+                destroy(*slot.type, slot.event, slot.storage);
+            }
+
+            slot.sequence.store(
+              m_dequeuePosition + m_slots.size(), std::memory_order_release
+            );
+            ++m_dequeuePosition;
+        }
+
+        if (overflowCount == 0u || m_dequeuePosition != end) return;
+
+        {
+            std::scoped_lock guard{ m_overflowMutex };
+            const auto drained = m_overflow.begin() + overflowCount;
+            m_drainedOverflow.assign(m_overflow.begin(), drained);
+            m_overflow.erase(m_overflow.begin(), drained);
+
+            // pushed since the drain started, producers seeing the flag cleared
+            // claim their slots after these
+            moveOverflowToRing();
+            if (m_overflow.empty())
+                m_overflowing.store(false, std::memory_order_release);
+        }
+
+        for (auto& [type, event] : m_drainedOverflow) {
+            callback(*type, event);
+            destroy(*type, event, nullptr);
+        }
+        m_drainedOverflow.clear();
+    }
+
+    u64 getCapacity() const;
+    // pushes go to the locked overflow list until a drain moves it to the ring
+    bool isOverflowing() const;
+
+private:
+    Slot* claimSlot(u64& position);
+    // as much of the overflow as fits, from the front
+    void moveOverflowToRing();
+    void destroy(const EventTypeInfo& type, void* event, const void* storage);
+
+    std::vector<Slot> m_slots;
+    u64 m_mask;
+
+    alignas(64) std::atomic<u64> m_enqueuePosition;
+    alignas(64) u64 m_dequeuePosition;
+
+    std::pmr::synchronized_pool_resource m_pool;
+
+    std::atomic_bool m_overflowing;
+    std::mutex m_overflowMutex;
+    std::vector<OverflowEvent> m_overflow;
+    std::vector<OverflowEvent> m_drainedOverflow;
+};
+
+}  // namespace sl::details
@@ -24,6 +24,11 @@ constexpr void enableBitOperations(ClearFlags);
 enum class Attachment : u8 { none = 0x0, swapchainColor = 0x1, depth = 0x2 };
 constexpr void enableBitOperations(Attachment);
 
+// how a resource is placed in device memory: sharing blocks with others through a
+// free list, bumped in a block reclaimed once all of it is freed (short lived
+// resources, e.g. staging), or in its own allocation (render targets)
+enum class MemoryStrategy : u8 { general, linear, dedicated };
+
 // TODO: camelCase
 
 enum class MemoryProperty : u64 {
@@ -0,0 +1,95 @@
+#include "DrawList.hh"
+
+#include <algorithm>
+#include <bit>
+
+#include "starlight/core/RadixSort.hh"
+
+namespace sl {
+
+static constexpr u64 mask(u64 bits) { return (1ull << bits) - 1u; }
+
+static_assert(
+  DrawList::passBits + DrawList::layerBits + DrawList::pipelineBits
+    + DrawList::materialBits + DrawList::meshBits + DrawList::depthBits
+  == 64
+);
+
+static u64 quantizeDepth(f32 depth) {
+    // positive floats order the same as their bit patterns, negative and NaN
+    // depths are clamped to the front
+    const auto bits = std::bit_cast<u32>(depth > 0.0f ? depth : 0.0f);
+    return bits >> (32u - 1u - DrawList::depthBits);
+}
+
+u64 DrawList::makeKey(const KeyFields& fields) {
+    const auto pass     = fields.pass & mask(passBits);
+    const auto pipeline = fields.pipeline & mask(pipelineBits);
+    const auto material = fields.material & mask(materialBits);
+    const auto mesh     = fields.mesh & mask(meshBits);
+    const auto depth    = quantizeDepth(fields.depth);
+
+    u64 key = pass;
+    key     = (key << layerBits) | static_cast<u64>(fields.layer);
+
+    if (fields.layer == Layer::opaque) {
+        key = (key << pipelineBits) | pipeline;
+        key = (key << materialBits) | material;
+        key = (key << meshBits) | mesh;
+        key = (key << depthBits) | depth;
+    } else {
+        key = (key << depthBits) | (~depth & mask(depthBits));
+        key = (key << pipelineBits) | pipeline;
+        key = (key << materialBits) | material;
+        key = (key << meshBits) | mesh;
+    }
+    return key;
+}
+
+DrawList::DrawList(u64 capacity) :
+    m_keys(FrameAllocator::get().makeVector<u64>(capacity)),
+    m_indices(FrameAllocator::get().makeVector<u32>(capacity)) {}
+
+void DrawList::add(u64 key, u32 index) {
+    m_keys.push_back(key);
+    m_indices.push_back(index);
+}
+
+void DrawList::sort() {
+    const auto count = m_keys.size();
+    if (count < 2u) return;
+
+    auto& frameAllocator = FrameAllocator::get();
+
+    auto keysScratch    = frameAllocator.makeVector<u64>();
+    auto indicesScratch = frameAllocator.makeVector<u32>();
+    keysScratch.resize(count);
+    indicesScratch.resize(count);
+
+    radixSort(m_keys, m_indices, keysScratch, indicesScratch);
+}
+
+void DrawList::clear() {
+    m_keys.clear();
+    m_indices.clear();
+}
+
+u64 DrawList::size() const { return m_keys.size(); }
+
+bool DrawList::empty() const { return m_keys.empty(); }
+
+std::span<const u32> DrawList::getIndices() const { return m_indices; }
+
+std::span<const u64> DrawList::getKeys() const { return m_keys; }
+
+DrawStats& DrawStats::operator+=(const DrawStats& oth) {
+    drawCalls += oth.drawCalls;
+    instances += oth.instances;
+    vertexBufferBinds += oth.vertexBufferBinds;
+    indexBufferBinds += oth.indexBufferBinds;
+    descriptorSetBinds += oth.descriptorSetBinds;
+    skippedBinds += oth.skippedBinds;
+    return *this;
+}
+
+}  // namespace sl
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <span>
+
+#include "starlight/core/Core.hh"
+#include "starlight/core/memory/FrameAllocator.hh"
+
+namespace sl {
+
+/*
+    Draws of a frame ordered by 64 bit sort keys, so the ones sharing GPU state are
+    submitted back to back. From the most significant bit a key holds:
+
+        opaque:      pass | 0 | pipeline | material | mesh | depth
+        transparent: pass | 1 | inverted depth | pipeline | material | mesh
+
+    Opaque draws are grouped by state and go front to back within a group, while
+    transparent ones go back to front no matter the state. Material and mesh take
+    their dense id indices, wrapped when they don't fit. Depth is the view distance,
+    compared by the upper bits of its float representation.
+*/
+class DrawList {
+public:
+    enum class Layer : u8 { opaque = 0, transparent = 1 };
+
+    static constexpr u64 passBits     = 4;
+    static constexpr u64 layerBits    = 1;
+    static constexpr u64 pipelineBits = 8;
+    static constexpr u64 materialBits = 16;
+    static constexpr u64 meshBits     = 16;
+    static constexpr u64 depthBits    = 19;
+
+    struct KeyFields {
+        u32 pass;
+        Layer layer;
+        u32 pipeline;
+        u64 material;
+        u64 mesh;
+        f32 depth;
+    };
+
+    static u64 makeKey(const KeyFields& fields);
+
+    // storage comes from the frame allocator
+    explicit DrawList(u64 capacity);
+
+    // index refers to the caller's draw data, e.g. a render entity
+    void add(u64 key, u32 index);
+    void sort();
+    void clear();
+
+    u64 size() const;
+    bool empty() const;
+
+    // valid after sort, indices of the added draws in key order
+    std::span<const u32> getIndices() const;
+    std::span<const u64> getKeys() const;
+
+private:
+    FrameVector<u64> m_keys;
+    FrameVector<u32> m_indices;
+};
+
+// GPU work recorded by a render pass during a frame, redundant binds are counted
+// as skipped instead of being recorded
+struct DrawStats {
+    u64 drawCalls          = 0u;
+    u64 instances          = 0u;
+    u64 vertexBufferBinds  = 0u;
+    u64 indexBufferBinds   = 0u;
+    u64 descriptorSetBinds = 0u;
+    u64 skippedBinds       = 0u;
+
+    DrawStats& operator+=(const DrawStats& oth);
+};
+
+}  // namespace sl
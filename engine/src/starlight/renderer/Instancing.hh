@@ -0,0 +1,68 @@
+#pragma once
+
+#include <span>
+
+#include "starlight/core/Core.hh"
+#include "starlight/core/memory/FrameAllocator.hh"
+
+#include "fwd.hh"
+
+namespace sl {
+
+/*
+    Grouping of render entities into instanced draws. Entities come ordered so the
+    ones that can share a draw are adjacent, e.g. by a DrawList, then every run of
+    them becomes a batch covering a contiguous range of the instance buffer.
+    Templated over the entity type, anything with mesh and material members works.
+*/
+
+enum class InstanceGrouping : u8 {
+    meshAndMaterial,
+    // for passes that ignore materials, e.g. depth only ones
+    mesh
+};
+
+struct InstanceBatch {
+    Mesh* mesh;
+    // null for batches grouped by mesh only
+    Material* material;
+    u32 firstInstance;
+    u32 instanceCount;
+};
+
+// appends a batch per run of adjacent entities sharing the grouping key, instances
+// are numbered on from the last batch already in the vector
+template <typename Entity>
+void appendInstanceBatches(
+  std::span<const Entity> entities, InstanceGrouping grouping,
+  FrameVector<InstanceBatch>& batches
+) {
+    const bool withMaterial = grouping == InstanceGrouping::meshAndMaterial;
+
+    u32 instance = 0u;
+    if (not batches.empty())
+        instance = batches.back().firstInstance + batches.back().instanceCount;
+
+    auto canJoin = [&](const InstanceBatch& batch, const Entity& entity) -> bool {
+        return batch.mesh == entity.mesh
+               && (not withMaterial || batch.material == entity.material);
+    };
+
+    const auto firstNew = batches.size();
+
+    for (const auto& entity : entities) {
+        if (batches.size() > firstNew && canJoin(batches.back(), entity)) {
+            ++batches.back().instanceCount;
+        } else {
+            batches.push_back(InstanceBatch{
+              .mesh          = entity.mesh,
+              .material      = withMaterial ? entity.material : nullptr,
+              .firstInstance = instance,
+              .instanceCount = 1u,
+            });
+        }
+        ++instance;
+    }
+}
+
+}  // namespace sl
@@ -0,0 +1,28 @@
+#include "LevelOfDetail.hh"
+
+#include <algorithm>
+
+namespace sl {
+
+f32 calculateScreenSize(f32 radius, f32 distance, f32 projectionScaleY) {
+    if (distance <= radius) return max<f32>();
+    // the projected radius in the -1..1 range is also the fraction of the height
+    return radius * projectionScaleY / distance;
+}
+
+u32 selectLevelOfDetail(
+  std::span<const f32> switchSizes, f32 screenSize, u32 currentLevel, f32 hysteresis
+) {
+    const auto levelCount = static_cast<u32>(switchSizes.size());
+    auto level            = std::min(currentLevel, levelCount);
+
+    const auto lower = 1.0f - hysteresis;
+    const auto upper = 1.0f + hysteresis;
+
+    while (level < levelCount && screenSize < switchSizes[level] * lower) ++level;
+    while (level > 0u && screenSize > switchSizes[level - 1u] * upper) --level;
+
+    return level;
+}
+
+}  // namespace sl
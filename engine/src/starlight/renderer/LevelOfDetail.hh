@@ -0,0 +1,28 @@
+#pragma once
+
+#include <span>
+
+#include "starlight/core/Core.hh"
+
+namespace sl {
+
+/*
+    Level of detail selection by projected size. Levels are ordered from the most
+    detailed one and each further level takes over once the object covers less of
+    the screen height than its switch size. Around every switch size there is a dead
+    band, an object has to get clearly smaller to drop a level and clearly bigger to
+    get it back, so objects resting near a switch distance do not pop every frame.
+*/
+
+// fraction of the screen height covered by a sphere, for a perspective projection
+// whose [1][1] element is projectionScaleY; a camera inside of the sphere gets max
+f32 calculateScreenSize(f32 radius, f32 distance, f32 projectionScaleY);
+
+// switchSizes are descending, switchSizes[i] being the screen size below which level
+// i + 1 replaces level i; hysteresis is the half width of the dead band relative to
+// the switch size, 0 gives the plain threshold test
+u32 selectLevelOfDetail(
+  std::span<const f32> switchSizes, f32 screenSize, u32 currentLevel, f32 hysteresis
+);
+
+}  // namespace sl
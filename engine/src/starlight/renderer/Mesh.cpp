@@ -3,6 +3,8 @@
 #include "starlight/core/math/Geometry.hh"
 #include "starlight/core/math/Vertex.hh"
 
+#include "MeshSimplifier.hh"
+
 namespace sl {
 
 Mesh::Mesh(
@@ -14,8 +16,15 @@ Mesh::Mesh(
       "Creating Mesh, vertex data size = {}b, index data size = {}b",
       data.vertexDataSize, data.indexDataSize
     );
-    auto vertexRange = vertexBuffer.allocate(data.vertexDataSize, data.vertexData);
-    auto indexRange  = indexBuffer.allocate(data.indexDataSize, data.indexData);
+    // the buffers move the ranges around when compacting them
+    auto vertexRange = vertexBuffer.allocate(
+      data.vertexDataSize, data.vertexData,
+      [&](const Range& range) { m_memoryLayout.vertexBufferRange = range; }
+    );
+    auto indexRange = indexBuffer.allocate(
+      data.indexDataSize, data.indexData,
+      [&](const Range& range) { m_memoryLayout.indexBufferRange = range; }
+    );
     log::expect(
       vertexRange.has_value(), "Could not allocate vertex buffer range for mesh"
     );
@@ -29,9 +38,8 @@ Mesh::Mesh(
 }
 
 Mesh::~Mesh() {
-    // TODO
-    // m_vertexBuffer.free(m_memoryLayout.vertexBufferRange);
-    // m_indexBuffer.free(m_memoryLayout.indexBufferRange);
+    m_vertexBuffer.free(m_memoryLayout.vertexBufferRange);
+    m_indexBuffer.free(m_memoryLayout.indexBufferRange);
 }
 
 const Mesh::MemoryLayout& Mesh::getMemoryLayout() const { return m_memoryLayout; }
@@ -277,4 +285,50 @@ void Mesh::Properties3D::generateNormals() {
     sl::generateFaceNormals(vertices, indices);
 }
 
+Mesh::Properties3D Mesh::Properties3D::simplify(
+  f32 targetRatio, f32 maxError
+) const {
+    log::expect(
+      targetRatio > 0.0f && targetRatio <= 1.0f,
+      "Simplification target ratio must be in (0, 1], got {}", targetRatio
+    );
+    log::expect(not vertices.empty(), "Cannot simplify a mesh without vertices");
+
+    MeshSimplifier simplifier{ VertexPositions{
+      .data   = math::value_ptr(vertices[0].position),
+      .count  = vertices.size(),
+      .stride = sizeof(Vertex3),
+    } };
+
+    const auto targetTriangles = static_cast<u64>(indices.size() / 3u * targetRatio);
+    const auto simplified      = simplifier.simplify(
+      indices,
+      MeshSimplifier::Properties{
+        .targetIndexCount = targetTriangles * 3u,
+        .maxError         = maxError,
+      }
+    );
+
+    // vertices keep their attributes, only those still in use are copied
+    static constexpr u32 unused = max<u32>();
+    std::vector<u32> remap(vertices.size(), unused);
+
+    Properties3D result;
+    result.indices.reserve(simplified.size());
+
+    for (const auto index : simplified) {
+        if (remap[index] == unused) {
+            remap[index] = static_cast<u32>(result.vertices.size());
+            result.vertices.push_back(vertices[index]);
+        }
+        result.indices.push_back(remap[index]);
+    }
+
+    log::debug(
+      "Simplified mesh from {} to {} triangles, error = {}", indices.size() / 3u,
+      result.indices.size() / 3u, simplifier.getError()
+    );
+    return result;
+}
+
 }  // namespace sl
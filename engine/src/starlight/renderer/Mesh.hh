@@ -121,6 +121,10 @@ public:
 
         void generateTangents();
         void generateNormals();
+
+        // quadric error simplification down to about targetRatio of the triangles,
+        // maxError is relative to the size of the mesh, see MeshSimplifier
+        Properties3D simplify(f32 targetRatio, f32 maxError = 0.01f) const;
     };
 
     struct Properties2D final : public Properties<Vertex2, Extent2> {};
@@ -1,20 +1,96 @@
 #include "MeshComposite.hh"
 
+#include "LevelOfDetail.hh"
+
 namespace sl {
 
+// switching needs a 10% change of the screen size past the threshold
+static constexpr f32 lodHysteresis = 0.1f;
+
 MeshComposite::Node::Node(
   SharedPtr<Mesh> mesh, SharedPtr<Material> material, u64 depth, u64 index
 ) :
     mesh(mesh), material(material), name(fmt::format("Node-{}/{}", depth, index)),
     m_depth(depth), m_index(index) {
     m_instances.emplace_back();
+    m_instanceLODs.push_back(0u);
 }
 
 std::span<Transform> MeshComposite::Node::getInstances() { return m_instances; }
 
 Transform& MeshComposite::Node::addInstance() {
     m_instances.emplace_back();
+    m_instanceLODs.push_back(0u);
     return m_instances.back();
 }
 
+void MeshComposite::Node::addLOD(SharedPtr<Mesh> mesh, f32 screenSize) {
+    log::expect(
+      m_lodScreenSizes.empty() || screenSize < m_lodScreenSizes.back(),
+      "LOD screen sizes must be descending, got {} after {}", screenSize,
+      m_lodScreenSizes.empty() ? 0.0f : m_lodScreenSizes.back()
+    );
+    m_lods.push_back(LOD{ .mesh = mesh, .screenSize = screenSize });
+    m_lodScreenSizes.push_back(screenSize);
+}
+
+std::span<const MeshComposite::Node::LOD> MeshComposite::Node::getLODs() const {
+    return m_lods;
+}
+
+Mesh* MeshComposite::Node::selectLOD(u64 instance, f32 screenSize) {
+    auto& level = m_instanceLODs[instance];
+    level = selectLevelOfDetail(m_lodScreenSizes, screenSize, level, lodHysteresis);
+    return level == 0u ? mesh.get() : m_lods[level - 1u].mesh.get();
+}
+
+void MeshComposite::updateTransforms() {
+    traverse([&](Node& node) {
+        for (auto i = node.m_handles.size(); i < node.m_instances.size(); ++i)
+            node.m_handles.push_back(m_transforms.create());
+    });
+
+    // handles exist for every instance now, so parents can be resolved
+    traverse([&](Node& node) {
+        for (u64 i = 0; i < node.m_instances.size(); ++i) {
+            auto& instance = node.m_instances[i];
+            if (not instance.isDirty()) continue;
+
+            const auto handle   = node.m_handles[i];
+            const auto position = instance.getPosition();
+            const auto rotation = instance.getOrientation();
+            const auto scale    = instance.getScale();
+
+            m_transforms.setPosition(handle, position.x, position.y, position.z);
+            m_transforms.setRotation(
+              handle, rotation.x, rotation.y, rotation.z, rotation.w
+            );
+            m_transforms.setScale(handle, scale.x, scale.y, scale.z);
+            m_transforms.setParent(handle, findHandle(instance.getParent()));
+
+            instance.setAsClean();
+        }
+    });
+
+    m_transforms.update();
+}
+
+Mat4<f32> MeshComposite::getWorld(const Node& node, u64 instance) const {
+    return math::make_mat4(m_transforms.getWorld(node.m_handles[instance]));
+}
+
+TransformHierarchy::Handle MeshComposite::findHandle(const Transform* instance) {
+    auto handle = TransformHierarchy::invalidHandle;
+    if (not instance) return handle;
+
+    traverse([&](Node& node) {
+        for (u64 i = 0; i < node.m_instances.size(); ++i)
+            if (&node.m_instances[i] == instance) handle = node.m_handles[i];
+    });
+
+    if (handle == TransformHierarchy::invalidHandle)
+        log::warn("Transform parent outside of the mesh composite is ignored");
+    return handle;
+}
+
 }  // namespace sl
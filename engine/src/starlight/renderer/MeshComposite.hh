@@ -4,6 +4,7 @@
 #include <span>
 
 #include "starlight/core/math/Transform.hh"
+#include "starlight/core/math/TransformHierarchy.hh"
 #include "starlight/core/Concepts.hh"
 
 #include "Mesh.hh"
@@ -17,6 +18,12 @@ public:
         friend class MeshComposite;
 
     public:
+        struct LOD {
+            SharedPtr<Mesh> mesh;
+            // fraction of the screen height below which it replaces the level before
+            f32 screenSize;
+        };
+
         explicit Node(
           SharedPtr<Mesh> mesh, SharedPtr<Material> material, u64 depth, u64 index
         );
@@ -25,6 +32,13 @@ public:
 
         Transform& addInstance();
 
+        // coarser levels following the node mesh, added in descending screen sizes
+        void addLOD(SharedPtr<Mesh> mesh, f32 screenSize);
+        std::span<const LOD> getLODs() const;
+
+        // the level is kept per instance between frames, for the hysteresis
+        Mesh* selectLOD(u64 instance, f32 screenSize);
+
     private:
         template <typename C>
         requires Callable<C, void, Node&>
@@ -43,7 +57,14 @@ public:
         u64 m_index;
 
         std::vector<Transform> m_instances;
+        // per instance, created by the composite on its next transforms update
+        std::vector<TransformHierarchy::Handle> m_handles;
         std::vector<Node> m_children;
+
+        std::vector<LOD> m_lods;
+        std::vector<f32> m_lodScreenSizes;
+        // per instance, 0 is the node mesh
+        std::vector<u32> m_instanceLODs;
     };
 
     explicit MeshComposite(SharedPtr<Mesh> mesh, SharedPtr<Material> material) :
@@ -51,6 +72,15 @@ public:
 
     Node& getRoot() { return m_root; }
 
+    // pushes the changed instances into the hierarchy and recomputes their worlds,
+    // parents are followed only between instances of this composite
+    void updateTransforms();
+    // up to date after updateTransforms()
+    Mat4<f32> getWorld(const Node& node, u64 instance) const;
+
+    // never moves, so shadow passes can keep its shadows between frames
+    bool isStatic = false;
+
     template <typename C>
     requires Callable<C, void, Node&>
     void traverse(C&& callback) {
@@ -58,6 +88,9 @@ public:
     }
 
 private:
+    TransformHierarchy::Handle findHandle(const Transform* instance);
+
+    TransformHierarchy m_transforms;
     Node m_root;
 };
 
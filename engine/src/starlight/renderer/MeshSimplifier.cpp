@@ -0,0 +1,334 @@
+#include "MeshSimplifier.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+#include "starlight/core/Log.hh"
+
+namespace sl {
+
+namespace {
+
+void subtract(const f32* lhs, const f32* rhs, f32* out) {
+    for (u32 i = 0; i < 3u; ++i) out[i] = lhs[i] - rhs[i];
+}
+
+void cross(const f32* lhs, const f32* rhs, f32* out) {
+    out[0] = lhs[1] * rhs[2] - lhs[2] * rhs[1];
+    out[1] = lhs[2] * rhs[0] - lhs[0] * rhs[2];
+    out[2] = lhs[0] * rhs[1] - lhs[1] * rhs[0];
+}
+
+f32 dot(const f32* lhs, const f32* rhs) {
+    return lhs[0] * rhs[0] + lhs[1] * rhs[1] + lhs[2] * rhs[2];
+}
+
+// not normalized, twice the area long
+void calculateNormal(const f32* a, const f32* b, const f32* c, f32* normal) {
+    f32 ab[3];
+    f32 ac[3];
+    subtract(b, a, ab);
+    subtract(c, a, ac);
+    cross(ab, ac, normal);
+}
+
+}  // namespace
+
+MeshSimplifier::MeshSimplifier(const VertexPositions& positions) : m_error(0.0f) {
+    normalizePositions(positions);
+    findSharedPositions();
+}
+
+std::vector<u32> MeshSimplifier::simplify(
+  std::span<const u32> indices, const Properties& props
+) {
+    log::expect(
+      indices.size() % 3u == 0u, "Index count is not a multiple of 3: {}",
+      indices.size()
+    );
+
+    const auto vertexCount = static_cast<u32>(m_positionIds.size());
+    const auto maxCost     = props.maxError * props.maxError;
+
+    std::vector<u32> result{ indices.begin(), indices.end() };
+    m_error = 0.0f;
+
+    const auto locked = findLockedVertices(indices);
+    auto quadrics     = calculateQuadrics(indices);
+
+    std::vector<u32> offsets(vertexCount + 1u);
+    std::vector<u32> triangles;
+    std::vector<Collapse> collapses;
+    std::vector<u32> remap(vertexCount);
+    std::vector<u8> used(vertexCount);
+
+    while (result.size() > props.targetIndexCount) {
+        const auto triangleCount = static_cast<u32>(result.size() / 3u);
+
+        // triangles around every vertex, as offsets into one flat array
+        std::fill(offsets.begin(), offsets.end(), 0u);
+        for (const auto index : result) ++offsets[index + 1u];
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+        triangles.resize(result.size());
+        auto cursor = offsets;
+        for (u32 i = 0; i < result.size(); ++i)
+            triangles[cursor[result[i]]++] = i / 3u;
+
+        collapses.clear();
+        for (u32 i = 0; i < result.size(); ++i) {
+            const auto a = result[i];
+            const auto b = result[i - i % 3u + (i + 1u) % 3u];
+
+            const auto& quadricA = quadrics[m_positionIds[a]];
+            const auto& quadricB = quadrics[m_positionIds[b]];
+
+            if (not locked[a])
+                collapses.push_back({ a, b, calculateCost(quadricA, quadricB, b) });
+            if (not locked[b])
+                collapses.push_back({ b, a, calculateCost(quadricA, quadricB, a) });
+        }
+        std::sort(
+          collapses.begin(), collapses.end(),
+          [](const auto& lhs, const auto& rhs) { return lhs.cost < rhs.cost; }
+        );
+
+        // every collapse removes about two triangles
+        const auto excess = triangleCount - props.targetIndexCount / 3u;
+        const auto budget = std::max<u64>(excess / 2u, 1u);
+
+        std::iota(remap.begin(), remap.end(), 0u);
+        std::fill(used.begin(), used.end(), 0u);
+
+        u64 collapseCount = 0u;
+        for (const auto& [from, to, cost] : collapses) {
+            if (cost > maxCost || collapseCount == budget) break;
+            if (used[from] || used[to]) continue;
+            if (flipsTriangles(from, to, result, offsets, triangles)) continue;
+
+            remap[from] = to;
+            const auto& source = quadrics[m_positionIds[from]];
+            auto& target       = quadrics[m_positionIds[to]];
+            for (u32 i = 0; i < target.size(); ++i) target[i] += source[i];
+
+            m_error = std::max(m_error, std::sqrt(cost));
+            ++collapseCount;
+
+            // neighbours keep their triangles this pass, so the flip tests of the
+            // following collapses still see the current mesh
+            used[to] = 1u;
+            for (auto i = offsets[from]; i < offsets[from + 1u]; ++i) {
+                const auto triangle = triangles[i];
+                for (u32 corner = 0; corner < 3u; ++corner)
+                    used[result[triangle * 3u + corner]] = 1u;
+            }
+        }
+
+        if (collapseCount == 0u) break;
+
+        u64 size = 0u;
+        for (u64 i = 0; i < result.size(); i += 3u) {
+            const auto a = remap[result[i]];
+            const auto b = remap[result[i + 1u]];
+            const auto c = remap[result[i + 2u]];
+
+            if (a == b || b == c || c == a) continue;
+
+            result[size++] = a;
+            result[size++] = b;
+            result[size++] = c;
+        }
+        result.resize(size);
+    }
+
+    return result;
+}
+
+f32 MeshSimplifier::getError() const { return m_error; }
+
+void MeshSimplifier::normalizePositions(const VertexPositions& positions) {
+    const auto* bytes = reinterpret_cast<const u8*>(positions.data);
+
+    m_positions.resize(positions.count * 3u);
+    for (u64 i = 0; i < positions.count; ++i) {
+        std::memcpy(
+          &m_positions[i * 3u], bytes + i * positions.stride, sizeof(f32) * 3u
+        );
+    }
+
+    f32 lower[3] = { max<f32>(), max<f32>(), max<f32>() };
+    f32 upper[3] = { -max<f32>(), -max<f32>(), -max<f32>() };
+    for (u64 i = 0; i < m_positions.size(); ++i) {
+        lower[i % 3u] = std::min(lower[i % 3u], m_positions[i]);
+        upper[i % 3u] = std::max(upper[i % 3u], m_positions[i]);
+    }
+
+    // errors are relative to the size of the mesh then
+    auto scale = std::max(
+      { upper[0] - lower[0], upper[1] - lower[1], upper[2] - lower[2] }
+    );
+    if (scale <= 0.0f) scale = 1.0f;
+
+    for (u64 i = 0; i < m_positions.size(); ++i)
+        m_positions[i] = (m_positions[i] - lower[i % 3u]) / scale;
+}
+
+void MeshSimplifier::findSharedPositions() {
+    const auto vertexCount = static_cast<u32>(m_positions.size() / 3u);
+
+    std::vector<u32> order(vertexCount);
+    std::iota(order.begin(), order.end(), 0u);
+
+    const auto compare = [&](u32 lhs, u32 rhs) {
+        const auto* l = getPosition(lhs);
+        const auto* r = getPosition(rhs);
+        return std::lexicographical_compare(l, l + 3, r, r + 3);
+    };
+    std::sort(order.begin(), order.end(), compare);
+
+    m_positionIds.resize(vertexCount);
+    m_seams.assign(vertexCount, 0u);
+
+    for (u32 begin = 0; begin < vertexCount;) {
+        auto end = begin + 1u;
+        while (end < vertexCount && not compare(order[begin], order[end])) ++end;
+
+        const auto id =
+          *std::min_element(order.begin() + begin, order.begin() + end);
+        for (auto i = begin; i < end; ++i) {
+            m_positionIds[order[i]] = id;
+            m_seams[order[i]]       = end - begin > 1u;
+        }
+        begin = end;
+    }
+}
+
+std::vector<u8> MeshSimplifier::findLockedVertices(
+  std::span<const u32> indices
+) const {
+    // edges by position, an edge not shared by exactly two triangles is a border
+    std::vector<u64> edges;
+    edges.reserve(indices.size());
+
+    for (u64 i = 0; i < indices.size(); ++i) {
+        const u64 a = m_positionIds[indices[i]];
+        const u64 b = m_positionIds[indices[i - i % 3u + (i + 1u) % 3u]];
+        edges.push_back(std::min(a, b) << 32u | std::max(a, b));
+    }
+    std::sort(edges.begin(), edges.end());
+
+    std::vector<u8> lockedPositions(m_positionIds.size());
+    for (u64 begin = 0; begin < edges.size();) {
+        auto end = begin + 1u;
+        while (end < edges.size() && edges[end] == edges[begin]) ++end;
+
+        if (end - begin != 2u) {
+            lockedPositions[edges[begin] >> 32u]         = 1u;
+            lockedPositions[edges[begin] & 0xffffffffu] = 1u;
+        }
+        begin = end;
+    }
+
+    auto locked = m_seams;
+    for (u32 i = 0; i < locked.size(); ++i)
+        locked[i] |= lockedPositions[m_positionIds[i]];
+
+    return locked;
+}
+
+std::vector<MeshSimplifier::Quadric> MeshSimplifier::calculateQuadrics(
+  std::span<const u32> indices
+) const {
+    // vertices of a seam share one quadric, the surface is the same on both sides
+    std::vector<Quadric> quadrics(m_positionIds.size(), Quadric{});
+
+    for (u64 i = 0; i < indices.size(); i += 3u) {
+        const auto* a = getPosition(indices[i]);
+        const auto* b = getPosition(indices[i + 1u]);
+        const auto* c = getPosition(indices[i + 2u]);
+
+        f32 normal[3];
+        calculateNormal(a, b, c, normal);
+
+        const auto length = std::sqrt(dot(normal, normal));
+        if (length == 0.0f) continue;
+
+        const f32 plane[4] = {
+            normal[0] / length, normal[1] / length, normal[2] / length,
+            -dot(normal, a) / length
+        };
+        // weighted by area, so slivers do not pull as much as big triangles
+        const auto weight = length * 0.5f;
+
+        Quadric quadric;
+        u32 element = 0u;
+        for (u32 row = 0; row < 4u; ++row)
+            for (u32 column = row; column < 4u; ++column)
+                quadric[element++] = plane[row] * plane[column] * weight;
+        quadric[element] = weight;
+
+        for (u32 corner = 0; corner < 3u; ++corner) {
+            auto& target = quadrics[m_positionIds[indices[i + corner]]];
+            for (u32 j = 0; j < target.size(); ++j) target[j] += quadric[j];
+        }
+    }
+
+    return quadrics;
+}
+
+f32 MeshSimplifier::calculateCost(
+  const Quadric& lhs, const Quadric& rhs, u32 vertex
+) const {
+    const auto* p  = getPosition(vertex);
+    const f32 v[4] = { p[0], p[1], p[2], 1.0f };
+
+    f32 error   = 0.0f;
+    u32 element = 0u;
+    for (u32 row = 0; row < 4u; ++row) {
+        for (u32 column = row; column < 4u; ++column) {
+            // off diagonal elements stand for both halves of the matrix
+            const auto factor = row == column ? 1.0f : 2.0f;
+            error += factor * (lhs[element] + rhs[element]) * v[row] * v[column];
+            ++element;
+        }
+    }
+
+    const auto weight = lhs[element] + rhs[element];
+    return weight > 0.0f ? std::max(error / weight, 0.0f) : 0.0f;
+}
+
+bool MeshSimplifier::flipsTriangles(
+  u32 from, u32 to, std::span<const u32> indices, std::span<const u32> offsets,
+  std::span<const u32> triangles
+) const {
+    for (auto i = offsets[from]; i < offsets[from + 1u]; ++i) {
+        const auto* corners = &indices[triangles[i] * 3u];
+        // collapses into a line and goes away
+        if (corners[0] == to || corners[1] == to || corners[2] == to) continue;
+
+        const f32* before[3];
+        const f32* after[3];
+        for (u32 corner = 0; corner < 3u; ++corner) {
+            before[corner] = getPosition(corners[corner]);
+            after[corner] =
+              corners[corner] == from ? getPosition(to) : before[corner];
+        }
+
+        f32 normalBefore[3];
+        f32 normalAfter[3];
+        calculateNormal(before[0], before[1], before[2], normalBefore);
+        calculateNormal(after[0], after[1], after[2], normalAfter);
+
+        // also catches triangles squashed to nothing
+        if (dot(normalBefore, normalAfter) <= 0.0f) return true;
+    }
+    return false;
+}
+
+const f32* MeshSimplifier::getPosition(u32 vertex) const {
+    return &m_positions[vertex * 3u];
+}
+
+}  // namespace sl
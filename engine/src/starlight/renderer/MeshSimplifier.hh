@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <span>
+#include <vector>
+
+#include "starlight/core/Core.hh"
+
+namespace sl {
+
+// positions of an interleaved vertex array, stride in bytes between two vertices
+struct VertexPositions {
+    const f32* data;
+    u64 count;
+    u64 stride;
+};
+
+/*
+    Triangle list simplification with quadric error metrics (Garland-Heckbert). Each
+    vertex accumulates the planes of its triangles, collapsing an edge moves one end
+    onto the other and costs the summed quadrics measured there. Only half edge
+    collapses are done, vertices never move, so the simplified mesh indexes the
+    original vertices and keeps their normals and texture coordinates as they were.
+    Collapses run in passes, cheapest first, every vertex takes part in at most one
+    collapse per pass. Vertices on borders or on attribute seams, those sharing a
+    position with another vertex, are never moved, so outlines and seams survive.
+*/
+class MeshSimplifier {
+public:
+    struct Properties {
+        // the result has at most this many indices unless the error limit is hit
+        u64 targetIndexCount;
+        // largest allowed distance from the original surface, relative to the
+        // largest side of the bounding box
+        f32 maxError = 0.01f;
+    };
+
+    explicit MeshSimplifier(const VertexPositions& positions);
+
+    std::vector<u32> simplify(std::span<const u32> indices, const Properties& props);
+
+    // of the last simplification, relative like maxError
+    f32 getError() const;
+
+private:
+    // symmetric 4x4 matrix as its upper triangle row by row, then the summed area
+    // of the planes, which turns the error into a mean squared distance
+    using Quadric = std::array<f32, 11>;
+
+    struct Collapse {
+        u32 from;
+        u32 to;
+        f32 cost;
+    };
+
+    void normalizePositions(const VertexPositions& positions);
+    void findSharedPositions();
+
+    std::vector<u8> findLockedVertices(std::span<const u32> indices) const;
+    std::vector<Quadric> calculateQuadrics(std::span<const u32> indices) const;
+
+    f32 calculateCost(const Quadric& lhs, const Quadric& rhs, u32 vertex) const;
+    bool flipsTriangles(
+      u32 from, u32 to, std::span<const u32> indices, std::span<const u32> offsets,
+      std::span<const u32> triangles
+    ) const;
+
+    const f32* getPosition(u32 vertex) const;
+
+    // xyz of every vertex, moved and scaled into the 0..1 box
+    std::vector<f32> m_positions;
+    // the first vertex with the same position, seams are where it differs
+    std::vector<u32> m_positionIds;
+    std::vector<u8> m_seams;
+    f32 m_error;
+};
+
+}  // namespace sl
@@ -22,6 +22,13 @@ void RenderGraph::render(RenderPacket& renderPacket) {
     );
 }
 
+DrawStats RenderGraph::getDrawStats() const {
+    DrawStats stats;
+    for (const auto& renderPass : m_activeRenderPasses)
+        stats += renderPass->getDrawStats();
+    return stats;
+}
+
 void RenderGraph::onWindowResize() { rebuildChain(); }
 
 void RenderGraph::rebuildChain() {
@@ -40,6 +40,9 @@ public:
     void render(RenderPacket& renderPacket);
     void rebuildChain();
 
+    // summed over the active passes, describes the last rendered frame
+    DrawStats getDrawStats() const;
+
 private:
     void onWindowResize();
 
@@ -1,11 +1,13 @@
 #pragma once
 
 #include "starlight/core/math/Core.hh"
+#include "starlight/core/memory/FrameAllocator.hh"
 
 #include "gpu/Texture.hh"
 #include "Mesh.hh"
 #include "light/PointLight.hh"
 #include "light/DirectionalLight.hh"
+#include "light/ShadowCascades.hh"
 #include "camera/Camera.hh"
 #include "Material.hh"
 #include "Skybox.hh"
@@ -16,15 +18,22 @@ struct RenderEntity {
     Mat4<f32> worldTransform;
     Mesh* mesh;
     Material* material;
+    // its shadows are cached between frames
+    bool isStatic = false;
 };
 
 struct RenderPacket {
     Skybox* skybox;
     Camera* camera;
-    std::vector<PointLight> pointLights;
-    std::vector<DirectionalLight> directionalLights;
-    std::vector<RenderEntity> entities;
-    std::vector<Texture*> shadowMaps;
+    FrameVector<PointLight> pointLights;
+    FrameVector<DirectionalLight> directionalLights;
+    // visible to the camera
+    FrameVector<RenderEntity> entities;
+    // all entities, shadow passes cull them on their own
+    FrameVector<RenderEntity> shadowCasters;
+    FrameVector<Texture*> shadowMaps;
+    // filled by the shadow pass, cascades of the first directional light
+    FrameVector<ShadowCascade> shadowCascades;
     u64 frameNumber;
 };
 
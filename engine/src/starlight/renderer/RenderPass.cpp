@@ -1,5 +1,8 @@
 #include "RenderPass.hh"
 
+#include <algorithm>
+#include <bit>
+
 #include <fmt/core.h>
 
 #include "starlight/core/Function.hh"
@@ -8,6 +11,8 @@
 
 namespace sl {
 
+static constexpr u64 minInstanceCapacity = 1024;
+
 RenderPassBase::RenderPassBase(
   Renderer& renderer, const Vec2<f32>& viewportOffset,
   std::optional<std::string> name
@@ -62,6 +67,8 @@ RenderPassBackend::Properties RenderPassBase::generateRenderPassProperties(
     return props;
 }
 
+const DrawStats& RenderPassBase::getDrawStats() const { return m_drawStats; }
+
 Pipeline::Properties RenderPassBase::createPipelineProperties() {
     return Pipeline::Properties::createDefault();
 }
@@ -76,6 +83,9 @@ RenderPass::RenderPass(
 void RenderPass::run(
   RenderPacket& packet, CommandBuffer& commandBuffer, u32 imageIndex, u64 frameNumber
 ) {
+    m_drawStats  = DrawStats{};
+    m_boundState = BoundState{};
+
     const auto viewport = getViewport();
     commandBuffer.execute(SetViewportCommand{
       .offset = viewport.offset,
@@ -107,6 +117,14 @@ void RenderPass::setLocalUniforms(
   CommandBuffer& commandBuffer, u64 frameNumber, u32 id, u32 imageIndex,
   ShaderDataBinder::UniformCallback&& callback
 ) {
+    // set is already bound and up to date for this frame
+    if (m_boundState.localDescriptorSet == id) {
+        ++m_drawStats.skippedBinds;
+        return;
+    }
+    m_boundState.localDescriptorSet = id;
+    ++m_drawStats.descriptorSetBinds;
+
     m_shaderDataBinder->setLocalUniforms(
       *m_pipeline, commandBuffer, frameNumber, id, imageIndex, std::move(callback)
     );
@@ -124,27 +142,90 @@ void RenderPass::setGlobalUniforms(
   CommandBuffer& commandBuffer, u64 frameNumber, u32 imageIndex,
   ShaderDataBinder::UniformCallback&& callback
 ) {
+    ++m_drawStats.descriptorSetBinds;
     m_shaderDataBinder->setGlobalUniforms(
       *m_pipeline, commandBuffer, frameNumber, imageIndex, std::move(callback)
     );
 }
 
-void RenderPass::drawMesh(Mesh& mesh, CommandBuffer& commandBuffer) {
-    const auto& memoryLayout = mesh.getMemoryLayout();
+void RenderPass::setInstanceTransforms(
+  CommandBuffer& commandBuffer, u32 imageIndex, std::span<const Mat4<f32>> transforms
+) {
+    if (transforms.empty()) return;
+
+    if (m_instanceBuffers.size() <= imageIndex)
+        m_instanceBuffers.resize(imageIndex + 1u);
+
+    auto& [buffer, capacity] = m_instanceBuffers[imageIndex];
+
+    if (capacity < transforms.size()) {
+        capacity =
+          std::bit_ceil(std::max<u64>(transforms.size(), minInstanceCapacity));
+        log::debug(
+          "{}: growing instance buffer {} to {} instances", name, imageIndex,
+          capacity
+        );
+        // the old buffer is destroyed once the frames reading it completed
+        buffer.clear();
+        buffer = Buffer::create(Buffer::Properties{
+          .size = capacity * sizeof(Mat4<f32>),
+          .memoryProperty =
+            MemoryProperty::MEMORY_PROPERTY_HOST_VISIBLE_BIT
+            | MemoryProperty::MEMORY_PROPERTY_HOST_COHERENT_BIT,
+          .usage        = BufferUsage::BUFFER_USAGE_VERTEX_BUFFER_BIT,
+          .bindOnCreate = true,
+        });
+    }
+
+    buffer->copy(
+      Range{ .offset = 0u, .size = transforms.size_bytes() }, transforms.data()
+    );
 
     commandBuffer.execute(BindVertexBufferCommand{
-      .buffer = m_renderer.getVertexBuffer(),
-      .offset = memoryLayout.vertexBufferRange.offset,
+      .buffer  = *buffer,
+      .offset  = 0u,
+      .binding = Shader::instanceBinding,
     });
+    ++m_drawStats.vertexBufferBinds;
+}
 
-    commandBuffer.execute(BindIndexBufferCommand{
-      .buffer = m_renderer.getIndexBuffer(),
-      .offset = memoryLayout.indexBufferRange.offset,
-    });
+void RenderPass::drawMesh(
+  Mesh& mesh, CommandBuffer& commandBuffer, u32 firstInstance, u32 instanceCount
+) {
+    const auto& memoryLayout = mesh.getMemoryLayout();
+
+    const auto vertexOffset = memoryLayout.vertexBufferRange.offset;
+    const auto indexOffset  = memoryLayout.indexBufferRange.offset;
+
+    if (m_boundState.vertexBufferOffset != vertexOffset) {
+        commandBuffer.execute(BindVertexBufferCommand{
+          .buffer = m_renderer.getVertexBuffer(),
+          .offset = vertexOffset,
+        });
+        m_boundState.vertexBufferOffset = vertexOffset;
+        ++m_drawStats.vertexBufferBinds;
+    } else {
+        ++m_drawStats.skippedBinds;
+    }
+
+    if (m_boundState.indexBufferOffset != indexOffset) {
+        commandBuffer.execute(BindIndexBufferCommand{
+          .buffer = m_renderer.getIndexBuffer(),
+          .offset = indexOffset,
+        });
+        m_boundState.indexBufferOffset = indexOffset;
+        ++m_drawStats.indexBufferBinds;
+    } else {
+        ++m_drawStats.skippedBinds;
+    }
 
     commandBuffer.execute(DrawIndexedCommand{
-      .indexCount = static_cast<u32>(memoryLayout.indexCount),
+      .indexCount    = static_cast<u32>(memoryLayout.indexCount),
+      .instanceCount = instanceCount,
+      .firstInstance = firstInstance,
     });
+    ++m_drawStats.drawCalls;
+    m_drawStats.instances += instanceCount;
 }
 
 }  // namespace sl
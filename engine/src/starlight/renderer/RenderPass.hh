@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <optional>
+#include <span>
 #include <unordered_map>
 
 #include "starlight/core/Core.hh"
@@ -9,6 +10,7 @@
 #include "starlight/core/Enum.hh"
 #include "starlight/core/Id.hh"
 #include "starlight/renderer/RenderPacket.hh"
+#include "starlight/renderer/DrawList.hh"
 
 #include "gpu/Texture.hh"
 #include "gpu/CommandBuffer.hh"
@@ -37,6 +39,9 @@ public:
       u64 frameNumber
     ) = 0;
 
+    // counters of the last run
+    const DrawStats& getDrawStats() const;
+
 protected:
     virtual Rect2<u32> getViewport();
 
@@ -54,6 +59,7 @@ protected:
     Renderer& m_renderer;
     UniquePtr<RenderPassBackend> m_renderPassBackend;
     Vec2<f32> m_viewportOffset;
+    DrawStats m_drawStats;
 };
 
 class RenderPass : public RenderPassBase {
@@ -77,6 +83,21 @@ private:
 
     std::unordered_map<u32, u32> m_localDescriptorSets;
 
+    // host visible, one per swapchain image, grown on demand
+    struct InstanceBuffer {
+        UniquePtr<Buffer> buffer = nullptr;
+        u64 capacity             = 0u;
+    };
+    std::vector<InstanceBuffer> m_instanceBuffers;
+
+    // state recorded so far in the current run, used to drop redundant binds
+    struct BoundState {
+        std::optional<u64> vertexBufferOffset;
+        std::optional<u64> indexBufferOffset;
+        std::optional<u32> localDescriptorSet;
+    };
+    BoundState m_boundState;
+
     virtual void render(
       RenderPacket& packet, CommandBuffer& commandBuffer, u32 imageIndex,
       u64 frameNumber
@@ -104,7 +125,17 @@ protected:
       ShaderDataBinder::UniformCallback&& callback
     );
 
-    void drawMesh(Mesh& mesh, CommandBuffer& buffer);
+    // uploads per instance model matrices and binds them to the instance binding,
+    // drawMesh instance ranges index into them
+    void setInstanceTransforms(
+      CommandBuffer& commandBuffer, u32 imageIndex,
+      std::span<const Mat4<f32>> transforms
+    );
+
+    void drawMesh(
+      Mesh& mesh, CommandBuffer& buffer, u32 firstInstance = 0u,
+      u32 instanceCount = 1u
+    );
 };
 
 }  // namespace sl
@@ -8,7 +8,10 @@
 
 namespace sl {
 
+// initial element count of the geometry buffers, they grow when full
 static constexpr u64 bufferSize = 1024 * 1024;
+// budget of the incremental compaction of each geometry buffer
+static constexpr u64 defragmentationBytesPerFrame = 1024 * 1024;
 
 static UniquePtr<Buffer> createVertexBuffer();
 static UniquePtr<Buffer> createIndexBuffer();
@@ -31,14 +34,18 @@ Buffer& Renderer::getIndexBuffer() { return *m_indexBuffer; }
 
 Buffer& Renderer::getVertexBuffer() { return *m_vertexBuffer; }
 
+u8 Renderer::getMaxFramesInFlight() const { return m_maxFramesInFlight; }
+
 void Renderer::createSyncPrimitives() {
     m_frameFences.clear();
+    m_frameFenceNumbers.clear();
     m_imageFences.clear();
     m_imageAvailableSemaphores.clear();
     m_queueCompleteSemaphores.clear();
 
     for (u8 i = 0; i < m_maxFramesInFlight; ++i) {
         m_frameFences.push_back(Fence::create(Fence::State::signaled));
+        m_frameFenceNumbers.push_back(0u);
         m_imageFences.push_back(nullptr);
         m_imageAvailableSemaphores.push_back(Semaphore::create());
         m_queueCompleteSemaphores.push_back(Semaphore::create());
@@ -80,6 +87,10 @@ std::optional<u8> Renderer::beginFrame() {
     }
 
     m_frameFences[m_currentFrame]->wait();
+    // resources released before the frame got submitted are no longer in use
+    Device::get().onFrameCompleted(m_frameFenceNumbers[m_currentFrame]);
+    // uploads recorded by the update get copied while the frame is being recorded
+    Device::get().flushUploads();
 
     auto imageIndex = m_swapchain->acquireNextImageIndex(
       m_imageAvailableSemaphores[m_currentFrame].get()
@@ -91,6 +102,10 @@ std::optional<u8> Renderer::beginFrame() {
     auto& commandBuffer = *m_commandBuffers[*imageIndex];
     commandBuffer.begin();
 
+    // meshes are compacted a bit every frame, before anything draws them
+    m_vertexBuffer->defragment(commandBuffer, defragmentationBytesPerFrame);
+    m_indexBuffer->defragment(commandBuffer, defragmentationBytesPerFrame);
+
     const auto& framebufferSize = Window::get().getFramebufferSize();
 
     commandBuffer.execute(SetViewportCommand{
@@ -138,8 +153,13 @@ void Renderer::endFrame(u32 imageIndex) {
     };
 
     auto& device = Device::get();
+    // only uploads recorded along with the frame are left, usually none
+    device.flushUploads();
 
     if (device.getGraphicsQueue().submit(submitInfo)) [[likely]] {
+        m_frameFenceNumbers[m_currentFrame] = m_frameNumber;
+        device.onFrameSubmitted(m_frameNumber);
+
         Queue::PresentInfo presentInfo{
             .swapchain     = *m_swapchain,
             .imageIndex    = imageIndex,
@@ -163,6 +183,7 @@ UniquePtr<Buffer> createVertexBuffer() {
         | BufferUsage::BUFFER_USAGE_TRANSFER_SRC_BIT
         | BufferUsage::BUFFER_USAGE_VERTEX_BUFFER_BIT,
       .bindOnCreate = true,
+      .isGrowable   = true,
     });
 }
 
@@ -175,6 +196,7 @@ UniquePtr<Buffer> createIndexBuffer() {
         | BufferUsage::BUFFER_USAGE_TRANSFER_SRC_BIT
         | BufferUsage::BUFFER_USAGE_INDEX_BUFFER_BIT,
       .bindOnCreate = true,
+      .isGrowable   = true,
     });
 }
 
@@ -23,6 +23,8 @@ public:
     Buffer& getVertexBuffer();
     Buffer& getIndexBuffer();
 
+    u8 getMaxFramesInFlight() const;
+
     template <typename Callback>
     requires Callable<Callback, void, CommandBuffer&, u8, u64>
     void renderFrame(Callback&& callback) {
@@ -59,6 +61,8 @@ private:
     std::vector<UniquePtr<Semaphore>> m_imageAvailableSemaphores;
     std::vector<UniquePtr<Semaphore>> m_queueCompleteSemaphores;
     std::vector<UniquePtr<Fence>> m_frameFences;
+    // number of the last frame submitted with each frame fence
+    std::vector<u64> m_frameFenceNumbers;
     std::vector<Fence*> m_imageFences;
 
     EventHandlerSentinel m_eventSentinel;
@@ -18,6 +18,10 @@ Camera::Camera(
 
 const Mat4<f32>& Camera::getProjectionMatrix() const { return m_projectionMatrix; }
 
+const Camera::ProjectionProperties& Camera::getProjectionProperties() const {
+    return m_projectionProperties;
+}
+
 void Camera::calculateProjectionMatrix() {
     m_projectionMatrix = math::perspective(
       math::radians(m_projectionProperties.fov),
@@ -30,6 +30,7 @@ public:
     virtual void update(float deltaTime)    = 0;
 
     const Mat4<f32>& getProjectionMatrix() const;
+    const ProjectionProperties& getProjectionProperties() const;
 
 protected:
     void calculateProjectionMatrix();
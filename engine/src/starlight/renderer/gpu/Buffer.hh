@@ -1,11 +1,13 @@
 #pragma once
 
+#include <functional>
 #include <optional>
 
 #include "starlight/core/Core.hh"
 #include "starlight/renderer/Core.hh"
 
 #include "Sync.hh"
+#include "fwd.hh"
 
 namespace sl {
 
@@ -15,6 +17,10 @@ struct Buffer : public NonCopyable, public NonMovable {
         MemoryProperty memoryProperty;
         BufferUsage usage;
         bool bindOnCreate;
+        MemoryStrategy memoryStrategy = MemoryStrategy::general;
+        // reallocated with twice the size when an allocation doesn't fit, device
+        // local ones need the transfer source and destination usages
+        bool isGrowable = false;
 
         static Properties staging(u64 size) {
             return Buffer::Properties{
@@ -22,12 +28,16 @@ struct Buffer : public NonCopyable, public NonMovable {
                 .memoryProperty =
                   MemoryProperty::MEMORY_PROPERTY_HOST_VISIBLE_BIT
                   | MemoryProperty::MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                .usage        = BufferUsage::BUFFER_USAGE_TRANSFER_SRC_BIT,
-                .bindOnCreate = true
+                .usage          = BufferUsage::BUFFER_USAGE_TRANSFER_SRC_BIT,
+                .bindOnCreate   = true,
+                .memoryStrategy = MemoryStrategy::linear,
             };
         }
     };
 
+    // called with the new place of a range moved by defragment
+    using RelocationCallback = std::function<void(const Range&)>;
+
     static UniquePtr<Buffer> create(const Properties& props);
 
     virtual ~Buffer() = default;
@@ -37,8 +47,17 @@ struct Buffer : public NonCopyable, public NonMovable {
     virtual void* lockMemory(const Range& range = Range{ 0u, max<u64>() }) = 0;
     virtual void unlockMemory()                                            = 0;
 
-    virtual std::optional<Range> allocate(u64 size, const void* data = nullptr) = 0;
-    virtual void free(const Range& range)                                       = 0;
+    // only ranges with a relocation callback are moved by defragment
+    virtual std::optional<Range> allocate(
+      u64 size, const void* data = nullptr, RelocationCallback&& onRelocation = {}
+    ) = 0;
+    // the range is reused once the frames in flight completed
+    virtual void free(const Range& range) = 0;
+
+    // records copies of up to maxBytes of relocatable ranges into free space below
+    // them, outside of a render pass and before anything reads the buffer in the
+    // command buffer; returns the number of bytes moved
+    virtual u64 defragment(CommandBuffer& commandBuffer, u64 maxBytes) = 0;
 
     virtual void copy(const Range& range, const void* data) = 0;
 };
@@ -11,6 +11,7 @@ namespace sl {
 struct BindVertexBufferCommand {
     Buffer& buffer;
     u64 offset;
+    u32 binding = 0u;
 };
 
 struct BindIndexBufferCommand {
@@ -43,8 +44,15 @@ struct SetScissorsCommand {
     Vec2<u32> size;
 };
 
+// clears a region of the depth attachment, only valid inside of a render pass
+struct ClearDepthCommand {
+    Vec2<u32> offset;
+    Vec2<u32> size;
+    f32 depth = 1.0f;
+};
+
 using Command = std::variant<
   BindVertexBufferCommand, BindIndexBufferCommand, DrawCommand, DrawIndexedCommand,
-  SetViewportCommand, SetScissorsCommand>;
+  SetViewportCommand, SetScissorsCommand, ClearDepthCommand>;
 
 }  // namespace sl
@@ -0,0 +1,35 @@
+#include "DeletionQueue.hh"
+
+#include "starlight/core/Log.hh"
+
+namespace sl {
+
+DeletionQueue::~DeletionQueue() { flush(); }
+
+void DeletionQueue::push(u64 frame, Deleter&& deleter) {
+    log::expect(
+      m_entries.empty() || m_entries.back().frame <= frame,
+      "Resource retired with frame {} after one of frame {}", frame,
+      m_entries.empty() ? 0u : m_entries.back().frame
+    );
+    m_entries.push_back(Entry{ .frame = frame, .deleter = std::move(deleter) });
+}
+
+u64 DeletionQueue::collect(u64 completedFrame) {
+    u64 count = 0u;
+
+    while (not m_entries.empty() && m_entries.front().frame <= completedFrame) {
+        // popped first, a deleter may retire something else
+        auto deleter = std::move(m_entries.front().deleter);
+        m_entries.pop_front();
+        deleter();
+        ++count;
+    }
+    return count;
+}
+
+u64 DeletionQueue::flush() { return collect(max<u64>()); }
+
+u64 DeletionQueue::getSize() const { return m_entries.size(); }
+
+}  // namespace sl
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <deque>
+#include <functional>
+
+#include "starlight/core/Core.hh"
+
+namespace sl {
+
+/*
+    Destruction of gpu resources postponed until the frames that may still use them
+    have completed, instead of waiting for the whole device. Each deleter is pushed
+    with the number of the last frame that could reference the resource and runs
+    once that frame is reported as completed. Frames complete in submission order
+    so the queue stays sorted and only its front is ever checked. Not thread safe.
+*/
+class DeletionQueue : public NonCopyable, public NonMovable {
+public:
+    using Deleter = std::function<void()>;
+
+    // runs whatever is still queued, the device has to be idle by then
+    ~DeletionQueue();
+
+    // frame numbers must not decrease between pushes
+    void push(u64 frame, Deleter&& deleter);
+
+    // runs deleters of frames up to and including the given one, returns their count
+    u64 collect(u64 completedFrame);
+    u64 flush();
+
+    u64 getSize() const;
+
+private:
+    struct Entry {
+        u64 frame;
+        Deleter deleter;
+    };
+
+    std::deque<Entry> m_entries;
+};
+
+}  // namespace sl
@@ -23,6 +23,20 @@ Queue& Device::getQueue(Queue::Type type) { return m_impl->getQueue(type); }
 
 void Device::waitIdle() { m_impl->waitIdle(); }
 
+void Device::flushUploads() { m_impl->flushUploads(); }
+
+void Device::onFrameSubmitted(u64 frameNumber) {
+    m_impl->onFrameSubmitted(frameNumber);
+}
+
+void Device::onFrameCompleted(u64 frameNumber) {
+    m_impl->onFrameCompleted(frameNumber);
+}
+
+std::vector<Device::MemoryHeapStatistics> Device::getMemoryStatistics() const {
+    return m_impl->getMemoryStatistics();
+}
+
 Device::Impl& Device::getImpl() { return *m_impl; }
 
 }  // namespace sl
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "starlight/core/Core.hh"
 #include "starlight/core/Singleton.hh"
 #include "starlight/core/memory/Memory.hh"
@@ -11,20 +13,49 @@ namespace sl {
 
 class Device : public Singleton<Device> {
 public:
+    struct MemoryHeapStatistics {
+        u64 size;
+        // reserved from the heap, in blocks shared by resources or dedicated ones
+        u64 reservedBytes;
+        // taken by resources within the reserved blocks
+        u64 usedBytes;
+        u32 blockCount;
+        u32 allocationCount;
+        bool isDeviceLocal;
+    };
+
     struct Impl : NonCopyable, NonMovable {
         virtual ~Impl() = default;
 
         virtual void waitIdle()                   = 0;
+        virtual void flushUploads()               = 0;
         virtual Queue& getQueue(Queue::Type type) = 0;
 
+        virtual void onFrameSubmitted(u64 frameNumber) = 0;
+        virtual void onFrameCompleted(u64 frameNumber) = 0;
+
+        virtual std::vector<MemoryHeapStatistics> getMemoryStatistics() const = 0;
+
         static UniquePtr<Impl> create();
     };
 
     explicit Device();
 
+    // also destroys every resource waiting for the gpu to be done with it
     void waitIdle();
+    // submits buffer and texture uploads recorded so far, without waiting for them
+    void flushUploads();
     Queue& getQueue(Queue::Type type);
 
+    // resources released from now on are kept until the next frame completed
+    void onFrameSubmitted(u64 frameNumber);
+    // the fence of the frame signaled, resources released before its submission
+    // are destroyed
+    void onFrameCompleted(u64 frameNumber);
+
+    // one entry per memory heap of the device
+    std::vector<MemoryHeapStatistics> getMemoryStatistics() const;
+
     Queue& getGraphicsQueue();
     Queue& getPresentQueue();
 
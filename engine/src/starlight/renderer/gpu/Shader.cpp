@@ -55,6 +55,8 @@ std::string toString(const Shader::DataType& type) {
             return "mat4";
         case Shader::DataType::sampler:
             return "sampler";
+        case Shader::DataType::storageBuffer:
+            return "storageBuffer";
         case Shader::DataType::custom:
             return "custom";
         case Shader::DataType::boolean:
@@ -120,6 +122,13 @@ void logObject(const Shader::Properties& properties) {
     for (const auto& attribute : layout.inputAttributes.fields)
         log::debug("{}{}", spaces(4), attribute);
 
+    log::debug(
+      "{}Instance Attributes (total stride - {}b):", spaces(2),
+      layout.instanceAttributes.stride
+    );
+    for (const auto& attribute : layout.instanceAttributes.fields)
+        log::debug("{}{}", spaces(4), attribute);
+
     log::debug(
       "{}Push Constants (total size - {}b):", spaces(2), layout.pushConstants.size
     );
@@ -137,6 +146,11 @@ void logObject(const Shader::Properties& properties) {
         set.samplers.forEach([](const auto& field) {
             log::debug("{}{}", spaces(8), field);
         });
+
+        log::debug("{}Storage Buffers:", spaces(6));
+        set.storageBuffers.forEach([](const auto& field) {
+            log::debug("{}{}", spaces(8), field);
+        });
     };
 
     log::debug("{}Uniforms:", spaces(2));
@@ -157,19 +171,20 @@ void logObject(const Shader::Properties& properties) {
 
 template <> Shader::DataType fromString<Shader::DataType>(std::string_view str) {
     static std::unordered_map<std::string_view, Shader::DataType> lut{
-        { "vec2",    Shader::DataType::vec2    },
-        { "vec3",    Shader::DataType::vec3    },
-        { "vec4",    Shader::DataType::vec4    },
-        { "f32",     Shader::DataType::f32     },
-        { "i8",      Shader::DataType::i8      },
-        { "u8",      Shader::DataType::u8      },
-        { "i16",     Shader::DataType::i16     },
-        { "u16",     Shader::DataType::u16     },
-        { "i32",     Shader::DataType::i32     },
-        { "u32",     Shader::DataType::u32     },
-        { "mat4",    Shader::DataType::mat4    },
-        { "sampler", Shader::DataType::sampler },
-        { "custom",  Shader::DataType::custom  }
+        { "vec2",          Shader::DataType::vec2          },
+        { "vec3",          Shader::DataType::vec3          },
+        { "vec4",          Shader::DataType::vec4          },
+        { "f32",           Shader::DataType::f32           },
+        { "i8",            Shader::DataType::i8            },
+        { "u8",            Shader::DataType::u8            },
+        { "i16",           Shader::DataType::i16           },
+        { "u16",           Shader::DataType::u16           },
+        { "i32",           Shader::DataType::i32           },
+        { "u32",           Shader::DataType::u32           },
+        { "mat4",          Shader::DataType::mat4          },
+        { "sampler",       Shader::DataType::sampler       },
+        { "storageBuffer", Shader::DataType::storageBuffer },
+        { "custom",        Shader::DataType::custom        }
     };
     if (auto it = lut.find(str); it != lut.end()) [[likely]]
         return it->second;
@@ -180,27 +195,35 @@ template <> Shader::DataType fromString<Shader::DataType>(std::string_view str)
     Shader::DataLayout
 */
 
-static void calculateSamplersOffsets(Shader::UniformMap& samplers) {
-    samplers.forEach([index = 0u](Shader::Uniform& sampler) mutable {
-        sampler.offset = index++;
+// samplers and storage buffers use their offset as an index within the set
+static void calculateIndexOffsets(Shader::UniformMap& uniforms) {
+    uniforms.forEach([index = 0u](Shader::Uniform& uniform) mutable {
+        uniform.offset = index++;
     });
 }
 
 Shader::DataLayout::DataLayout(
   std::span<const InputAttribute> attributes, std::span<const Uniform> uniforms
 ) {
-    std::ranges::copy(attributes, into(inputAttributes.fields));
+    for (const auto& attribute : attributes) {
+        auto& destination = attribute.rate == InputAttribute::Rate::instance
+                              ? instanceAttributes
+                              : inputAttributes;
+        destination.fields.push_back(attribute);
+    }
 
-    std::ranges::sort(
-      inputAttributes.fields,
-      [](const auto& lhs, const auto& rhs) -> bool {
-          return lhs.location < rhs.location;
-      }
-    );
+    for (auto* bindingAttributes : { &inputAttributes, &instanceAttributes }) {
+        std::ranges::sort(
+          bindingAttributes->fields,
+          [](const auto& lhs, const auto& rhs) -> bool {
+              return lhs.location < rhs.location;
+          }
+        );
 
-    for (auto& attribute : inputAttributes.fields) {
-        attribute.offset = inputAttributes.stride;
-        inputAttributes.stride += attribute.size;
+        for (auto& attribute : bindingAttributes->fields) {
+            attribute.offset = bindingAttributes->stride;
+            bindingAttributes->stride += attribute.size;
+        }
     }
 
     std::array<DescriptorSet*, 2> lut{ &localDescriptorSet, &globalDescriptorSet };
@@ -217,14 +240,22 @@ Shader::DataLayout::DataLayout(
             auto set = getDescriptorSet(uniform.scope);
             if (uniform.type == DataType::sampler) {
                 set->samplers.push(uniform);
+            } else if (uniform.type == DataType::storageBuffer) {
+                log::expect(
+                  uniform.scope == Uniform::Scope::global,
+                  "Storage buffer '{}' has to be in the global descriptor set",
+                  uniform.name
+                );
+                set->storageBuffers.push(uniform);
             } else {
                 set->nonSamplers.push(uniform);
                 set->size += uniform.size;
             }
         }
     }
-    calculateSamplersOffsets(localDescriptorSet.samplers);
-    calculateSamplersOffsets(globalDescriptorSet.samplers);
+    calculateIndexOffsets(localDescriptorSet.samplers);
+    calculateIndexOffsets(globalDescriptorSet.samplers);
+    calculateIndexOffsets(globalDescriptorSet.storageBuffers);
 }
 
 }  // namespace sl
@@ -33,6 +33,9 @@ public:
     static constexpr u32 uboGlobalSet       = 0u;
     static constexpr u32 uboLocalSet        = 1u;
 
+    static constexpr u32 vertexBinding   = 0u;
+    static constexpr u32 instanceBinding = 1u;
+
     enum class DataType : u8 {
         vec2,
         vec3,
@@ -46,15 +49,20 @@ public:
         u32,
         mat4,
         sampler,
+        storageBuffer,
         boolean,
         custom
     };
 
     struct InputAttribute {
+        // per instance attributes are fed from the instance binding
+        enum class Rate : u8 { vertex = 0, instance };
+
         u32 location;
         u32 offset;
         DataType type;
         u64 size;
+        Rate rate;
         std::string name;
     };
 
@@ -89,10 +97,13 @@ public:
         struct DescriptorSet {
             UniformMap nonSamplers;
             UniformMap samplers;
+            // bound after the samplers, looked up by their block names
+            UniformMap storageBuffers;
             u64 size = 0u;
         };
 
         InputAttributes inputAttributes;
+        InputAttributes instanceAttributes;
         PushConstants pushConstants;
         DescriptorSet globalDescriptorSet;
         DescriptorSet localDescriptorSet;
@@ -16,10 +16,12 @@ namespace sl {
 
 ShaderDataBinder::Setter::Setter(
   UniformSetter&& uniformSetter, SamplerSetter&& samplerSetter,
+  StorageBufferSetter&& storageBufferSetter,
   const Shader::DataLayout::DescriptorSet& descriptorLayout
 ) :
     m_updated(false), m_uniformSetter(std::forward<UniformSetter>(uniformSetter)),
     m_samplerSetter(std::forward<SamplerSetter>(samplerSetter)),
+    m_storageBufferSetter(std::forward<StorageBufferSetter>(storageBufferSetter)),
     m_descriptorLayout(descriptorLayout) {}
 
 void ShaderDataBinder::Setter::set(
@@ -40,6 +42,14 @@ const Shader::Uniform& ShaderDataBinder::Setter::getUniform(
     return container.at(uniform);
 }
 
+const Shader::Uniform& ShaderDataBinder::Setter::getStorageBuffer(
+  const std::string& name
+) const {
+    const auto& container = m_descriptorLayout.storageBuffers;
+    log::expect(container.contains(name), "Could not find '{}' storage buffer", name);
+    return container.at(name);
+}
+
 /*
     ShaderDataBinder
 */
@@ -69,6 +79,9 @@ void ShaderDataBinder::setGlobalUniforms(
         [&](const auto& uniform, const Texture* value) -> bool {
             return setGlobalSampler(uniform, value);
         },
+        [&](const auto& uniform, const void* data, u64 size) -> bool {
+            return setGlobalStorageBuffer(uniform, imageIndex, data, size);
+        },
         m_dataLayout.globalDescriptorSet
     };
     callback(globalSetter);
@@ -89,6 +102,9 @@ void ShaderDataBinder::setLocalUniforms(
         [&](const auto& uniform, const Texture* value) -> bool {
             return setLocalSampler(uniform, id, value);
         },
+        [&](const auto& uniform, const void*, u64) -> bool {
+            log::panic("Storage buffer '{}' can't be set per instance", uniform.name);
+        },
         m_dataLayout.localDescriptorSet
     };
     callback(localSetter);
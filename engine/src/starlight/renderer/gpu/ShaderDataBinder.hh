@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <functional>
+#include <ranges>
 
 #include "starlight/core/Core.hh"
 #include "starlight/core/math/Core.hh"
@@ -31,7 +32,8 @@ const void* addressOf(const T& value) {
     return std::addressof(value);
 }
 
-template <typename T> const void* addressOf(const std::vector<T>& vector) {
+template <typename T, typename Allocator>
+const void* addressOf(const std::vector<T, Allocator>& vector) {
     return vector.data();
 }
 
@@ -46,10 +48,13 @@ public:
           std::function<bool(const Shader::Uniform&, const void*)>;
         using SamplerSetter =
           std::function<bool(const Shader::Uniform&, const Texture*)>;
+        using StorageBufferSetter =
+          std::function<bool(const Shader::Uniform&, const void*, u64)>;
 
     public:
         explicit Setter(
           UniformSetter&& uniformSetter, SamplerSetter&& samplerSetter,
+          StorageBufferSetter&& storageBufferSetter,
           const Shader::DataLayout::DescriptorSet& descriptorLayout
         );
 
@@ -64,16 +69,29 @@ public:
         }
 
         void set(const std::string& uniform, const Texture* value);
+
+        // replaces the whole content of a storage buffer, which grows as needed
+        template <typename T>
+        requires std::ranges::contiguous_range<T>
+        void setStorageBuffer(const std::string& name, const T& values) {
+            m_updated |= m_storageBufferSetter(
+              getStorageBuffer(name), std::ranges::data(values),
+              std::ranges::size(values) * sizeof(std::ranges::range_value_t<T>)
+            );
+        }
+
         bool wasUpdated() const;
 
     private:
         const Shader::Uniform& getUniform(const std::string& uniform, bool isSampler)
           const;
+        const Shader::Uniform& getStorageBuffer(const std::string& name) const;
 
         bool m_updated;
 
         UniformSetter m_uniformSetter;
         SamplerSetter m_samplerSetter;
+        StorageBufferSetter m_storageBufferSetter;
         const Shader::DataLayout::DescriptorSet& m_descriptorLayout;
     };
 
@@ -137,6 +155,11 @@ protected:
       const Shader::Uniform& uniform, const void* value
     ) = 0;
 
+    // returns true when the buffer had to be recreated and descriptors rewritten
+    virtual bool setGlobalStorageBuffer(
+      const Shader::Uniform& uniform, u32 imageIndex, const void* data, u64 size
+    ) = 0;
+
     virtual void setPushConstant(
       const Shader::Uniform& uniform, const void* value,
       CommandBuffer& commandBuffer, Pipeline& pipeline
@@ -62,6 +62,7 @@ public:
         Usage usage;
         Aspect aspect;
         Pixels pixels;
+        MemoryStrategy memoryStrategy = MemoryStrategy::general;
     };
 
     struct SamplerProperties {
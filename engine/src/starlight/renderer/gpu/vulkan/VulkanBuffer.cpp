@@ -1,7 +1,11 @@
 #include "VulkanBuffer.hh"
 
+#include <algorithm>
+#include <cstring>
+
 #include "VulkanDevice.hh"
 #include "VulkanCommandBuffer.hh"
+#include "VulkanUploader.hh"
 
 namespace sl::vk {
 
@@ -9,24 +13,23 @@ static VkBufferUsageFlagBits toVk(BufferUsage flags) {
     return static_cast<VkBufferUsageFlagBits>(flags);
 }
 
-static VkMemoryPropertyFlagBits toVk(MemoryProperty flags) {
-    return static_cast<VkMemoryPropertyFlagBits>(flags);
+static VkMemoryPropertyFlags toVk(MemoryProperty flags) {
+    return static_cast<VkMemoryPropertyFlags>(flags);
 }
 
-static VkMemoryAllocateInfo createMemoryAllocateInfo(
-  VkMemoryRequirements memoryRequirements, u32 memoryIndex
-) {
-    VkMemoryAllocateInfo allocateInfo;
-    allocateInfo.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocateInfo.pNext           = nullptr;
-    allocateInfo.allocationSize  = memoryRequirements.size;
-    allocateInfo.memoryTypeIndex = memoryIndex;
+VulkanBuffer::VulkanBuffer(VulkanDevice& device, const Properties& props) :
+    m_device(device), m_props(props), m_freeList(props.size), m_hasUploads(false),
+    m_hasFreedRanges(false) {
+    createHandle();
+    if (props.bindOnCreate) bind();
+}
 
-    return allocateInfo;
+VulkanBuffer::~VulkanBuffer() {
+    if (m_hasUploads) m_device.flushUploads();
+    retire(m_handle, m_memory);
 }
 
-VulkanBuffer::VulkanBuffer(VulkanDevice& device, const Properties& props) :
-    m_device(device), m_props(props), m_freeList(props.size) {
+void VulkanBuffer::createHandle() {
     auto bufferCreateInfo = createBufferCreateInfo();
 
     log::expect(vkCreateBuffer(
@@ -34,41 +37,25 @@ VulkanBuffer::VulkanBuffer(VulkanDevice& device, const Properties& props) :
     ));
     log::trace("vkCreateBuffer: {}", static_cast<void*>(m_handle));
 
-    const auto memoryRequirements = getMemoryRequirements();
-
-    const auto memoryIndex = m_device.findMemoryIndex(
-      memoryRequirements.memoryTypeBits, toVk(m_props.memoryProperty)
-    );
-    log::expect(
-      memoryIndex.has_value(), "Could not find memory index for vulkan buffer"
-    );
-    m_memoryIndex = *memoryIndex;
-
-    const auto allocateInfo =
-      createMemoryAllocateInfo(memoryRequirements, *memoryIndex);
-
-    log::expect(vkAllocateMemory(
-      m_device.logical.handle, &allocateInfo, m_device.allocator, &m_memory
-    ));
-    log::trace("vkAllocateMemory: {}", static_cast<void*>(m_memory));
-
-    if (props.bindOnCreate) bind();
+    m_memory = m_device.getMemoryAllocator().allocate(VulkanMemoryAllocator::Request{
+      .requirements = getMemoryRequirements(),
+      .properties   = toVk(m_props.memoryProperty),
+      .strategy     = m_props.memoryStrategy,
+      .isOptimal    = false,
+    });
 }
 
-VulkanBuffer::~VulkanBuffer() {
-    auto device    = m_device.logical.handle;
-    auto allocator = m_device.allocator;
-
-    m_device.waitIdle();
-
-    if (m_memory) {
-        log::trace("vkFreeMemory: {}", static_cast<void*>(m_memory));
-        vkFreeMemory(device, m_memory, allocator);
-    }
-    if (m_handle) {
-        log::trace("vkDestroyBuffer: {}", static_cast<void*>(m_handle));
-        vkDestroyBuffer(device, m_handle, allocator);
-    }
+void VulkanBuffer::retire(
+  VkBuffer handle, const VulkanMemoryAllocator::Allocation& memory
+) {
+    // frames in flight may still read it, destroyed once they completed
+    m_device.retire([&device = m_device, handle, memory]() {
+        if (handle) {
+            log::trace("vkDestroyBuffer: {}", static_cast<void*>(handle));
+            vkDestroyBuffer(device.logical.handle, handle, device.allocator);
+        }
+        device.getMemoryAllocator().free(memory);
+    });
 }
 
 VkMemoryRequirements VulkanBuffer::getMemoryRequirements() const {
@@ -92,27 +79,35 @@ VkBufferCreateInfo VulkanBuffer::createBufferCreateInfo() const {
 }
 
 void VulkanBuffer::bind(u64 offset) {
-    log::expect(
-      vkBindBufferMemory(m_device.logical.handle, m_handle, m_memory, offset)
-    );
+    log::expect(vkBindBufferMemory(
+      m_device.logical.handle, m_handle, m_memory.memory, m_memory.offset + offset
+    ));
 }
 
 void* VulkanBuffer::lockMemory(const Range& range) {
-    void* data;
-    log::expect(vkMapMemory(
-      m_device.logical.handle, m_memory, range.offset,
-      range.size == max<u64>() ? VK_WHOLE_SIZE : range.size, 0, &data
-    ));
-    return data;
+    // host visible memory is mapped by the allocator for as long as it exists
+    log::expect(
+      m_memory.mapped != nullptr, "Could not lock memory that is not host visible"
+    );
+    return m_memory.mapped + range.offset;
 }
 
-void VulkanBuffer::unlockMemory() {
-    vkUnmapMemory(m_device.logical.handle, m_memory);
-}
+void VulkanBuffer::unlockMemory() {}
+
+std::optional<Range> VulkanBuffer::allocate(
+  u64 size, const void* data, RelocationCallback&& onRelocation
+) {
+    m_freedRanges.collect(m_device.getCompletedFrame());
 
-std::optional<Range> VulkanBuffer::allocate(u64 size, const void* data) {
+    if (m_props.isGrowable && m_freeList.spaceLeft() < size) grow(size);
     auto offset = m_freeList.allocateBlock(size);
 
+    if (not offset && m_props.isGrowable) {
+        // enough space in total, but not in one piece
+        grow(size);
+        offset = m_freeList.allocateBlock(size);
+    }
+
     if (not offset) {
         log::warn("Could not allocate {}b, not space left", size);
         return {};
@@ -125,30 +120,205 @@ std::optional<Range> VulkanBuffer::allocate(u64 size, const void* data) {
         );
 
         if (isDeviceLocal) {
-            VulkanBuffer stagingBuffer{
-                m_device, Buffer::Properties::staging(range.size)
-            };
-            stagingBuffer.copy(Range{ .offset = 0u, .size = range.size }, data);
-
-            VkBufferCopy copyRegion{
-                .srcOffset = 0, .dstOffset = range.offset, .size = size
-            };
-            auto& queue = Device::get().getGraphicsQueue();
-            CommandBuffer::Immediate commandBuffer{ queue };
-            vkCmdCopyBuffer(
-              toVk(commandBuffer).getHandle(), stagingBuffer.getHandle(), m_handle,
-              1, &copyRegion
-            );
+            // lands on the GPU with the next flush, at the latest before a frame
+            m_device.getUploader().upload(*this, range.offset, data, size);
+            m_hasUploads = true;
         } else {
             copy(range, data);
         }
     }
 
+    if (onRelocation) {
+        m_relocatableRanges.emplace(
+          range.offset,
+          Relocatable{ .size = size, .onRelocation = std::move(onRelocation) }
+        );
+    }
+
     return range;
 }
 
 void VulkanBuffer::free(const Range& range) {
-    m_freeList.freeBlock(range.size, range.offset);
+    m_relocatableRanges.erase(range.offset);
+    m_hasFreedRanges = true;
+
+    // frames in flight may still read the range, it's reused once they completed
+    m_freedRanges.push(m_device.getRetireFrame(), [this, range]() {
+        m_freeList.freeBlock(range.size, range.offset);
+    });
+}
+
+u64 VulkanBuffer::defragment(CommandBuffer& commandBuffer, u64 maxBytes) {
+    m_freedRanges.collect(m_device.getCompletedFrame());
+
+    // nothing was freed since the last pass that couldn't move anything
+    if (not m_hasFreedRanges) return 0u;
+
+    std::vector<VkBufferCopy> regions;
+    u64 movedBytes = 0u;
+    u32 attempts   = 0u;
+
+    // the last ranges go to the lowest free space below them
+    for (auto it = m_relocatableRanges.rbegin(); it != m_relocatableRanges.rend();
+         ++it) {
+        const auto& [offset, relocatable] = *it;
+
+        if (movedBytes > 0u && movedBytes + relocatable.size > maxBytes) continue;
+        if (++attempts > maxDefragmentationAttempts) break;
+
+        const auto destination =
+          m_freeList.allocateBlockBelow(relocatable.size, offset);
+        if (not destination) continue;
+
+        regions.push_back(VkBufferCopy{
+          .srcOffset = offset, .dstOffset = *destination, .size = relocatable.size
+        });
+
+        movedBytes += relocatable.size;
+        if (movedBytes >= maxBytes) break;
+    }
+
+    if (regions.empty()) {
+        // ranges freed during the last frames are not reusable yet
+        m_hasFreedRanges = m_freedRanges.getSize() > 0u;
+        return 0u;
+    }
+
+    // pending uploads into the moved ranges land before the frame and its copies
+    auto handle = toVk(commandBuffer).getHandle();
+    recordTransferBarrier(handle);
+    vkCmdCopyBuffer(
+      handle, m_handle, m_handle, static_cast<u32>(regions.size()), regions.data()
+    );
+
+    VkMemoryBarrier barrier;
+    clearMemory(&barrier);
+    barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask =
+      VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT;
+
+    vkCmdPipelineBarrier(
+      handle, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0,
+      1, &barrier, 0, nullptr, 0, nullptr
+    );
+
+    collectPendingMoves();
+    const auto frame = m_device.getRetireFrame();
+
+    for (const auto& region : regions) {
+        auto node = m_relocatableRanges.extract(region.srcOffset);
+        auto& [size, onRelocation] = node.mapped();
+
+        // the old range is still read by frames in flight
+        free(Range{ .offset = region.srcOffset, .size = size });
+        onRelocation(Range{ .offset = region.dstOffset, .size = size });
+
+        node.key() = region.dstOffset;
+        m_relocatableRanges.insert(std::move(node));
+
+        m_pendingMoves.push_back(Move{ .frame = frame, .region = region });
+    }
+
+    log::trace(
+      "Moved {} ranges, {}b, towards the start of the buffer", regions.size(),
+      movedBytes
+    );
+    return movedBytes;
+}
+
+void VulkanBuffer::grow(u64 requiredSize) {
+    const auto oldSize   = m_props.size;
+    const auto oldHandle = m_handle;
+    const auto oldMemory = m_memory;
+
+    m_props.size = std::max(oldSize * 2u, oldSize + requiredSize);
+    log::debug("Growing buffer {}b -> {}b", oldSize, m_props.size);
+
+    // copies recorded for the old handle have to run before it's copied over
+    if (m_hasUploads) m_device.flushUploads();
+
+    createHandle();
+    bind();
+
+    // ranges were already handed out at the destinations of the pending moves,
+    // while the old contents may not have them yet
+    collectPendingMoves();
+
+    if (m_memory.mapped != nullptr) {
+        std::memcpy(m_memory.mapped, oldMemory.mapped, oldSize);
+        applyPendingMoves(m_memory.mapped);
+    } else {
+        // rare enough to wait for, meshes created later in the frame read it
+        CommandBuffer::Immediate commandBuffer{
+            m_device.getQueue(Queue::Type::graphics)
+        };
+        auto handle = toVk(commandBuffer.get()).getHandle();
+
+        VkBufferCopy region;
+        region.srcOffset = 0u;
+        region.dstOffset = 0u;
+        region.size      = oldSize;
+
+        recordTransferBarrier(handle);
+        vkCmdCopyBuffer(handle, oldHandle, m_handle, 1, &region);
+        applyPendingMoves(handle);
+    }
+
+    // frames recorded so far keep the old one bound
+    retire(oldHandle, oldMemory);
+    m_freeList.resize(m_props.size);
+}
+
+void VulkanBuffer::applyPendingMoves(VkCommandBuffer commandBuffer) {
+    // a range can move again in a later frame, so frames are copied one by one
+    std::vector<VkBufferCopy> regions;
+    for (u64 i = 0; i < m_pendingMoves.size(); ++i) {
+        const auto& [frame, region] = m_pendingMoves[i];
+        regions.push_back(region);
+
+        const auto isLast = i + 1u == m_pendingMoves.size()
+                            || m_pendingMoves[i + 1u].frame != frame;
+        if (not isLast) continue;
+
+        recordTransferBarrier(commandBuffer);
+        vkCmdCopyBuffer(
+          commandBuffer, m_handle, m_handle, static_cast<u32>(regions.size()),
+          regions.data()
+        );
+        regions.clear();
+    }
+}
+
+void VulkanBuffer::applyPendingMoves(u8* memory) {
+    // sources stay untouched until their frame completed, applying a move which
+    // already ran just copies the same bytes again
+    for (const auto& [frame, region] : m_pendingMoves) {
+        std::memcpy(
+          memory + region.dstOffset, memory + region.srcOffset, region.size
+        );
+    }
+}
+
+void VulkanBuffer::collectPendingMoves() {
+    const auto completedFrame = m_device.getCompletedFrame();
+    std::erase_if(m_pendingMoves, [&](const auto& move) {
+        return move.frame <= completedFrame;
+    });
+}
+
+void VulkanBuffer::recordTransferBarrier(VkCommandBuffer commandBuffer) {
+    VkMemoryBarrier barrier;
+    clearMemory(&barrier);
+    barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+    barrier.dstAccessMask =
+      VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+
+    vkCmdPipelineBarrier(
+      commandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+      VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr
+    );
 }
 
 void VulkanBuffer::copy(const Range& range, const void* data) {
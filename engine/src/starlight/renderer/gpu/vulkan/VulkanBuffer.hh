@@ -1,18 +1,46 @@
 #pragma once
 
+#include <map>
+#include <vector>
+
 #include "starlight/core/memory/Memory.hh"
 #include "starlight/core/containers/FreeList.hh"
 
 #include "starlight/renderer/gpu/Buffer.hh"
+#include "starlight/renderer/gpu/DeletionQueue.hh"
 
 #include "VulkanCommandBuffer.hh"
+#include "VulkanMemoryAllocator.hh"
 #include "Vulkan.hh"
 #include "fwd.hh"
 
 namespace sl::vk {
 
+/*
+    Ranges given out by allocate come from a FreeList over the whole buffer, freed
+    ones are only reused once the frames that could read them completed. Ranges
+    with a relocation callback can be moved towards the start by defragment, a few
+    per frame, and growable buffers are reallocated when a range doesn't fit; both
+    keep the old location intact for the frames already recorded. Moves recorded
+    into frames which did not complete yet are applied again to a grown buffer,
+    its copy of the old contents may be taken before they ran.
+*/
 class VulkanBuffer : public Buffer {
+    struct Relocatable {
+        u64 size;
+        RelocationCallback onRelocation;
+    };
+
+    struct Move {
+        // retire frame of the command buffer the copy was recorded into
+        u64 frame;
+        VkBufferCopy region;
+    };
+
 public:
+    // free space searches per defragment call, each walks the whole free list
+    static constexpr u32 maxDefragmentationAttempts = 16u;
+
     explicit VulkanBuffer(VulkanDevice& device, const Properties& props);
     ~VulkanBuffer();
 
@@ -24,24 +52,45 @@ public:
     void* lockMemory(const Range& range = Range{ 0u, max<u64>() }) override;
     void unlockMemory() override;
 
-    std::optional<Range> allocate(u64 size, const void* data = nullptr) override;
+    std::optional<Range> allocate(
+      u64 size, const void* data = nullptr, RelocationCallback&& onRelocation = {}
+    ) override;
     void free(const Range& range) override;
 
+    u64 defragment(CommandBuffer& commandBuffer, u64 maxBytes) override;
+
     void copy(const Range& range, const void* data) override;
 
 private:
     VkBufferCreateInfo createBufferCreateInfo() const;
     VkMemoryRequirements getMemoryRequirements() const;
 
+    void createHandle();
+    void retire(VkBuffer handle, const VulkanMemoryAllocator::Allocation& memory);
+    void grow(u64 requiredSize);
+    void applyPendingMoves(VkCommandBuffer commandBuffer);
+    void applyPendingMoves(u8* memory);
+    void collectPendingMoves();
+
+    static void recordTransferBarrier(VkCommandBuffer commandBuffer);
+
     VulkanDevice& m_device;
     Properties m_props;
     FreeList m_freeList;
 
     VkBuffer m_handle;
-    VkDeviceMemory m_memory;
-    bool m_isLocked;
+    VulkanMemoryAllocator::Allocation m_memory;
+    // copies into it may still be recorded in the uploader
+    bool m_hasUploads;
 
-    i32 m_memoryIndex;
+    // keyed by offset, the last ones are moved first
+    std::map<u64, Relocatable> m_relocatableRanges;
+    // returned to the free list once their frame completed
+    DeletionQueue m_freedRanges;
+    // cleared by a defragment pass without anything to move
+    bool m_hasFreedRanges;
+    // recorded by defragment into frames which may not have run them yet, in order
+    std::vector<Move> m_pendingMoves;
 };
 
 }  // namespace sl::vk
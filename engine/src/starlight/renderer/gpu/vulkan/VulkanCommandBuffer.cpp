@@ -5,8 +5,15 @@
 
 namespace sl::vk {
 
-VulkanCommandBuffer::VulkanCommandBuffer(VulkanDevice& device, Severity severity) :
-    m_device(device) {
+VulkanCommandBuffer::VulkanCommandBuffer(
+  VulkanDevice& device, Severity severity, Queue::Type queueType
+) :
+    m_device(device),
+    m_commandPool(
+      queueType == Queue::Type::transfer
+        ? device.logical.transferCommandPool
+        : device.logical.graphicsCommandPool
+    ) {
     VkCommandBufferAllocateInfo allocateInfo;
     clearMemory(&allocateInfo);
     allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
@@ -16,7 +23,7 @@ VulkanCommandBuffer::VulkanCommandBuffer(VulkanDevice& device, Severity severity
         ? VK_COMMAND_BUFFER_LEVEL_PRIMARY
         : VK_COMMAND_BUFFER_LEVEL_SECONDARY;
 
-    allocateInfo.commandPool        = m_device.logical.graphicsCommandPool;
+    allocateInfo.commandPool        = m_commandPool;
     allocateInfo.level              = level;
     allocateInfo.commandBufferCount = 1;
 
@@ -29,9 +36,7 @@ VulkanCommandBuffer::VulkanCommandBuffer(VulkanDevice& device, Severity severity
 VulkanCommandBuffer::~VulkanCommandBuffer() {
     if (m_handle) {
         log::trace("vkFreeCommandBuffers: {}", static_cast<void*>(m_handle));
-        vkFreeCommandBuffers(
-          m_device.logical.handle, m_device.logical.graphicsCommandPool, 1, &m_handle
-        );
+        vkFreeCommandBuffers(m_device.logical.handle, m_commandPool, 1, &m_handle);
     }
 }
 
@@ -69,7 +74,7 @@ void VulkanCommandBuffer::execute(const Command& command) {
     auto visitor = Overload{
         [&](const BindVertexBufferCommand& cmd) {
             vkCmdBindVertexBuffers(
-              m_handle, 0, 1,
+              m_handle, cmd.binding, 1,
               static_cast<VulkanBuffer&>(cmd.buffer).getHandlePointer(), &cmd.offset
             );
         },
@@ -92,9 +97,10 @@ void VulkanCommandBuffer::execute(const Command& command) {
             );
         },
         [&](const SetViewportCommand& cmd) {
+            // flipped, so it starts at the bottom edge of the area
             VkViewport viewport;
             viewport.x        = static_cast<float>(cmd.offset.x);
-            viewport.y        = static_cast<float>(cmd.size.h);
+            viewport.y        = static_cast<float>(cmd.offset.y + cmd.size.h);
             viewport.width    = static_cast<float>(cmd.size.w);
             viewport.height   = -static_cast<float>(cmd.size.h);
             viewport.minDepth = 0.0f;
@@ -108,6 +114,21 @@ void VulkanCommandBuffer::execute(const Command& command) {
             scissor.extent.width  = cmd.size.w;
             scissor.extent.height = cmd.size.h;
             vkCmdSetScissor(m_handle, 0, 1, &scissor);
+        },
+        [&](const ClearDepthCommand& cmd) {
+            VkClearAttachment attachment;
+            clearMemory(&attachment);
+            attachment.aspectMask                    = VK_IMAGE_ASPECT_DEPTH_BIT;
+            attachment.clearValue.depthStencil.depth = cmd.depth;
+
+            VkClearRect rect;
+            rect.rect.offset.x      = cmd.offset.x;
+            rect.rect.offset.y      = cmd.offset.y;
+            rect.rect.extent.width  = cmd.size.w;
+            rect.rect.extent.height = cmd.size.h;
+            rect.baseArrayLayer     = 0;
+            rect.layerCount         = 1;
+            vkCmdClearAttachments(m_handle, 1, &attachment, 1, &rect);
         }
     };
 
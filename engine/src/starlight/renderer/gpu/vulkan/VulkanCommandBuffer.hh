@@ -3,14 +3,17 @@
 #include "Vulkan.hh"
 
 #include "starlight/renderer/gpu/CommandBuffer.hh"
+#include "starlight/renderer/gpu/Queue.hh"
 #include "fwd.hh"
 
 namespace sl::vk {
 
 class VulkanCommandBuffer : public CommandBuffer {
 public:
+    // allocated from the pool of the given queue's family, it can only go there
     explicit VulkanCommandBuffer(
-      VulkanDevice& device, Severity severity = Severity::primary
+      VulkanDevice& device, Severity severity = Severity::primary,
+      Queue::Type queueType = Queue::Type::graphics
     );
 
     ~VulkanCommandBuffer();
@@ -24,6 +27,7 @@ public:
 
 private:
     VulkanDevice& m_device;
+    VkCommandPool m_commandPool;
     VkCommandBuffer m_handle;
 };
 
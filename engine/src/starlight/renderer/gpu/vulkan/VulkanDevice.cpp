@@ -1,5 +1,6 @@
 #include "VulkanDevice.hh"
 
+#include <algorithm>
 #include <optional>
 
 #include "VulkanQueue.hh"
@@ -19,6 +20,7 @@
 #include "VulkanPipeline.hh"
 #include "VulkanBuffer.hh"
 #include "VulkanShaderDataBinder.hh"
+#include "VulkanUploader.hh"
 
 namespace sl::vk {
 
@@ -28,7 +30,8 @@ VulkanDevice::VulkanDevice() :
     m_debugMessenger(instance.handle, allocator),
 #endif
     surface(instance.handle, allocator), physical(instance.handle, surface.handle),
-    logical(physical.handle, allocator, physical.info.queueIndices) {
+    logical(physical.handle, allocator, physical.info.queueIndices),
+    m_memoryAllocator(*this), m_retireFrame(1u), m_completedFrame(0u) {
 
     createUiResources();
 
@@ -38,12 +41,58 @@ VulkanDevice::VulkanDevice() :
 }
 
 VulkanDevice::~VulkanDevice() {
+    // the staging ring of the uploader is retired as well
+    m_uploader.clear();
+    waitIdle();
+
     if (uiDescriptorPool) {
         vkDestroyDescriptorPool(logical.handle, uiDescriptorPool, allocator);
     }
 }
 
-void VulkanDevice::waitIdle() { vkDeviceWaitIdle(logical.handle); }
+void VulkanDevice::waitIdle() {
+    vkDeviceWaitIdle(logical.handle);
+    m_deletionQueue.flush();
+    m_completedFrame = m_retireFrame - 1u;
+}
+
+void VulkanDevice::flushUploads() {
+    if (m_uploader) m_uploader->flush();
+}
+
+void VulkanDevice::onFrameSubmitted(u64 frameNumber) {
+    // an upload flushed after the submission only lands before the next frame
+    m_retireFrame = frameNumber + 1u;
+}
+
+void VulkanDevice::onFrameCompleted(u64 frameNumber) {
+    m_completedFrame = std::max(m_completedFrame, frameNumber);
+    if (const auto count = m_deletionQueue.collect(frameNumber); count > 0u)
+        log::trace(
+          "Destroyed {} resources retired up to frame {}", count, frameNumber
+        );
+}
+
+void VulkanDevice::retire(DeletionQueue::Deleter&& deleter) {
+    m_deletionQueue.push(m_retireFrame, std::move(deleter));
+}
+
+u64 VulkanDevice::getRetireFrame() const { return m_retireFrame; }
+
+u64 VulkanDevice::getCompletedFrame() const { return m_completedFrame; }
+
+std::vector<Device::MemoryHeapStatistics> VulkanDevice::getMemoryStatistics() const {
+    return m_memoryAllocator.getHeapStatistics();
+}
+
+VulkanMemoryAllocator& VulkanDevice::getMemoryAllocator() {
+    return m_memoryAllocator;
+}
+
+VulkanUploader& VulkanDevice::getUploader() {
+    if (not m_uploader) m_uploader = UniquePtr<VulkanUploader>::create(*this);
+    return *m_uploader;
+}
 
 VulkanQueue& VulkanDevice::getQueue(Queue::Type type) {
     return logical.queues.at(type);
@@ -307,7 +356,17 @@ static bool assignQueues(
         const auto& queueFlags = queueFamilies[i].queueFlags;
         if (queueFlags & VK_QUEUE_GRAPHICS_BIT) markIndex(Queue::Type::graphics, i);
         if (queueFlags & VK_QUEUE_COMPUTE_BIT) markIndex(Queue::Type::compute, i);
-        if (queueFlags & VK_QUEUE_TRANSFER_BIT) markIndex(Queue::Type::transfer, i);
+
+        // a family only for transfers is a separate DMA engine, copies submitted
+        // there run alongside the graphics work
+        const bool isDedicatedTransfer =
+          (queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) == 0;
+        const bool hasTransfer = isFlagEnabled(foundQueues, Queue::Type::transfer);
+
+        if ((queueFlags & VK_QUEUE_TRANSFER_BIT)
+            && (isDedicatedTransfer || not hasTransfer)) {
+            markIndex(Queue::Type::transfer, i);
+        }
 
         VkBool32 supportsPresent = false;
         log::expect(
@@ -473,6 +532,25 @@ static bool detectDepthFormat(
     return false;
 }
 
+static bool supportsTimelineSemaphores(
+  VkPhysicalDevice device, const VulkanDevice::Physical::Info& info
+) {
+    // core since 1.2, older devices can't be asked about it this way
+    if (info.coreProperties.apiVersion < VK_API_VERSION_1_2) return false;
+
+    VkPhysicalDeviceVulkan12Features features12;
+    clearMemory(&features12);
+    features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+    VkPhysicalDeviceFeatures2 features;
+    clearMemory(&features);
+    features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features.pNext = &features12;
+
+    vkGetPhysicalDeviceFeatures2(device, &features);
+    return features12.timelineSemaphore;
+}
+
 static std::optional<VulkanDevice::Physical::Info> getPhysicalDeviceInfo(
   VkPhysicalDevice device, VkSurfaceKHR surface,
   const VulkanDevice::Physical::Requirements& requirements
@@ -509,6 +587,12 @@ static std::optional<VulkanDevice::Physical::Info> getPhysicalDeviceInfo(
         return {};
     }
 
+    if (requirements.supportsTimelineSemaphores
+        && not supportsTimelineSemaphores(device, info)) {
+        log::info("Device does not support timeline semaphores, skipping");
+        return {};
+    }
+
     if (not detectDepthFormat(device, info)) {
         log::info("Could not detect depth format, skipping");
         return {};
@@ -586,18 +670,27 @@ VulkanDevice::Physical::Physical(VkInstance instance, VkSurfaceKHR surface) :
     Requirements requirements{
         .supportedQueues =
           Queue::Type::graphics | Queue::Type::present | Queue::Type::transfer,
-        .isDiscrete                = true,
-        .supportsSamplerAnisotropy = true,
-        .extensions                = { VK_KHR_SWAPCHAIN_EXTENSION_NAME }
+        .isDiscrete                 = true,
+        .supportsSamplerAnisotropy  = true,
+        .supportsTimelineSemaphores = true,
+        .extensions                 = { VK_KHR_SWAPCHAIN_EXTENSION_NAME }
     };
 
-    for (const auto device : getPhysicalDevices(instance)) {
-        if (auto info = getPhysicalDeviceInfo(device, surface, requirements); info) {
-            showDeviceInfo(*info);
-            this->info = *info;
-            handle     = device;
-            break;
+    // a discrete GPU is preferred, any other one (e.g. lavapipe, the software
+    // implementation used for testing) only when there is none
+    for (const auto isDiscrete : { true, false }) {
+        requirements.isDiscrete = isDiscrete;
+
+        for (const auto device : getPhysicalDevices(instance)) {
+            auto info = getPhysicalDeviceInfo(device, surface, requirements);
+            if (info) {
+                showDeviceInfo(*info);
+                this->info = *info;
+                handle     = device;
+                break;
+            }
         }
+        if (handle != VK_NULL_HANDLE) break;
     }
 
     log::expect(
@@ -615,7 +708,8 @@ VulkanDevice::Logical::Logical(
   const Physical::QueueIndices& queueIndices
 ) :
     handle(VK_NULL_HANDLE), graphicsCommandPool(VK_NULL_HANDLE),
-    m_physicalDevice(device), m_allocator(allocator) {
+    transferCommandPool(VK_NULL_HANDLE), m_physicalDevice(device),
+    m_allocator(allocator) {
     createDevice(queueIndices);
     assignQueues(queueIndices);
     createCommandPool(queueIndices);
@@ -632,6 +726,12 @@ VulkanDevice::Logical::~Logical() {
         );
         vkDestroyCommandPool(handle, graphicsCommandPool, m_allocator);
     }
+    if (transferCommandPool) {
+        log::trace(
+          "vkDestroyCommandPool: {}", static_cast<void*>(transferCommandPool)
+        );
+        vkDestroyCommandPool(handle, transferCommandPool, m_allocator);
+    }
     if (handle) {
         log::trace("vkDestroyDevice: {}", static_cast<void*>(handle));
         vkDestroyDevice(handle, m_allocator);
@@ -644,15 +744,13 @@ void VulkanDevice::Logical::createDevice(const Physical::QueueIndices& queueIndi
 
     std::vector<u32> indices;
     indices.reserve(maximumExpectedQueuesCount);
-    indices.push_back(queueIndices.at(Queue::Type::graphics));
 
-    if (queueIndices.at(Queue::Type::graphics)
-        != queueIndices.at(Queue::Type::present)) {
-        indices.push_back(queueIndices.at(Queue::Type::present));
-    }
-    if (queueIndices.at(Queue::Type::graphics)
-        != queueIndices.at(Queue::Type::transfer)) {
-        indices.push_back(queueIndices.at(Queue::Type::transfer));
+    // every family once, present and transfer may share one too
+    for (const auto type :
+         { Queue::Type::graphics, Queue::Type::present, Queue::Type::transfer }) {
+        const auto index = queueIndices.at(type);
+        if (std::find(indices.begin(), indices.end(), index) == indices.end())
+            indices.push_back(index);
     }
 
     std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
@@ -681,9 +779,15 @@ void VulkanDevice::Logical::createDevice(const Physical::QueueIndices& queueIndi
     deviceFeatures.samplerAnisotropy        = VK_TRUE;
     std::vector<const char*> extensionNames = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
 
+    VkPhysicalDeviceVulkan12Features features12;
+    clearMemory(&features12);
+    features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    features12.timelineSemaphore = VK_TRUE;
+
     VkDeviceCreateInfo deviceCreateInfo;
     clearMemory(&deviceCreateInfo);
     deviceCreateInfo.sType                   = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    deviceCreateInfo.pNext                   = &features12;
     deviceCreateInfo.queueCreateInfoCount    = queueCreateInfos.size();
     deviceCreateInfo.pQueueCreateInfos       = queueCreateInfos.data();
     deviceCreateInfo.pEnabledFeatures        = &deviceFeatures;
@@ -699,17 +803,22 @@ void VulkanDevice::Logical::createDevice(const Physical::QueueIndices& queueIndi
 void VulkanDevice::Logical::createCommandPool(
   const Physical::QueueIndices& queueIndices
 ) {
-    VkCommandPoolCreateInfo poolCreateInfo;
-    clearMemory(&poolCreateInfo);
-    poolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    const auto createPool = [&](Queue::Type type, VkCommandPool& pool) {
+        VkCommandPoolCreateInfo poolCreateInfo;
+        clearMemory(&poolCreateInfo);
+        poolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
 
-    poolCreateInfo.queueFamilyIndex = queueIndices.at(Queue::Type::graphics);
-    poolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        poolCreateInfo.queueFamilyIndex = queueIndices.at(type);
+        poolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
 
-    log::expect(
-      vkCreateCommandPool(handle, &poolCreateInfo, m_allocator, &graphicsCommandPool)
-    );
-    log::trace("vkCreateCommandPool: {}", static_cast<void*>(graphicsCommandPool));
+        log::expect(
+          vkCreateCommandPool(handle, &poolCreateInfo, m_allocator, &pool)
+        );
+        log::trace("vkCreateCommandPool: {}", static_cast<void*>(pool));
+    };
+
+    createPool(Queue::Type::graphics, graphicsCommandPool);
+    createPool(Queue::Type::transfer, transferCommandPool);
 }
 
 void VulkanDevice::Logical::assignQueues(const Physical::QueueIndices& queueIndices
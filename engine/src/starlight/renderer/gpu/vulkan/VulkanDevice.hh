@@ -6,10 +6,12 @@
 #include "starlight/event/EventHandlerSentinel.hh"
 
 #include "starlight/renderer/gpu/Device.hh"
+#include "starlight/renderer/gpu/DeletionQueue.hh"
 #include "starlight/renderer/gpu/Sync.hh"
 
 #include "fwd.hh"
 #include "VulkanQueue.hh"
+#include "VulkanMemoryAllocator.hh"
 #include "Vulkan.hh"
 
 namespace sl::vk {
@@ -60,6 +62,7 @@ public:
             Queue::Type supportedQueues;
             bool isDiscrete;
             bool supportsSamplerAnisotropy;
+            bool supportsTimelineSemaphores;
             std::vector<const char*> extensions;
         };
 
@@ -96,6 +99,7 @@ public:
 
         VkDevice handle;
         VkCommandPool graphicsCommandPool;
+        VkCommandPool transferCommandPool;
         Queues queues;
 
     private:
@@ -111,8 +115,25 @@ public:
     ~VulkanDevice() override;
 
     void waitIdle() override;
+    void flushUploads() override;
     VulkanQueue& getQueue(Queue::Type type) override;
 
+    void onFrameSubmitted(u64 frameNumber) override;
+    void onFrameCompleted(u64 frameNumber) override;
+
+    // destroys the resource once the frames that may still use it have completed,
+    // pending uploads into it have to be flushed before
+    void retire(DeletionQueue::Deleter&& deleter);
+    // for resources keeping their own retired parts, e.g. freed buffer ranges
+    u64 getRetireFrame() const;
+    u64 getCompletedFrame() const;
+
+    std::vector<Device::MemoryHeapStatistics> getMemoryStatistics() const override;
+
+    VulkanMemoryAllocator& getMemoryAllocator();
+    // created on first use, it needs the device to be complete
+    VulkanUploader& getUploader();
+
     std::optional<i32> findMemoryIndex(u32 typeFilter, u32 propertyFlags) const;
 
     EventHandlerSentinel m_eventSentinel;
@@ -132,6 +153,15 @@ public:
     Physical physical;
     Logical logical;
     VkDescriptorPool uiDescriptorPool;
+
+private:
+    // destroyed before the logical device, the resources live on it
+    VulkanMemoryAllocator m_memoryAllocator;
+    DeletionQueue m_deletionQueue;
+    // frame the resources retired now are kept for
+    u64 m_retireFrame;
+    u64 m_completedFrame;
+    UniquePtr<VulkanUploader> m_uploader;
 };
 
 }  // namespace sl::vk
@@ -65,6 +65,14 @@ bool VulkanFence::wait(Nanoseconds timeout) {
     return false;
 }
 
+bool VulkanFence::isSignaled() {
+    if (m_state == State::signaled) return true;
+
+    if (vkGetFenceStatus(m_device.logical.handle, m_handle) == VK_SUCCESS)
+        m_state = State::signaled;
+    return m_state == State::signaled;
+}
+
 void VulkanFence::reset() {
     if (m_state == State::signaled) {
         log::expect(vkResetFences(m_device.logical.handle, 1, &m_handle));
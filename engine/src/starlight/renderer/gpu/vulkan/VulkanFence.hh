@@ -15,6 +15,9 @@ public:
     bool wait(Nanoseconds timeout) override;
     void reset() override;
 
+    // does not block, unlike a wait with no timeout it logs nothing when unsignaled
+    bool isSignaled();
+
     VkFence getHandle();
 
 private:
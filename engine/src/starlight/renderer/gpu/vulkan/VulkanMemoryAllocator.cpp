@@ -0,0 +1,235 @@
+#include "VulkanMemoryAllocator.hh"
+
+#include <algorithm>
+
+#include "starlight/core/Utils.hh"
+
+#include "VulkanDevice.hh"
+
+namespace sl::vk {
+
+VulkanMemoryAllocator::VulkanMemoryAllocator(VulkanDevice& device, u64 blockSize) :
+    m_device(device), m_blockSize(blockSize),
+    m_bufferImageGranularity(
+      device.physical.info.coreProperties.limits.bufferImageGranularity
+    ),
+    m_maxAllocationCount(
+      device.physical.info.coreProperties.limits.maxMemoryAllocationCount
+    ) {
+    log::trace(
+      "Creating device memory allocator, blocks of {}b, granularity {}b",
+      m_blockSize, m_bufferImageGranularity
+    );
+}
+
+VulkanMemoryAllocator::~VulkanMemoryAllocator() {
+    for (auto& block : m_blocks) {
+        if (block->allocationCount > 0u) {
+            log::warn(
+              "Destroying device memory block with {} resources still in it",
+              block->allocationCount
+            );
+        }
+        destroyBlock(*block);
+    }
+}
+
+VulkanMemoryAllocator::Allocation VulkanMemoryAllocator::allocate(
+  const Request& request
+) {
+    const auto [size, alignment, typeBits] = request.requirements;
+
+    const auto memoryIndex = m_device.findMemoryIndex(typeBits, request.properties);
+    log::expect(
+      memoryIndex.has_value(), "Could not find memory type for {}/{}", typeBits,
+      request.properties
+    );
+    const auto memoryType = static_cast<u32>(*memoryIndex);
+
+    // with no granularity to respect all resources can share blocks
+    const auto isOptimal = m_bufferImageGranularity > 1u && request.isOptimal;
+    const auto blockSize = getBlockSize(memoryType);
+
+    if (request.strategy == MemoryStrategy::dedicated || size > blockSize / 2u) {
+        auto& block =
+          createBlock(memoryType, size, MemoryStrategy::dedicated, isOptimal);
+        return *allocateFromBlock(block, size, alignment);
+    }
+
+    for (auto& block : m_blocks) {
+        const auto isSuitable = block->memoryType == memoryType
+                                && block->strategy == request.strategy
+                                && block->isOptimal == isOptimal;
+        if (not isSuitable) continue;
+
+        if (auto allocation = allocateFromBlock(*block, size, alignment); allocation)
+            return *allocation;
+    }
+
+    auto& block = createBlock(memoryType, blockSize, request.strategy, isOptimal);
+    auto allocation = allocateFromBlock(block, size, alignment);
+    log::expect(
+      allocation.has_value(), "Could not allocate {}b in a new block of {}b", size,
+      blockSize
+    );
+    return *allocation;
+}
+
+void VulkanMemoryAllocator::free(const Allocation& allocation) {
+    auto& block = *allocation.block;
+
+    if (block.freeList)
+        block.freeList->freeBlock(allocation.size, allocation.offset);
+
+    block.usedBytes -= allocation.size;
+    --block.allocationCount;
+
+    if (block.allocationCount > 0u) return;
+
+    // an empty linear block starts over, one empty block of each kind is kept
+    // around so that a resource recreated every frame doesn't hit the driver
+    block.linearOffset = 0u;
+
+    const auto isDedicated = block.strategy == MemoryStrategy::dedicated;
+    if (isDedicated || not isLastBlockOfItsKind(block)) {
+        destroyBlock(block);
+        std::erase_if(m_blocks, [&](const auto& other) {
+            return other.get() == &block;
+        });
+    }
+}
+
+std::vector<Device::MemoryHeapStatistics> VulkanMemoryAllocator::getHeapStatistics(
+) const {
+    const auto& properties = m_device.physical.info.memoryProperties;
+
+    std::vector<Device::MemoryHeapStatistics> heaps;
+    heaps.reserve(properties.memoryHeapCount);
+
+    for (u32 i = 0; i < properties.memoryHeapCount; ++i) {
+        heaps.push_back(Device::MemoryHeapStatistics{
+          .size            = properties.memoryHeaps[i].size,
+          .reservedBytes   = 0u,
+          .usedBytes       = 0u,
+          .blockCount      = 0u,
+          .allocationCount = 0u,
+          .isDeviceLocal =
+            (properties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0,
+        });
+    }
+
+    for (const auto& block : m_blocks) {
+        auto& heap = heaps[properties.memoryTypes[block->memoryType].heapIndex];
+        heap.reservedBytes += block->size;
+        heap.usedBytes += block->usedBytes;
+        heap.allocationCount += block->allocationCount;
+        ++heap.blockCount;
+    }
+
+    return heaps;
+}
+
+std::optional<VulkanMemoryAllocator::Allocation>
+  VulkanMemoryAllocator::allocateFromBlock(Block& block, u64 size, u64 alignment) {
+    std::optional<u64> offset;
+
+    if (block.freeList) {
+        // the free list complains about every failure, most are just a full block
+        if (block.freeList->spaceLeft() >= size)
+            offset = block.freeList->allocateBlock(size, alignment);
+    } else {
+        const auto alignedOffset = getAlignedValue(block.linearOffset, alignment);
+        if (alignedOffset + size <= block.size) {
+            offset             = alignedOffset;
+            block.linearOffset = alignedOffset + size;
+        }
+    }
+
+    if (not offset) return {};
+
+    block.usedBytes += size;
+    ++block.allocationCount;
+
+    return Allocation{
+        .memory = block.memory,
+        .offset = *offset,
+        .size   = size,
+        .mapped = block.mapped != nullptr ? block.mapped + *offset : nullptr,
+        .block  = &block,
+    };
+}
+
+VulkanMemoryAllocator::Block& VulkanMemoryAllocator::createBlock(
+  u32 memoryType, u64 size, MemoryStrategy strategy, bool isOptimal
+) {
+    log::expect(
+      m_blocks.size() < m_maxAllocationCount,
+      "Device memory allocation limit of {} reached", m_maxAllocationCount
+    );
+
+    auto& block = *m_blocks.emplace_back(UniquePtr<Block>::create());
+
+    block.size            = size;
+    block.mapped          = nullptr;
+    block.memoryType      = memoryType;
+    block.strategy        = strategy;
+    block.isOptimal       = isOptimal;
+    block.linearOffset    = 0u;
+    block.usedBytes       = 0u;
+    block.allocationCount = 0u;
+
+    if (strategy == MemoryStrategy::general) block.freeList.emplace(size);
+
+    VkMemoryAllocateInfo allocateInfo;
+    clearMemory(&allocateInfo);
+    allocateInfo.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocateInfo.allocationSize  = size;
+    allocateInfo.memoryTypeIndex = memoryType;
+
+    log::expect(vkAllocateMemory(
+      m_device.logical.handle, &allocateInfo, m_device.allocator, &block.memory
+    ));
+    log::trace(
+      "vkAllocateMemory: {}, {}b of type {}", static_cast<void*>(block.memory), size,
+      memoryType
+    );
+
+    const auto& properties = m_device.physical.info.memoryProperties;
+    if (properties.memoryTypes[memoryType].propertyFlags
+        & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+        void* mapped = nullptr;
+        log::expect(vkMapMemory(
+          m_device.logical.handle, block.memory, 0u, VK_WHOLE_SIZE, 0, &mapped
+        ));
+        block.mapped = static_cast<u8*>(mapped);
+    }
+
+    return block;
+}
+
+void VulkanMemoryAllocator::destroyBlock(Block& block) {
+    if (block.mapped != nullptr)
+        vkUnmapMemory(m_device.logical.handle, block.memory);
+
+    log::trace("vkFreeMemory: {}", static_cast<void*>(block.memory));
+    vkFreeMemory(m_device.logical.handle, block.memory, m_device.allocator);
+}
+
+u64 VulkanMemoryAllocator::getBlockSize(u32 memoryType) const {
+    const auto& properties = m_device.physical.info.memoryProperties;
+    const auto heapSize =
+      properties.memoryHeaps[properties.memoryTypes[memoryType].heapIndex].size;
+
+    // small heaps (e.g. 256MiB of host visible device memory) get smaller blocks
+    return std::min(m_blockSize, heapSize / 8u);
+}
+
+bool VulkanMemoryAllocator::isLastBlockOfItsKind(const Block& block) const {
+    return std::ranges::none_of(m_blocks, [&](const auto& other) {
+        return other.get() != &block && other->memoryType == block.memoryType
+               && other->strategy == block.strategy
+               && other->isOptimal == block.isOptimal;
+    });
+}
+
+}  // namespace sl::vk
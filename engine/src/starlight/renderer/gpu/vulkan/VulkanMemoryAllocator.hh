@@ -0,0 +1,96 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "starlight/core/Core.hh"
+#include "starlight/core/containers/FreeList.hh"
+#include "starlight/core/memory/Memory.hh"
+#include "starlight/renderer/Core.hh"
+#include "starlight/renderer/gpu/Device.hh"
+
+#include "Vulkan.hh"
+#include "fwd.hh"
+
+namespace sl::vk {
+
+/*
+    Places buffers and images in a few large VkDeviceMemory blocks per memory type
+    instead of one vkAllocateMemory per resource, drivers limit the number of those
+    (maxMemoryAllocationCount) and round each one up. General blocks are managed by
+    a FreeList (TLSF), linear blocks only bump an offset and start over once all of
+    their resources were freed. Resources bigger than half a block, or asking for
+    it, get a dedicated allocation. With a bufferImageGranularity above 1 buffers
+    and optimally tiled images never share a block, so they can't share a page
+    either. Host visible blocks stay mapped for their whole lifetime.
+    Not thread safe.
+*/
+class VulkanMemoryAllocator : public NonCopyable, public NonMovable {
+    struct Block {
+        VkDeviceMemory memory;
+        u64 size;
+        u8* mapped;
+        u32 memoryType;
+        MemoryStrategy strategy;
+        bool isOptimal;
+
+        // general blocks only
+        std::optional<FreeList> freeList;
+        // linear blocks only, start of the free space
+        u64 linearOffset;
+
+        u64 usedBytes;
+        u32 allocationCount;
+    };
+
+public:
+    static constexpr u64 defaultBlockSize = 64u * 1024u * 1024u;
+
+    struct Request {
+        VkMemoryRequirements requirements;
+        VkMemoryPropertyFlags properties;
+        MemoryStrategy strategy;
+        // images with optimal tiling, anything else is placed like a buffer
+        bool isOptimal;
+    };
+
+    struct Allocation {
+        VkDeviceMemory memory;
+        u64 offset;
+        u64 size;
+        // null unless the memory is host visible
+        u8* mapped;
+        Block* block;
+    };
+
+    explicit VulkanMemoryAllocator(
+      VulkanDevice& device, u64 blockSize = defaultBlockSize
+    );
+    ~VulkanMemoryAllocator();
+
+    Allocation allocate(const Request& request);
+    void free(const Allocation& allocation);
+
+    std::vector<Device::MemoryHeapStatistics> getHeapStatistics() const;
+
+private:
+    std::optional<Allocation> allocateFromBlock(
+      Block& block, u64 size, u64 alignment
+    );
+    Block& createBlock(
+      u32 memoryType, u64 size, MemoryStrategy strategy, bool isOptimal
+    );
+    void destroyBlock(Block& block);
+
+    u64 getBlockSize(u32 memoryType) const;
+    bool isLastBlockOfItsKind(const Block& block) const;
+
+    VulkanDevice& m_device;
+    u64 m_blockSize;
+    u64 m_bufferImageGranularity;
+    u32 m_maxAllocationCount;
+
+    std::vector<UniquePtr<Block>> m_blocks;
+};
+
+}  // namespace sl::vk
@@ -145,20 +145,26 @@ VulkanPipeline::VulkanPipeline(
     dynamicStateCreateInfo.dynamicStateCount = dynamicStates.size();
     dynamicStateCreateInfo.pDynamicStates    = dynamicStates.data();
 
-    // Vertex input
-    VkVertexInputBindingDescription bindingDescription;
-    clearMemory(&bindingDescription);
-    bindingDescription.binding   = 0;  // Binding index
-    bindingDescription.stride    = shader.properties.layout.inputAttributes.stride;
-    bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+    // Vertex input, instance binding only if the shader has per instance inputs
+    const auto& layout = shader.properties.layout;
+
+    std::array<VkVertexInputBindingDescription, 2> bindingDescriptions;
+    clearMemory(&bindingDescriptions);
+    bindingDescriptions[0].binding   = Shader::vertexBinding;
+    bindingDescriptions[0].stride    = layout.inputAttributes.stride;
+    bindingDescriptions[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+    bindingDescriptions[1].binding   = Shader::instanceBinding;
+    bindingDescriptions[1].stride    = layout.instanceAttributes.stride;
+    bindingDescriptions[1].inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
 
     // Attributes
     VkPipelineVertexInputStateCreateInfo vertexInputInfo;
     clearMemory(&vertexInputInfo);
     vertexInputInfo.sType =
       VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-    vertexInputInfo.vertexBindingDescriptionCount = 1;
-    vertexInputInfo.pVertexBindingDescriptions    = &bindingDescription;
+    vertexInputInfo.vertexBindingDescriptionCount =
+      layout.instanceAttributes.fields.empty() ? 1u : 2u;
+    vertexInputInfo.pVertexBindingDescriptions = bindingDescriptions.data();
 
     auto vertexAttributes = shader.getInputAttributesDescriptions();
 
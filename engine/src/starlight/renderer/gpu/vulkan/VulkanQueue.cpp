@@ -50,6 +50,44 @@ bool VulkanQueue::submit(const SubmitInfo& submitInfo) {
     return true;
 }
 
+bool VulkanQueue::submit(const TimelineSubmitInfo& submitInfo) {
+    const auto semaphore = submitInfo.semaphore.getHandle();
+    const auto isWaiting = submitInfo.waitValue != 0u;
+
+    VkTimelineSemaphoreSubmitInfo timelineInfo;
+    clearMemory(&timelineInfo);
+    timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timelineInfo.signalSemaphoreValueCount = 1;
+    timelineInfo.pSignalSemaphoreValues    = &submitInfo.signalValue;
+
+    VkSubmitInfo vkSubmitInfo;
+    clearMemory(&vkSubmitInfo);
+    vkSubmitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    vkSubmitInfo.pNext                = &timelineInfo;
+    vkSubmitInfo.commandBufferCount   = 1;
+    vkSubmitInfo.pCommandBuffers      = &submitInfo.commandBuffer;
+    vkSubmitInfo.signalSemaphoreCount = 1;
+    vkSubmitInfo.pSignalSemaphores    = &semaphore;
+
+    if (isWaiting) {
+        timelineInfo.waitSemaphoreValueCount = 1;
+        timelineInfo.pWaitSemaphoreValues    = &submitInfo.waitValue;
+        vkSubmitInfo.waitSemaphoreCount      = 1;
+        vkSubmitInfo.pWaitSemaphores         = &semaphore;
+        vkSubmitInfo.pWaitDstStageMask       = &submitInfo.waitStage;
+    }
+
+    const auto result = vkQueueSubmit(m_handle, 1, &vkSubmitInfo, VK_NULL_HANDLE);
+
+    if (result != VK_SUCCESS) {
+        log::error(
+          "vkQueueSubmit failed with result: {}", getResultString(result, true)
+        );
+        return false;
+    }
+    return true;
+}
+
 void VulkanQueue::wait() { vkQueueWaitIdle(m_handle); }
 
 bool VulkanQueue::present(const PresentInfo& presentInfo) {
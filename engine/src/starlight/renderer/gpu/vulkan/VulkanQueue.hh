@@ -3,15 +3,26 @@
 #include "starlight/renderer/gpu/Queue.hh"
 
 #include "Vulkan.hh"
+#include "fwd.hh"
 
 namespace sl::vk {
 
 class VulkanQueue : public Queue {
 public:
+    struct TimelineSubmitInfo {
+        VkCommandBuffer commandBuffer;
+        VulkanTimelineSemaphore& semaphore;
+        u64 signalValue;
+        // nothing is waited for when 0
+        u64 waitValue                  = 0u;
+        VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    };
+
     explicit VulkanQueue(VkQueue handle);
 
     void wait() override;
     bool submit(const SubmitInfo& submitInfo) override;
+    bool submit(const TimelineSubmitInfo& submitInfo);
     bool present(const PresentInfo& presentInfo) override;
 
     VkQueue getHandle();
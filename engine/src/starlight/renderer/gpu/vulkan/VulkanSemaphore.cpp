@@ -26,6 +26,63 @@ VkSemaphore VulkanSemaphore::getHandle() { return m_handle; }
 
 VkSemaphore* VulkanSemaphore::getHandlePointer() { return &m_handle; }
 
+VulkanTimelineSemaphore::VulkanTimelineSemaphore(
+  VulkanDevice& device, u64 initialValue
+) : m_handle(VK_NULL_HANDLE), m_device(device) {
+    VkSemaphoreTypeCreateInfo typeCreateInfo;
+    clearMemory(&typeCreateInfo);
+    typeCreateInfo.sType         = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    typeCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    typeCreateInfo.initialValue  = initialValue;
+
+    VkSemaphoreCreateInfo semaphoreCreateInfo;
+    clearMemory(&semaphoreCreateInfo);
+    semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreCreateInfo.pNext = &typeCreateInfo;
+
+    log::expect(vkCreateSemaphore(
+      m_device.logical.handle, &semaphoreCreateInfo, m_device.allocator, &m_handle
+    ));
+    log::trace("vkCreateSemaphore: {} (timeline)", static_cast<void*>(m_handle));
+}
+
+VulkanTimelineSemaphore::~VulkanTimelineSemaphore() {
+    if (m_handle) {
+        log::trace("vkDestroySemaphore: {}", static_cast<void*>(m_handle));
+        vkDestroySemaphore(m_device.logical.handle, m_handle, m_device.allocator);
+    }
+}
+
+u64 VulkanTimelineSemaphore::getValue() {
+    u64 value = 0u;
+    log::expect(
+      vkGetSemaphoreCounterValue(m_device.logical.handle, m_handle, &value)
+    );
+    return value;
+}
+
+bool VulkanTimelineSemaphore::wait(u64 value, Nanoseconds timeout) {
+    VkSemaphoreWaitInfo waitInfo;
+    clearMemory(&waitInfo);
+    waitInfo.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores    = &m_handle;
+    waitInfo.pValues        = &value;
+
+    const auto result =
+      vkWaitSemaphores(m_device.logical.handle, &waitInfo, timeout);
+    if (result == VK_SUCCESS) return true;
+
+    if (result != VK_TIMEOUT) {
+        log::error(
+          "vkWaitSemaphores failed with result: {}", getResultString(result, true)
+        );
+    }
+    return false;
+}
+
+VkSemaphore VulkanTimelineSemaphore::getHandle() { return m_handle; }
+
 VulkanSemaphore& toVk(Semaphore& semaphore) {
     return static_cast<VulkanSemaphore&>(semaphore);
 }
@@ -21,6 +21,27 @@ private:
     VulkanDevice& m_device;
 };
 
+/*
+    Semaphore with a counter instead of a binary state, the queue submitting work
+    sets it to a value on completion and both the host and other submissions can
+    wait for a value to be reached. Vulkan backend only, the engine wide Semaphore
+    stays binary.
+*/
+class VulkanTimelineSemaphore : public NonCopyable, public NonMovable {
+public:
+    explicit VulkanTimelineSemaphore(VulkanDevice& device, u64 initialValue = 0u);
+    ~VulkanTimelineSemaphore();
+
+    u64 getValue();
+    bool wait(u64 value, Nanoseconds timeout = max<u64>());
+
+    VkSemaphore getHandle();
+
+private:
+    VkSemaphore m_handle;
+    VulkanDevice& m_device;
+};
+
 VulkanSemaphore& toVk(Semaphore& semaphore);
 
 }  // namespace sl::vk
@@ -73,17 +73,39 @@ VulkanShader::~VulkanShader() {
 }
 
 void VulkanShader::prepareAttributeDescriptions() {
-    const auto attributeCount = properties.layout.inputAttributes.fields.size();
-    m_attributeDescriptions.reserve(attributeCount);
-
-    for (const auto& attribute : properties.layout.inputAttributes.fields) {
-        VkVertexInputAttributeDescription attributeDescription;
-        attributeDescription.location = attribute.location;
-        attributeDescription.binding  = 0;
-        attributeDescription.offset   = attribute.offset;
-        attributeDescription.format   = toVk(attribute.type);
-        m_attributeDescriptions.push_back(attributeDescription);
-    }
+    const auto& layout = properties.layout;
+
+    m_attributeDescriptions.reserve(
+      layout.inputAttributes.fields.size() + layout.instanceAttributes.fields.size()
+    );
+
+    const auto addDescriptions = [&](const auto& attributes, u32 binding) {
+        for (const auto& attribute : attributes.fields) {
+            VkVertexInputAttributeDescription attributeDescription;
+            attributeDescription.binding = binding;
+
+            // matrices take a location per column
+            if (attribute.type == Shader::DataType::mat4) {
+                static constexpr u32 columnSize = sizeof(f32) * 4u;
+                for (u32 column = 0; column < 4u; ++column) {
+                    attributeDescription.location = attribute.location + column;
+                    attributeDescription.offset =
+                      attribute.offset + column * columnSize;
+                    attributeDescription.format = toVk(Shader::DataType::vec4);
+                    m_attributeDescriptions.push_back(attributeDescription);
+                }
+                continue;
+            }
+
+            attributeDescription.location = attribute.location;
+            attributeDescription.offset   = attribute.offset;
+            attributeDescription.format   = toVk(attribute.type);
+            m_attributeDescriptions.push_back(attributeDescription);
+        }
+    };
+
+    addDescriptions(layout.inputAttributes, vertexBinding);
+    addDescriptions(layout.instanceAttributes, instanceBinding);
 }
 
 void VulkanShader::createDescriptorSetLayouts() {
@@ -137,6 +159,19 @@ void VulkanShader::createDescriptorSetLayout(Uniform::Scope scope) {
         log::debug("\tSampler binding: {:02}.", bindingLayout.binding);
     }
 
+    const auto storageBufferCount = setDescription.storageBuffers.size();
+    log::debug("\tStorage buffer count: {:02}", storageBufferCount);
+
+    for (u64 i = 0; i < storageBufferCount; ++i) {
+        bindingLayout.descriptorCount = 1;
+        bindingLayout.descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindingLayout.binding         = bindings.count;
+
+        bindings.storageBuffer.emplace(bindings.count++);
+        bindingLayouts.push_back(bindingLayout);
+        log::debug("\tStorage buffer binding: {:02}.", bindingLayout.binding);
+    }
+
     log::trace(
       "Creating descriptor set layout {}. bindings: {}",
       m_descriptorSetLayouts.size() + 1, bindings.count
@@ -17,6 +17,7 @@ class VulkanShader : public Shader {
         u8 count = 0u;
         std::optional<u8> ubo;
         std::optional<u8> sampler;
+        std::optional<u8> storageBuffer;
     };
 
 public:
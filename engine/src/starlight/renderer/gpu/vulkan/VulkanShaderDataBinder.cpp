@@ -1,13 +1,19 @@
 #include "VulkanShaderDataBinder.hh"
 
+#include <bit>
+
 #include "VulkanShader.hh"
 #include "VulkanDevice.hh"
 #include "VulkanPipeline.hh"
 #include "VulkanCommandBuffer.hh"
 #include "VulkanBuffer.hh"
 
+#include "starlight/core/memory/FrameAllocator.hh"
+
 namespace sl::vk {
 
+static constexpr u64 minStorageBufferSize = 4096u;
+
 VulkanShaderDataBinder::VulkanShaderDataBinder(
   VulkanDevice& device, VulkanShader& shader
 ) :
@@ -18,30 +24,24 @@ VulkanShaderDataBinder::VulkanShaderDataBinder(
     m_uniformBufferView(nullptr),
     m_globalDescriptorSets(maxFramesInFlight, VK_NULL_HANDLE),
     m_globalTextures(m_dataLayout.globalDescriptorSet.samplers.size(), nullptr),
-    m_globalLastUpdateFrame(max<u64>()) {
+    m_globalLastUpdateFrame(max<u64>()),
+    m_storageBuffers(m_dataLayout.globalDescriptorSet.storageBuffers.size()) {
     createDescriptorPool();
     createUniformBuffer();
+
+    // created up front, descriptors have to point to a buffer before the first set
+    for (auto& storageBuffers : m_storageBuffers)
+        for (auto& storageBuffer : storageBuffers)
+            createStorageBuffer(storageBuffer, minStorageBufferSize);
 }
 
 VulkanShaderDataBinder::~VulkanShaderDataBinder() {
-    m_device.waitIdle();
-
-    log::expect(vkFreeDescriptorSets(
-      m_device.logical.handle, m_descriptorPool, maxFramesInFlight,
-      m_globalDescriptorSets.data()
-    ));
-
-    for (auto& localSet : m_localDescriptorSets) {
-        if (localSet) {
-            log::expect(vkFreeDescriptorSets(
-              m_device.logical.handle, m_descriptorPool, maxFramesInFlight,
-              localSet->descriptorSets.data()
-            ));
-        }
-    }
-    vkDestroyDescriptorPool(
-      m_device.logical.handle, m_descriptorPool, m_device.allocator
-    );
+    // destroying the pool frees the sets allocated from it, frames in flight may
+    // still have them bound
+    m_device.retire([&device = m_device, pool = m_descriptorPool]() {
+        log::trace("vkDestroyDescriptorPool: {}", static_cast<void*>(pool));
+        vkDestroyDescriptorPool(device.logical.handle, pool, device.allocator);
+    });
 }
 
 u32 VulkanShaderDataBinder::acquireLocalDescriptorSet() {
@@ -95,16 +95,18 @@ void VulkanShaderDataBinder::releaseLocalDescriptorSet(u32 id) {
     log::debug("Releaseing local descriptor set: {}", id);
     log::expect(localSet, "Local descriptor set with id {} not found", id);
 
-    m_device.waitIdle();
-
-    log::trace("vkFreeDescriptorSets");
-    for (auto& descriptorSet : localSet->descriptorSets)
-        log::trace("\t {}", static_cast<void*>(descriptorSet));
+    // the sets go once the frames in flight are done with them, retired before
+    // the pool they come from
+    m_device.retire([&device = m_device, pool = m_descriptorPool,
+                     descriptorSets = localSet->descriptorSets]() {
+        log::trace("vkFreeDescriptorSets");
+        for (auto& descriptorSet : descriptorSets)
+            log::trace("\t {}", static_cast<void*>(descriptorSet));
 
-    log::expect(vkFreeDescriptorSets(
-      m_device.logical.handle, m_descriptorPool, maxFramesInFlight,
-      localSet->descriptorSets.data()
-    ));
+        log::expect(vkFreeDescriptorSets(
+          device.logical.handle, pool, maxFramesInFlight, descriptorSets.data()
+        ));
+    });
 
     m_uniformBuffer->free(Range{
       .offset = localSet->offset,
@@ -117,12 +119,17 @@ void VulkanShaderDataBinder::releaseLocalDescriptorSet(u32 id) {
 void VulkanShaderDataBinder::bindDescriptorSet(
   CommandBuffer& commandBuffer, Pipeline& pipeline, VkDescriptorSet& descriptorSet,
   u64 uniformBufferOffset, u64 stride, std::span<const VulkanTexture*> textures,
-  u64 nonSamplerCount, u64 descriptorIndex, u8& counter
+  std::span<const VulkanBuffer* const> storageBuffers, u64 nonSamplerCount,
+  u64 descriptorIndex, u8& counter
 ) {
     if (counter > 0) {
         counter--;
 
-        std::vector<VkWriteDescriptorSet> descriptorWrites;
+        auto& frameAllocator = FrameAllocator::get();
+
+        auto descriptorWrites = frameAllocator.makeVector<VkWriteDescriptorSet>(
+          textures.size() + storageBuffers.size() + 1u
+        );
         VkDescriptorBufferInfo bufferInfo;
 
         if (nonSamplerCount > 0u) {
@@ -142,8 +149,9 @@ void VulkanShaderDataBinder::bindDescriptorSet(
             descriptorWrites.push_back(uboDescriptor);
         }
 
-        std::vector<VkDescriptorImageInfo> imageInfos;
-        imageInfos.reserve(textures.size());
+        // reserved up front, writes keep pointers to the elements
+        auto imageInfos =
+          frameAllocator.makeVector<VkDescriptorImageInfo>(textures.size());
 
         for (const auto& texture : textures) {
             imageInfos.emplace_back(
@@ -163,6 +171,26 @@ void VulkanShaderDataBinder::bindDescriptorSet(
             descriptorWrites.push_back(samplerDescriptor);
         }
 
+        auto storageBufferInfos =
+          frameAllocator.makeVector<VkDescriptorBufferInfo>(storageBuffers.size());
+
+        for (const auto& storageBuffer : storageBuffers) {
+            storageBufferInfos.emplace_back(
+              storageBuffer->getHandle(), 0u, VK_WHOLE_SIZE
+            );
+
+            VkWriteDescriptorSet storageDescriptor;
+            clearMemory(&storageDescriptor);
+            storageDescriptor.sType      = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            storageDescriptor.dstSet     = descriptorSet;
+            storageDescriptor.dstBinding = descriptorWrites.size();
+            storageDescriptor.descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            storageDescriptor.descriptorCount = 1;
+            storageDescriptor.pBufferInfo     = &storageBufferInfos.back();
+
+            descriptorWrites.push_back(storageDescriptor);
+        }
+
         if (descriptorWrites.size() > 0) {
             vkUpdateDescriptorSets(
               m_device.logical.handle, descriptorWrites.size(),
@@ -190,10 +218,16 @@ void VulkanShaderDataBinder::bindGlobalDescriptorSet(
 
         if (update) m_globalDescriptorDirtyFrames = maxFramesInFlight;
 
+        auto& frameAllocator = FrameAllocator::get();
+        auto storageBuffers =
+          frameAllocator.makeVector<const VulkanBuffer*>(m_storageBuffers.size());
+        for (const auto& frameBuffers : m_storageBuffers)
+            storageBuffers.push_back(frameBuffers[imageIndex].buffer.get());
+
         bindDescriptorSet(
           commandBuffer, pipeline, m_globalDescriptorSets[imageIndex],
-          m_globalUboOffset, m_globalUboStride, m_globalTextures, nonSamplerCount,
-          Shader::uboGlobalSet, m_globalDescriptorDirtyFrames
+          m_globalUboOffset, m_globalUboStride, m_globalTextures, storageBuffers,
+          nonSamplerCount, Shader::uboGlobalSet, m_globalDescriptorDirtyFrames
         );
     }
 }
@@ -204,20 +238,25 @@ void VulkanShaderDataBinder::bindLocalDescriptorSet(
 ) {
     auto localDescriptor = m_localDescriptorSets[id].get();
 
-    if (localDescriptor->lastUpdateFrame != frameNumber) {
-        localDescriptor->lastUpdateFrame = frameNumber;
-
-        const auto nonSamplerCount =
-          m_dataLayout.localDescriptorSet.nonSamplers.size();
+    // a set may be bound many times per frame when draws of other sets come in
+    // between, but it can't be written once recorded, so only the first bind
+    // in a frame updates it
+    const bool firstInFrame = localDescriptor->lastUpdateFrame != frameNumber;
+    u8 noUpdates            = 0u;
 
+    if (firstInFrame) {
+        localDescriptor->lastUpdateFrame = frameNumber;
         if (update) m_localDescriptorDirtyFrames = maxFramesInFlight;
-
-        bindDescriptorSet(
-          commandBuffer, pipeline, localDescriptor->descriptorSets[imageIndex],
-          localDescriptor->offset, m_localUboStride, localDescriptor->textures,
-          nonSamplerCount, Shader::uboLocalSet, m_localDescriptorDirtyFrames
-        );
     }
+
+    const auto nonSamplerCount = m_dataLayout.localDescriptorSet.nonSamplers.size();
+
+    bindDescriptorSet(
+      commandBuffer, pipeline, localDescriptor->descriptorSets[imageIndex],
+      localDescriptor->offset, m_localUboStride, localDescriptor->textures, {},
+      nonSamplerCount, Shader::uboLocalSet,
+      firstInFrame ? m_localDescriptorDirtyFrames : noUpdates
+    );
 }
 
 bool VulkanShaderDataBinder::setGlobalUniform(
@@ -255,6 +294,25 @@ bool VulkanShaderDataBinder::setUniform(const Range& range, const void* value) {
     return true;
 }
 
+bool VulkanShaderDataBinder::setGlobalStorageBuffer(
+  const Shader::Uniform& uniform, u32 imageIndex, const void* data, u64 size
+) {
+    auto& storageBuffer = m_storageBuffers[uniform.offset][imageIndex];
+    const bool grown    = storageBuffer.capacity < size;
+
+    if (grown) {
+        log::debug(
+          "Growing storage buffer '{}' of frame {} to {}b", uniform.name, imageIndex,
+          size
+        );
+        createStorageBuffer(storageBuffer, size);
+    }
+
+    if (size > 0u)
+        storageBuffer.buffer->copy(Range{ .offset = 0u, .size = size }, data);
+    return grown;
+}
+
 bool VulkanShaderDataBinder::setGlobalSampler(
   const Shader::Uniform& uniform, const Texture* value
 ) {
@@ -291,6 +349,7 @@ void VulkanShaderDataBinder::createDescriptorPool() {
     static std::vector<VkDescriptorPoolSize> poolSizes = {
         { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,         1024u },
         { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4096u },
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         1024u },
     };
     static constexpr u32 maxDescriptorAllocateCount = 1024u;
 
@@ -374,6 +433,26 @@ void VulkanShaderDataBinder::createUniformBuffer() {
     }
 }
 
+void VulkanShaderDataBinder::createStorageBuffer(
+  StorageBuffer& storageBuffer, u64 size
+) {
+    storageBuffer.capacity = std::bit_ceil(std::max(size, minStorageBufferSize));
+
+    // the old buffer is retired, frames in flight keep reading it until done
+    storageBuffer.buffer.clear();
+    storageBuffer.buffer = UniquePtr<VulkanBuffer>::create(
+      m_device,
+      Buffer::Properties{
+        .size = storageBuffer.capacity,
+        .memoryProperty =
+          MemoryProperty::MEMORY_PROPERTY_HOST_VISIBLE_BIT
+          | MemoryProperty::MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        .usage        = BufferUsage::BUFFER_USAGE_STORAGE_BUFFER_BIT,
+        .bindOnCreate = true,
+      }
+    );
+}
+
 VulkanShaderDataBinder::LocalDescriptorSet*
   VulkanShaderDataBinder::findFreeLocalDescriptorSet() {
     const auto localSamplerCount = m_dataLayout.localDescriptorSet.samplers.size();
@@ -27,6 +27,15 @@ class VulkanShaderDataBinder : public ShaderDataBinder {
     using LocalDescriptorSets =
       std::array<LocalPtr<LocalDescriptorSet>, maxLocalDescriptorSets>;
 
+    // host visible, grown on demand
+    struct StorageBuffer {
+        UniquePtr<VulkanBuffer> buffer = nullptr;
+        u64 capacity                   = 0u;
+    };
+
+    // every storage buffer of the global set has a copy per frame in flight
+    using StorageBuffers = std::array<StorageBuffer, maxFramesInFlight>;
+
 public:
     explicit VulkanShaderDataBinder(VulkanDevice& device, VulkanShader& shader);
     ~VulkanShaderDataBinder() override;
@@ -48,7 +57,8 @@ private:
     void bindDescriptorSet(
       CommandBuffer& commandBuffer, Pipeline& pipeline,
       VkDescriptorSet& descriptorSet, u64 uniformBufferOffset, u64 stride,
-      std::span<const VulkanTexture*> textures, u64 nonSamplerCount,
+      std::span<const VulkanTexture*> textures,
+      std::span<const VulkanBuffer* const> storageBuffers, u64 nonSamplerCount,
       u64 descriptorIndex, u8& counter
     );
 
@@ -67,6 +77,10 @@ private:
 
     bool setUniform(const Range& range, const void* value);
 
+    bool setGlobalStorageBuffer(
+      const Shader::Uniform& uniform, u32 imageIndex, const void* data, u64 size
+    ) override;
+
     void setPushConstant(
       const Shader::Uniform& uniform, const void* value,
       CommandBuffer& commandBuffer, Pipeline& pipeline
@@ -74,6 +88,7 @@ private:
 
     void createDescriptorPool();
     void createUniformBuffer();
+    void createStorageBuffer(StorageBuffer& storageBuffer, u64 size);
 
     LocalDescriptorSet* findFreeLocalDescriptorSet();
 
@@ -96,6 +111,7 @@ private:
     std::vector<VkDescriptorSet> m_globalDescriptorSets;
     std::vector<const VulkanTexture*> m_globalTextures;
     u64 m_globalLastUpdateFrame;
+    std::vector<StorageBuffers> m_storageBuffers;
     LocalDescriptorSets m_localDescriptorSets;
 };
 
@@ -177,6 +177,8 @@ void VulkanSwapchain::createImages() {
     depthImageData.format = static_cast<Format>(m_device.physical.info.depthFormat);
     depthImageData.channels = m_device.physical.info.depthChannelCount;
 
+    depthImageData.memoryStrategy = MemoryStrategy::dedicated;
+
     m_depthTexture
       .emplace(m_device, depthImageData, samplerProperties, "Swapchain_DepthBuffer");
 }
@@ -11,6 +11,7 @@
 #include "VulkanBuffer.hh"
 #include "VulkanDevice.hh"
 #include "VulkanCommandBuffer.hh"
+#include "VulkanUploader.hh"
 
 namespace sl::vk {
 
@@ -149,7 +150,7 @@ VulkanTexture::VulkanTexture(
   VulkanDevice& device, const ImageData& imageData, const SamplerProperties& sampler,
   OptStr name
 ) :
-    VulkanTextureBase(device, imageData, sampler, name), m_memory(VK_NULL_HANDLE),
+    VulkanTextureBase(device, imageData, sampler, name), m_memory(),
     m_layout(VK_IMAGE_LAYOUT_GENERAL) {
     log::trace("Creating vulkan texture: {}", id);
     create();
@@ -163,9 +164,7 @@ void VulkanTexture::resize(u32 width, u32 height) {
     recreate(m_imageData);
 }
 
-void VulkanTexture::copyFromBuffer(
-  VulkanBuffer& buffer, VulkanCommandBuffer& commandBuffer
-) {
+VkBufferImageCopy VulkanTexture::getCopyRegion() const {
     VkBufferImageCopy region;
     std::memset(&region, 0, sizeof(VkBufferImageCopy));
 
@@ -183,6 +182,24 @@ void VulkanTexture::copyFromBuffer(
     region.imageExtent.height = m_imageData.height;
     region.imageExtent.depth  = 1;
 
+    return region;
+}
+
+VkImageSubresourceRange VulkanTexture::getSubresourceRange() const {
+    VkImageSubresourceRange range;
+    range.aspectMask     = toVk(m_imageData.aspect);
+    range.baseMipLevel   = 0;
+    range.levelCount     = 1;
+    range.baseArrayLayer = 0;
+    range.layerCount     = m_imageData.type == Texture::Type::cubemap ? 6 : 1;
+    return range;
+}
+
+void VulkanTexture::copyFromBuffer(
+  VulkanBuffer& buffer, VulkanCommandBuffer& commandBuffer
+) {
+    const auto region = getCopyRegion();
+
     vkCmdCopyBufferToImage(
       commandBuffer.getHandle(), buffer.getHandle(), m_image,
       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region
@@ -198,18 +215,13 @@ void VulkanTexture::transitionLayout(
 
     VkImageMemoryBarrier barrier;
     clearMemory(&barrier);
-    barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    barrier.oldLayout                       = oldLayout;
-    barrier.newLayout                       = newLayout;
-    barrier.srcQueueFamilyIndex             = queueFamilyIndex;
-    barrier.dstQueueFamilyIndex             = queueFamilyIndex;
-    barrier.image                           = m_image;
-    barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
-    barrier.subresourceRange.baseMipLevel   = 0;
-    barrier.subresourceRange.levelCount     = 1;
-    barrier.subresourceRange.baseArrayLayer = 0;
-    barrier.subresourceRange.layerCount =
-      m_imageData.type == Texture::Type::cubemap ? 6 : 1;
+    barrier.sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout           = oldLayout;
+    barrier.newLayout           = newLayout;
+    barrier.srcQueueFamilyIndex = queueFamilyIndex;
+    barrier.dstQueueFamilyIndex = queueFamilyIndex;
+    barrier.image               = m_image;
+    barrier.subresourceRange    = getSubresourceRange();
 
     VkPipelineStageFlags source;
     VkPipelineStageFlags destination;
@@ -226,6 +238,13 @@ void VulkanTexture::transitionLayout(
         barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
         source                = VK_PIPELINE_STAGE_TRANSFER_BIT;
         destination           = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    } else if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED
+               && newLayout == VK_IMAGE_LAYOUT_GENERAL) {
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT
+                                | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        source                = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        destination           = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
     } else {
         log::error("Unsupported layout transition");
         return;
@@ -238,43 +257,31 @@ void VulkanTexture::transitionLayout(
 void VulkanTexture::write(std::span<u8> pixels, CommandBuffer* commandBuffer) {
     const auto imageSize = pixels.size();
 
-    const auto memoryProps =
-      MemoryProperty::MEMORY_PROPERTY_HOST_VISIBLE_BIT
-      | MemoryProperty::MEMORY_PROPERTY_HOST_COHERENT_BIT;
-
-    Buffer::Properties stagingBufferProperties{
-        .size           = imageSize,
-        .memoryProperty = memoryProps,
-        .usage          = BufferUsage::BUFFER_USAGE_TRANSFER_SRC_BIT,
-        .bindOnCreate   = true
-    };
+    if (commandBuffer == nullptr) {
+        // copied on the transfer queue, ready for frames submitted after the flush
+        m_device.getUploader().upload(
+          m_image, getCopyRegion(), getSubresourceRange(), pixels.data(), imageSize
+        );
+        m_layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        return;
+    }
 
-    VulkanBuffer stagingBuffer(m_device, stagingBufferProperties);
+    VulkanBuffer stagingBuffer(m_device, Buffer::Properties::staging(imageSize));
     stagingBuffer.copy(Range{ .offset = 0u, .size = imageSize }, pixels.data());
 
-    const auto execute = [&](CommandBuffer& commandBuffer) {
-        auto& vkCommandBuffer = static_cast<VulkanCommandBuffer&>(commandBuffer);
-
-        transitionLayout(
-          vkCommandBuffer, VK_IMAGE_LAYOUT_UNDEFINED,
-          VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
-        );
+    auto& vkCommandBuffer = static_cast<VulkanCommandBuffer&>(*commandBuffer);
 
-        copyFromBuffer(stagingBuffer, vkCommandBuffer);
+    transitionLayout(
+      vkCommandBuffer, VK_IMAGE_LAYOUT_UNDEFINED,
+      VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+    );
 
-        transitionLayout(
-          vkCommandBuffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-          VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-        );
-    };
+    copyFromBuffer(stagingBuffer, vkCommandBuffer);
 
-    if (commandBuffer != nullptr) {
-        execute(*commandBuffer);
-    } else {
-        auto& queue = Device::get().getGraphicsQueue();
-        CommandBuffer::Immediate commandBuffer{ queue };
-        execute(commandBuffer);
-    }
+    transitionLayout(
+      vkCommandBuffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+      VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+    );
     m_layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 }
 
@@ -283,36 +290,54 @@ VkImageLayout VulkanTexture::getLayout() const { return m_layout; }
 void VulkanTexture::create() {
     createImage();
     allocateAndBindMemory();
-    if (m_imageData.pixels.size() > 0) write(m_imageData.pixels);
+    if (m_imageData.pixels.size() > 0)
+        write(m_imageData.pixels);
+    else if (isFlagEnabled(m_imageData.usage, Usage::depthStencilAttachment))
+        initializeDepthLayout();
     createView();
     createSampler();
 }
 
+void VulkanTexture::initializeDepthLayout() {
+    // render passes loading the depth instead of clearing it expect general layout,
+    // also on the first frame when nothing has been drawn into it yet
+    CommandBuffer::Immediate commandBuffer{
+        m_device.getQueue(Queue::Type::graphics)
+    };
+    transitionLayout(
+      static_cast<VulkanCommandBuffer&>(commandBuffer.get()),
+      VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL
+    );
+    m_layout = VK_IMAGE_LAYOUT_GENERAL;
+}
+
 void VulkanTexture::destroy() {
     log::trace("Destroying vulkan texture: {}", id);
-    auto device    = m_device.logical.handle;
-    auto allocator = m_device.allocator;
-    m_device.waitIdle();
-
-    if (m_sampler) {
-        log::trace("vkDestroySampler: {}", static_cast<void*>(m_sampler));
-        vkDestroySampler(device, m_sampler, allocator);
-    }
-
-    if (m_view) {
-        log::trace("vkDestroyImageView: {}", static_cast<void*>(m_view));
-        vkDestroyImageView(device, m_view, allocator);
-    }
-
-    if (m_memory) {
-        log::trace("vkFreeMemory: {}", static_cast<void*>(m_memory));
-        vkFreeMemory(device, m_memory, allocator);
-    }
-
-    if (m_image) {
-        log::trace("vkDestroyImage: {}", static_cast<void*>(m_image));
-        vkDestroyImage(device, m_image, allocator);
-    }
+    // a copy into the image may still be only recorded
+    m_device.flushUploads();
+
+    m_device.retire([&device = m_device, sampler = m_sampler, view = m_view,
+                     image = m_image, memory = m_memory]() {
+        auto handle    = device.logical.handle;
+        auto allocator = device.allocator;
+
+        if (sampler) {
+            log::trace("vkDestroySampler: {}", static_cast<void*>(sampler));
+            vkDestroySampler(handle, sampler, allocator);
+        }
+
+        if (view) {
+            log::trace("vkDestroyImageView: {}", static_cast<void*>(view));
+            vkDestroyImageView(handle, view, allocator);
+        }
+
+        if (image) {
+            log::trace("vkDestroyImage: {}", static_cast<void*>(image));
+            vkDestroyImage(handle, image, allocator);
+        }
+
+        if (memory.memory) device.getMemoryAllocator().free(memory);
+    });
 }
 
 void VulkanTexture::allocateAndBindMemory() {
@@ -321,24 +346,16 @@ void VulkanTexture::allocateAndBindMemory() {
       m_device.logical.handle, m_image, &memoryRequirements
     );
 
-    auto memoryType = m_device.findMemoryIndex(
-      memoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
-    );
-
-    if (not memoryType)
-        log::error("Required memory type not found. VKImage not valid.");
-
-    VkMemoryAllocateInfo memoryAllocateInfo;
-    clearMemory(&memoryAllocateInfo);
-    memoryAllocateInfo.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    memoryAllocateInfo.allocationSize  = memoryRequirements.size;
-    memoryAllocateInfo.memoryTypeIndex = memoryType.value_or(-1);
+    m_memory = m_device.getMemoryAllocator().allocate(VulkanMemoryAllocator::Request{
+      .requirements = memoryRequirements,
+      .properties   = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+      .strategy     = m_imageData.memoryStrategy,
+      .isOptimal    = m_imageData.tiling == Texture::Tiling::optimal,
+    });
 
-    log::expect(vkAllocateMemory(
-      m_device.logical.handle, &memoryAllocateInfo, m_device.allocator, &m_memory
+    log::expect(vkBindImageMemory(
+      m_device.logical.handle, m_image, m_memory.memory, m_memory.offset
     ));
-    log::trace("vkAllocateMemory: {}", static_cast<void*>(m_memory));
-    log::expect(vkBindImageMemory(m_device.logical.handle, m_image, m_memory, 0));
 }
 
 void VulkanTexture::recreate(const Texture::ImageData& imageData) {
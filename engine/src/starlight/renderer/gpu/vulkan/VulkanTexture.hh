@@ -10,6 +10,7 @@
 
 #include "Vulkan.hh"
 #include "VulkanBuffer.hh"
+#include "VulkanMemoryAllocator.hh"
 #include "fwd.hh"
 
 #include "VulkanCommandBuffer.hh"
@@ -56,6 +57,10 @@ private:
     void recreate(const Texture::ImageData& imageData);
     void createImage();
     void allocateAndBindMemory();
+    void initializeDepthLayout();
+
+    VkBufferImageCopy getCopyRegion() const;
+    VkImageSubresourceRange getSubresourceRange() const;
 
     void copyFromBuffer(VulkanBuffer& buffer, VulkanCommandBuffer& commandBuffer);
 
@@ -64,7 +69,7 @@ private:
       VkImageLayout newLayout
     );
 
-    VkDeviceMemory m_memory;
+    VulkanMemoryAllocator::Allocation m_memory;
     VkImageLayout m_layout;
 };
 
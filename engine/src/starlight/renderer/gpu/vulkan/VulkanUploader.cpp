@@ -0,0 +1,390 @@
+#include "VulkanUploader.hh"
+
+#include <algorithm>
+#include <cstring>
+
+#include "VulkanDevice.hh"
+
+namespace sl::vk {
+
+// keeps the copies into the ring on cache line boundaries, a multiple of any texel
+static constexpr u64 stagingAlignment = 64u;
+
+static constexpr VkAccessFlags bufferReadAccess =
+  VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT
+  | VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT
+  | VK_ACCESS_TRANSFER_READ_BIT;
+
+static VkBufferMemoryBarrier createBufferBarrier(
+  VkBuffer buffer, const VkBufferCopy& region
+) {
+    VkBufferMemoryBarrier barrier;
+    clearMemory(&barrier);
+    barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer              = buffer;
+    barrier.offset              = region.dstOffset;
+    barrier.size                = region.size;
+    return barrier;
+}
+
+static VkImageMemoryBarrier createImageBarrier(
+  VkImage image, const VkImageSubresourceRange& subresources,
+  VkImageLayout oldLayout, VkImageLayout newLayout
+) {
+    VkImageMemoryBarrier barrier;
+    clearMemory(&barrier);
+    barrier.sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout           = oldLayout;
+    barrier.newLayout           = newLayout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image               = image;
+    barrier.subresourceRange    = subresources;
+    return barrier;
+}
+
+static Buffer::Properties getRingProperties(u64 capacity) {
+    // lives as long as the device, in a linear block it would pin the whole block
+    auto props           = Buffer::Properties::staging(capacity);
+    props.memoryStrategy = MemoryStrategy::dedicated;
+    return props;
+}
+
+VulkanUploader::VulkanUploader(
+  VulkanDevice& device, u64 capacity, bool forceQueueHandover
+) :
+    m_device(device), m_transferQueue(device.getQueue(Queue::Type::transfer)),
+    m_graphicsQueue(device.getQueue(Queue::Type::graphics)),
+    m_transferFamily(device.physical.info.queueIndices.at(Queue::Type::transfer)),
+    m_graphicsFamily(device.physical.info.queueIndices.at(Queue::Type::graphics)),
+    m_transfersOwnership(forceQueueHandover || m_transferFamily != m_graphicsFamily),
+    m_timeline(device),
+    m_submittedValue(0u),
+    m_stagingBuffer(device, getRingProperties(capacity)),
+    m_stagingMemory(static_cast<u8*>(m_stagingBuffer.lockMemory())),
+    m_ring(capacity) {
+    log::debug(
+      "Created staging ring of {}b, transfer queue family {} (graphics {})",
+      capacity, m_transferFamily, m_graphicsFamily
+    );
+}
+
+VulkanUploader::~VulkanUploader() {
+    flush();
+    m_timeline.wait(m_submittedValue);
+    m_stagingBuffer.unlockMemory();
+}
+
+u64 VulkanUploader::upload(
+  VulkanBuffer& destination, u64 offset, const void* data, u64 size
+) {
+    if (size > m_ring.getCapacity()) [[unlikely]] {
+        flush();
+        m_bufferCopies.push_back(BufferCopy{
+          .destination = destination.getHandle(),
+          .region      = { .srcOffset = 0u, .dstOffset = offset, .size = size },
+        });
+        uploadThroughTemporaryBuffer(data, size);
+        return m_submittedValue;
+    }
+
+    const auto stagingOffset = stage(data, size);
+    m_bufferCopies.push_back(BufferCopy{
+      .destination = destination.getHandle(),
+      .region = { .srcOffset = stagingOffset, .dstOffset = offset, .size = size },
+    });
+    return getPendingTicket();
+}
+
+u64 VulkanUploader::upload(
+  VkImage destination, const VkBufferImageCopy& region,
+  const VkImageSubresourceRange& subresources, const void* data, u64 size
+) {
+    ImageCopy copy{
+        .destination = destination, .region = region, .subresources = subresources
+    };
+
+    if (size > m_ring.getCapacity()) [[unlikely]] {
+        flush();
+        copy.region.bufferOffset = 0u;
+        m_imageCopies.push_back(copy);
+        uploadThroughTemporaryBuffer(data, size);
+        return m_submittedValue;
+    }
+
+    copy.region.bufferOffset = stage(data, size);
+    m_imageCopies.push_back(copy);
+    return getPendingTicket();
+}
+
+void VulkanUploader::flush() {
+    if (m_bufferCopies.empty() && m_imageCopies.empty()) return;
+
+    auto batch               = acquireBatch();
+    const auto transferValue = m_submittedValue + 1u;
+    batch.completionValue    = getPendingTicket();
+
+    auto transferCommands = batch.transferCommands->getHandle();
+    batch.transferCommands->begin(CommandBuffer::BeginFlags::singleUse);
+    auto handover = recordCopies(transferCommands, m_stagingBuffer.getHandle());
+    recordHandover(
+      transferCommands, handover,
+      m_transfersOwnership ? HandoverSide::release : HandoverSide::sameQueue
+    );
+    batch.transferCommands->end();
+
+    log::expect(
+      m_transferQueue.submit(VulkanQueue::TimelineSubmitInfo{
+        .commandBuffer = transferCommands,
+        .semaphore     = m_timeline,
+        .signalValue   = transferValue,
+      }),
+      "Could not submit uploads to the transfer queue"
+    );
+
+    // the graphics side of the ownership transfer, once the copies are done
+    if (m_transfersOwnership) {
+        auto acquireCommands = batch.acquireCommands->getHandle();
+        batch.acquireCommands->begin(CommandBuffer::BeginFlags::singleUse);
+        recordHandover(acquireCommands, handover, HandoverSide::acquire);
+        batch.acquireCommands->end();
+
+        log::expect(
+          m_graphicsQueue.submit(VulkanQueue::TimelineSubmitInfo{
+            .commandBuffer = acquireCommands,
+            .semaphore     = m_timeline,
+            .signalValue   = batch.completionValue,
+            .waitValue     = transferValue,
+          }),
+          "Could not submit acquire of uploads to the graphics queue"
+        );
+    }
+
+    batch.ringHead   = m_ring.getHead();
+    m_submittedValue = batch.completionValue;
+    m_batchesInFlight.push_back(std::move(batch));
+}
+
+bool VulkanUploader::isComplete(u64 ticket) {
+    return ticket <= m_timeline.getValue();
+}
+
+void VulkanUploader::wait(u64 ticket) {
+    if (ticket > m_submittedValue) flush();
+    log::expect(m_timeline.wait(ticket), "Could not wait for upload {}", ticket);
+    releaseCompletedBatches();
+}
+
+u64 VulkanUploader::stage(const void* data, u64 size) {
+    releaseCompletedBatches();
+    auto stagingOffset = m_ring.allocate(size, stagingAlignment);
+
+    if (not stagingOffset) [[unlikely]] {
+        log::trace("Staging ring full, waiting for uploads in flight");
+        flush();
+        while (not stagingOffset) {
+            waitForOldestBatch();
+            stagingOffset = m_ring.allocate(size, stagingAlignment);
+        }
+    }
+
+    std::memcpy(m_stagingMemory + *stagingOffset, data, size);
+    return *stagingOffset;
+}
+
+u64 VulkanUploader::getPendingTicket() const {
+    // the acquire on the graphics queue signals one more value
+    return m_submittedValue + (m_transfersOwnership ? 2u : 1u);
+}
+
+void VulkanUploader::uploadThroughTemporaryBuffer(const void* data, u64 size) {
+    log::debug(
+      "Upload of {}b does not fit the staging ring, copying directly", size
+    );
+
+    VulkanBuffer stagingBuffer{ m_device, Buffer::Properties::staging(size) };
+    stagingBuffer.copy(Range{ .offset = 0u, .size = size }, data);
+
+    CommandBuffer::Immediate commandBuffer{ m_graphicsQueue };
+    auto handle   = toVk(commandBuffer.get()).getHandle();
+    auto handover = recordCopies(handle, stagingBuffer.getHandle());
+    recordHandover(handle, handover, HandoverSide::sameQueue);
+}
+
+VulkanUploader::Handover VulkanUploader::recordCopies(
+  VkCommandBuffer commandBuffer, VkBuffer source
+) {
+    Handover handover;
+
+    if (not m_imageCopies.empty()) {
+        // the previous contents are not needed, the copy overwrites them
+        std::vector<VkImageMemoryBarrier> toTransferLayout;
+        toTransferLayout.reserve(m_imageCopies.size());
+
+        for (const auto& [destination, region, subresources] : m_imageCopies) {
+            auto& barrier = toTransferLayout.emplace_back(createImageBarrier(
+              destination, subresources, VK_IMAGE_LAYOUT_UNDEFINED,
+              VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+            ));
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        }
+
+        vkCmdPipelineBarrier(
+          commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+          VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr,
+          static_cast<u32>(toTransferLayout.size()), toTransferLayout.data()
+        );
+
+        for (const auto& [destination, region, subresources] : m_imageCopies) {
+            vkCmdCopyBufferToImage(
+              commandBuffer, source, destination,
+              VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region
+            );
+            handover.images.push_back(createImageBarrier(
+              destination, subresources, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+              VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+            ));
+        }
+    }
+
+    // grouped by destination, regions contiguous in both buffers merged into one
+    std::sort(
+      m_bufferCopies.begin(), m_bufferCopies.end(),
+      [](const auto& lhs, const auto& rhs) {
+          if (lhs.destination != rhs.destination)
+              return lhs.destination < rhs.destination;
+          return lhs.region.dstOffset < rhs.region.dstOffset;
+      }
+    );
+
+    std::vector<VkBufferCopy> regions;
+    regions.reserve(m_bufferCopies.size());
+
+    for (u64 i = 0; i < m_bufferCopies.size(); ++i) {
+        const auto& [destination, region] = m_bufferCopies[i];
+
+        if (not regions.empty()) {
+            auto& last = regions.back();
+            if (last.srcOffset + last.size == region.srcOffset
+                && last.dstOffset + last.size == region.dstOffset) {
+                last.size += region.size;
+            } else {
+                regions.push_back(region);
+            }
+        } else {
+            regions.push_back(region);
+        }
+
+        const auto isLast = i + 1u == m_bufferCopies.size()
+                            || m_bufferCopies[i + 1u].destination != destination;
+        if (isLast) {
+            vkCmdCopyBuffer(
+              commandBuffer, source, destination, static_cast<u32>(regions.size()),
+              regions.data()
+            );
+            for (const auto& copied : regions)
+                handover.buffers.push_back(createBufferBarrier(destination, copied));
+            regions.clear();
+        }
+    }
+
+    m_bufferCopies.clear();
+    m_imageCopies.clear();
+    return handover;
+}
+
+void VulkanUploader::recordHandover(
+  VkCommandBuffer commandBuffer, Handover& handover, HandoverSide side
+) {
+    if (handover.buffers.empty() && handover.images.empty()) return;
+
+    // a release makes the writes available, an acquire visible to the readers,
+    // on a single queue one barrier does both
+    const auto isRelease   = side != HandoverSide::acquire;
+    const auto isAcquire   = side != HandoverSide::release;
+    const auto isSameQueue = side == HandoverSide::sameQueue;
+
+    const auto srcFamily = isSameQueue ? VK_QUEUE_FAMILY_IGNORED : m_transferFamily;
+    const auto dstFamily = isSameQueue ? VK_QUEUE_FAMILY_IGNORED : m_graphicsFamily;
+    const VkAccessFlags transferWrite = VK_ACCESS_TRANSFER_WRITE_BIT;
+    const VkAccessFlags shaderRead    = VK_ACCESS_SHADER_READ_BIT;
+    const auto srcAccess              = isRelease ? transferWrite : 0u;
+
+    for (auto& barrier : handover.buffers) {
+        barrier.srcAccessMask       = srcAccess;
+        barrier.dstAccessMask       = isAcquire ? bufferReadAccess : 0u;
+        barrier.srcQueueFamilyIndex = srcFamily;
+        barrier.dstQueueFamilyIndex = dstFamily;
+    }
+    for (auto& barrier : handover.images) {
+        barrier.srcAccessMask       = srcAccess;
+        barrier.dstAccessMask       = isAcquire ? shaderRead : 0u;
+        barrier.srcQueueFamilyIndex = srcFamily;
+        barrier.dstQueueFamilyIndex = dstFamily;
+        // without a change of the family the release already did the transition
+        if (side == HandoverSide::acquire && srcFamily == dstFamily)
+            barrier.oldLayout = barrier.newLayout;
+    }
+
+    // the acquire waits for the semaphore at all commands, its barrier starts there
+    const VkPipelineStageFlags srcStage =
+      isRelease ? VK_PIPELINE_STAGE_TRANSFER_BIT
+                : VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    const VkPipelineStageFlags dstStage =
+      isAcquire ? VK_PIPELINE_STAGE_ALL_COMMANDS_BIT
+                : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+
+    vkCmdPipelineBarrier(
+      commandBuffer, srcStage, dstStage, 0, 0, nullptr,
+      static_cast<u32>(handover.buffers.size()), handover.buffers.data(),
+      static_cast<u32>(handover.images.size()), handover.images.data()
+    );
+}
+
+VulkanUploader::Batch VulkanUploader::acquireBatch() {
+    releaseCompletedBatches();
+
+    if (m_freeBatches.empty()) {
+        return Batch{
+            .transferCommands = UniquePtr<VulkanCommandBuffer>::create(
+              m_device, CommandBuffer::Severity::primary, Queue::Type::transfer
+            ),
+            .acquireCommands =
+              m_transfersOwnership
+                ? UniquePtr<VulkanCommandBuffer>::create(m_device)
+                : UniquePtr<VulkanCommandBuffer>{},
+            .ringHead        = 0u,
+            .completionValue = 0u,
+        };
+    }
+
+    auto batch = std::move(m_freeBatches.back());
+    m_freeBatches.pop_back();
+    return batch;
+}
+
+void VulkanUploader::releaseCompletedBatches() {
+    if (m_batchesInFlight.empty()) return;
+
+    const auto completedValue = m_timeline.getValue();
+    while (not m_batchesInFlight.empty()
+           && m_batchesInFlight.front().completionValue <= completedValue) {
+        auto& batch = m_batchesInFlight.front();
+        m_ring.release(batch.ringHead);
+        m_freeBatches.push_back(std::move(batch));
+        m_batchesInFlight.pop_front();
+    }
+}
+
+void VulkanUploader::waitForOldestBatch() {
+    log::expect(
+      not m_batchesInFlight.empty(), "No uploads in flight to wait for, {}b used",
+      m_ring.getUsedSpace()
+    );
+    m_timeline.wait(m_batchesInFlight.front().completionValue);
+    releaseCompletedBatches();
+}
+
+}  // namespace sl::vk
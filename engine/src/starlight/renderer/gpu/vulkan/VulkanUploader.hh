@@ -0,0 +1,120 @@
+#pragma once
+
+#include <deque>
+#include <vector>
+
+#include "starlight/core/memory/Memory.hh"
+#include "starlight/core/memory/RingAllocator.hh"
+
+#include "VulkanBuffer.hh"
+#include "VulkanCommandBuffer.hh"
+#include "VulkanSemaphore.hh"
+#include "Vulkan.hh"
+#include "fwd.hh"
+
+namespace sl::vk {
+
+/*
+    Uploads to device local buffers and images through one persistently mapped
+    staging ring. The data is copied into the ring right away while the copy into
+    the destination is only recorded; flush submits everything recorded so far to
+    the transfer queue, a single vkCmdCopyBuffer per destination buffer. When the
+    transfer queue is of another family than the graphics one the resources are
+    released there and acquired by a small graphics submission waiting for the
+    copies, so the graphics queue never runs them itself. The split can be forced
+    on devices with a single family, so that path runs e.g. on lavapipe as well.
+
+    Every upload returns a ticket, a value of the timeline semaphore signaled once
+    the data is usable by graphics work submitted after the flush. Nothing on the
+    host waits for the GPU unless the ring is full or wait is called; streaming code
+    can poll isComplete and keep using the old data until then. The renderer
+    flushes when a frame begins, so the copies run while the frame is recorded,
+    and once more before its submission for the uploads recorded meanwhile; code
+    reading the destination outside of frames has to flush first.
+*/
+class VulkanUploader : public NonCopyable, public NonMovable {
+public:
+    static constexpr u64 defaultCapacity = 32u * 1024u * 1024u;
+
+    explicit VulkanUploader(
+      VulkanDevice& device, u64 capacity = defaultCapacity,
+      bool forceQueueHandover = false
+    );
+    ~VulkanUploader();
+
+    u64 upload(VulkanBuffer& destination, u64 offset, const void* data, u64 size);
+    // leaves the image in shader read only layout, region.bufferOffset is set here
+    u64 upload(
+      VkImage destination, const VkBufferImageCopy& region,
+      const VkImageSubresourceRange& subresources, const void* data, u64 size
+    );
+    void flush();
+
+    bool isComplete(u64 ticket);
+    void wait(u64 ticket);
+
+private:
+    struct BufferCopy {
+        VkBuffer destination;
+        VkBufferCopy region;
+    };
+
+    struct ImageCopy {
+        VkImage destination;
+        VkBufferImageCopy region;
+        VkImageSubresourceRange subresources;
+    };
+
+    // barriers handing the written resources over to their readers
+    struct Handover {
+        std::vector<VkBufferMemoryBarrier> buffers;
+        std::vector<VkImageMemoryBarrier> images;
+    };
+
+    enum class HandoverSide : u8 { release, acquire, sameQueue };
+
+    struct Batch {
+        UniquePtr<VulkanCommandBuffer> transferCommands;
+        // only when the transfer queue belongs to another family
+        UniquePtr<VulkanCommandBuffer> acquireCommands;
+        // ring head after the batch, released once the batch completed
+        u64 ringHead;
+        u64 completionValue;
+    };
+
+    u64 stage(const void* data, u64 size);
+    u64 getPendingTicket() const;
+
+    void uploadThroughTemporaryBuffer(const void* data, u64 size);
+
+    Handover recordCopies(VkCommandBuffer commandBuffer, VkBuffer source);
+    void recordHandover(
+      VkCommandBuffer commandBuffer, Handover& handover, HandoverSide side
+    );
+
+    Batch acquireBatch();
+    void releaseCompletedBatches();
+    void waitForOldestBatch();
+
+    VulkanDevice& m_device;
+    VulkanQueue& m_transferQueue;
+    VulkanQueue& m_graphicsQueue;
+    u32 m_transferFamily;
+    u32 m_graphicsFamily;
+    // a release and an acquire around the copies, needed across queue families
+    bool m_transfersOwnership;
+
+    VulkanTimelineSemaphore m_timeline;
+    u64 m_submittedValue;
+
+    VulkanBuffer m_stagingBuffer;
+    u8* m_stagingMemory;
+    RingAllocator m_ring;
+
+    std::vector<BufferCopy> m_bufferCopies;
+    std::vector<ImageCopy> m_imageCopies;
+    std::deque<Batch> m_batchesInFlight;
+    std::vector<Batch> m_freeBatches;
+};
+
+}  // namespace sl::vk
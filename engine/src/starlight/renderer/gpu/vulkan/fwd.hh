@@ -14,6 +14,9 @@ class VulkanTextureBase;
 class VulkanQueue;
 class VulkanFence;
 class VulkanSemaphore;
+class VulkanTimelineSemaphore;
 class VulkanDevice;
+class VulkanUploader;
+class VulkanMemoryAllocator;
 
 }  // namespace sl::vk
@@ -0,0 +1,355 @@
+#include "LightClusters.hh"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include "starlight/core/Log.hh"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define SL_LIGHT_CLUSTERS_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SL_LIGHT_CLUSTERS_SSE 1
+#endif
+
+namespace sl {
+
+namespace {
+
+struct SpheresView {
+    const f32* x;
+    const f32* y;
+    const f32* z;
+    const f32* radiusSquared;
+    const u32* light;
+};
+
+// squared distance from the box, value ternaries so it compiles to min/max
+bool touches(const f32* min, const f32* max, const SpheresView& spheres, u32 i) {
+    const auto axis = [](f32 low, f32 high, f32 value) {
+        const auto below = low - value;
+        const auto above = value - high;
+        const auto delta = below > above ? below : above;
+        return delta > 0.0f ? delta : 0.0f;
+    };
+    const auto dx = axis(min[0], max[0], spheres.x[i]);
+    const auto dy = axis(min[1], max[1], spheres.y[i]);
+    const auto dz = axis(min[2], max[2], spheres.z[i]);
+    return (dx * dx + dy * dy) + dz * dz <= spheres.radiusSquared[i];
+}
+
+#if defined(SL_LIGHT_CLUSTERS_AVX)
+
+constexpr u32 batchSize = 8u;
+
+// i-th bit is set when the sphere at first + i touches the box
+u32 testBatch(const f32* min, const f32* max, const SpheresView& spheres, u32 first) {
+    const auto zero = _mm256_setzero_ps();
+    const auto axis = [&](u32 index, const f32* values) {
+        const auto value = _mm256_loadu_ps(values + first);
+        const auto delta = _mm256_max_ps(
+          _mm256_sub_ps(_mm256_set1_ps(min[index]), value),
+          _mm256_sub_ps(value, _mm256_set1_ps(max[index]))
+        );
+        return _mm256_max_ps(delta, zero);
+    };
+
+    const auto dx       = axis(0u, spheres.x);
+    const auto dy       = axis(1u, spheres.y);
+    const auto dz       = axis(2u, spheres.z);
+    const auto distance = _mm256_add_ps(
+      _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)),
+      _mm256_mul_ps(dz, dz)
+    );
+    return static_cast<u32>(_mm256_movemask_ps(_mm256_cmp_ps(
+      distance, _mm256_loadu_ps(spheres.radiusSquared + first), _CMP_LE_OQ
+    )));
+}
+
+#elif defined(SL_LIGHT_CLUSTERS_SSE)
+
+constexpr u32 batchSize = 4u;
+
+// i-th bit is set when the sphere at first + i touches the box
+u32 testBatch(const f32* min, const f32* max, const SpheresView& spheres, u32 first) {
+    const auto zero = _mm_setzero_ps();
+    const auto axis = [&](u32 index, const f32* values) {
+        const auto value = _mm_loadu_ps(values + first);
+        const auto delta = _mm_max_ps(
+          _mm_sub_ps(_mm_set1_ps(min[index]), value),
+          _mm_sub_ps(value, _mm_set1_ps(max[index]))
+        );
+        return _mm_max_ps(delta, zero);
+    };
+
+    const auto dx       = axis(0u, spheres.x);
+    const auto dy       = axis(1u, spheres.y);
+    const auto dz       = axis(2u, spheres.z);
+    const auto distance = _mm_add_ps(
+      _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)
+    );
+    return static_cast<u32>(_mm_movemask_ps(
+      _mm_cmple_ps(distance, _mm_loadu_ps(spheres.radiusSquared + first))
+    ));
+}
+
+#else
+
+constexpr u32 batchSize = 1u;
+
+u32 testBatch(const f32* min, const f32* max, const SpheresView& spheres, u32 first) {
+    return touches(min, max, spheres, first) ? 1u : 0u;
+}
+
+#endif
+
+// calls back with every sphere in [begin, end) and 1 if it touches the box, 0
+// otherwise; callers append unconditionally and advance by the flag, so the
+// compaction does not branch on the test results
+template <typename C>
+void testSpheres(
+  const f32* min, const f32* max, const SpheresView& spheres, u32 begin, u32 end,
+  C&& callback
+) {
+    auto i = begin;
+    for (; i + batchSize <= end; i += batchSize) {
+        const auto mask = testBatch(min, max, spheres, i);
+        for (u32 lane = 0; lane < batchSize; ++lane)
+            callback(i + lane, (mask >> lane) & 1u);
+    }
+    for (; i < end; ++i) callback(i, touches(min, max, spheres, i) ? 1u : 0u);
+}
+
+// view space range covered by a tile side between two depths
+std::pair<f32, f32> getTileRange(f32 ndc0, f32 ndc1, f32 near, f32 far, f32 scale) {
+    const f32 corners[4] = {
+        ndc0 * near / scale,
+        ndc0 * far / scale,
+        ndc1 * near / scale,
+        ndc1 * far / scale,
+    };
+    const auto [min, max] = std::ranges::minmax(corners);
+    return { min, max };
+}
+
+}  // namespace
+
+LightClusters::LightClusters(const Properties& props) : m_props(props) {
+    computeBoxes();
+}
+
+void LightClusters::setProperties(const Properties& props) {
+    if (props == m_props) return;
+
+    m_props = props;
+    computeBoxes();
+}
+
+void LightClusters::build(std::span<const LightSphere> lights) {
+    binLights(lights);
+
+    const auto getView = [](const Candidates& candidates) {
+        return SpheresView{
+            .x             = candidates.x.data(),
+            .y             = candidates.y.data(),
+            .z             = candidates.z.data(),
+            .radiusSquared = candidates.radiusSquared.data(),
+            .light         = candidates.light.data(),
+        };
+    };
+
+    const auto tilesX       = m_props.tilesX;
+    const auto tilesY       = m_props.tilesY;
+    const auto sliceSpheres = getView(m_candidates);
+
+    u32 written = 0u;
+    for (u32 slice = 0; slice < m_props.slices; ++slice) {
+        const auto begin = m_sliceOffsets[slice];
+        const auto end   = m_sliceOffsets[slice + 1u];
+        m_rowCandidates.grow(end - begin);
+
+        for (u32 y = 0; y < tilesY; ++y) {
+            // a row keeps the slice candidates touching it, clusters only test those
+            const auto& row = m_rowBoxes[slice * tilesY + y];
+            u32 rowCount    = 0u;
+
+            testSpheres(
+              row.min, row.max, sliceSpheres, begin, end,
+              [&](u32 i, u32 touches) {
+                  auto& rows = m_rowCandidates;
+
+                  rows.x[rowCount]             = sliceSpheres.x[i];
+                  rows.y[rowCount]             = sliceSpheres.y[i];
+                  rows.z[rowCount]             = sliceSpheres.z[i];
+                  rows.radiusSquared[rowCount] = sliceSpheres.radiusSquared[i];
+                  rows.light[rowCount]         = sliceSpheres.light[i];
+                  rowCount += touches;
+              }
+            );
+
+            if (const auto required = written + rowCount * tilesX;
+                m_lightIndices.size() < required)
+                m_lightIndices.resize(std::bit_ceil(required));
+
+            const auto rowSpheres = getView(m_rowCandidates);
+            const auto indices    = m_lightIndices.data();
+
+            for (u32 x = 0; x < tilesX; ++x) {
+                const auto index = getClusterIndex(x, y, slice);
+                const auto& box  = m_boxes[index];
+                auto& cluster    = m_clusters[index];
+
+                cluster.offset = written;
+                testSpheres(
+                  box.min, box.max, rowSpheres, 0u, rowCount,
+                  [&](u32 i, u32 touches) {
+                      indices[written] = rowSpheres.light[i];
+                      written += touches;
+                  }
+                );
+                cluster.count = written - cluster.offset;
+            }
+        }
+    }
+    m_lightIndexCount = written;
+}
+
+const LightClusters::Properties& LightClusters::getProperties() const {
+    return m_props;
+}
+
+std::span<const LightClusters::Cluster> LightClusters::getClusters() const {
+    return m_clusters;
+}
+
+std::span<const u32> LightClusters::getLightIndices() const {
+    return { m_lightIndices.data(), m_lightIndexCount };
+}
+
+u32 LightClusters::getClusterIndex(u32 x, u32 y, u32 slice) const {
+    return (slice * m_props.tilesY + y) * m_props.tilesX + x;
+}
+
+f32 LightClusters::getDepthScale() const { return m_depthScale; }
+
+f32 LightClusters::getDepthBias() const { return m_depthBias; }
+
+void LightClusters::computeBoxes() {
+    const auto& [tilesX, tilesY, slices, scaleX, scaleY, nearZ, farZ] = m_props;
+    log::expect(
+      tilesX > 0u && tilesY > 0u && slices > 0u, "Light cluster grid can't be empty"
+    );
+    log::expect(
+      nearZ > 0.0f && farZ > nearZ, "Invalid light cluster depth range: {} - {}",
+      nearZ, farZ
+    );
+
+    m_depthScale = slices / std::log(farZ / nearZ);
+    m_depthBias  = -std::log(nearZ) * m_depthScale;
+
+    const auto count = tilesX * tilesY * slices;
+    m_boxes.resize(count);
+    m_rowBoxes.resize(tilesY * slices);
+    m_clusters.assign(count, Cluster{ .offset = 0u, .count = 0u });
+
+    const auto getDepth = [&](u32 slice) {
+        return slice == slices
+                 ? farZ
+                 : nearZ * std::pow(farZ / nearZ, static_cast<f32>(slice) / slices);
+    };
+
+    for (u32 slice = 0; slice < slices; ++slice) {
+        const auto near = getDepth(slice);
+        const auto far  = getDepth(slice + 1u);
+
+        const auto [rowMinX, rowMaxX] = getTileRange(-1.0f, 1.0f, near, far, scaleX);
+
+        for (u32 y = 0; y < tilesY; ++y) {
+            const auto [minY, maxY] = getTileRange(
+              -1.0f + 2.0f * y / tilesY, -1.0f + 2.0f * (y + 1u) / tilesY, near, far,
+              scaleY
+            );
+            m_rowBoxes[slice * tilesY + y] = Box{
+                .min = { rowMinX, minY, -far },
+                .max = { rowMaxX, maxY, -near },
+            };
+
+            for (u32 x = 0; x < tilesX; ++x) {
+                const auto [minX, maxX] = getTileRange(
+                  -1.0f + 2.0f * x / tilesX, -1.0f + 2.0f * (x + 1u) / tilesX, near,
+                  far, scaleX
+                );
+                m_boxes[getClusterIndex(x, y, slice)] = Box{
+                    .min = { minX, minY, -far },
+                    .max = { maxX, maxY, -near },
+                };
+            }
+        }
+    }
+}
+
+u32 LightClusters::getSlice(f32 depth) const {
+    const auto slice = std::floor(
+      std::log(std::max(depth, m_props.nearZ)) * m_depthScale + m_depthBias
+    );
+    return static_cast<u32>(
+      std::clamp(slice, 0.0f, static_cast<f32>(m_props.slices - 1u))
+    );
+}
+
+// counting sort of the lights into the depth slices they span
+void LightClusters::binLights(std::span<const LightSphere> lights) {
+    const auto isInRange = [&](const LightSphere& light) {
+        const auto depth = -light.position[2];
+        return depth + light.radius >= m_props.nearZ
+               && depth - light.radius <= m_props.farZ;
+    };
+
+    m_sliceOffsets.assign(m_props.slices + 1u, 0u);
+
+    for (const auto& light : lights) {
+        if (not isInRange(light)) continue;
+
+        const auto depth = -light.position[2];
+        const auto last  = getSlice(depth + light.radius);
+        for (auto slice = getSlice(depth - light.radius); slice <= last; ++slice)
+            ++m_sliceOffsets[slice + 1u];
+    }
+
+    for (u32 slice = 0; slice < m_props.slices; ++slice)
+        m_sliceOffsets[slice + 1u] += m_sliceOffsets[slice];
+
+    m_candidates.grow(m_sliceOffsets.back());
+    m_sliceCursors.assign(m_sliceOffsets.begin(), m_sliceOffsets.end() - 1);
+
+    for (u32 i = 0; i < lights.size(); ++i) {
+        const auto& light = lights[i];
+        if (not isInRange(light)) continue;
+
+        const auto depth = -light.position[2];
+        const auto last  = getSlice(depth + light.radius);
+        for (auto slice = getSlice(depth - light.radius); slice <= last; ++slice) {
+            const auto candidate = m_sliceCursors[slice]++;
+
+            m_candidates.x[candidate]             = light.position[0];
+            m_candidates.y[candidate]             = light.position[1];
+            m_candidates.z[candidate]             = light.position[2];
+            m_candidates.radiusSquared[candidate] = light.radius * light.radius;
+            m_candidates.light[candidate]         = i;
+        }
+    }
+}
+
+void LightClusters::Candidates::grow(u64 size) {
+    if (x.size() >= size) return;
+
+    x.resize(size);
+    y.resize(size);
+    z.resize(size);
+    radiusSquared.resize(size);
+    light.resize(size);
+}
+
+}  // namespace sl
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "starlight/core/Core.hh"
+
+namespace sl {
+
+// range of a light as a view space sphere, the camera looks down -Z
+struct LightSphere {
+    f32 position[3];
+    f32 radius;
+};
+
+/*
+    Clustered light assignment. The view frustum is split into froxels, screen tiles
+    times exponentially spaced depth slices, and every froxel gets the list of lights
+    whose range touches its view space box. Lights are binned into the depth slices
+    they span first, so each froxel only tests the candidates of its slice, 8 (AVX)
+    or 4 (SSE) at a time. All lists live in one flat index array and clusters store
+    their offset and count into it, which is the layout uploaded to the shaders.
+*/
+class LightClusters {
+public:
+    struct Properties {
+        bool operator==(const Properties&) const = default;
+
+        u32 tilesX = 16u;
+        u32 tilesY = 9u;
+        u32 slices = 24u;
+        // [0][0] and [1][1] elements of the perspective projection matrix
+        f32 projectionScaleX = 1.0f;
+        f32 projectionScaleY = 1.0f;
+        f32 nearZ            = 0.1f;
+        f32 farZ             = 1000.0f;
+    };
+
+    struct Cluster {
+        u32 offset;
+        u32 count;
+    };
+
+    explicit LightClusters(const Properties& props);
+
+    // froxel boxes are recomputed only when the properties differ
+    void setProperties(const Properties& props);
+    void build(std::span<const LightSphere> lights);
+
+    const Properties& getProperties() const;
+    std::span<const Cluster> getClusters() const;
+    std::span<const u32> getLightIndices() const;
+
+    u32 getClusterIndex(u32 x, u32 y, u32 slice) const;
+    // the slice of a view depth is floor(log(depth) * scale + bias)
+    f32 getDepthScale() const;
+    f32 getDepthBias() const;
+
+private:
+    struct Box {
+        f32 min[3];
+        f32 max[3];
+    };
+
+    // light candidates of the depth slices, as structure of arrays
+    struct Candidates {
+        // only ever grows, the arrays are reused between builds
+        void grow(u64 size);
+
+        std::vector<f32> x;
+        std::vector<f32> y;
+        std::vector<f32> z;
+        std::vector<f32> radiusSquared;
+        std::vector<u32> light;
+    };
+
+    void computeBoxes();
+    u32 getSlice(f32 depth) const;
+
+    void binLights(std::span<const LightSphere> lights);
+
+    Properties m_props;
+    f32 m_depthScale;
+    f32 m_depthBias;
+
+    std::vector<Box> m_boxes;
+    // union of the cluster boxes of a tile row in a slice
+    std::vector<Box> m_rowBoxes;
+    std::vector<Cluster> m_clusters;
+    // sized with some slack, only the first m_lightIndexCount are valid
+    std::vector<u32> m_lightIndices;
+    u32 m_lightIndexCount = 0u;
+
+    // candidates of the i-th slice are in [m_sliceOffsets[i], m_sliceOffsets[i + 1])
+    std::vector<u32> m_sliceOffsets;
+    std::vector<u32> m_sliceCursors;
+    Candidates m_candidates;
+    Candidates m_rowCandidates;
+};
+
+}  // namespace sl
@@ -8,9 +8,10 @@ namespace sl {
 PointLight::PointLight(
   const Vec4<f32>& color, const Vec3<f32>& position, const Vec3<f32>& attenuation
 ) :
-    m_data{ color, position, attenuation }, color(m_data.color),
+    m_data{ color, position, attenuation }, m_radius(0.0f), color(m_data.color),
     position(m_data.position) {
     generateLODs();
+    calculateRadius();
 }
 
 const Vec3<f32>& PointLight::getAttenuation() const { return m_data.attenuation; }
@@ -18,6 +19,7 @@ const Vec3<f32>& PointLight::getAttenuation() const { return m_data.attenuation;
 void PointLight::setAttenuation(const Vec3<f32>& attenuation) {
     m_data.attenuation = attenuation;
     generateLODs();
+    calculateRadius();
 }
 
 std::span<const PointLight::LOD> PointLight::getLODs() const { return m_lods; }
@@ -51,6 +53,26 @@ void PointLight::generateLODs() {
     }
 }
 
+f32 PointLight::getRadius() const { return m_radius; }
+
+void PointLight::calculateRadius() {
+    // attenuation is 1 / (constant + linear * d + quadratic * d^2)
+    const auto quadratic = m_data.attenuation.x;
+    const auto linear    = m_data.attenuation.y;
+    const auto constant  = m_data.attenuation.z;
+    const auto target    = 1.0f / cutoffAttenuation;
+
+    if (quadratic > 0.0f) {
+        const auto roots =
+          solveQuadraticEquation(quadratic, linear, constant - target);
+        m_radius = roots ? std::max(roots->second, 0.0f) : 0.0f;
+    } else if (linear > 0.0f) {
+        m_radius = std::max((target - constant) / linear, 0.0f);
+    } else {
+        m_radius = max<f32>();
+    }
+}
+
 const PointLight::ShaderData& PointLight::getShaderData() const { return m_data; }
 
 std::string toString(const PointLight& l) {
@@ -14,6 +14,9 @@ public:
         f32 opacity;
     };
 
+    // attenuation below which the light is considered out of range
+    static constexpr f32 cutoffAttenuation = 1.0f / 256.0f;
+
     struct ShaderData {
         alignas(16) Vec4<f32> color;
         alignas(16) Vec3<f32> position;
@@ -32,11 +35,17 @@ public:
     std::span<const LOD> getLODs() const;
     void generateLODs();
 
+    // distance at which the attenuation drops to the cutoff
+    f32 getRadius() const;
+
     const ShaderData& getShaderData() const;
 
 private:
+    void calculateRadius();
+
     ShaderData m_data;
     std::vector<LOD> m_lods;
+    f32 m_radius;
 
 public:
     Vec4<f32>& color;
@@ -0,0 +1,140 @@
+#include "ShadowCascades.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "starlight/core/Log.hh"
+
+namespace sl {
+
+namespace {
+
+f32 dot(const f32* lhs, const f32* rhs) {
+    return lhs[0] * rhs[0] + lhs[1] * rhs[1] + lhs[2] * rhs[2];
+}
+
+void cross(const f32* lhs, const f32* rhs, f32* out) {
+    out[0] = lhs[1] * rhs[2] - lhs[2] * rhs[1];
+    out[1] = lhs[2] * rhs[0] - lhs[0] * rhs[2];
+    out[2] = lhs[0] * rhs[1] - lhs[1] * rhs[0];
+}
+
+void normalize(f32* vector) {
+    const auto length = std::sqrt(dot(vector, vector));
+    for (u32 i = 0; i < 3u; ++i) vector[i] /= length;
+}
+
+}  // namespace
+
+ShadowCascades::ShadowCascades(const Properties& props) :
+    m_props(props), m_cascades{} {
+    log::expect(
+      props.cascadeCount > 0u && props.cascadeCount <= maxCascades,
+      "Shadow cascade count must be between 1 and {}, got {}", maxCascades,
+      props.cascadeCount
+    );
+    log::expect(
+      props.resolution > 2u, "Shadow map resolution too small: {}", props.resolution
+    );
+}
+
+void ShadowCascades::update(const View& view, const f32* lightDirection) {
+    computeSplits(view);
+
+    // light space basis, the same one a look at matrix would use
+    f32 forward[3] = { lightDirection[0], lightDirection[1], lightDirection[2] };
+    normalize(forward);
+
+    const f32 worldUp[3]    = { 0.0f, 1.0f, 0.0f };
+    const f32 worldFront[3] = { 0.0f, 0.0f, 1.0f };
+    const auto* up          = std::abs(forward[1]) > 0.99f ? worldFront : worldUp;
+
+    f32 right[3];
+    cross(forward, up, right);
+    normalize(right);
+
+    f32 lightUp[3];
+    cross(right, forward, lightUp);
+
+    const auto tanX = 1.0f / view.projectionScaleX;
+    const auto tanY = 1.0f / view.projectionScaleY;
+    // squared tangent of the half diagonal angle of the frustum
+    const auto diagonal = tanX * tanX + tanY * tanY;
+    const auto* toWorld = view.inverseView;
+
+    for (u32 i = 0; i < m_props.cascadeCount; ++i) {
+        auto& cascade        = m_cascades[i];
+        const auto sliceNear = i == 0u ? view.nearZ : m_cascades[i - 1u].splitDepth;
+        const auto sliceFar  = cascade.splitDepth;
+
+        // the smallest sphere around the slice has its center on the view axis,
+        // equally far from the near and far corners unless that is past the slice
+        const auto centerDepth =
+          std::min((sliceNear + sliceFar) * (1.0f + diagonal) * 0.5f, sliceFar);
+        const auto nearDepth = centerDepth - sliceNear;
+        const auto farDepth  = sliceFar - centerDepth;
+
+        auto radius = std::sqrt(std::max(
+          nearDepth * nearDepth + sliceNear * sliceNear * diagonal,
+          farDepth * farDepth + sliceFar * sliceFar * diagonal
+        ));
+        // rounded up so float noise does not change the texel size between frames
+        radius = std::ceil(radius * 16.0f) / 16.0f;
+
+        // one texel of margin, so the snapped projection still covers the sphere
+        const auto resolution = static_cast<f32>(m_props.resolution);
+        const auto halfSize   = radius * resolution / (resolution - 2.0f);
+        const auto texel      = 2.0f * halfSize / resolution;
+
+        f32 center[3];
+        for (u32 axis = 0; axis < 3u; ++axis)
+            center[axis] = toWorld[12 + axis] - toWorld[8 + axis] * centerDepth;
+
+        // the depth is snapped as well, so a cascade of a camera that barely moved
+        // gives exactly the same matrix and its cached shadows stay valid
+        const auto x     = std::floor(dot(right, center) / texel) * texel;
+        const auto y     = std::floor(dot(lightUp, center) / texel) * texel;
+        const auto depth = std::floor(dot(forward, center) / texel) * texel;
+
+        const auto minDepth = depth - halfSize - m_props.casterDistance;
+        const auto range    = 2.0f * halfSize + m_props.casterDistance;
+
+        auto* matrix = cascade.viewProjection;
+
+        for (u32 axis = 0; axis < 3u; ++axis) {
+            matrix[axis * 4u]      = right[axis] / halfSize;
+            matrix[axis * 4u + 1u] = lightUp[axis] / halfSize;
+            matrix[axis * 4u + 2u] = forward[axis] / range;
+            matrix[axis * 4u + 3u] = 0.0f;
+        }
+        matrix[12] = -x / halfSize;
+        matrix[13] = -y / halfSize;
+        matrix[14] = -minDepth / range;
+        matrix[15] = 1.0f;
+    }
+}
+
+const ShadowCascades::Properties& ShadowCascades::getProperties() const {
+    return m_props;
+}
+
+std::span<const ShadowCascade> ShadowCascades::getCascades() const {
+    return std::span{ m_cascades }.first(m_props.cascadeCount);
+}
+
+void ShadowCascades::computeSplits(const View& view) {
+    const auto nearZ = view.nearZ;
+    const auto farZ  = std::min(view.farZ, m_props.shadowDistance);
+    const auto count = m_props.cascadeCount;
+
+    for (u32 i = 0; i < count; ++i) {
+        const auto part        = static_cast<f32>(i + 1u) / count;
+        const auto logarithmic = nearZ * std::pow(farZ / nearZ, part);
+        const auto uniform     = nearZ + (farZ - nearZ) * part;
+
+        m_cascades[i].splitDepth =
+          m_props.splitLambda * logarithmic + (1.0f - m_props.splitLambda) * uniform;
+    }
+}
+
+}  // namespace sl
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <span>
+
+#include "starlight/core/Core.hh"
+
+namespace sl {
+
+struct ShadowCascade {
+    // world to light clip space with 0..1 depth, column major
+    f32 viewProjection[16];
+    // view depth at which the next cascade takes over
+    f32 splitDepth;
+};
+
+/*
+    Cascaded shadow maps of a directional light. The camera frustum, up to the
+    shadow distance, is split into slices with the practical split scheme, a blend
+    of logarithmic and uniform splits. Each slice is bounded by a sphere, so the
+    orthographic projection keeps its size however the camera turns, and the
+    projection is moved in whole shadow map texels only, which stops the edges of
+    shadows from shimmering when the camera moves. The depth range reaches further
+    towards the light so casters in front of the slice still land in the map.
+*/
+class ShadowCascades {
+public:
+    static constexpr u32 maxCascades = 4u;
+
+    struct Properties {
+        u32 cascadeCount = maxCascades;
+        // of a single cascade
+        u32 resolution = 1024u;
+        // 0 gives uniform splits, 1 logarithmic ones
+        f32 splitLambda = 0.75f;
+        // shadows end here or at the far plane, whichever is closer
+        f32 shadowDistance = 100.0f;
+        // how far towards the light from a slice casters are still drawn
+        f32 casterDistance = 50.0f;
+    };
+
+    struct View {
+        // camera to world, column major
+        const f32* inverseView;
+        // [0][0] and [1][1] elements of the perspective projection matrix
+        f32 projectionScaleX;
+        f32 projectionScaleY;
+        f32 nearZ;
+        f32 farZ;
+    };
+
+    explicit ShadowCascades(const Properties& props);
+
+    void update(const View& view, const f32* lightDirection);
+
+    const Properties& getProperties() const;
+    std::span<const ShadowCascade> getCascades() const;
+
+private:
+    void computeSplits(const View& view);
+
+    Properties m_props;
+    std::array<ShadowCascade, maxCascades> m_cascades;
+};
+
+}  // namespace sl
@@ -0,0 +1,100 @@
+#include "starlight/app/scene/ecs/ComponentManager.hh"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace sl;
+
+namespace {
+
+struct Position {
+    float x;
+};
+
+struct Velocity {
+    float x;
+};
+
+struct Health {
+    int value;
+};
+
+}  // namespace
+
+class ComponentManagerTests : public testing::Test {
+protected:
+    std::vector<u64> collectEntities() {
+        std::vector<u64> entities;
+        manager.view<Position, Velocity>().forEach(
+          [&](Component<Position>& position, Component<Velocity>& velocity) {
+              EXPECT_EQ(position.getEntityId(), velocity.getEntityId());
+              entities.push_back(position.getEntityId());
+          }
+        );
+        std::ranges::sort(entities);
+        return entities;
+    }
+
+    ComponentManager manager;
+};
+
+TEST_F(ComponentManagerTests, givenNoComponents_whenViewing_shouldBeEmpty) {
+    EXPECT_TRUE(manager.view<Position>().empty());
+    EXPECT_TRUE((manager.view<Position, Velocity>().empty()));
+}
+
+TEST_F(ComponentManagerTests, givenComponents_whenViewing_shouldVisitOnlyMatching) {
+    for (u64 i = 0; i < 10; ++i) manager.add<Position>(i, static_cast<float>(i));
+    for (u64 i = 0; i < 10; i += 2) manager.add<Velocity>(i, 1.0f);
+    manager.add<Health>(4, 100);
+
+    EXPECT_EQ(manager.view<Position>().size(), 10u);
+    EXPECT_EQ(collectEntities(), (std::vector<u64>{ 0, 2, 4, 6, 8 }));
+    EXPECT_EQ((manager.view<Position, Velocity, Health>().size()), 1u);
+}
+
+TEST_F(ComponentManagerTests, givenView_whenIterating_shouldAllowMutation) {
+    for (u64 i = 0; i < 4; ++i) {
+        manager.add<Position>(i, 0.0f);
+        manager.add<Velocity>(i, static_cast<float>(i));
+    }
+
+    auto apply = [](Component<Position>& position, Component<Velocity>& velocity) {
+        position.data().x += velocity.data().x;
+    };
+    manager.view<Position, Velocity>().forEach(apply);
+    manager.view<Position, Velocity>().forEach(apply);
+
+    for (u64 i = 0; i < 4; ++i)
+        EXPECT_EQ(manager.get<Position>(i).data().x, 2.0f * i);
+}
+
+TEST_F(ComponentManagerTests, givenCachedView_whenMembershipChanges_shouldRebuild) {
+    for (u64 i = 0; i < 4; ++i) {
+        manager.add<Position>(i, 0.0f);
+        manager.add<Velocity>(i, 0.0f);
+    }
+    EXPECT_EQ(collectEntities(), (std::vector<u64>{ 0, 1, 2, 3 }));
+
+    // removal moves the last component into the hole, cached indices must follow
+    EXPECT_TRUE(manager.remove<Velocity>(1));
+    EXPECT_EQ(collectEntities(), (std::vector<u64>{ 0, 2, 3 }));
+
+    manager.add<Velocity>(1, 0.0f);
+    manager.add<Velocity>(7, 0.0f);
+    EXPECT_EQ(collectEntities(), (std::vector<u64>{ 0, 1, 2, 3 }));
+
+    EXPECT_FALSE(manager.remove<Velocity>(100));
+    EXPECT_EQ(collectEntities(), (std::vector<u64>{ 0, 1, 2, 3 }));
+}
+
+TEST_F(ComponentManagerTests, givenComponents_whenClearing_shouldInvalidateViews) {
+    manager.add<Position>(0, 0.0f);
+    manager.add<Velocity>(0, 0.0f);
+    EXPECT_EQ((manager.view<Position, Velocity>().size()), 1u);
+
+    manager.clear();
+    EXPECT_TRUE((manager.view<Position, Velocity>().empty()));
+}
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+
+#include "mock/SceneTest.hh"
+
+using namespace sl;
+
+class SceneTests : public SceneTest {
+protected:
+    u64 countVisibleEntities() {
+        frameAllocator.beginFrame();
+        return scene.getRenderPacket().entities.size();
+    }
+
+    Transform& addStaticEntity(const Vec3<f32>& position) {
+        auto& composite =
+          scene.addEntity().addComponent<MeshComposite>(mesh, nullptr).data();
+        composite.isStatic = true;
+
+        auto& instance = composite.getRoot().getInstances()[0];
+        instance.setPosition(position);
+        return instance;
+    }
+
+    SharedPtr<Mesh> mesh = createMesh();
+};
+
+TEST_F(SceneTests, givenMovedStaticEntity_whenCulling_shouldUseNewBox) {
+    addStaticEntity(Vec3<f32>{ 0.0f });
+    auto& moved = addStaticEntity(Vec3<f32>{ 2.0f, 0.0f, 0.0f });
+    EXPECT_EQ(countVisibleEntities(), 2u);
+
+    // behind the camera, same entities so the hierarchy is only refitted
+    moved.setPosition(Vec3<f32>{ 0.0f, 0.0f, -100.0f });
+    EXPECT_EQ(countVisibleEntities(), 1u);
+
+    moved.setPosition(Vec3<f32>{ 0.0f, 2.0f, 0.0f });
+    EXPECT_EQ(countVisibleEntities(), 2u);
+}
+
+TEST_F(SceneTests, givenStaticEntityInView_whenAddingAnother_shouldCullBoth) {
+    addStaticEntity(Vec3<f32>{ 0.0f });
+    EXPECT_EQ(countVisibleEntities(), 1u);
+
+    addStaticEntity(Vec3<f32>{ 0.0f, 0.0f, -100.0f });
+    addStaticEntity(Vec3<f32>{ 0.0f, 2.0f, 0.0f });
+    EXPECT_EQ(countVisibleEntities(), 2u);
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "mock/SceneTest.hh"
+
+// the replaced operators count every heap allocation of this test binary, so it
+// holds nothing but the allocation checks
+
+using namespace sl;
+
+// replaced operators are matched, the warning about free on new-ed memory doesn't
+// apply
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+static std::atomic<u64> s_heapAllocations = 0u;
+
+void* operator new(std::size_t size) {
+    ++s_heapAllocations;
+    if (auto memory = std::malloc(size == 0 ? 1 : size); memory) return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+class SceneAllocationsTests : public SceneTest {
+protected:
+    // steady frames, once the containers and the arenas were created
+    u64 countFrameAllocations(u64 expectedEntities) {
+        auto buildFrame = [&]() {
+            frameAllocator.beginFrame();
+            const auto packet = scene.getRenderPacket();
+            return packet.entities.size();
+        };
+
+        for (u64 i = 0; i < 2u * frameAllocator.getFramesInFlight(); ++i)
+            buildFrame();
+
+        const auto allocations = s_heapAllocations.load();
+        for (int i = 0; i < 100; ++i) EXPECT_EQ(buildFrame(), expectedEntities);
+
+        return s_heapAllocations.load() - allocations;
+    }
+};
+
+TEST_F(
+  SceneAllocationsTests,
+  givenSteadyScene_whenBuildingRenderPackets_shouldNotTouchHeap
+) {
+    constexpr u32 entityCount   = 200u;
+    constexpr u32 instanceCount = 5u;
+
+    auto mesh = createMesh();
+
+    // all in front of the camera, nothing gets culled
+    for (u32 i = 0; i < entityCount; ++i) {
+        auto& composite =
+          scene.addEntity().addComponent<MeshComposite>(mesh, nullptr).data();
+        auto& root = composite.getRoot();
+        for (u32 j = 0; j < instanceCount; ++j) {
+            auto& instance = j == 0u ? root.getInstances()[0] : root.addInstance();
+            instance.setPosition(
+              Vec3<f32>{ (i % 20u) * 0.5f - 5.0f, j * 0.5f, (i / 20u) * 0.5f }
+            );
+        }
+    }
+
+    EXPECT_EQ(countFrameAllocations(entityCount * instanceCount), 0u);
+}
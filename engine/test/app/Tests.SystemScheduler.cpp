@@ -0,0 +1,198 @@
+#include "starlight/app/scene/ecs/SystemScheduler.hh"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cmath>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace sl;
+
+namespace {
+
+struct Position {
+    float x;
+};
+
+struct Velocity {
+    float x;
+};
+
+struct Mass {
+    float value;
+};
+
+constexpr u64 entityCount = 1000;
+constexpr u64 frameCount  = 50;
+
+void populate(ComponentManager& manager) {
+    for (u64 i = 0; i < entityCount; ++i) {
+        manager.add<Position>(i, 0.0f);
+        manager.add<Velocity>(i, static_cast<float>(i));
+        if (i % 2 == 0) manager.add<Mass>(i, 2.0f);
+    }
+}
+
+// order matters, results differ if any of the dependencies is not respected
+void addSimulation(SystemScheduler& scheduler) {
+    scheduler.addSystem<Write<Velocity>, Read<Mass>>(
+      "gravity",
+      [](ComponentManager& manager, float deltaTime) {
+          manager.view<Velocity, Mass>().forEach([&](auto& velocity, auto& mass) {
+              velocity.data().x -= mass.data().value * deltaTime;
+          });
+      }
+    );
+    scheduler.addSystem<Read<Velocity>, Write<Position>>(
+      "movement",
+      [](ComponentManager& manager, float deltaTime) {
+          manager.view<Position, Velocity>().forEach([&](auto& position, auto& velocity) {
+              position.data().x += velocity.data().x * deltaTime;
+          });
+      }
+    );
+    scheduler.addSystem<Write<Mass>>("decay", [](ComponentManager& manager, float) {
+        manager.getComponentContainer<Mass>().forEach([](auto& mass) {
+            mass.data().value *= 0.5f;
+        });
+    });
+    scheduler.addSystem<Read<Position, Mass>>(
+      "observer",
+      [](ComponentManager& manager, float) {
+          float sum = 0.0f;
+          manager.view<Position, Mass>().forEach([&](auto& position, auto& mass) {
+              sum += position.data().x * mass.data().value;
+          });
+          EXPECT_FALSE(std::isnan(sum));
+      }
+    );
+}
+
+std::vector<float> simulate(SystemScheduler::Mode mode) {
+    ComponentManager manager;
+    populate(manager);
+
+    JobSystem jobSystem{ 4u };
+    SystemScheduler scheduler{ jobSystem, mode };
+    addSimulation(scheduler);
+
+    for (u64 i = 0; i < frameCount; ++i) scheduler.run(manager, 0.1f);
+
+    std::vector<float> positions;
+    manager.getComponentContainer<Position>().forEach([&](auto& position) {
+        positions.push_back(position.data().x);
+    });
+    return positions;
+}
+
+}  // namespace
+
+TEST(SystemSchedulerTests, givenSerialMode_whenRunning_shouldCallSystemsInOrder) {
+    ComponentManager manager;
+    JobSystem jobSystem{ 0u };
+    SystemScheduler scheduler{ jobSystem, SystemScheduler::Mode::serial };
+
+    std::vector<int> calls;
+    scheduler.addSystem<Read<Position>>("first", [&](auto&, float) {
+        calls.push_back(1);
+    });
+    scheduler.addSystem<Read<Position>>("second", [&](auto&, float) {
+        calls.push_back(2);
+    });
+    scheduler.addSystem<Write<Velocity>>("third", [&](auto&, float) {
+        calls.push_back(3);
+    });
+
+    scheduler.run(manager, 0.0f);
+    EXPECT_EQ(calls, (std::vector<int>{ 1, 2, 3 }));
+    EXPECT_EQ(scheduler.getSystemCount(), 3u);
+}
+
+TEST(SystemSchedulerTests, givenConflictingSystems_whenRunning_shouldKeepOrder) {
+    ComponentManager manager;
+    JobSystem jobSystem{ 4u };
+    SystemScheduler scheduler{ jobSystem };
+
+    std::mutex mutex;
+    std::vector<int> calls;
+    auto record = [&](int value) {
+        std::scoped_lock guard{ mutex };
+        calls.push_back(value);
+    };
+
+    scheduler.addSystem<Write<Position>>("writer", [&](auto&, float) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });
+        record(1);
+    });
+    scheduler.addSystem<Read<Position>>("reader", [&](auto&, float) { record(2); });
+    scheduler.addSystem<Write<Position>>("second writer", [&](auto&, float) {
+        record(3);
+    });
+
+    for (int i = 0; i < 10; ++i) {
+        calls.clear();
+        scheduler.run(manager, 0.0f);
+        EXPECT_EQ(calls, (std::vector<int>{ 1, 2, 3 }));
+    }
+}
+
+TEST(SystemSchedulerTests, givenIndependentSystems_whenRunning_shouldRunConcurrently) {
+    ComponentManager manager;
+    JobSystem jobSystem{ 2u };
+    SystemScheduler scheduler{ jobSystem };
+
+    std::atomic<int> arrived = 0;
+    std::atomic<bool> overlapped = true;
+
+    // both systems wait for each other, that's possible only if they overlap
+    auto rendezvous = [&](auto&, float) {
+        ++arrived;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{ 5 };
+        while (arrived.load() < 2) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                overlapped = false;
+                return;
+            }
+            std::this_thread::yield();
+        }
+    };
+
+    scheduler.addSystem<Read<Position>, Write<Velocity>>("first", rendezvous);
+    scheduler.addSystem<Read<Position>, Write<Mass>>("second", rendezvous);
+
+    scheduler.run(manager, 0.0f);
+    EXPECT_TRUE(overlapped);
+}
+
+TEST(SystemSchedulerTests, givenSimulation_whenRunningInParallel_shouldMatchSerialRun) {
+    const auto serial   = simulate(SystemScheduler::Mode::serial);
+    const auto parallel = simulate(SystemScheduler::Mode::parallel);
+
+    ASSERT_EQ(serial.size(), entityCount);
+    EXPECT_EQ(serial, parallel);
+}
+
+TEST(SystemSchedulerTests, givenScheduler_whenAddingSystemsBetweenRuns_shouldRebuildGraph) {
+    ComponentManager manager;
+    populate(manager);
+
+    JobSystem jobSystem{ 4u };
+    SystemScheduler scheduler{ jobSystem };
+    addSimulation(scheduler);
+    scheduler.run(manager, 0.1f);
+
+    std::atomic<u64> visited = 0u;
+    scheduler.addSystem<Read<Position>>("counter", [&](ComponentManager& manager, float) {
+        visited += manager.getComponentContainer<Position>().size();
+    });
+    scheduler.run(manager, 0.1f);
+
+    EXPECT_EQ(visited.load(), entityCount);
+
+    scheduler.clear();
+    scheduler.run(manager, 0.1f);
+    EXPECT_EQ(visited.load(), entityCount);
+}
@@ -0,0 +1,152 @@
+#include "starlight/core/containers/FreeList.hh"
+
+#include <gtest/gtest.h>
+
+using namespace sl;
+
+constexpr u64 defaultSize = 1024;
+
+TEST(FreeListTests, givenFreeList_whenGettingSpaceLeft_shouldReturnWholeSize) {
+    FreeList freeList{ defaultSize };
+    EXPECT_EQ(freeList.spaceLeft(), defaultSize);
+    EXPECT_EQ(freeList.getSize(), defaultSize);
+}
+
+TEST(FreeListTests, givenFreeList_whenAllocating_shouldReturnDistinctRanges) {
+    FreeList freeList{ defaultSize };
+
+    auto first  = freeList.allocateBlock(100);
+    auto second = freeList.allocateBlock(200);
+
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+    EXPECT_TRUE(*first + 100 <= *second || *second + 200 <= *first);
+    EXPECT_EQ(freeList.spaceLeft(), defaultSize - 300);
+}
+
+TEST(FreeListTests, givenFreeList_whenAllocatingWholeSpace_shouldSucceed) {
+    FreeList freeList{ defaultSize };
+
+    auto offset = freeList.allocateBlock(defaultSize);
+    ASSERT_TRUE(offset.has_value());
+    EXPECT_EQ(*offset, 0u);
+    EXPECT_EQ(freeList.spaceLeft(), 0u);
+    EXPECT_FALSE(freeList.allocateBlock(1).has_value());
+}
+
+TEST(FreeListTests, givenFreeList_whenAllocatingOverCapacity_shouldFail) {
+    FreeList freeList{ defaultSize };
+    EXPECT_FALSE(freeList.allocateBlock(defaultSize + 1).has_value());
+}
+
+TEST(FreeListTests, givenFreeList_whenFreeingBlocks_shouldMergeNeighbours) {
+    FreeList freeList{ defaultSize };
+
+    std::vector<u64> offsets;
+    for (int i = 0; i < 8; ++i) offsets.push_back(*freeList.allocateBlock(128));
+    ASSERT_EQ(freeList.spaceLeft(), 0u);
+
+    // free in an interleaved order so every merge case is exercised
+    for (int i = 0; i < 8; i += 2) freeList.freeBlock(128, offsets[i]);
+    for (int i = 1; i < 8; i += 2) freeList.freeBlock(128, offsets[i]);
+
+    EXPECT_EQ(freeList.spaceLeft(), defaultSize);
+
+    auto offset = freeList.allocateBlock(defaultSize);
+    ASSERT_TRUE(offset.has_value());
+    EXPECT_EQ(*offset, 0u);
+}
+
+TEST(FreeListTests, givenFreeList_whenAllocatingWithAlignment_shouldReturnAligned) {
+    FreeList freeList{ defaultSize };
+
+    ASSERT_TRUE(freeList.allocateBlock(3).has_value());
+
+    auto offset = freeList.allocateBlock(64, 256);
+    ASSERT_TRUE(offset.has_value());
+    EXPECT_EQ(*offset % 256, 0u);
+
+    // padding in front of the aligned block is still usable
+    EXPECT_EQ(freeList.spaceLeft(), defaultSize - 3 - 64);
+    EXPECT_TRUE(freeList.allocateBlock(250).has_value());
+}
+
+TEST(FreeListTests, givenFullFreeList_whenResizing_shouldAllowNewAllocations) {
+    FreeList freeList{ defaultSize };
+
+    ASSERT_TRUE(freeList.allocateBlock(defaultSize).has_value());
+    ASSERT_FALSE(freeList.allocateBlock(1).has_value());
+
+    freeList.resize(defaultSize * 2);
+
+    EXPECT_EQ(freeList.getSize(), defaultSize * 2);
+    EXPECT_EQ(freeList.spaceLeft(), defaultSize);
+
+    auto offset = freeList.allocateBlock(defaultSize);
+    ASSERT_TRUE(offset.has_value());
+    EXPECT_EQ(*offset, defaultSize);
+}
+
+TEST(FreeListTests, givenFreeTail_whenResizing_shouldMergeWithTail) {
+    FreeList freeList{ defaultSize };
+
+    ASSERT_TRUE(freeList.allocateBlock(defaultSize / 2).has_value());
+    freeList.resize(defaultSize * 2);
+
+    auto offset = freeList.allocateBlock(defaultSize + defaultSize / 2);
+    ASSERT_TRUE(offset.has_value());
+    EXPECT_EQ(*offset, defaultSize / 2);
+}
+
+TEST(FreeListTests, givenFreeList_whenClearing_shouldReleaseEverything) {
+    FreeList freeList{ defaultSize };
+
+    for (int i = 0; i < 10; ++i) freeList.allocateBlock(10);
+    freeList.clear();
+
+    EXPECT_EQ(freeList.spaceLeft(), defaultSize);
+    EXPECT_TRUE(freeList.allocateBlock(defaultSize).has_value());
+}
+
+TEST(FreeListTests, givenFragmentedFreeList_whenAllocating_shouldReuseHoles) {
+    FreeList freeList{ defaultSize };
+
+    std::vector<u64> offsets;
+    for (int i = 0; i < 16; ++i) offsets.push_back(*freeList.allocateBlock(64));
+    for (int i = 0; i < 16; i += 2) freeList.freeBlock(64, offsets[i]);
+
+    EXPECT_EQ(freeList.spaceLeft(), defaultSize / 2);
+    for (int i = 0; i < 8; ++i) EXPECT_TRUE(freeList.allocateBlock(64).has_value());
+    EXPECT_FALSE(freeList.allocateBlock(1).has_value());
+}
+
+TEST(FreeListTests, givenHolesBelowLimit_whenAllocatingBelow_shouldTakeLowest) {
+    FreeList freeList{ defaultSize };
+
+    std::vector<u64> offsets;
+    for (int i = 0; i < 16; ++i) offsets.push_back(*freeList.allocateBlock(64));
+    freeList.freeBlock(64, offsets[3]);
+    freeList.freeBlock(64, offsets[9]);
+
+    auto offset = freeList.allocateBlockBelow(32, offsets[15]);
+    ASSERT_TRUE(offset.has_value());
+    EXPECT_EQ(*offset, offsets[3]);
+
+    // the rest of the hole is still the lowest free space
+    EXPECT_EQ(freeList.allocateBlockBelow(32, offsets[15]), offsets[3] + 32u);
+    EXPECT_EQ(freeList.allocateBlockBelow(64, offsets[15]), offsets[9]);
+}
+
+TEST(FreeListTests, givenSpaceOnlyAboveLimit_whenAllocatingBelow_shouldFail) {
+    FreeList freeList{ defaultSize };
+
+    const auto first  = *freeList.allocateBlock(64);
+    const auto second = *freeList.allocateBlock(64);
+    freeList.freeBlock(64, first);
+
+    // free space must end before the limit, not just start there
+    EXPECT_FALSE(freeList.allocateBlockBelow(64, 32u).has_value());
+    EXPECT_FALSE(freeList.allocateBlockBelow(128, second).has_value());
+    EXPECT_EQ(freeList.allocateBlockBelow(64, second), first);
+    EXPECT_EQ(freeList.spaceLeft(), defaultSize - 128u);
+}
@@ -0,0 +1,126 @@
+#include "starlight/core/containers/SparseSet.hh"
+
+#include <gtest/gtest.h>
+
+using namespace sl;
+
+namespace {
+
+struct MoveOnly {
+    explicit MoveOnly(int value) : value(value) {}
+
+    MoveOnly(MoveOnly&&)            = default;
+    MoveOnly& operator=(MoveOnly&&) = delete;
+
+    const int value;
+};
+
+u64 makeKey(u32 index, u32 generation) {
+    return (static_cast<u64>(generation) << 32) | index;
+}
+
+}  // namespace
+
+TEST(SparseSetTests, givenEmptySet_whenCheckingKey_shouldReturnFalse) {
+    SparseSet<int> set;
+
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(set.has(0));
+    EXPECT_EQ(set.find(1337), nullptr);
+}
+
+TEST(SparseSetTests, givenSet_whenEmplacingValue_shouldBeAccessibleByKey) {
+    SparseSet<int> set;
+
+    set.emplace(5, 1337);
+
+    ASSERT_TRUE(set.has(5));
+    EXPECT_EQ(set.get(5), 1337);
+    EXPECT_EQ(set.size(), 1u);
+    EXPECT_FALSE(set.has(4));
+}
+
+TEST(SparseSetTests, givenSet_whenErasingValue_shouldKeepOthersPacked) {
+    SparseSet<MoveOnly> set;
+
+    for (int i = 0; i < 5; ++i) set.emplace(i, i * 10);
+
+    EXPECT_TRUE(set.erase(1));
+    EXPECT_FALSE(set.has(1));
+    EXPECT_FALSE(set.erase(1));
+
+    ASSERT_EQ(set.size(), 4u);
+    for (int i : { 0, 2, 3, 4 }) EXPECT_EQ(set.get(i).value, i * 10);
+
+    int sum = 0;
+    set.forEach([&](MoveOnly& value) { sum += value.value; });
+    EXPECT_EQ(sum, 90);
+}
+
+TEST(SparseSetTests, givenStaleGeneration_whenCheckingKey_shouldReturnFalse) {
+    SparseSet<int> set;
+
+    set.emplace(makeKey(3, 1), 1);
+
+    EXPECT_TRUE(set.has(makeKey(3, 1)));
+    EXPECT_FALSE(set.has(makeKey(3, 0)));
+    EXPECT_FALSE(set.has(makeKey(3, 2)));
+    EXPECT_FALSE(set.erase(makeKey(3, 2)));
+
+    EXPECT_TRUE(set.erase(makeKey(3, 1)));
+    set.emplace(makeKey(3, 2), 2);
+
+    EXPECT_FALSE(set.has(makeKey(3, 1)));
+    EXPECT_EQ(set.get(makeKey(3, 2)), 2);
+}
+
+TEST(SparseSetTests, givenSet_whenIteratingWithKeys_shouldVisitAllEntries) {
+    SparseSet<int> set;
+
+    for (int i = 0; i < 100; ++i) set.emplace(i * 3, i);
+
+    u64 visited = 0;
+    set.forEach([&](const u64& key, int& value) {
+        EXPECT_EQ(key, static_cast<u64>(value * 3));
+        ++visited;
+    });
+    EXPECT_EQ(visited, 100u);
+}
+
+TEST(SparseSetTests, givenErasedValues_whenGrowing_shouldKeepValuesContiguous) {
+    SparseSet<MoveOnly> set;
+
+    for (int i = 0; i < 100; ++i) set.emplace(i, i);
+
+    // the last value is moved into the hole, values can't be assigned
+    for (int i = 0; i < 100; i += 3) EXPECT_TRUE(set.erase(i));
+    for (int i = 100; i < 200; ++i) set.emplace(i, i);
+
+    const auto keys   = set.keys();
+    const auto values = set.values();
+    ASSERT_EQ(values.size(), set.size());
+    ASSERT_EQ(keys.size(), set.size());
+
+    for (u64 i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(&set.get(keys[i]), &values[i]);
+        EXPECT_EQ(values[i].value, static_cast<int>(keys[i]));
+    }
+}
+
+TEST(SparseSetTests, givenErasedValue_whenEmplacing_shouldAppendIt) {
+    SparseSet<int> set;
+
+    set.emplace(0, 1);
+    set.emplace(1, 2);
+    set.emplace(2, 3);
+
+    set.erase(1);
+    set.emplace(7, 4);
+
+    EXPECT_EQ(set.values().back(), 4);
+    EXPECT_EQ(set.findDenseIndex(2), 1u);
+
+    int sum = 0;
+    for (const auto value : set.values()) sum += value;
+    EXPECT_EQ(sum, 8);
+}
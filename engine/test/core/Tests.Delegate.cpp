@@ -0,0 +1,80 @@
+#include "starlight/core/Delegate.hh"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+
+using namespace sl;
+
+TEST(DelegateTests, givenEmptyDelegate_shouldBeFalse) {
+    Delegate<void()> delegate;
+    EXPECT_FALSE(delegate);
+}
+
+TEST(DelegateTests, givenSmallCallable_whenCalling_shouldForwardArgumentsAndResult) {
+    int offset = 10;
+    Delegate<int(int, int&)> delegate = [&offset](int value, int& out) -> int {
+        out = value + offset;
+        return out * 2;
+    };
+
+    int out = 0;
+    EXPECT_TRUE(delegate);
+    EXPECT_EQ(delegate(5, out), 30);
+    EXPECT_EQ(out, 15);
+}
+
+TEST(DelegateTests, givenBigCallable_whenCalling_shouldWork) {
+    std::array<u64, 32> values{};
+    values.back() = 1337u;
+
+    Delegate<u64()> delegate = [values]() -> u64 { return values.back(); };
+    EXPECT_EQ(delegate(), 1337u);
+}
+
+TEST(DelegateTests, givenMutableCallable_whenCalling_shouldKeepState) {
+    Delegate<int()> delegate = [counter = 0]() mutable -> int { return ++counter; };
+
+    EXPECT_EQ(delegate(), 1);
+    EXPECT_EQ(delegate(), 2);
+}
+
+TEST(DelegateTests, givenDelegate_whenMoving_shouldTransferCallable) {
+    auto value = std::make_shared<int>(42);
+
+    Delegate<int()> delegate = [value]() -> int { return *value; };
+    EXPECT_EQ(value.use_count(), 2);
+
+    Delegate<int()> moved = std::move(delegate);
+    EXPECT_FALSE(delegate);
+    EXPECT_EQ(moved(), 42);
+    EXPECT_EQ(value.use_count(), 2);
+
+    std::array<u64, 32> padding{};
+    Delegate<int()> big = [value, padding]() -> int {
+        return *value + static_cast<int>(padding.size());
+    };
+    EXPECT_EQ(value.use_count(), 3);
+
+    moved = std::move(big);
+    EXPECT_EQ(value.use_count(), 2);
+    EXPECT_EQ(moved(), 42 + 32);
+}
+
+TEST(DelegateTests, givenDelegate_whenDestroying_shouldDestroyCallable) {
+    auto value = std::make_shared<int>(42);
+
+    {
+        Delegate<int()> small = [value]() -> int { return *value; };
+        std::array<u64, 32> padding{};
+        Delegate<int()> big = [value, padding]() -> int { return *value; };
+        EXPECT_EQ(value.use_count(), 3);
+    }
+    EXPECT_EQ(value.use_count(), 1);
+
+    Delegate<int()> delegate = [value]() -> int { return *value; };
+    delegate.reset();
+    EXPECT_FALSE(delegate);
+    EXPECT_EQ(value.use_count(), 1);
+}
@@ -0,0 +1,121 @@
+#include "starlight/core/Id.hh"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace sl;
+
+namespace {
+
+template <u64 Tag> struct Object : Identificable<Object<Tag>> {};
+
+struct SmallObject : Identificable<SmallObject, u32> {};
+
+}  // namespace
+
+TEST(IdRecyclerTests, givenObjects_whenCreating_shouldGiveConsecutiveIndices) {
+    using Tester   = Object<0>;
+    using Recycler = IdRecycler<Tester, u64>;
+
+    Tester a, b, c;
+
+    EXPECT_EQ(Recycler::getIndex(b.id), Recycler::getIndex(a.id) + 1u);
+    EXPECT_EQ(Recycler::getIndex(c.id), Recycler::getIndex(b.id) + 1u);
+}
+
+TEST(IdRecyclerTests, givenReleasedId_whenReused_shouldBumpGeneration) {
+    using Tester   = Object<1>;
+    using Recycler = IdRecycler<Tester, u64>;
+
+    u64 oldId;
+    {
+        Tester object;
+        oldId = object.id;
+        EXPECT_TRUE(Tester::isAlive(oldId));
+    }
+    EXPECT_FALSE(Tester::isAlive(oldId));
+
+    Tester object;
+    EXPECT_EQ(Recycler::getIndex(object.id), Recycler::getIndex(oldId));
+    EXPECT_EQ(Recycler::getGeneration(object.id), Recycler::getGeneration(oldId) + 1u);
+
+    EXPECT_TRUE(Tester::isAlive(object.id));
+    EXPECT_FALSE(Tester::isAlive(oldId));
+}
+
+TEST(IdRecyclerTests, givenMovedObject_shouldKeepIdAlive) {
+    using Tester = Object<2>;
+
+    Tester object;
+    const auto id = object.id;
+
+    Tester moved{ std::move(object) };
+    EXPECT_EQ(moved.id, id);
+    EXPECT_TRUE(Tester::isAlive(id));
+}
+
+TEST(IdRecyclerTests, givenNarrowIdType_shouldSplitIndexAndGeneration) {
+    using Recycler = IdRecycler<SmallObject, u32>;
+
+    EXPECT_EQ(Recycler::indexBits, 24u);
+    EXPECT_EQ(Recycler::generationBits, 8u);
+
+    u32 oldId;
+    {
+        SmallObject object;
+        oldId = object.id;
+    }
+    SmallObject object;
+    EXPECT_EQ(Recycler::getIndex(object.id), Recycler::getIndex(oldId));
+    EXPECT_NE(object.id, oldId);
+}
+
+TEST(IdRecyclerTests, givenManyObjects_whenCreatingBeyondFirstSegment_shouldBeUnique) {
+    using Tester = Object<3>;
+
+    std::vector<Tester> objects(5000);
+
+    std::set<u64> ids;
+    for (const auto& object : objects) ids.insert(object.id);
+    EXPECT_EQ(ids.size(), objects.size());
+}
+
+TEST(IdRecyclerTests, givenManyThreads_whenCreatingAndDestroying_shouldKeepLiveIdsUnique) {
+    using Tester = Object<4>;
+
+    constexpr u64 threadCount = 4;
+    constexpr u64 iterations  = 200;
+    constexpr u64 batch       = 100;
+
+    std::mutex mutex;
+    std::vector<u64> survivors;
+
+    std::vector<std::thread> threads;
+    for (u64 t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&]() {
+            std::vector<Tester> keep;
+
+            for (u64 i = 0; i < iterations; ++i) {
+                std::vector<Tester> objects(batch);
+                // keep a few alive, so ids released by other threads get mixed in
+                keep.emplace_back(std::move(objects.back()));
+            }
+
+            std::scoped_lock guard{ mutex };
+            for (const auto& object : keep) {
+                EXPECT_TRUE(Tester::isAlive(object.id));
+                survivors.push_back(object.id);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    std::ranges::sort(survivors);
+    EXPECT_EQ(std::ranges::adjacent_find(survivors), survivors.end());
+    EXPECT_EQ(survivors.size(), threadCount * iterations);
+}
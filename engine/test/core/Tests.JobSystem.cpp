@@ -0,0 +1,136 @@
+#include "starlight/core/JobSystem.hh"
+#include "starlight/core/TaskQueue.hh"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace sl;
+
+constexpr u64 workerCount = 4;
+
+TEST(JobSystemTests, givenJob_whenWaiting_shouldBeExecuted) {
+    JobSystem jobSystem{ workerCount };
+
+    std::atomic<int> value = 0;
+    auto job               = jobSystem.spawn([&]() { value = 42; });
+
+    jobSystem.wait(job);
+    EXPECT_TRUE(job.isFinished());
+    EXPECT_EQ(value.load(), 42);
+}
+
+TEST(JobSystemTests, givenEmptyHandle_whenWaiting_shouldReturnImmediately) {
+    JobSystem jobSystem{ workerCount };
+    JobHandle handle;
+
+    EXPECT_TRUE(handle.isFinished());
+    jobSystem.wait(handle);
+}
+
+TEST(JobSystemTests, givenManyJobs_whenWaiting_shouldExecuteAllOfThem) {
+    JobSystem jobSystem{ workerCount };
+
+    constexpr u64 jobCount = 10'000;
+    std::atomic<u64> counter = 0u;
+
+    std::vector<JobHandle> jobs;
+    for (u64 i = 0; i < jobCount; ++i) jobs.push_back(jobSystem.spawn([&]() { ++counter; }));
+
+    jobSystem.wait(jobs);
+    EXPECT_EQ(counter.load(), jobCount);
+}
+
+TEST(JobSystemTests, givenDependencies_whenExecuting_shouldRespectOrder) {
+    JobSystem jobSystem{ workerCount };
+
+    std::mutex mutex;
+    std::vector<int> order;
+    auto record = [&](int value) {
+        return [&, value]() {
+            std::scoped_lock guard{ mutex };
+            order.push_back(value);
+        };
+    };
+
+    auto first  = jobSystem.spawn(record(1));
+    auto second = jobSystem.spawn(record(2), { first });
+    auto third  = jobSystem.then(second, record(3));
+    auto fourth = jobSystem.spawn(record(4), { first, third });
+
+    jobSystem.wait(fourth);
+    EXPECT_EQ(order, (std::vector<int>{ 1, 2, 3, 4 }));
+}
+
+TEST(JobSystemTests, givenFinishedDependency_whenSpawning_shouldScheduleImmediately) {
+    JobSystem jobSystem{ workerCount };
+
+    auto first = jobSystem.spawn([]() {});
+    jobSystem.wait(first);
+
+    std::atomic<bool> executed = false;
+    jobSystem.wait(jobSystem.then(first, [&]() { executed = true; }));
+    EXPECT_TRUE(executed.load());
+}
+
+TEST(JobSystemTests, givenNestedJobs_whenWaitingInsideJob_shouldNotDeadlock) {
+    JobSystem jobSystem{ 1u };
+
+    std::atomic<u64> counter = 0u;
+
+    auto outer = jobSystem.spawn([&]() {
+        std::vector<JobHandle> inner;
+        for (int i = 0; i < 100; ++i) inner.push_back(jobSystem.spawn([&]() { ++counter; }));
+        jobSystem.wait(inner);
+        ++counter;
+    });
+
+    jobSystem.wait(outer);
+    EXPECT_EQ(counter.load(), 101u);
+}
+
+TEST(JobSystemTests, givenRange_whenParallelFor_shouldVisitEachIndexOnce) {
+    JobSystem jobSystem{ workerCount };
+
+    constexpr u64 size = 100'003;
+    std::vector<int> visits(size, 0);
+
+    jobSystem.parallelFor(0u, size, 1000u, [&](u64 begin, u64 end) {
+        for (u64 i = begin; i < end; ++i) ++visits[i];
+    });
+
+    EXPECT_TRUE(std::ranges::all_of(visits, [](int value) { return value == 1; }));
+}
+
+TEST(JobSystemTests, givenNoWorkers_whenSpawning_shouldExecuteInline) {
+    JobSystem jobSystem{ 0u };
+
+    const auto caller = std::this_thread::get_id();
+    std::thread::id executor;
+
+    auto job = jobSystem.spawn([&]() { executor = std::this_thread::get_id(); });
+
+    EXPECT_TRUE(job.isFinished());
+    EXPECT_EQ(executor, caller);
+}
+
+TEST(TaskQueueTests, givenCallbackPushedFromJob_whenDispatching_shouldRunOnMainThread) {
+    TaskQueue taskQueue{ workerCount };
+
+    const auto mainThread = std::this_thread::get_id();
+    std::thread::id executor;
+
+    auto job = taskQueue.spawn([&]() {
+        taskQueue.callPostFrame([&]() { executor = std::this_thread::get_id(); });
+    });
+    taskQueue.wait(job);
+
+    taskQueue.dispatchQueue(TaskQueue::Type::preFrame);
+    EXPECT_EQ(executor, std::thread::id{});
+
+    taskQueue.dispatchQueue(TaskQueue::Type::postFrame);
+    EXPECT_EQ(executor, mainThread);
+}
@@ -0,0 +1,252 @@
+#include <gtest/gtest.h>
+
+#include "starlight/core/math/BoundingVolumeHierarchy.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace sl;
+
+namespace {
+
+std::vector<Aabb> makeBoxes(u64 count, u32 seed) {
+    std::mt19937 generator{ seed };
+    std::uniform_real_distribution<f32> position{ -100.0f, 100.0f };
+    std::uniform_real_distribution<f32> size{ 0.1f, 3.0f };
+
+    std::vector<Aabb> boxes(count);
+    for (auto& box : boxes) {
+        for (u32 axis = 0; axis < 3u; ++axis) {
+            box.min[axis] = position(generator);
+            box.max[axis] = box.min[axis] + size(generator);
+        }
+    }
+    return boxes;
+}
+
+bool overlaps(const Aabb& lhs, const Aabb& rhs) {
+    for (u32 axis = 0; axis < 3u; ++axis) {
+        if (lhs.max[axis] < rhs.min[axis] || rhs.max[axis] < lhs.min[axis])
+            return false;
+    }
+    return true;
+}
+
+// inward facing planes of an axis aligned region, a frustum in the query's eyes
+FrustumPlanes regionPlanes(const Aabb& region) {
+    return FrustumPlanes{
+        Plane{ 1.0f, 0.0f, 0.0f, -region.min[0] },
+        Plane{ -1.0f, 0.0f, 0.0f, region.max[0] },
+        Plane{ 0.0f, 1.0f, 0.0f, -region.min[1] },
+        Plane{ 0.0f, -1.0f, 0.0f, region.max[1] },
+        Plane{ 0.0f, 0.0f, 1.0f, -region.min[2] },
+        Plane{ 0.0f, 0.0f, -1.0f, region.max[2] },
+    };
+}
+
+template <typename Query> std::vector<u32> collect(Query&& query) {
+    std::vector<u32> result;
+    query([&](u32 primitive) { result.push_back(primitive); });
+    std::ranges::sort(result);
+    return result;
+}
+
+const Aabb region{
+    .min = { -20.0f, -50.0f, 0.0f },
+    .max = { 30.0f, 10.0f, 40.0f },
+};
+
+}  // namespace
+
+class BoundingVolumeHierarchyTests : public testing::Test {
+protected:
+    std::vector<u32> bruteForce(const std::vector<Aabb>& boxes, const Aabb& query) {
+        std::vector<u32> result;
+        for (u32 i = 0; i < boxes.size(); ++i)
+            if (overlaps(boxes[i], query)) result.push_back(i);
+        return result;
+    }
+
+    void expectQueriesMatch(const std::vector<Aabb>& boxes) {
+        const auto expected = bruteForce(boxes, region);
+        ASSERT_FALSE(expected.empty());
+
+        EXPECT_EQ(
+          collect([&](auto&& callback) { bvh.queryBox(region, callback); }), expected
+        );
+        EXPECT_EQ(
+          collect([&](auto&& callback) {
+              bvh.queryFrustum(regionPlanes(region), callback);
+          }),
+          expected
+        );
+    }
+
+    BoundingVolumeHierarchy bvh;
+};
+
+TEST_F(
+  BoundingVolumeHierarchyTests, givenEmptyInput_whenQuerying_shouldFindNothing
+) {
+    bvh.build({});
+
+    EXPECT_EQ(bvh.getNodeCount(), 0u);
+    EXPECT_TRUE(collect([&](auto&& callback) { bvh.queryBox(region, callback); })
+                  .empty());
+    EXPECT_FALSE(bvh.castRay(Ray{ {}, { 1.0f, 0.0f, 0.0f }, 100.0f }).has_value());
+}
+
+TEST_F(BoundingVolumeHierarchyTests, givenBoxes_whenQuerying_shouldMatchBruteForce) {
+    const auto boxes = makeBoxes(5'000, 1u);
+    bvh.build(boxes);
+
+    EXPECT_EQ(bvh.getPrimitiveCount(), boxes.size());
+    expectQueriesMatch(boxes);
+}
+
+TEST_F(
+  BoundingVolumeHierarchyTests, givenMovedBoxes_whenRefitting_shouldStayCorrect
+) {
+    auto boxes = makeBoxes(5'000, 2u);
+    bvh.build(boxes);
+
+    std::mt19937 generator{ 3u };
+    std::uniform_real_distribution<f32> offset{ -15.0f, 15.0f };
+    for (auto& box : boxes) {
+        for (u32 axis = 0; axis < 3u; ++axis) {
+            const auto delta = offset(generator);
+            box.min[axis] += delta;
+            box.max[axis] += delta;
+        }
+    }
+
+    bvh.refit(boxes);
+    expectQueriesMatch(boxes);
+}
+
+TEST_F(BoundingVolumeHierarchyTests, givenSmallMotion_whenRefitting_shouldKeepTree) {
+    auto boxes = makeBoxes(2'000, 4u);
+    bvh.build(boxes);
+
+    for (u32 frame = 0; frame < 10u; ++frame) {
+        for (u32 i = 0; i < boxes.size(); ++i) {
+            const auto delta = (i % 2u == 0u) ? 0.05f : -0.05f;
+            boxes[i].min[(i + frame) % 3u] += delta;
+            boxes[i].max[(i + frame) % 3u] += delta;
+        }
+        bvh.refit(boxes);
+    }
+
+    EXPECT_FALSE(bvh.needsRebuild());
+    expectQueriesMatch(boxes);
+}
+
+TEST_F(
+  BoundingVolumeHierarchyTests, givenScatteredBoxes_whenRefitting_shouldAskForRebuild
+) {
+    auto boxes = makeBoxes(2'000, 4u);
+    bvh.build(boxes);
+
+    // every box swaps places with a random one, the old hierarchy is meaningless
+    std::mt19937 generator{ 5u };
+    std::ranges::shuffle(boxes, generator);
+    bvh.refit(boxes);
+
+    EXPECT_TRUE(bvh.needsRebuild());
+    expectQueriesMatch(boxes);
+
+    bvh.build(boxes);
+    EXPECT_FALSE(bvh.needsRebuild());
+}
+
+TEST_F(
+  BoundingVolumeHierarchyTests, givenSkewedBoxes_whenRefitting_shouldStayShallow
+) {
+    // exponentially spaced boxes make every binned split cut off a single box
+    auto boxes = makeBoxes(2'000, 7u);
+    for (u32 i = 0; i < 200u; ++i) {
+        const auto x = std::pow(1.4f, static_cast<f32>(i));
+        boxes[i]     = Aabb{ .min = { x, 0.0f, 0.0f }, .max = { x, 1.0f, 1.0f } };
+    }
+    bvh.build(boxes);
+    EXPECT_LT(bvh.getHeight(), BoundingVolumeHierarchy::maxDepth);
+
+    std::mt19937 generator{ 8u };
+    for (u32 frame = 0; frame < 40u; ++frame) {
+        std::ranges::shuffle(boxes, generator);
+        bvh.refit(boxes);
+        ASSERT_LT(bvh.getHeight(), BoundingVolumeHierarchy::maxDepth);
+    }
+    expectQueriesMatch(boxes);
+}
+
+TEST_F(
+  BoundingVolumeHierarchyTests, givenSphere_whenQuerying_shouldFindTouchedBoxes
+) {
+    const auto boxes = makeBoxes(3'000, 5u);
+    bvh.build(boxes);
+
+    const f32 center[3] = { 10.0f, -5.0f, 20.0f };
+    const auto radius   = 25.0f;
+
+    std::vector<u32> expected;
+    for (u32 i = 0; i < boxes.size(); ++i) {
+        auto distance = 0.0f;
+        for (u32 axis = 0; axis < 3u; ++axis) {
+            const auto delta = std::max(
+              { boxes[i].min[axis] - center[axis], 0.0f,
+                center[axis] - boxes[i].max[axis] }
+            );
+            distance += delta * delta;
+        }
+        if (distance <= radius * radius) expected.push_back(i);
+    }
+
+    ASSERT_FALSE(expected.empty());
+    EXPECT_EQ(
+      collect([&](auto&& callback) { bvh.querySphere(center, radius, callback); }),
+      expected
+    );
+}
+
+TEST_F(BoundingVolumeHierarchyTests, givenRay_whenCasting_shouldReturnClosestBox) {
+    auto boxes = makeBoxes(3'000, 6u);
+    // a wall of boxes on the ray, the closest one has to win
+    for (u32 i = 0; i < 5u; ++i) {
+        const auto x = 50.0f - i * 10.0f;
+        boxes[i]     = Aabb{
+                .min = { x, -1.0f, -1.0f },
+                .max = { x + 1.0f, 1.0f, 1.0f },
+        };
+    }
+    bvh.build(boxes);
+
+    const Ray ray{
+        .origin      = { -200.0f, 0.0f, 0.0f },
+        .direction   = { 1.0f, 0.0f, 0.0f },
+        .maxDistance = 1000.0f,
+    };
+
+    // brute force over every box the ray passes through
+    std::optional<RayHit> expected;
+    for (u32 i = 0; i < boxes.size(); ++i) {
+        const auto& box = boxes[i];
+        if (box.min[1] > 0.0f || box.max[1] < 0.0f) continue;
+        if (box.min[2] > 0.0f || box.max[2] < 0.0f) continue;
+
+        const auto distance = box.min[0] - ray.origin[0];
+        if (not expected || distance < expected->distance)
+            expected = RayHit{ .primitive = i, .distance = distance };
+    }
+
+    const auto hit = bvh.castRay(ray);
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit->primitive, expected->primitive);
+    EXPECT_FLOAT_EQ(hit->distance, expected->distance);
+
+    auto shortRay        = ray;
+    shortRay.maxDistance = expected->distance - 1.0f;
+    EXPECT_FALSE(bvh.castRay(shortRay).has_value());
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+
+#include "starlight/core/math/Culling.hh"
+
+#include "mock/RawMatrix.hh"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace sl;
+
+namespace {
+
+RawMatrix translation(f32 x, f32 y, f32 z) {
+    RawMatrix m{};
+    m[0] = m[5] = m[10] = m[15] = 1.0f;
+    m[12]                       = x;
+    m[13]                       = y;
+    m[14]                       = z;
+    return m;
+}
+
+// rotation around the y axis combined with a non uniform scale
+RawMatrix rotationScale(f32 angle, f32 sx, f32 sy, f32 sz) {
+    RawMatrix m{};
+    m[0]  = std::cos(angle) * sx;
+    m[2]  = -std::sin(angle) * sx;
+    m[5]  = sy;
+    m[8]  = std::sin(angle) * sz;
+    m[10] = std::cos(angle) * sz;
+    m[15] = 1.0f;
+    return m;
+}
+
+struct Boxes {
+    explicit Boxes(u64 count) :
+        centerX(count), centerY(count), centerZ(count), extentX(count), extentY(count),
+        extentZ(count) {}
+
+    BoxesView getView() const {
+        return BoxesView{
+            centerX.data(), centerY.data(), centerZ.data(), extentX.data(),
+            extentY.data(), extentZ.data(), centerX.size(),
+        };
+    }
+
+    void set(u64 i, f32 x, f32 y, f32 z, f32 extent) {
+        centerX[i] = x;
+        centerY[i] = y;
+        centerZ[i] = z;
+        extentX[i] = extentY[i] = extentZ[i] = extent;
+    }
+
+    std::vector<f32> centerX, centerY, centerZ;
+    std::vector<f32> extentX, extentY, extentZ;
+};
+
+const auto camera = perspective(1.0f, 16.0f / 9.0f, 0.1f, 100.0f);
+
+}  // namespace
+
+TEST(CullingTests, givenPerspective_whenExtractingPlanes_shouldBoundVisibleVolume) {
+    const auto planes = extractFrustumPlanes(camera.data());
+
+    Boxes boxes{ 6 };
+    boxes.set(0, 0.0f, 0.0f, -10.0f, 0.5f);    // in front
+    boxes.set(1, 0.0f, 0.0f, 10.0f, 0.5f);     // behind
+    boxes.set(2, 0.0f, 0.0f, -200.0f, 0.5f);   // past the far plane
+    boxes.set(3, 100.0f, 0.0f, -10.0f, 0.5f);  // far to the right
+    boxes.set(4, 0.0f, -100.0f, -10.0f, 0.5f); // far below
+    boxes.set(5, 0.0f, 0.0f, -0.5f, 1.0f);     // crossing the near plane
+
+    std::array<u8, 6> visible;
+    cullBoxes(planes, boxes.getView(), visible.data());
+
+    EXPECT_EQ(visible, (std::array<u8, 6>{ 1, 0, 0, 0, 0, 1 }));
+}
+
+TEST(CullingTests, givenTransformedBox_shouldContainAllTransformedCorners) {
+    const std::array<f32, 3> min{ -1.0f, -2.0f, -0.5f };
+    const std::array<f32, 3> max{ 3.0f, 1.0f, 0.5f };
+
+    auto matrix = rotationScale(0.7f, 2.0f, 0.5f, 3.0f);
+    matrix[12]  = 5.0f;
+    matrix[13]  = -1.0f;
+    matrix[14]  = 2.0f;
+
+    std::array<f32, 3> center, extent;
+    transformBox(matrix.data(), min.data(), max.data(), center.data(), extent.data());
+
+    for (u64 corner = 0; corner < 8; ++corner) {
+        const std::array<f32, 3> local{
+            (corner & 1) ? max[0] : min[0],
+            (corner & 2) ? max[1] : min[1],
+            (corner & 4) ? max[2] : min[2],
+        };
+        for (u64 row = 0; row < 3; ++row) {
+            auto value = matrix[12 + row];
+            for (u64 column = 0; column < 3; ++column)
+                value += matrix[column * 4 + row] * local[column];
+
+            EXPECT_LE(std::abs(value - center[row]), extent[row] + 1e-4f);
+        }
+    }
+}
+
+TEST(CullingTests, givenTranslation_whenTransformingBox_shouldMoveCenter) {
+    const std::array<f32, 3> min{ -1.0f, -1.0f, -1.0f };
+    const std::array<f32, 3> max{ 1.0f, 3.0f, 1.0f };
+    const auto matrix = translation(1.0f, 2.0f, 3.0f);
+
+    std::array<f32, 3> center, extent;
+    transformBox(matrix.data(), min.data(), max.data(), center.data(), extent.data());
+
+    EXPECT_EQ(center, (std::array<f32, 3>{ 1.0f, 3.0f, 3.0f }));
+    EXPECT_EQ(extent, (std::array<f32, 3>{ 1.0f, 2.0f, 1.0f }));
+}
+
+TEST(CullingTests, givenRandomBoxes_whenCulling_shouldMatchScalarReference) {
+    // odd count, so the non batched tail is covered as well
+    constexpr u64 count = 10'007;
+
+    std::mt19937 generator{ 1337u };
+    std::uniform_real_distribution<f32> positions{ -150.0f, 150.0f };
+    std::uniform_real_distribution<f32> extents{ 0.01f, 10.0f };
+
+    Boxes boxes{ count };
+    for (u64 i = 0; i < count; ++i) {
+        boxes.centerX[i] = positions(generator);
+        boxes.centerY[i] = positions(generator);
+        boxes.centerZ[i] = positions(generator);
+        boxes.extentX[i] = extents(generator);
+        boxes.extentY[i] = extents(generator);
+        boxes.extentZ[i] = extents(generator);
+    }
+
+    // rotate the camera a bit so the planes are not axis aligned
+    const auto rotation = rotationScale(0.3f, 1.0f, 1.0f, 1.0f);
+
+    RawMatrix viewProjection{};
+    for (u64 c = 0; c < 4; ++c)
+        for (u64 r = 0; r < 4; ++r)
+            for (u64 k = 0; k < 4; ++k)
+                viewProjection[c * 4 + r] += camera[k * 4 + r] * rotation[c * 4 + k];
+
+    const auto planes = extractFrustumPlanes(viewProjection.data());
+
+    std::vector<u8> visible(count), expected(count);
+    cullBoxes(planes, boxes.getView(), visible.data());
+    cullBoxesScalar(planes, boxes.getView(), expected.data());
+
+    EXPECT_EQ(visible, expected);
+
+    // sanity check that the scene is not trivially all in or all out
+    const auto visibleCount = std::ranges::count(visible, 1u);
+    EXPECT_GT(visibleCount, 0);
+    EXPECT_LT(visibleCount, static_cast<i64>(count));
+}
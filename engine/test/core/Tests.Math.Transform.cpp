@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+
+#include "starlight/core/math/Transform.hh"
+
+using namespace sl;
+
+namespace {
+
+void expectMatrixNear(const Mat4<f32>& actual, const Mat4<f32>& expected) {
+    for (int column = 0; column < 4; ++column)
+        for (int row = 0; row < 4; ++row)
+            EXPECT_NEAR(actual[column][row], expected[column][row], 1e-5f);
+}
+
+const Vec3<f32> axis = glm::normalize(Vec3<f32>{ 1.0f, 2.0f, 3.0f });
+
+}  // namespace
+
+TEST(TransformTests, givenTRS_whenGettingModel_shouldMatchMatrixComposition) {
+    const Vec3<f32> position{ 1.0f, -2.0f, 3.0f };
+    const Vec3<f32> scale{ 2.0f, 0.5f, 4.0f };
+    const auto rotation = glm::angleAxis(0.7f, axis);
+
+    const Transform transform{ position, scale, rotation };
+
+    const auto expected = glm::translate(identityMatrix, position)
+                          * glm::mat4_cast(rotation)
+                          * glm::scale(identityMatrix, scale);
+    expectMatrixNear(transform.getModel(), expected);
+}
+
+TEST(TransformTests, givenMatrixRotation_whenRoundTripping_shouldKeepRotation) {
+    const auto rotation = glm::rotate(identityMatrix, 1.2f, axis);
+
+    expectMatrixNear(Transform::fromRotation(rotation).getRotation(), rotation);
+    expectMatrixNear(Transform::fromRotation(axis, 1.2f).getRotation(), rotation);
+}
+
+TEST(TransformTests, givenAxisRotations_whenRotating_shouldComposeLikeMatrices) {
+    Transform transform;
+    transform.rotate(axis, 0.3f).rotate(worldUp, 1.1f);
+
+    const auto expected =
+      glm::rotate(glm::rotate(identityMatrix, 0.3f, axis), 1.1f, worldUp);
+    expectMatrixNear(transform.getRotation(), expected);
+}
+
+TEST(TransformTests, givenParent_whenGettingWorld_shouldApplyParentModel) {
+    Transform parent{ Vec3<f32>{ 0.0f, 5.0f, 0.0f } };
+    parent.rotate(worldUp, pi / 2.0f);
+
+    Transform child{ Vec3<f32>{ 1.0f, 0.0f, 0.0f } };
+    child.setParent(&parent);
+
+    const auto origin = child.getWorld() * Vec3<f32>{ 0.0f };
+    EXPECT_NEAR(origin.x, 0.0f, 1e-5f);
+    EXPECT_NEAR(origin.y, 5.0f, 1e-5f);
+    EXPECT_NEAR(origin.z, -1.0f, 1e-5f);
+}
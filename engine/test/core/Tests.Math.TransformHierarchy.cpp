@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include "starlight/core/math/TransformHierarchy.hh"
+
+#include <cmath>
+
+using namespace sl;
+
+namespace {
+
+void expectTranslation(const f32* world, f32 x, f32 y, f32 z) {
+    EXPECT_NEAR(world[12], x, 1e-5f);
+    EXPECT_NEAR(world[13], y, 1e-5f);
+    EXPECT_NEAR(world[14], z, 1e-5f);
+    EXPECT_FLOAT_EQ(world[15], 1.0f);
+}
+
+// 90 degrees around Y
+constexpr f32 halfSqrt2 = 0.70710678f;
+
+}  // namespace
+
+TEST(TransformHierarchyTests, givenRootNode_whenUpdating_shouldComposeTRS) {
+    TransformHierarchy hierarchy;
+    const auto node = hierarchy.create();
+
+    hierarchy.setPosition(node, 1.0f, 2.0f, 3.0f);
+    hierarchy.setRotation(node, 0.0f, halfSqrt2, 0.0f, halfSqrt2);
+    hierarchy.setScale(node, 2.0f, 2.0f, 2.0f);
+
+    EXPECT_EQ(hierarchy.update(), 1u);
+
+    const auto world = hierarchy.getWorld(node);
+    // local X axis turns into -Z, scaled by 2
+    EXPECT_NEAR(world[0], 0.0f, 1e-5f);
+    EXPECT_NEAR(world[2], -2.0f, 1e-5f);
+    expectTranslation(world, 1.0f, 2.0f, 3.0f);
+}
+
+TEST(TransformHierarchyTests, givenChain_whenUpdating_shouldApplyParentTransforms) {
+    TransformHierarchy hierarchy;
+    const auto root  = hierarchy.create();
+    const auto child = hierarchy.create(root);
+    const auto leaf  = hierarchy.create(child);
+
+    hierarchy.setRotation(root, 0.0f, halfSqrt2, 0.0f, halfSqrt2);
+    hierarchy.setScale(root, 2.0f, 2.0f, 2.0f);
+    hierarchy.setPosition(child, 1.0f, 0.0f, 0.0f);
+    hierarchy.setPosition(leaf, 0.0f, 1.0f, 0.0f);
+
+    EXPECT_EQ(hierarchy.update(), 3u);
+
+    expectTranslation(hierarchy.getWorld(child), 0.0f, 0.0f, -2.0f);
+    expectTranslation(hierarchy.getWorld(leaf), 0.0f, 2.0f, -2.0f);
+}
+
+TEST(TransformHierarchyTests, givenDirtyNode_whenUpdating_shouldOnlyRecomputeSubtree) {
+    TransformHierarchy hierarchy;
+    const auto root   = hierarchy.create();
+    const auto left   = hierarchy.create(root);
+    const auto right  = hierarchy.create(root);
+    const auto nested = hierarchy.create(left);
+
+    hierarchy.update();
+    EXPECT_EQ(hierarchy.update(), 0u);
+
+    hierarchy.setPosition(left, 5.0f, 0.0f, 0.0f);
+    EXPECT_EQ(hierarchy.update(), 2u);
+
+    expectTranslation(hierarchy.getWorld(nested), 5.0f, 0.0f, 0.0f);
+    expectTranslation(hierarchy.getWorld(right), 0.0f, 0.0f, 0.0f);
+}
+
+TEST(TransformHierarchyTests, givenReparentedNode_whenUpdating_shouldFollowNewParent) {
+    TransformHierarchy hierarchy;
+    // child created before its future parent, forcing a reorder
+    const auto child  = hierarchy.create();
+    const auto first  = hierarchy.create();
+    const auto second = hierarchy.create(first);
+
+    hierarchy.setPosition(first, 1.0f, 0.0f, 0.0f);
+    hierarchy.setPosition(second, 0.0f, 1.0f, 0.0f);
+    hierarchy.setPosition(child, 0.0f, 0.0f, 1.0f);
+    hierarchy.setParent(child, second);
+
+    hierarchy.update();
+
+    EXPECT_EQ(hierarchy.getParent(child), second);
+    expectTranslation(hierarchy.getWorld(child), 1.0f, 1.0f, 1.0f);
+
+    hierarchy.setParent(child, TransformHierarchy::invalidHandle);
+    hierarchy.update();
+
+    EXPECT_EQ(hierarchy.getParent(child), TransformHierarchy::invalidHandle);
+    expectTranslation(hierarchy.getWorld(child), 0.0f, 0.0f, 1.0f);
+}
+
+TEST(TransformHierarchyTests, givenDestroyedNodes_whenUpdating_shouldKeepHandlesValid) {
+    TransformHierarchy hierarchy;
+    const auto root  = hierarchy.create();
+    const auto a     = hierarchy.create(root);
+    const auto b     = hierarchy.create(root);
+    const auto bLeaf = hierarchy.create(b);
+
+    hierarchy.setPosition(root, 1.0f, 0.0f, 0.0f);
+    hierarchy.setPosition(bLeaf, 0.0f, 0.0f, 3.0f);
+
+    hierarchy.destroy(a);
+    EXPECT_EQ(hierarchy.size(), 3u);
+
+    hierarchy.update();
+    expectTranslation(hierarchy.getWorld(bLeaf), 1.0f, 0.0f, 3.0f);
+
+    // freed handle gets recycled
+    const auto reused = hierarchy.create(bLeaf);
+    EXPECT_EQ(reused, a);
+    hierarchy.update();
+    expectTranslation(hierarchy.getWorld(reused), 1.0f, 0.0f, 3.0f);
+}
+
+TEST(TransformHierarchyTests, givenCycle_whenSettingParent_shouldAbort) {
+    TransformHierarchy hierarchy;
+    const auto root  = hierarchy.create();
+    const auto child = hierarchy.create(root);
+
+    EXPECT_DEATH(hierarchy.setParent(root, child), "");
+}
+
+TEST(TransformHierarchyTests, givenNodeWithChildren_whenDestroying_shouldAbort) {
+    TransformHierarchy hierarchy;
+    const auto root = hierarchy.create();
+    hierarchy.create(root);
+
+    EXPECT_DEATH(hierarchy.destroy(root), "");
+}
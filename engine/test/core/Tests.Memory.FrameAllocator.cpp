@@ -0,0 +1,136 @@
+#include "starlight/core/memory/FrameAllocator.hh"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace sl;
+
+// counts every heap allocation done by this test binary, replaced operators are
+// matched so the warning about free on new-ed memory doesn't apply
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+static std::atomic<u64> s_heapAllocations = 0u;
+
+void* operator new(std::size_t size) {
+    ++s_heapAllocations;
+    if (auto memory = std::malloc(size == 0 ? 1 : size); memory) return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+namespace {
+
+struct Light {
+    float position[3];
+    float color[4];
+};
+
+struct Entity {
+    float transform[16];
+    void* mesh;
+    void* material;
+};
+
+}  // namespace
+
+TEST(LinearAllocatorTests, givenAllocator_whenAllocating_shouldReturnAlignedDistinctMemory) {
+    LinearAllocator allocator{ 1024 };
+
+    auto first  = static_cast<std::byte*>(allocator.allocate(3));
+    auto second = static_cast<std::byte*>(allocator.allocate(16, 64));
+
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(first) % LinearAllocator::defaultAlignment, 0u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(second) % 64, 0u);
+    EXPECT_GE(second, first + 3);
+    EXPECT_GE(allocator.getUsedSpace(), 19u);
+}
+
+TEST(LinearAllocatorTests, givenAllocator_whenResetting_shouldReuseMemory) {
+    LinearAllocator allocator{ 1024 };
+
+    auto first = allocator.allocate(100);
+    allocator.deallocate(first, 100);
+    EXPECT_NE(allocator.allocate(100), first);
+
+    allocator.reset();
+    EXPECT_EQ(allocator.getUsedSpace(), 0u);
+    EXPECT_EQ(allocator.allocate(100), first);
+}
+
+TEST(LinearAllocatorTests, givenExhaustedAllocator_whenResetting_shouldMergeBlocks) {
+    LinearAllocator allocator{ 128 };
+
+    for (int i = 0; i < 10; ++i) EXPECT_NE(allocator.allocate(100), nullptr);
+    EXPECT_GT(allocator.getBlockCount(), 1u);
+
+    const auto used = allocator.getUsedSpace();
+    allocator.reset();
+
+    EXPECT_EQ(allocator.getBlockCount(), 1u);
+    EXPECT_GE(allocator.getCapacity(), used);
+
+    // previous usage fits into the merged block now
+    for (int i = 0; i < 10; ++i) EXPECT_NE(allocator.allocate(100), nullptr);
+    EXPECT_EQ(allocator.getBlockCount(), 1u);
+}
+
+TEST(StlAllocatorTests, givenVector_whenUsingAdaptor_shouldAllocateFromUpstream) {
+    LinearAllocator allocator{ 4096 };
+    std::vector<int, StlAllocator<int>> values{ StlAllocator<int>{ allocator } };
+
+    for (int i = 0; i < 100; ++i) values.push_back(i);
+
+    EXPECT_GT(allocator.getUsedSpace(), 100 * sizeof(int));
+    EXPECT_EQ(values.back(), 99);
+}
+
+TEST(FrameAllocatorTests, givenFrameAllocator_whenBeginningFrame_shouldRotateArenas) {
+    FrameAllocator frameAllocator{ 2u, 1024 };
+
+    auto& first = frameAllocator.getArena();
+    auto data   = static_cast<int*>(first.allocate(sizeof(int)));
+    *data       = 42;
+
+    frameAllocator.beginFrame();
+    EXPECT_NE(&frameAllocator.getArena(), &first);
+    EXPECT_EQ(*data, 42);
+
+    frameAllocator.beginFrame();
+    EXPECT_EQ(&frameAllocator.getArena(), &first);
+    EXPECT_EQ(first.getUsedSpace(), 0u);
+}
+
+TEST(FrameAllocatorTests, givenSteadyFrames_whenBuildingFrameData_shouldNotTouchHeap) {
+    constexpr u64 framesInFlight = 3u;
+    constexpr u64 warmUpFrames   = 2 * framesInFlight;
+
+    // initial capacity is too small on purpose, arenas have to grow first
+    FrameAllocator frameAllocator{ framesInFlight, 256 };
+
+    auto buildFrame = [&]() {
+        frameAllocator.beginFrame();
+
+        auto lights   = frameAllocator.makeVector<Light>(5);
+        auto entities = frameAllocator.makeVector<Entity>();
+
+        for (int i = 0; i < 5; ++i) lights.emplace_back();
+        for (int i = 0; i < 1000; ++i) entities.emplace_back();
+
+        auto sorted = frameAllocator.makeVector<Entity*>(entities.size());
+        for (auto& entity : entities) sorted.push_back(&entity);
+
+        return sorted.size();
+    };
+
+    for (u64 i = 0; i < warmUpFrames; ++i) buildFrame();
+
+    const auto allocations = s_heapAllocations.load();
+    for (int i = 0; i < 100; ++i) EXPECT_EQ(buildFrame(), 1000u);
+
+    EXPECT_EQ(s_heapAllocations.load(), allocations);
+}
@@ -0,0 +1,159 @@
+#include "starlight/core/memory/PoolAllocator.hh"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace sl;
+
+namespace {
+
+struct Small {
+    u64 values[2];
+};
+
+struct Medium {
+    u64 values[20];
+};
+
+struct Big {
+    std::array<u64, 1024> values;
+};
+
+struct alignas(64) OverAligned {
+    u64 value;
+};
+
+bool isAligned(const void* ptr, u64 alignment) {
+    return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0u;
+}
+
+}  // namespace
+
+TEST(PoolAllocatorTests, givenBlock_whenFreedAndAllocatedAgain_shouldBeReused) {
+    PoolAllocator<Small> allocator;
+
+    auto first = allocator.allocate(1);
+    allocator.deallocate(first, 1);
+
+    auto second = allocator.allocate(1);
+    EXPECT_EQ(first, second);
+    allocator.deallocate(second, 1);
+}
+
+TEST(PoolAllocatorTests, givenManyAllocations_shouldReturnDistinctAlignedBlocks) {
+    PoolAllocator<Medium> allocator;
+
+    std::vector<void*> blocks;
+    for (u64 i = 0; i < 1000; ++i) {
+        auto block = allocator.allocate(1);
+        ASSERT_TRUE(isAligned(block, BlockPool::alignment));
+
+        // whole block has to be usable
+        std::memset(block, static_cast<int>(i), sizeof(Medium));
+        blocks.push_back(block);
+    }
+
+    const std::set<void*> unique(blocks.begin(), blocks.end());
+    EXPECT_EQ(unique.size(), blocks.size());
+
+    for (u64 i = 0; i < blocks.size(); ++i) {
+        const auto bytes = static_cast<const unsigned char*>(blocks[i]);
+        EXPECT_TRUE(std::all_of(bytes, bytes + sizeof(Medium), [&](auto byte) {
+            return byte == static_cast<unsigned char>(i);
+        }));
+    }
+
+    for (auto block : blocks) allocator.deallocate(block, 1);
+}
+
+TEST(PoolAllocatorTests, givenObjectsBiggerThanLargestClass_shouldFallBackToHeap) {
+    EXPECT_FALSE(BlockPool::isPooled(sizeof(Big), alignof(Big)));
+
+    PoolAllocator<Big> allocator;
+    auto block = static_cast<Big*>(allocator.allocate(1));
+    block->values.fill(1u);
+    allocator.deallocate(block, 1);
+}
+
+TEST(PoolAllocatorTests, givenOverAlignedType_shouldRespectAlignment) {
+    PoolAllocator<OverAligned> allocator;
+
+    auto block = allocator.allocate(1);
+    EXPECT_TRUE(isAligned(block, alignof(OverAligned)));
+    allocator.deallocate(block, 1);
+}
+
+TEST(PoolAllocatorTests, givenArrayAllocation_shouldUseClassOfWholeSize) {
+    PoolAllocator<Small> allocator;
+
+    auto block = static_cast<Small*>(allocator.allocate(10));
+    for (u64 i = 0; i < 10; ++i) block[i].values[1] = i;
+    allocator.deallocate(block, 10);
+}
+
+TEST(PoolAllocatorTests, givenBlocksFreedOnOtherThread_shouldBeReusable) {
+    constexpr u64 count = 10'000;
+
+    PoolAllocator<Small> allocator;
+    std::vector<void*> blocks(count);
+
+    std::thread producer{ [&]() {
+        for (auto& block : blocks) block = allocator.allocate(1);
+    } };
+    producer.join();
+
+    std::thread consumer{ [&]() {
+        for (auto block : blocks) allocator.deallocate(block, 1);
+    } };
+    consumer.join();
+
+    // both threads are gone, their caches went back to the shared pool
+    std::vector<void*> reused(count);
+    for (auto& block : reused) block = allocator.allocate(1);
+
+    const std::set<void*> unique(reused.begin(), reused.end());
+    EXPECT_EQ(unique.size(), count);
+
+    for (auto block : reused) allocator.deallocate(block, 1);
+}
+
+TEST(PoolAllocatorTests, givenManyThreads_whenChurning_shouldNotCorruptBlocks) {
+    constexpr u64 threadCount = 4;
+    constexpr u64 iterations  = 20'000;
+
+    std::vector<std::thread> threads;
+    std::array<bool, threadCount> valid;
+    valid.fill(true);
+
+    for (u64 t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&valid, t]() {
+            PoolAllocator<Small> allocator;
+            std::vector<Small*> live;
+
+            for (u64 i = 0; i < iterations; ++i) {
+                auto block       = static_cast<Small*>(allocator.allocate(1));
+                block->values[0] = t;
+                block->values[1] = i;
+                live.push_back(block);
+
+                if (live.size() > 64) {
+                    for (auto old : live)
+                        if (old->values[0] != t) valid[t] = false;
+                    for (auto old : live) allocator.deallocate(old, 1);
+                    live.clear();
+                }
+            }
+            for (auto old : live) allocator.deallocate(old, 1);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    for (const auto ok : valid) EXPECT_TRUE(ok);
+}
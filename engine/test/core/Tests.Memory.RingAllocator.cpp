@@ -0,0 +1,86 @@
+#include "starlight/core/memory/RingAllocator.hh"
+
+#include <gtest/gtest.h>
+
+using namespace sl;
+
+constexpr u64 capacity = 1024;
+
+TEST(RingAllocatorTests, givenRingAllocator_whenAllocating_shouldReturnConsecutive) {
+    RingAllocator ring{ capacity };
+
+    EXPECT_EQ(ring.allocate(100), 0u);
+    EXPECT_EQ(ring.allocate(200), 100u);
+    EXPECT_EQ(ring.getUsedSpace(), 300u);
+}
+
+TEST(RingAllocatorTests, givenRingAllocator_whenAllocatingAligned_shouldPad) {
+    RingAllocator ring{ capacity };
+
+    EXPECT_EQ(ring.allocate(10), 0u);
+    EXPECT_EQ(ring.allocate(10, 16u), 16u);
+    EXPECT_EQ(ring.getUsedSpace(), 26u);
+}
+
+TEST(RingAllocatorTests, givenFullRing_whenAllocating_shouldFail) {
+    RingAllocator ring{ capacity };
+
+    EXPECT_EQ(ring.allocate(capacity), 0u);
+    EXPECT_FALSE(ring.allocate(1).has_value());
+    EXPECT_FALSE(RingAllocator{ capacity }.allocate(capacity + 1).has_value());
+}
+
+TEST(RingAllocatorTests, givenReleasedHead_whenAllocating_shouldReuseSpace) {
+    RingAllocator ring{ capacity };
+
+    ring.allocate(600);
+    const auto head = ring.getHead();
+    ring.allocate(300);
+
+    EXPECT_FALSE(ring.allocate(600).has_value());
+
+    ring.release(head);
+    EXPECT_EQ(ring.getUsedSpace(), 300u);
+
+    // the tail of the ring is too short, the block starts over at the beginning
+    EXPECT_EQ(ring.allocate(500), 0u);
+    EXPECT_EQ(ring.getUsedSpace(), 300u + 124u + 500u);
+}
+
+TEST(RingAllocatorTests, givenSpaceSplitByWrap_whenAllocating_shouldFail) {
+    RingAllocator ring{ capacity };
+
+    ring.allocate(500);
+    const auto head = ring.getHead();
+    ring.allocate(400);
+    ring.release(head);
+
+    // 124 bytes at the end and 500 at the beginning, but not in one piece
+    EXPECT_FALSE(ring.allocate(550).has_value());
+    EXPECT_EQ(ring.allocate(450), 0u);
+}
+
+TEST(
+  RingAllocatorTests, givenEverythingReleased_whenAllocating_shouldKeepGoingAround
+) {
+    RingAllocator ring{ capacity };
+
+    for (u64 i = 0; i < 100; ++i) {
+        const auto offset = ring.allocate(300, 16u);
+        ASSERT_TRUE(offset.has_value());
+        EXPECT_LE(*offset + 300u, capacity);
+        EXPECT_EQ(*offset % 16u, 0u);
+
+        ring.release(ring.getHead());
+        EXPECT_EQ(ring.getUsedSpace(), 0u);
+    }
+}
+
+TEST(RingAllocatorTests, givenEmptyRing_whenAllocatingWholeCapacity_shouldSucceed) {
+    RingAllocator ring{ capacity };
+
+    ring.allocate(100);
+    ring.release(ring.getHead());
+
+    EXPECT_EQ(ring.allocate(capacity), 0u);
+}
@@ -3,6 +3,10 @@
 
 using namespace testing;
 
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
 #include "starlight/core/memory/SharedPtr.hh"
 
 using namespace sl;
@@ -126,3 +130,43 @@ TEST_F(SharedPtrTests, whenCreatingPolymorphicSharedPtr_shouldBeDestroyedProperl
     expectTesterCalls<Tester>(1u, 1u);
     expectTesterCalls<Tester2>(1u, 1u);
 }
+
+TEST_F(SharedPtrTests, whenSharingBetweenThreads_shouldDestroyResourceOnce) {
+    {
+        auto p = SharedPtr<Tester>::create();
+
+        std::vector<std::thread> threads;
+        for (u64 i = 0; i < 4; ++i) {
+            threads.emplace_back([copy = p]() mutable {
+                for (u64 j = 0; j < 1000; ++j) {
+                    auto other = copy;
+                    other.reset();
+                }
+                copy.reset();
+            });
+        }
+        p.reset();
+
+        for (auto& thread : threads) thread.join();
+    }
+    expectTesterCalls<Tester>(1u, 1u);
+}
+
+struct ThrowingTester {
+    ThrowingTester() { throw std::runtime_error{ "ThrowingTester" }; }
+};
+
+struct alignas(64) AlignedTester {
+    int value;
+};
+
+TEST_F(SharedPtrTests, whenConstructorThrows_shouldPropagateException) {
+    EXPECT_THROW(SharedPtr<ThrowingTester>::create(), std::runtime_error);
+}
+
+TEST_F(SharedPtrTests, whenCreatingOverAlignedObject_shouldRespectAlignment) {
+    auto p = SharedPtr<AlignedTester>::create(42);
+
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p.get()) % alignof(AlignedTester), 0u);
+    EXPECT_EQ(p->value, 42);
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include "starlight/core/RadixSort.hh"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace sl;
+
+namespace {
+
+struct SortOutput {
+    std::vector<u64> keys;
+    std::vector<u32> values;
+};
+
+SortOutput radixSorted(std::vector<u64> keys) {
+    std::vector<u32> values(keys.size());
+    std::iota(values.begin(), values.end(), 0u);
+
+    std::vector<u64> keysScratch(keys.size());
+    std::vector<u32> valuesScratch(keys.size());
+    radixSort(keys, values, keysScratch, valuesScratch);
+
+    return SortOutput{ std::move(keys), std::move(values) };
+}
+
+}  // namespace
+
+TEST(RadixSortTests, givenEmptyOrSingleKey_whenSorting_shouldDoNothing) {
+    EXPECT_TRUE(radixSorted({}).keys.empty());
+
+    const auto [keys, values] = radixSorted({ 42u });
+    EXPECT_EQ(keys, std::vector<u64>{ 42u });
+    EXPECT_EQ(values, std::vector<u32>{ 0u });
+}
+
+TEST(RadixSortTests, givenRandomKeys_whenSorting_shouldMatchStableSort) {
+    std::mt19937_64 generator{ 1234u };
+
+    // small inputs take the comparison sort, bigger ones the radix passes
+    for (const u64 count : { 500u, 1024u, 1025u, 10'000u }) {
+        std::vector<u64> keys(count);
+        // few distinct values so stability is exercised
+        for (auto& key : keys)
+            key = ((generator() % 64u) << 40u) | (generator() % 3u);
+
+        std::vector<u32> expected(keys.size());
+        std::iota(expected.begin(), expected.end(), 0u);
+        std::ranges::stable_sort(expected, [&](u32 lhs, u32 rhs) {
+            return keys[lhs] < keys[rhs];
+        });
+
+        const auto [sortedKeys, values] = radixSorted(keys);
+
+        EXPECT_TRUE(std::ranges::is_sorted(sortedKeys));
+        EXPECT_EQ(values, expected) << count << " keys";
+    }
+}
+
+TEST(RadixSortTests, givenKeysUsingAllBits_whenSorting_shouldSortThem) {
+    std::mt19937_64 generator{ 42u };
+
+    std::vector<u64> keys(1'000);
+    for (auto& key : keys) key = generator();
+    keys.push_back(0u);
+    keys.push_back(~0ull);
+
+    const auto [sortedKeys, values] = radixSorted(keys);
+
+    ASSERT_TRUE(std::ranges::is_sorted(sortedKeys));
+    for (u64 i = 0; i < sortedKeys.size(); ++i)
+        EXPECT_EQ(sortedKeys[i], keys[values[i]]);
+}
+
+TEST(RadixSortTests, givenEqualKeys_whenSorting_shouldKeepOrder) {
+    const auto [keys, values] = radixSorted(std::vector<u64>(100, 7u));
+
+    for (u32 i = 0; i < values.size(); ++i) EXPECT_EQ(values[i], i);
+}
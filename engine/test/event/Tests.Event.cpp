@@ -13,6 +13,10 @@ struct TestEvent {
     int y;
 };
 
+struct OtherEvent {
+    int z;
+};
+
 struct EventTests : Test {
     EventBroker broker;
     EventProxy& proxy = broker.getProxy();
@@ -25,6 +29,22 @@ TEST_F(EventTests, givenNoHandler_whenEmittingEvent_shouldHaveNoConsequences) {
     });
 }
 
+TEST_F(EventTests, givenEventWithoutHandler_whenDispatching_shouldDispatchLaterEvents) {
+    int received = 0;
+
+    auto id = proxy.pushEventHandler<TestEvent>([&](const TestEvent& ev) {
+        received += ev.y;
+    });
+
+    proxy.emit<TestEvent>(0.0f, 1);
+    proxy.emit<OtherEvent>(2);
+    proxy.emit<TestEvent>(0.0f, 2);
+    broker.dispatch();
+
+    EXPECT_EQ(received, 3);
+    proxy.popEventHandler(id);
+}
+
 TEST_F(EventTests, givenHandler_whenEmittingEvent_shouldBeCalled) {
     bool called = false;
 
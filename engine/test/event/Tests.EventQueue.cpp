@@ -0,0 +1,286 @@
+#include "starlight/event/EventQueue.hh"
+#include "starlight/event/EventBroker.hh"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace sl;
+using namespace sl::details;
+
+namespace {
+
+struct SmallEvent {
+    u64 producer;
+    u64 index;
+};
+
+// too big for an inline slot, goes through the pool
+struct LargeEvent {
+    u64 producer;
+    u64 index;
+    std::array<u64, 32> payload{};
+};
+
+struct StringEvent {
+    std::string value;
+};
+
+// holds its slot claimed but unpublished until released
+struct BlockingEvent {
+    explicit BlockingEvent(
+      std::atomic_bool& claimed, const std::atomic_bool& released
+    ) {
+        claimed.store(true);
+        while (not released.load()) std::this_thread::yield();
+    }
+};
+
+constexpr u64 producerCount     = 4;
+constexpr u64 eventsPerProducer = 50'000;
+
+}  // namespace
+
+TEST(EventQueueTests, givenEventTypes_shouldHaveDistinctStableIds) {
+    const auto smallId = getEventTypeInfo<SmallEvent>().id;
+    const auto largeId = getEventTypeInfo<LargeEvent>().id;
+
+    EXPECT_NE(smallId, largeId);
+    EXPECT_EQ(smallId, getEventTypeInfo<SmallEvent>().id);
+    EXPECT_EQ(largeId, getEventTypeInfo<LargeEvent>().id);
+}
+
+TEST(EventQueueTests, givenEvents_whenDraining_shouldReturnThemInOrder) {
+    EventQueue queue{ 8u };
+
+    for (u64 i = 0; i < 20; ++i) queue.push<SmallEvent>(0u, i);
+
+    std::vector<u64> indices;
+    queue.drain([&](const EventTypeInfo& type, void* event) {
+        ASSERT_EQ(type.id, getEventTypeInfo<SmallEvent>().id);
+        indices.push_back(static_cast<SmallEvent*>(event)->index);
+    });
+
+    // first 8 go to the ring, the rest overflows, order is kept anyway
+    ASSERT_EQ(indices.size(), 20u);
+    for (u64 i = 0; i < 20; ++i) EXPECT_EQ(indices[i], i);
+}
+
+TEST(EventQueueTests, givenNonTrivialEvents_whenDraining_shouldDestroyThem) {
+    EventQueue queue{ 4u };
+
+    const std::string value(100, 'x');
+    for (int i = 0; i < 10; ++i) queue.push<StringEvent>(value);
+    queue.push<LargeEvent>(0u, 0u);
+
+    u64 count = 0u;
+    queue.drain([&](const EventTypeInfo& type, void* event) {
+        if (type.id == getEventTypeInfo<StringEvent>().id) {
+            EXPECT_EQ(static_cast<StringEvent*>(event)->value, value);
+        }
+        ++count;
+    });
+    EXPECT_EQ(count, 11u);
+
+    count = 0u;
+    queue.drain([&](const EventTypeInfo&, void*) { ++count; });
+    EXPECT_EQ(count, 0u);
+
+    // left in the queue on purpose, destructor has to release them
+    queue.push<StringEvent>(value);
+    queue.push<LargeEvent>(0u, 0u);
+}
+
+TEST(EventQueueTests, givenEventPushedWhileDraining_whenDraining_shouldDeferIt) {
+    EventQueue queue{ 16u };
+    queue.push<SmallEvent>(0u, 0u);
+
+    u64 count = 0u;
+    queue.drain([&](const EventTypeInfo&, void*) {
+        ++count;
+        queue.push<SmallEvent>(0u, 1u);
+    });
+    EXPECT_EQ(count, 1u);
+
+    queue.drain([&](const EventTypeInfo&, void*) { ++count; });
+    EXPECT_EQ(count, 2u);
+}
+
+TEST(EventQueueTests, givenOverflowPushedWhileDraining_whenDraining_shouldDeferIt) {
+    EventQueue queue{ 2u };
+    for (u64 i = 0; i < 4; ++i) queue.push<SmallEvent>(0u, i);
+
+    std::vector<u64> indices;
+    queue.drain([&](const EventTypeInfo&, void* event) {
+        const auto index = static_cast<SmallEvent*>(event)->index;
+        indices.push_back(index);
+        // the queue is still overflowing, so these go to the overflow list too
+        if (index < 4u) queue.push<SmallEvent>(0u, index + 4u);
+    });
+    EXPECT_EQ(indices, (std::vector<u64>{ 0, 1, 2, 3 }));
+
+    indices.clear();
+    queue.drain([&](const EventTypeInfo&, void* event) {
+        indices.push_back(static_cast<SmallEvent*>(event)->index);
+    });
+    EXPECT_EQ(indices, (std::vector<u64>{ 4, 5, 6, 7 }));
+}
+
+TEST(EventQueueTests, givenUnpublishedSlot_whenDraining_shouldKeepOverflowBehind) {
+    EventQueue queue{ 4u };
+
+    std::atomic_bool claimed  = false;
+    std::atomic_bool released = false;
+    std::thread blocked{ [&]() { queue.push<BlockingEvent>(claimed, released); } };
+
+    // the blocked producer holds the first slot, the rest of the ring and the
+    // overflow are filled from here
+    while (not claimed.load()) std::this_thread::yield();
+    for (u64 i = 0; i < 6; ++i) queue.push<SmallEvent>(0u, i);
+
+    const auto smallId = getEventTypeInfo<SmallEvent>().id;
+    std::vector<u64> indices;
+    auto collect = [&](const EventTypeInfo& type, void* event) {
+        if (type.id == smallId)
+            indices.push_back(static_cast<SmallEvent*>(event)->index);
+    };
+
+    queue.drain(collect);
+    EXPECT_TRUE(indices.empty());
+
+    released.store(true);
+    blocked.join();
+
+    queue.drain(collect);
+    EXPECT_EQ(indices, (std::vector<u64>{ 0, 1, 2, 3, 4, 5 }));
+}
+
+TEST(EventQueueTests, givenManyProducers_whenDrainingConcurrently_shouldReceiveAllEvents) {
+    EventQueue queue{ 256u };
+
+    std::vector<std::thread> producers;
+    for (u64 producer = 0; producer < producerCount; ++producer) {
+        producers.emplace_back([&queue, producer]() {
+            for (u64 i = 0; i < eventsPerProducer; ++i) {
+                if (i % 7 == 0)
+                    queue.push<LargeEvent>(producer, i);
+                else
+                    queue.push<SmallEvent>(producer, i);
+            }
+        });
+    }
+
+    std::array<u64, producerCount> expected{};
+    u64 received    = 0u;
+    bool inOrder    = true;
+    const u64 total = producerCount * eventsPerProducer;
+
+    auto consume = [&](u64 producer, u64 index) {
+        inOrder &= expected[producer] == index;
+        expected[producer] = index + 1;
+        ++received;
+    };
+
+    while (received < total) {
+        queue.drain([&](const EventTypeInfo& type, void* event) {
+            if (type.id == getEventTypeInfo<LargeEvent>().id) {
+                auto largeEvent = static_cast<LargeEvent*>(event);
+                consume(largeEvent->producer, largeEvent->index);
+            } else {
+                auto smallEvent = static_cast<SmallEvent*>(event);
+                consume(smallEvent->producer, smallEvent->index);
+            }
+        });
+    }
+
+    for (auto& producer : producers) producer.join();
+
+    EXPECT_EQ(received, total);
+    EXPECT_TRUE(inOrder);
+    for (const auto count : expected) EXPECT_EQ(count, eventsPerProducer);
+}
+
+TEST(EventQueueTests, givenSteadyProducer_whenOverflowDrained_shouldReturnToRing) {
+    constexpr u64 eventsPerDrain = 4u;
+    EventQueue queue{ 64u };
+
+    // fills the ring and overflows before the producer starts
+    for (u64 i = 0; i < 100; ++i) queue.push<SmallEvent>(0u, i);
+    ASSERT_TRUE(queue.isOverflowing());
+
+    std::atomic_bool stop      = false;
+    std::atomic<u64> requested = 0u;
+    std::atomic<u64> pushed    = 0u;
+    std::thread producer{ [&]() {
+        for (u64 i = 0; not stop.load();) {
+            if (i == requested.load()) {
+                std::this_thread::yield();
+                continue;
+            }
+            queue.push<SmallEvent>(1u, i);
+            pushed.store(++i);
+        }
+    } };
+
+    // the producer pushes while every drain is in progress, so the overflow is
+    // never empty after one and has to be moved back to the ring instead
+    std::array<u64, 2> expected{};
+    bool inOrder = true;
+    auto consume = [&](const EventTypeInfo&, void* event) {
+        const auto smallEvent = static_cast<SmallEvent*>(event);
+        inOrder &= expected[smallEvent->producer] == smallEvent->index;
+        expected[smallEvent->producer] = smallEvent->index + 1u;
+    };
+    auto drain = [&]() {
+        bool first = true;
+        queue.drain([&](const EventTypeInfo& type, void* event) {
+            if (std::exchange(first, false)) {
+                requested.fetch_add(eventsPerDrain);
+                while (pushed.load() != requested.load()) std::this_thread::yield();
+            }
+            consume(type, event);
+        });
+    };
+
+    drain();
+    EXPECT_FALSE(queue.isOverflowing());
+
+    for (int i = 0; i < 10; ++i) {
+        drain();
+        EXPECT_FALSE(queue.isOverflowing());
+    }
+
+    stop.store(true);
+    producer.join();
+    queue.drain(consume);
+
+    EXPECT_TRUE(inOrder);
+    EXPECT_EQ(expected[0], 100u);
+    EXPECT_EQ(expected[1], pushed.load());
+}
+
+TEST(EventQueueTests, givenBroker_whenEmittingFromWorkerThreads_shouldDispatchAll) {
+    EventBroker broker;
+    auto& proxy = broker.getProxy();
+
+    u64 received = 0u;
+    auto id = proxy.pushEventHandler<SmallEvent>([&](const SmallEvent&) { ++received; });
+
+    std::vector<std::thread> producers;
+    for (u64 producer = 0; producer < producerCount; ++producer) {
+        producers.emplace_back([&proxy, producer]() {
+            for (u64 i = 0; i < eventsPerProducer; ++i) proxy.emit<SmallEvent>(producer, i);
+        });
+    }
+    for (auto& producer : producers) producer.join();
+
+    broker.dispatch();
+    EXPECT_EQ(received, producerCount * eventsPerProducer);
+
+    proxy.popEventHandler(id);
+}
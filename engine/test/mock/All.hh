@@ -1,5 +1,6 @@
 #pragma once
 
+#include "BufferMock.hh"
 #include "RendererBackendMock.hh"
 #include "ResourcePoolsMock.hh"
 #include "WindowMock.hh"
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "starlight/renderer/gpu/Buffer.hh"
+
+#include <gmock/gmock.h>
+
+using namespace sl;
+
+struct BufferMock : public Buffer {
+    MOCK_METHOD(void, bind, (u64), (override));
+    MOCK_METHOD(void*, lockMemory, (const Range&), (override));
+    MOCK_METHOD(void, unlockMemory, (), (override));
+    MOCK_METHOD(
+      std::optional<Range>, allocate, (u64, const void*, RelocationCallback&&),
+      (override)
+    );
+    MOCK_METHOD(void, free, (const Range&), (override));
+    MOCK_METHOD(u64, defragment, (CommandBuffer&, u64), (override));
+    MOCK_METHOD(void, copy, (const Range&, const void*), (override));
+};
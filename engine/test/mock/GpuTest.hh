@@ -0,0 +1,84 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+#include "starlight/core/Globals.hh"
+#include "starlight/event/EventBroker.hh"
+#include "starlight/window/Window.hh"
+#include "starlight/renderer/gpu/Device.hh"
+#include "starlight/renderer/gpu/vulkan/VulkanBuffer.hh"
+#include "starlight/renderer/gpu/vulkan/VulkanCommandBuffer.hh"
+#include "starlight/renderer/gpu/vulkan/VulkanDevice.hh"
+
+/*
+    Base of the tests running on a real vulkan device and a window, built only with
+    SL_ENABLE_GPU_TESTS; the pipeline runs them on lavapipe under xvfb.
+*/
+class GpuTest : public testing::Test {
+protected:
+    static sl::Config createConfig() {
+        return sl::Config{
+            .window  = { .width = 64u, .height = 64u, .name = "GpuTest" },
+            .version = { .major = 0u, .minor = 0u, .build = 0u },
+            .paths   = {},
+            .events  = {},
+        };
+    }
+
+    sl::Buffer::Properties getDeviceLocalProperties(sl::u64 size) const {
+        return sl::Buffer::Properties{
+            .size           = size,
+            .memoryProperty = sl::MemoryProperty::MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            .usage          = sl::BufferUsage::BUFFER_USAGE_TRANSFER_DST_BIT
+                     | sl::BufferUsage::BUFFER_USAGE_TRANSFER_SRC_BIT
+                     | sl::BufferUsage::BUFFER_USAGE_VERTEX_BUFFER_BIT,
+            .bindOnCreate = true,
+        };
+    }
+
+    // copied through a host visible buffer on the graphics queue
+    std::vector<sl::u8> readBack(
+      sl::vk::VulkanBuffer& source, sl::u64 offset, sl::u64 size
+    ) {
+        sl::vk::VulkanBuffer readBackBuffer{
+            vulkanDevice,
+            sl::Buffer::Properties{
+              .size = size,
+              .memoryProperty =
+                sl::MemoryProperty::MEMORY_PROPERTY_HOST_VISIBLE_BIT
+                | sl::MemoryProperty::MEMORY_PROPERTY_HOST_COHERENT_BIT,
+              .usage        = sl::BufferUsage::BUFFER_USAGE_TRANSFER_DST_BIT,
+              .bindOnCreate = true,
+            },
+        };
+
+        {
+            sl::CommandBuffer::Immediate commandBuffer{
+                vulkanDevice.getQueue(sl::Queue::Type::graphics)
+            };
+            VkBufferCopy region{
+                .srcOffset = offset, .dstOffset = 0u, .size = size
+            };
+            vkCmdCopyBuffer(
+              static_cast<sl::vk::VulkanCommandBuffer&>(commandBuffer.get())
+                .getHandle(),
+              source.getHandle(), readBackBuffer.getHandle(), 1, &region
+            );
+        }
+
+        std::vector<sl::u8> data(size);
+        std::memcpy(data.data(), readBackBuffer.lockMemory(), size);
+        readBackBuffer.unlockMemory();
+        return data;
+    }
+
+    sl::Globals globals{ createConfig() };
+    sl::EventBroker eventBroker;
+    sl::Window window;
+    sl::Device device;
+    sl::vk::VulkanDevice& vulkanDevice =
+      static_cast<sl::vk::VulkanDevice&>(device.getImpl());
+};
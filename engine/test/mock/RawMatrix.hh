@@ -0,0 +1,26 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+
+#include "starlight/core/Core.hh"
+
+// plain float matrices for code taking raw pointers, so its tests and benchmarks
+// don't need glm; shared with bench/ through its include path
+
+using RawMatrix = std::array<sl::f32, 16>;
+
+// column major perspective with 0..1 depth, camera at the origin looking at -z
+inline RawMatrix perspective(
+  sl::f32 fovY, sl::f32 aspect, sl::f32 nearZ, sl::f32 farZ
+) {
+    const auto f = 1.0f / std::tan(fovY / 2.0f);
+
+    RawMatrix m{};
+    m[0]  = f / aspect;
+    m[5]  = f;
+    m[10] = farZ / (nearZ - farZ);
+    m[11] = -1.0f;
+    m[14] = -(farZ * nearZ) / (farZ - nearZ);
+    return m;
+}
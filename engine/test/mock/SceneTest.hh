@@ -0,0 +1,66 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "BufferMock.hh"
+
+#include "starlight/app/scene/Scene.hh"
+#include "starlight/core/TaskQueue.hh"
+#include "starlight/core/memory/FrameAllocator.hh"
+#include "starlight/event/EventBroker.hh"
+#include "starlight/renderer/MeshComposite.hh"
+
+// looks at the origin from 50 units away, along the z axis
+class FixedCamera : public sl::Camera {
+public:
+    explicit FixedCamera() : Camera(sl::Vec2<sl::u32>{ 800u, 600u }) {}
+
+    sl::Mat4<sl::f32> getViewMatrix() const override {
+        return sl::math::lookAt(
+          getPosition(), sl::Vec3<sl::f32>{ 0.0f },
+          sl::Vec3<sl::f32>{ 0.0f, 1.0f, 0.0f }
+        );
+    }
+
+    sl::Vec3<sl::f32> getPosition() const override {
+        return sl::Vec3<sl::f32>{ 0.0f, 0.0f, -50.0f };
+    }
+
+    void update(float) override {}
+};
+
+/*
+    Scene with the singletons it needs and meshes on mocked buffers, for tests
+    building render packets without a device.
+*/
+class SceneTest : public testing::Test {
+protected:
+    explicit SceneTest() {
+        ON_CALL(vertexBuffer, allocate(testing::_, testing::_, testing::_))
+          .WillByDefault(testing::Return(sl::Range{ 0u, 64u }));
+        ON_CALL(indexBuffer, allocate(testing::_, testing::_, testing::_))
+          .WillByDefault(testing::Return(sl::Range{ 0u, 12u }));
+    }
+
+    // a 2x2x2 box around the origin
+    sl::SharedPtr<sl::Mesh> createMesh() {
+        const sl::Mesh::Data data{
+            .indexCount     = 3u,
+            .vertexDataSize = 64u,
+            .indexDataSize  = 12u,
+            .vertexData     = nullptr,
+            .indexData      = nullptr,
+            .extent         = sl::Extent3{ sl::Vec3<sl::f32>{ -1.0f },
+                                           sl::Vec3<sl::f32>{ 1.0f } },
+        };
+        return sl::SharedPtr<sl::Mesh>::create(data, vertexBuffer, indexBuffer);
+    }
+
+    sl::EventBroker eventBroker;
+    sl::TaskQueue taskQueue{ 1u };
+    sl::FrameAllocator frameAllocator{ 3u, 1024u };
+    testing::NiceMock<BufferMock> vertexBuffer;
+    testing::NiceMock<BufferMock> indexBuffer;
+    FixedCamera camera;
+    sl::Scene scene{ &camera };
+};
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include "starlight/renderer/gpu/DeletionQueue.hh"
+
+#include <vector>
+
+using namespace sl;
+
+TEST(
+  DeletionQueueTests, givenRetiredResources_whenFrameCompletes_shouldRunItsDeleters
+) {
+    DeletionQueue queue;
+    std::vector<int> deleted;
+
+    queue.push(1u, [&] { deleted.push_back(1); });
+    queue.push(2u, [&] { deleted.push_back(2); });
+    queue.push(2u, [&] { deleted.push_back(3); });
+
+    EXPECT_EQ(queue.collect(0u), 0u);
+    EXPECT_TRUE(deleted.empty());
+
+    EXPECT_EQ(queue.collect(1u), 1u);
+    EXPECT_EQ(deleted, std::vector<int>({ 1 }));
+
+    EXPECT_EQ(queue.collect(2u), 2u);
+    EXPECT_EQ(deleted, std::vector<int>({ 1, 2, 3 }));
+    EXPECT_EQ(queue.getSize(), 0u);
+}
+
+TEST(DeletionQueueTests, givenSkippedFrames_whenCollecting_shouldRunOlderOnes) {
+    DeletionQueue queue;
+    u64 deleted = 0u;
+
+    queue.push(3u, [&] { ++deleted; });
+    queue.push(7u, [&] { ++deleted; });
+
+    EXPECT_EQ(queue.collect(5u), 1u);
+    EXPECT_EQ(queue.getSize(), 1u);
+    EXPECT_EQ(deleted, 1u);
+}
+
+TEST(DeletionQueueTests, givenDeleterRetiringResource_whenCollecting_shouldKeepIt) {
+    DeletionQueue queue;
+    bool innerDeleted = false;
+
+    queue.push(1u, [&] { queue.push(4u, [&] { innerDeleted = true; }); });
+
+    EXPECT_EQ(queue.collect(1u), 1u);
+    EXPECT_FALSE(innerDeleted);
+    EXPECT_EQ(queue.getSize(), 1u);
+
+    queue.flush();
+    EXPECT_TRUE(innerDeleted);
+}
+
+TEST(DeletionQueueTests, givenQueuedDeleters_whenDestroyed_shouldRunThem) {
+    u64 deleted = 0u;
+    {
+        DeletionQueue queue;
+        queue.push(10u, [&] { ++deleted; });
+        queue.push(11u, [&] { ++deleted; });
+    }
+    EXPECT_EQ(deleted, 2u);
+}
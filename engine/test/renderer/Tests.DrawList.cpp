@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include "starlight/renderer/DrawList.hh"
+
+#include <cmath>
+#include <vector>
+
+using namespace sl;
+
+namespace {
+
+DrawList::KeyFields opaque(u64 material, u64 mesh, f32 depth) {
+    return DrawList::KeyFields{
+        .pass     = 0u,
+        .layer    = DrawList::Layer::opaque,
+        .pipeline = 0u,
+        .material = material,
+        .mesh     = mesh,
+        .depth    = depth,
+    };
+}
+
+DrawList::KeyFields transparent(u64 material, u64 mesh, f32 depth) {
+    auto fields  = opaque(material, mesh, depth);
+    fields.layer = DrawList::Layer::transparent;
+    return fields;
+}
+
+}  // namespace
+
+class DrawListTests : public testing::Test {
+protected:
+    FrameAllocator frameAllocator{ 1u };
+
+    std::vector<u32> sortDraws(const std::vector<DrawList::KeyFields>& draws) {
+        DrawList drawList{ draws.size() };
+        for (u32 i = 0; i < draws.size(); ++i)
+            drawList.add(DrawList::makeKey(draws[i]), i);
+        drawList.sort();
+
+        const auto indices = drawList.getIndices();
+        return std::vector<u32>(indices.begin(), indices.end());
+    }
+};
+
+TEST_F(DrawListTests, givenOpaqueDraws_whenSorting_shouldGroupByMaterialThenMesh) {
+    const auto order = sortDraws({
+      opaque(2u, 1u, 1.0f),
+      opaque(1u, 2u, 1.0f),
+      opaque(2u, 1u, 5.0f),
+      opaque(1u, 1u, 1.0f),
+      opaque(2u, 2u, 1.0f),
+      opaque(1u, 2u, 0.5f),
+    });
+
+    EXPECT_EQ(order, (std::vector<u32>{ 3u, 5u, 1u, 0u, 2u, 4u }));
+}
+
+TEST_F(DrawListTests, givenOpaqueAndTransparentDraws_whenSorting_shouldDrawOpaqueFirst) {
+    const auto order = sortDraws({
+      transparent(0u, 0u, 1.0f),
+      opaque(9u, 9u, 100.0f),
+      transparent(0u, 0u, 3.0f),
+      opaque(0u, 0u, 1.0f),
+    });
+
+    // transparent ones back to front, whatever their state
+    EXPECT_EQ(order, (std::vector<u32>{ 3u, 1u, 2u, 0u }));
+}
+
+TEST_F(DrawListTests, givenTransparentDraws_whenSorting_shouldOrderBackToFront) {
+    const auto order = sortDraws({
+      transparent(1u, 1u, 2.0f),
+      transparent(2u, 2u, 10.0f),
+      transparent(1u, 1u, 0.25f),
+      transparent(3u, 3u, 1000.0f),
+    });
+
+    EXPECT_EQ(order, (std::vector<u32>{ 3u, 1u, 0u, 2u }));
+}
+
+TEST_F(DrawListTests, givenDifferentPasses_whenSorting_shouldOrderByPassFirst) {
+    auto second = opaque(0u, 0u, 0.0f);
+    second.pass = 1u;
+
+    const auto order =
+      sortDraws({ second, transparent(5u, 5u, 1.0f), opaque(7u, 7u, 7.0f) });
+
+    EXPECT_EQ(order, (std::vector<u32>{ 2u, 1u, 0u }));
+}
+
+TEST_F(DrawListTests, givenInvalidDepth_whenMakingKey_shouldClampToFront) {
+    EXPECT_EQ(
+      DrawList::makeKey(opaque(1u, 1u, -5.0f)),
+      DrawList::makeKey(opaque(1u, 1u, 0.0f))
+    );
+    EXPECT_EQ(
+      DrawList::makeKey(opaque(1u, 1u, std::nanf(""))),
+      DrawList::makeKey(opaque(1u, 1u, 0.0f))
+    );
+}
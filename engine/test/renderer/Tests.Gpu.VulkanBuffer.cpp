@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <optional>
+#include <vector>
+
+#include "mock/GpuTest.hh"
+
+using namespace sl;
+
+namespace {
+
+constexpr u64 rangeSize  = 512u;
+constexpr u64 rangeCount = 4u;
+
+}  // namespace
+
+class VulkanBufferTests : public GpuTest {
+protected:
+    explicit VulkanBufferTests() {
+        auto props       = getDeviceLocalProperties(rangeSize * rangeCount * 2u);
+        props.isGrowable = true;
+        buffer.emplace(vulkanDevice, props);
+
+        for (u64 i = 0; i < rangeCount; ++i) {
+            data[i].assign(rangeSize, static_cast<u8>(i + 1u));
+            ranges[i] = *buffer->allocate(
+              rangeSize, data[i].data(), [&, i](const Range& range) {
+                  ranges[i] = range;
+              }
+            );
+        }
+        vulkanDevice.flushUploads();
+        vulkanDevice.waitIdle();
+    }
+
+    // the first ranges are reusable, as if the frames which read them completed
+    void freeFirstRanges() {
+        buffer->free(ranges[0]);
+        buffer->free(ranges[1]);
+        vulkanDevice.onFrameSubmitted(1u);
+        vulkanDevice.onFrameCompleted(1u);
+    }
+
+    void expectRangesKept(u64 first) {
+        for (auto i = first; i < rangeCount; ++i)
+            EXPECT_EQ(readBack(*buffer, ranges[i].offset, rangeSize), data[i]);
+    }
+
+    std::optional<vk::VulkanBuffer> buffer;
+    std::array<std::vector<u8>, rangeCount> data;
+    std::array<Range, rangeCount> ranges;
+};
+
+TEST_F(VulkanBufferTests, givenFullBuffer_whenGrowing_shouldKeepRanges) {
+    const auto grown = buffer->allocate(rangeSize * rangeCount * 4u);
+    ASSERT_TRUE(grown.has_value());
+
+    expectRangesKept(0u);
+}
+
+TEST_F(VulkanBufferTests, givenFreedRanges_whenDefragmenting_shouldMoveRangesDown) {
+    freeFirstRanges();
+    {
+        CommandBuffer::Immediate frame{
+            vulkanDevice.getQueue(Queue::Type::graphics)
+        };
+        EXPECT_EQ(buffer->defragment(frame, rangeSize * rangeCount), 2u * rangeSize);
+    }
+
+    EXPECT_EQ(ranges[2].offset + ranges[3].offset, rangeSize);
+    expectRangesKept(2u);
+}
+
+TEST_F(
+  VulkanBufferTests,
+  givenDefragmentRecordedInFrame_whenGrowingBeforeSubmit_shouldKeepMovedRanges
+) {
+    freeFirstRanges();
+    {
+        // the frame is submitted only after the buffer grew
+        CommandBuffer::Immediate frame{
+            vulkanDevice.getQueue(Queue::Type::graphics)
+        };
+        EXPECT_EQ(buffer->defragment(frame, rangeSize * rangeCount), 2u * rangeSize);
+
+        const auto grown = buffer->allocate(rangeSize * rangeCount * 4u);
+        ASSERT_TRUE(grown.has_value());
+    }
+
+    EXPECT_EQ(ranges[2].offset + ranges[3].offset, rangeSize);
+    expectRangesKept(2u);
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <vector>
+
+#include "mock/GpuTest.hh"
+
+#include "starlight/renderer/gpu/vulkan/VulkanUploader.hh"
+
+using namespace sl;
+
+namespace {
+
+std::vector<u8> createData(u64 size, u8 seed) {
+    std::vector<u8> data(size);
+    std::iota(data.begin(), data.end(), seed);
+    return data;
+}
+
+}  // namespace
+
+class VulkanUploaderTests : public GpuTest {};
+
+TEST_F(VulkanUploaderTests, givenUpload_whenWaitingForTicket_shouldLandInBuffer) {
+    constexpr u64 size = 4096u;
+    const auto data    = createData(size, 7u);
+
+    vk::VulkanBuffer destination{ vulkanDevice, getDeviceLocalProperties(size) };
+    vk::VulkanUploader uploader{ vulkanDevice };
+
+    const auto ticket = uploader.upload(destination, 0u, data.data(), size);
+    EXPECT_FALSE(uploader.isComplete(ticket));
+
+    uploader.wait(ticket);
+    EXPECT_TRUE(uploader.isComplete(ticket));
+    EXPECT_EQ(readBack(destination, 0u, size), data);
+}
+
+TEST_F(
+  VulkanUploaderTests,
+  givenForcedQueueHandover_whenUploading_shouldReleaseAndAcquireCopies
+) {
+    constexpr u64 size = 4096u;
+    const auto data    = createData(size, 3u);
+
+    vk::VulkanBuffer destination{ vulkanDevice, getDeviceLocalProperties(size) };
+    vk::VulkanUploader uploader{
+        vulkanDevice, vk::VulkanUploader::defaultCapacity, true
+    };
+
+    // two halves in one batch, the acquire on the graphics queue signals the ticket
+    const auto half  = size / 2u;
+    const auto first = uploader.upload(destination, 0u, data.data(), half);
+    const auto second =
+      uploader.upload(destination, half, data.data() + half, half);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(first, 2u);
+
+    uploader.flush();
+    uploader.wait(second);
+    EXPECT_EQ(readBack(destination, 0u, size), data);
+}
+
+TEST_F(
+  VulkanUploaderTests, givenUploadsLargerThanRing_whenUploading_shouldReuseRing
+) {
+    constexpr u64 ringCapacity = 4096u;
+    constexpr u64 chunkSize    = 1024u;
+    constexpr u64 size         = ringCapacity * 4u;
+    const auto data            = createData(size, 11u);
+
+    vk::VulkanBuffer destination{ vulkanDevice, getDeviceLocalProperties(size) };
+    vk::VulkanUploader uploader{ vulkanDevice, ringCapacity, true };
+
+    u64 ticket = 0u;
+    for (u64 offset = 0u; offset < size; offset += chunkSize) {
+        ticket =
+          uploader.upload(destination, offset, data.data() + offset, chunkSize);
+        // a frame worth of uploads per flush, the ring wraps every few of them
+        if ((offset / chunkSize) % 2u == 1u) uploader.flush();
+    }
+
+    uploader.wait(ticket);
+    EXPECT_EQ(readBack(destination, 0u, size), data);
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include "starlight/renderer/Instancing.hh"
+
+#include <vector>
+
+using namespace sl;
+
+namespace {
+
+// only addresses are compared, never dereferenced
+Mesh* const meshA = reinterpret_cast<Mesh*>(0x1000);
+Mesh* const meshB = reinterpret_cast<Mesh*>(0x2000);
+
+Material* const materialA = reinterpret_cast<Material*>(0x3000);
+Material* const materialB = reinterpret_cast<Material*>(0x4000);
+
+struct Entity {
+    Mesh* mesh;
+    Material* material;
+};
+
+}  // namespace
+
+class InstancingTests : public testing::Test {
+protected:
+    FrameAllocator frameAllocator{ 1u };
+    FrameVector<InstanceBatch> batches = frameAllocator.makeVector<InstanceBatch>();
+};
+
+TEST_F(InstancingTests, givenNoEntities_whenBatching_shouldProduceNoBatches) {
+    std::vector<Entity> entities;
+    appendInstanceBatches<Entity>(
+      entities, InstanceGrouping::meshAndMaterial, batches
+    );
+    EXPECT_TRUE(batches.empty());
+}
+
+TEST_F(InstancingTests, givenGroupedEntities_whenBatching_shouldDrawEachGroupOnce) {
+    std::vector<Entity> entities{
+        { meshA, materialA },
+        { meshA, materialA },
+        { meshA, materialA },
+        { meshA, materialB },
+        { meshB, materialA },
+        { meshB, materialA },
+    };
+
+    appendInstanceBatches<Entity>(
+      entities, InstanceGrouping::meshAndMaterial, batches
+    );
+
+    ASSERT_EQ(batches.size(), 3u);
+
+    u32 nextInstance = 0u;
+    for (const auto& batch : batches) {
+        EXPECT_EQ(batch.firstInstance, nextInstance);
+        nextInstance += batch.instanceCount;
+
+        // every instance of the batch has to be drawable with its mesh and material
+        for (u32 i = 0; i < batch.instanceCount; ++i) {
+            const auto& entity = entities[batch.firstInstance + i];
+            EXPECT_EQ(entity.mesh, batch.mesh);
+            EXPECT_EQ(entity.material, batch.material);
+        }
+    }
+    EXPECT_EQ(nextInstance, entities.size());
+}
+
+TEST_F(InstancingTests, givenMeshGrouping_whenBatching_shouldIgnoreMaterials) {
+    std::vector<Entity> entities{
+        { meshA, materialA },
+        { meshA, materialB },
+        { meshB, materialA },
+    };
+
+    appendInstanceBatches<Entity>(entities, InstanceGrouping::mesh, batches);
+
+    ASSERT_EQ(batches.size(), 2u);
+    for (const auto& batch : batches) EXPECT_EQ(batch.material, nullptr);
+    EXPECT_EQ(batches[0].instanceCount, 2u);
+}
+
+TEST_F(InstancingTests, givenUnsortedEntities_whenBatching_shouldKeepTheirOrder) {
+    // e.g. transparent geometry sorted by distance, only neighbours may merge
+    std::vector<Entity> entities{
+        { meshA, materialA },
+        { meshA, materialA },
+        { meshB, materialA },
+        { meshA, materialA },
+    };
+
+    appendInstanceBatches<Entity>(
+      entities, InstanceGrouping::meshAndMaterial, batches
+    );
+
+    ASSERT_EQ(batches.size(), 3u);
+    EXPECT_EQ(batches[0].instanceCount, 2u);
+    EXPECT_EQ(batches[1].mesh, meshB);
+    EXPECT_EQ(batches[2].firstInstance, 3u);
+}
+
+TEST_F(InstancingTests, givenExistingBatches_whenAppending_shouldContinueInstanceNumbering) {
+    std::vector<Entity> opaque{
+        { meshA, materialA },
+        { meshA, materialA },
+    };
+    std::vector<Entity> transparent{
+        { meshA, materialA },
+    };
+
+    appendInstanceBatches<Entity>(
+      opaque, InstanceGrouping::meshAndMaterial, batches
+    );
+    appendInstanceBatches<Entity>(
+      transparent, InstanceGrouping::meshAndMaterial, batches
+    );
+
+    // separate calls never merge, the second group has its own draw
+    ASSERT_EQ(batches.size(), 2u);
+    EXPECT_EQ(batches[1].firstInstance, 2u);
+    EXPECT_EQ(batches[1].instanceCount, 1u);
+}
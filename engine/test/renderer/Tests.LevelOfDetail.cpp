@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include "starlight/renderer/LevelOfDetail.hh"
+
+#include <array>
+
+using namespace sl;
+
+namespace {
+
+const std::array<f32, 3> switchSizes = { 0.5f, 0.25f, 0.1f };
+
+}  // namespace
+
+TEST(
+  LevelOfDetailTests, givenSphere_whenCalculatingScreenSize_shouldShrinkWithDistance
+) {
+    const auto near = calculateScreenSize(1.0f, 10.0f, 2.414f);
+    const auto far  = calculateScreenSize(1.0f, 20.0f, 2.414f);
+
+    EXPECT_FLOAT_EQ(near, 0.2414f);
+    EXPECT_FLOAT_EQ(far, near * 0.5f);
+}
+
+TEST(
+  LevelOfDetailTests, givenCameraInsideSphere_whenCalculatingScreenSize_shouldFill
+) {
+    EXPECT_GE(calculateScreenSize(2.0f, 1.0f, 2.414f), 1.0f);
+}
+
+TEST(LevelOfDetailTests, givenNoHysteresis_whenSelecting_shouldPickByThresholds) {
+    EXPECT_EQ(selectLevelOfDetail(switchSizes, 0.9f, 0u, 0.0f), 0u);
+    EXPECT_EQ(selectLevelOfDetail(switchSizes, 0.4f, 0u, 0.0f), 1u);
+    EXPECT_EQ(selectLevelOfDetail(switchSizes, 0.2f, 0u, 0.0f), 2u);
+    EXPECT_EQ(selectLevelOfDetail(switchSizes, 0.05f, 0u, 0.0f), 3u);
+    EXPECT_EQ(selectLevelOfDetail(switchSizes, 0.9f, 3u, 0.0f), 0u);
+}
+
+TEST(LevelOfDetailTests, givenHysteresis_whenSizeWithinDeadBand_shouldKeepLevel) {
+    // just below the first switch size, but not by enough to drop a level
+    EXPECT_EQ(selectLevelOfDetail(switchSizes, 0.48f, 0u, 0.1f), 0u);
+    // just above it coming from the coarser level, not enough to go back
+    EXPECT_EQ(selectLevelOfDetail(switchSizes, 0.52f, 1u, 0.1f), 1u);
+
+    EXPECT_EQ(selectLevelOfDetail(switchSizes, 0.44f, 0u, 0.1f), 1u);
+    EXPECT_EQ(selectLevelOfDetail(switchSizes, 0.56f, 1u, 0.1f), 0u);
+}
+
+TEST(LevelOfDetailTests, givenLargeChange_whenSelecting_shouldSkipLevels) {
+    EXPECT_EQ(selectLevelOfDetail(switchSizes, 0.01f, 0u, 0.1f), 3u);
+    EXPECT_EQ(selectLevelOfDetail(switchSizes, 1.0f, 3u, 0.1f), 0u);
+}
+
+TEST(LevelOfDetailTests, givenNoSwitchSizes_whenSelecting_shouldUseFirstLevel) {
+    EXPECT_EQ(selectLevelOfDetail({}, 0.01f, 2u, 0.1f), 0u);
+}
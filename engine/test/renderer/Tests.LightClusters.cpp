@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+
+#include "starlight/renderer/light/LightClusters.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace sl;
+
+namespace {
+
+const LightClusters::Properties properties{
+    .tilesX           = 16u,
+    .tilesY           = 9u,
+    .slices           = 24u,
+    .projectionScaleX = 1.357f,
+    .projectionScaleY = 2.414f,
+    .nearZ            = 0.1f,
+    .farZ             = 100.0f,
+};
+
+// lights spread over the view frustum and a bit around it
+std::vector<LightSphere> makeLights(u64 count, u32 seed) {
+    std::mt19937 generator{ seed };
+    std::uniform_real_distribution<f32> depth{ -5.0f, 110.0f };
+    std::uniform_real_distribution<f32> side{ -1.2f, 1.2f };
+    std::uniform_real_distribution<f32> radius{ 0.5f, 8.0f };
+
+    std::vector<LightSphere> lights(count);
+    for (auto& light : lights) {
+        const auto z = depth(generator);
+        light        = LightSphere{
+                   .position = { side(generator) * z / properties.projectionScaleX,
+                                 side(generator) * z / properties.projectionScaleY, -z },
+                   .radius   = radius(generator),
+        };
+    }
+    return lights;
+}
+
+}  // namespace
+
+class LightClustersTests : public testing::Test {
+protected:
+    // cluster of a view space point, looked up the same way as in the shader
+    u32 getCluster(const f32* point) const {
+        const auto depth = -point[2];
+        const auto ndcX  = point[0] * properties.projectionScaleX / depth;
+        const auto ndcY  = point[1] * properties.projectionScaleY / depth;
+
+        const auto tile = [](f32 ndc, u32 tiles) {
+            const auto index = static_cast<i32>((ndc * 0.5f + 0.5f) * tiles);
+            return static_cast<u32>(std::clamp<i32>(index, 0, tiles - 1));
+        };
+        const auto slice = static_cast<i32>(
+          std::floor(std::log(depth) * clusters.getDepthScale() + clusters.getDepthBias())
+        );
+
+        return clusters.getClusterIndex(
+          tile(ndcX, properties.tilesX), tile(ndcY, properties.tilesY),
+          static_cast<u32>(std::clamp<i32>(slice, 0, properties.slices - 1))
+        );
+    }
+
+    std::vector<u32> getLights(u32 cluster) const {
+        const auto [offset, count] = clusters.getClusters()[cluster];
+        const auto indices         = clusters.getLightIndices().subspan(offset, count);
+        return { indices.begin(), indices.end() };
+    }
+
+    LightClusters clusters{ properties };
+};
+
+TEST_F(LightClustersTests, givenNoLights_whenBuilding_shouldLeaveClustersEmpty) {
+    clusters.build({});
+
+    EXPECT_EQ(
+      clusters.getClusters().size(),
+      properties.tilesX * properties.tilesY * properties.slices
+    );
+    EXPECT_TRUE(clusters.getLightIndices().empty());
+    for (const auto& cluster : clusters.getClusters()) EXPECT_EQ(cluster.count, 0u);
+}
+
+TEST_F(
+  LightClustersTests, givenLights_whenBuilding_shouldListEveryLightReachingAPoint
+) {
+    const auto lights = makeLights(300, 1u);
+    clusters.build(lights);
+
+    std::mt19937 generator{ 2u };
+    std::uniform_real_distribution<f32> depth{ properties.nearZ, properties.farZ };
+    std::uniform_real_distribution<f32> side{ -0.999f, 0.999f };
+
+    u64 checkedLights = 0u;
+    for (u32 sample = 0; sample < 20'000u; ++sample) {
+        const auto z      = depth(generator);
+        const f32 point[] = { side(generator) * z / properties.projectionScaleX,
+                              side(generator) * z / properties.projectionScaleY, -z };
+
+        const auto listed = getLights(getCluster(point));
+        for (u32 i = 0; i < lights.size(); ++i) {
+            const auto& light = lights[i];
+            auto distance     = 0.0f;
+            for (u32 axis = 0; axis < 3u; ++axis) {
+                const auto delta = point[axis] - light.position[axis];
+                distance += delta * delta;
+            }
+            if (distance > light.radius * light.radius) continue;
+
+            ++checkedLights;
+            ASSERT_NE(std::ranges::find(listed, i), listed.end())
+              << "light " << i << " is missing in the cluster of sample " << sample;
+        }
+    }
+    EXPECT_GT(checkedLights, 0u);
+}
+
+TEST_F(LightClustersTests, givenSmallLight_whenBuilding_shouldOnlyListItNearby) {
+    const std::vector<LightSphere> lights{
+        LightSphere{ .position = { 0.0f, 0.0f, -10.0f }, .radius = 0.5f },
+    };
+    clusters.build(lights);
+
+    u64 touched = 0u;
+    for (const auto& cluster : clusters.getClusters()) touched += cluster.count;
+
+    const f32 center[] = { 0.0f, 0.0f, -10.0f };
+    EXPECT_EQ(getLights(getCluster(center)), std::vector<u32>{ 0u });
+    // a handful of tiles over a couple of slices, nowhere near the whole grid
+    EXPECT_GT(touched, 0u);
+    EXPECT_LT(touched, 50u);
+}
+
+TEST_F(
+  LightClustersTests, givenLightsOutsideOfFrustum_whenBuilding_shouldSkipThem
+) {
+    const std::vector<LightSphere> lights{
+        LightSphere{ .position = { 0.0f, 0.0f, 5.0f }, .radius = 2.0f },
+        LightSphere{ .position = { 0.0f, 0.0f, -150.0f }, .radius = 10.0f },
+        LightSphere{ .position = { 500.0f, 0.0f, -50.0f }, .radius = 10.0f },
+    };
+    clusters.build(lights);
+
+    EXPECT_TRUE(clusters.getLightIndices().empty());
+}
+
+TEST_F(LightClustersTests, givenHugeLight_whenBuilding_shouldListItEverywhere) {
+    const std::vector<LightSphere> lights{
+        LightSphere{ .position = { 0.0f, 0.0f, -50.0f }, .radius = 1000.0f },
+    };
+    clusters.build(lights);
+
+    for (const auto& cluster : clusters.getClusters()) EXPECT_EQ(cluster.count, 1u);
+}
+
+TEST_F(LightClustersTests, givenNewProperties_whenBuilding_shouldResizeGrid) {
+    auto smaller   = properties;
+    smaller.tilesX = 4u;
+    smaller.tilesY = 4u;
+    smaller.slices = 8u;
+
+    clusters.setProperties(smaller);
+    clusters.build(makeLights(50, 3u));
+
+    EXPECT_EQ(clusters.getClusters().size(), 4u * 4u * 8u);
+}
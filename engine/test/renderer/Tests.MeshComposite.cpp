@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include "starlight/renderer/MeshComposite.hh"
+
+using namespace sl;
+
+namespace {
+
+Vec3<f32> getOrigin(const Mat4<f32>& world) { return Vec3<f32>{ world[3] }; }
+
+}  // namespace
+
+TEST(
+  MeshCompositeTests, givenMovedInstance_whenUpdatingTransforms_shouldUseNewWorld
+) {
+    MeshComposite composite{ nullptr, nullptr };
+    auto& root = composite.getRoot();
+
+    composite.updateTransforms();
+    EXPECT_EQ(getOrigin(composite.getWorld(root, 0u)), Vec3<f32>{ 0.0f });
+
+    root.getInstances()[0].setPosition(Vec3<f32>{ 1.0f, 2.0f, 3.0f });
+    EXPECT_TRUE(root.getInstances()[0].isDirty());
+
+    composite.updateTransforms();
+    EXPECT_FALSE(root.getInstances()[0].isDirty());
+    EXPECT_EQ(
+      getOrigin(composite.getWorld(root, 0u)), (Vec3<f32>{ 1.0f, 2.0f, 3.0f })
+    );
+}
+
+TEST(MeshCompositeTests, givenParentedInstance_whenParentMoves_shouldMoveChild) {
+    MeshComposite composite{ nullptr, nullptr };
+    auto& root = composite.getRoot();
+
+    root.addInstance().setPosition(Vec3<f32>{ 1.0f, 0.0f, 0.0f });
+    auto instances = root.getInstances();
+    instances[1].setParent(&instances[0]);
+    instances[0].setPosition(Vec3<f32>{ 0.0f, 5.0f, 0.0f });
+    composite.updateTransforms();
+
+    EXPECT_EQ(
+      getOrigin(composite.getWorld(root, 1u)), (Vec3<f32>{ 1.0f, 5.0f, 0.0f })
+    );
+
+    // only the parent changed, the child world follows through the hierarchy
+    instances[0].setPosition(Vec3<f32>{ 0.0f, 0.0f, 2.0f });
+    EXPECT_FALSE(instances[1].isDirty());
+    composite.updateTransforms();
+
+    EXPECT_EQ(
+      getOrigin(composite.getWorld(root, 1u)), (Vec3<f32>{ 1.0f, 0.0f, 2.0f })
+    );
+}
@@ -0,0 +1,224 @@
+#include <gtest/gtest.h>
+
+#include "starlight/renderer/MeshSimplifier.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace sl;
+
+namespace {
+
+struct TestMesh {
+    VertexPositions getPositions() const {
+        return VertexPositions{
+            .data   = positions.data(),
+            .count  = positions.size() / 3u,
+            .stride = sizeof(f32) * 3u,
+        };
+    }
+
+    std::vector<f32> positions;
+    std::vector<u32> indices;
+};
+
+// flat square of size x size quads in the XZ plane, facing up; with a seam the
+// middle column of vertices is duplicated, as texture coordinates would require
+TestMesh makeGrid(u32 size, bool withSeam = false) {
+    TestMesh mesh;
+    const auto side = size + 1u;
+
+    for (u32 z = 0; z < side; ++z) {
+        for (u32 x = 0; x < side; ++x) {
+            mesh.positions.insert(
+              mesh.positions.end(),
+              { static_cast<f32>(x), 0.0f, static_cast<f32>(z) }
+            );
+        }
+    }
+
+    const auto seamColumn = size / 2u;
+    std::vector<u32> seamVertices(side);
+    for (u32 z = 0; z < side && withSeam; ++z) {
+        seamVertices[z] = static_cast<u32>(mesh.positions.size() / 3u);
+        mesh.positions.insert(
+          mesh.positions.end(),
+          { static_cast<f32>(seamColumn), 0.0f, static_cast<f32>(z) }
+        );
+    }
+
+    const auto vertex = [&](u32 x, u32 z, u32 quadX) {
+        if (withSeam && x == seamColumn && quadX >= seamColumn)
+            return seamVertices[z];
+        return z * side + x;
+    };
+
+    for (u32 z = 0; z < size; ++z) {
+        for (u32 x = 0; x < size; ++x) {
+            const auto a = vertex(x, z, x);
+            const auto b = vertex(x + 1u, z, x);
+            const auto c = vertex(x, z + 1u, x);
+            const auto d = vertex(x + 1u, z + 1u, x);
+            mesh.indices.insert(mesh.indices.end(), { a, c, b, b, c, d });
+        }
+    }
+    return mesh;
+}
+
+// closed sphere with shared vertices, so nothing is locked
+TestMesh makeSphere(u32 stacks, u32 slices) {
+    constexpr f32 pi = 3.14159265f;
+
+    TestMesh mesh;
+    mesh.positions.insert(mesh.positions.end(), { 0.0f, 1.0f, 0.0f });
+    for (u32 stack = 1; stack < stacks; ++stack) {
+        const auto phi = pi * stack / stacks;
+        for (u32 slice = 0; slice < slices; ++slice) {
+            const auto theta = 2.0f * pi * slice / slices;
+            mesh.positions.insert(
+              mesh.positions.end(), { std::sin(phi) * std::cos(theta), std::cos(phi),
+                                      std::sin(phi) * std::sin(theta) }
+            );
+        }
+    }
+    mesh.positions.insert(mesh.positions.end(), { 0.0f, -1.0f, 0.0f });
+
+    const auto bottom = static_cast<u32>(mesh.positions.size() / 3u) - 1u;
+    const auto ring   = [&](u32 stack, u32 slice) {
+        return 1u + (stack - 1u) * slices + slice % slices;
+    };
+
+    for (u32 slice = 0; slice < slices; ++slice) {
+        mesh.indices.insert(
+          mesh.indices.end(), { 0u, ring(1u, slice + 1u), ring(1u, slice) }
+        );
+        mesh.indices.insert(
+          mesh.indices.end(),
+          { bottom, ring(stacks - 1u, slice), ring(stacks - 1u, slice + 1u) }
+        );
+    }
+    for (u32 stack = 1; stack < stacks - 1u; ++stack) {
+        for (u32 slice = 0; slice < slices; ++slice) {
+            const auto a = ring(stack, slice);
+            const auto b = ring(stack, slice + 1u);
+            const auto c = ring(stack + 1u, slice);
+            const auto d = ring(stack + 1u, slice + 1u);
+            mesh.indices.insert(mesh.indices.end(), { a, b, c, b, d, c });
+        }
+    }
+    return mesh;
+}
+
+// Y component of the normal times twice the area, for triangles in the XZ plane
+f32 calculateFacingArea(const TestMesh& mesh, u32 a, u32 b, u32 c) {
+    const auto* p = mesh.positions.data();
+    const f32 ab[2] = { p[b * 3] - p[a * 3], p[b * 3 + 2] - p[a * 3 + 2] };
+    const f32 ac[2] = { p[c * 3] - p[a * 3], p[c * 3 + 2] - p[a * 3 + 2] };
+    return ab[1] * ac[0] - ab[0] * ac[1];
+}
+
+f32 calculateArea(const TestMesh& mesh, const std::vector<u32>& indices) {
+    f32 area = 0.0f;
+    for (u64 i = 0; i < indices.size(); i += 3u) {
+        const auto facing =
+          calculateFacingArea(mesh, indices[i], indices[i + 1], indices[i + 2]);
+        EXPECT_GT(facing, 0.0f);
+        area += facing * 0.5f;
+    }
+    return area;
+}
+
+bool isReferenced(const std::vector<u32>& indices, u32 vertex) {
+    return std::find(indices.begin(), indices.end(), vertex) != indices.end();
+}
+
+}  // namespace
+
+TEST(
+  MeshSimplifierTests, givenFlatGrid_whenSimplifying_shouldReachTargetWithoutError
+) {
+    const auto grid = makeGrid(8u);
+    MeshSimplifier simplifier{ grid.getPositions() };
+
+    // 32 triangles, two more than the locked border alone needs
+    const auto result = simplifier.simplify(
+      grid.indices, MeshSimplifier::Properties{ .targetIndexCount = 96u }
+    );
+
+    EXPECT_LE(result.size(), 96u);
+    EXPECT_EQ(result.size() % 3u, 0u);
+    EXPECT_NEAR(simplifier.getError(), 0.0f, 1e-4f);
+    // no flipped triangles and no holes
+    EXPECT_NEAR(calculateArea(grid, result), 64.0f, 1e-3f);
+}
+
+TEST(MeshSimplifierTests, givenFlatGrid_whenSimplifying_shouldKeepBorder) {
+    const auto grid = makeGrid(8u);
+    MeshSimplifier simplifier{ grid.getPositions() };
+
+    const auto result = simplifier.simplify(
+      grid.indices, MeshSimplifier::Properties{ .targetIndexCount = 0u }
+    );
+
+    for (u32 i = 0; i <= 8u; ++i) {
+        EXPECT_TRUE(isReferenced(result, i));
+        EXPECT_TRUE(isReferenced(result, 8u * 9u + i));
+        EXPECT_TRUE(isReferenced(result, i * 9u));
+        EXPECT_TRUE(isReferenced(result, i * 9u + 8u));
+    }
+}
+
+TEST(MeshSimplifierTests, givenGridWithSeam_whenSimplifying_shouldKeepSeam) {
+    const auto grid = makeGrid(8u, true);
+    MeshSimplifier simplifier{ grid.getPositions() };
+
+    const auto result = simplifier.simplify(
+      grid.indices, MeshSimplifier::Properties{ .targetIndexCount = 0u }
+    );
+
+    EXPECT_LT(result.size(), grid.indices.size());
+    EXPECT_NEAR(calculateArea(grid, result), 64.0f, 1e-3f);
+    // both sides of the seam still meet at every seam vertex
+    for (u32 z = 0; z <= 8u; ++z) {
+        EXPECT_TRUE(isReferenced(result, z * 9u + 4u));
+        EXPECT_TRUE(isReferenced(result, 81u + z));
+    }
+}
+
+TEST(MeshSimplifierTests, givenSphere_whenSimplifying_shouldStopAtMaxError) {
+    const auto sphere = makeSphere(16u, 32u);
+    MeshSimplifier simplifier{ sphere.getPositions() };
+
+    const MeshSimplifier::Properties props{
+        .targetIndexCount = 0u,
+        .maxError         = 0.02f,
+    };
+    const auto result = simplifier.simplify(sphere.indices, props);
+
+    EXPECT_LT(result.size(), sphere.indices.size() / 2u);
+    EXPECT_GT(result.size(), 0u);
+    EXPECT_LE(simplifier.getError(), props.maxError);
+    EXPECT_GT(simplifier.getError(), 0.0f);
+}
+
+TEST(MeshSimplifierTests, givenSphere_whenSimplifying_shouldKeepTrianglesValid) {
+    const auto sphere      = makeSphere(16u, 32u);
+    const auto vertexCount = sphere.positions.size() / 3u;
+    MeshSimplifier simplifier{ sphere.getPositions() };
+
+    const MeshSimplifier::Properties props{
+        .targetIndexCount = sphere.indices.size() / 4u,
+        .maxError         = 1.0f,
+    };
+    const auto result = simplifier.simplify(sphere.indices, props);
+
+    EXPECT_LE(result.size(), props.targetIndexCount);
+    ASSERT_EQ(result.size() % 3u, 0u);
+    for (u64 i = 0; i < result.size(); i += 3u) {
+        EXPECT_LT(result[i], vertexCount);
+        EXPECT_NE(result[i], result[i + 1]);
+        EXPECT_NE(result[i + 1], result[i + 2]);
+        EXPECT_NE(result[i + 2], result[i]);
+    }
+}
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+
+#include "starlight/renderer/light/ShadowCascades.hh"
+
+#include <array>
+#include <cmath>
+
+using namespace sl;
+
+namespace {
+
+using Matrix = std::array<f32, 16>;
+
+const ShadowCascades::Properties properties{
+    .cascadeCount   = 4u,
+    .resolution     = 1024u,
+    .splitLambda    = 0.75f,
+    .shadowDistance = 100.0f,
+    .casterDistance = 50.0f,
+};
+
+// 45 degree, 16:9 perspective
+constexpr f32 projectionScaleX = 1.358f;
+constexpr f32 projectionScaleY = 2.414f;
+constexpr f32 nearZ            = 0.1f;
+constexpr f32 farZ             = 1000.0f;
+
+const f32 lightDirection[3] = { -0.4f, -0.8f, -0.3f };
+
+// camera to world for a camera turned by yaw around the Y axis, looking down -Z
+Matrix makeInverseView(f32 x, f32 y, f32 z, f32 yaw) {
+    const auto c = std::cos(yaw);
+    const auto s = std::sin(yaw);
+    return Matrix{ c, 0.0f, -s, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
+                   s, 0.0f, c,  0.0f, x,    y,    z,    1.0f };
+}
+
+std::array<f32, 3> transform(const f32* matrix, const std::array<f32, 3>& point) {
+    std::array<f32, 3> result;
+    for (u32 row = 0; row < 3u; ++row) {
+        result[row] = matrix[12 + row];
+        for (u32 column = 0; column < 3u; ++column)
+            result[row] += matrix[column * 4 + row] * point[column];
+    }
+    return result;
+}
+
+}  // namespace
+
+class ShadowCascadesTests : public testing::Test {
+protected:
+    void update(const Matrix& inverseView) {
+        cascades.update(
+          ShadowCascades::View{
+            .inverseView      = inverseView.data(),
+            .projectionScaleX = projectionScaleX,
+            .projectionScaleY = projectionScaleY,
+            .nearZ            = nearZ,
+            .farZ             = farZ,
+          },
+          lightDirection
+        );
+    }
+
+    ShadowCascades cascades{ properties };
+};
+
+TEST_F(ShadowCascadesTests, givenView_whenUpdating_shouldSplitUpToShadowDistance) {
+    update(makeInverseView(0.0f, 0.0f, 0.0f, 0.0f));
+
+    const auto result = cascades.getCascades();
+    ASSERT_EQ(result.size(), properties.cascadeCount);
+
+    auto previous = nearZ;
+    for (const auto& cascade : result) {
+        EXPECT_GT(cascade.splitDepth, previous);
+        previous = cascade.splitDepth;
+    }
+    EXPECT_FLOAT_EQ(result.back().splitDepth, properties.shadowDistance);
+    // closer cascades cover less depth
+    EXPECT_LT(
+      result[0].splitDepth - nearZ, result[1].splitDepth - result[0].splitDepth
+    );
+}
+
+TEST_F(ShadowCascadesTests, givenView_whenUpdating_shouldFitFrustumSlices) {
+    const auto inverseView = makeInverseView(3.0f, 2.0f, -7.0f, 0.6f);
+    update(inverseView);
+
+    auto sliceNear = nearZ;
+    for (const auto& cascade : cascades.getCascades()) {
+        const auto sliceFar = cascade.splitDepth;
+
+        for (const auto depth : { sliceNear, sliceFar }) {
+            for (const auto sx : { -1.0f, 1.0f }) {
+                for (const auto sy : { -1.0f, 1.0f }) {
+                    const auto world = transform(
+                      inverseView.data(), { sx * depth / projectionScaleX,
+                                            sy * depth / projectionScaleY, -depth }
+                    );
+                    const auto clip = transform(cascade.viewProjection, world);
+
+                    EXPECT_LE(std::abs(clip[0]), 1.0f);
+                    EXPECT_LE(std::abs(clip[1]), 1.0f);
+                    EXPECT_GE(clip[2], 0.0f);
+                    EXPECT_LE(clip[2], 1.0f);
+                }
+            }
+        }
+        sliceNear = sliceFar;
+    }
+}
+
+TEST_F(
+  ShadowCascadesTests, givenCasterTowardsLight_whenUpdating_shouldKeepItInRange
+) {
+    const auto inverseView = makeInverseView(0.0f, 0.0f, 0.0f, 0.0f);
+    update(inverseView);
+
+    const auto& cascade = cascades.getCascades()[0];
+    const auto receiver = transform(inverseView.data(), { 0.0f, 0.0f, -1.0f });
+
+    std::array<f32, 3> caster;
+    for (u32 axis = 0; axis < 3u; ++axis)
+        caster[axis] = receiver[axis] - lightDirection[axis] * 30.0f;
+
+    const auto receiverClip = transform(cascade.viewProjection, receiver);
+    const auto casterClip   = transform(cascade.viewProjection, caster);
+
+    EXPECT_GE(casterClip[2], 0.0f);
+    EXPECT_LT(casterClip[2], receiverClip[2]);
+}
+
+TEST_F(ShadowCascadesTests, givenTurningCamera_whenUpdating_shouldKeepTexelSize) {
+    update(makeInverseView(0.0f, 0.0f, 0.0f, 0.0f));
+    const auto before = cascades.getCascades()[2];
+
+    update(makeInverseView(0.0f, 0.0f, 0.0f, 1.3f));
+    const auto after = cascades.getCascades()[2];
+
+    for (u32 i = 0; i < 3u; ++i) {
+        EXPECT_FLOAT_EQ(before.viewProjection[i * 4], after.viewProjection[i * 4]);
+        EXPECT_FLOAT_EQ(
+          before.viewProjection[i * 4 + 1], after.viewProjection[i * 4 + 1]
+        );
+    }
+}
+
+TEST_F(
+  ShadowCascadesTests, givenMovingCamera_whenUpdating_shouldMoveByWholeTexels
+) {
+    const std::array<f32, 3> point{ 1.0f, 0.0f, -5.0f };
+    update(makeInverseView(0.0f, 0.0f, 0.0f, 0.0f));
+    const auto before = transform(cascades.getCascades()[0].viewProjection, point);
+
+    update(makeInverseView(0.123f, 0.0f, -0.057f, 0.0f));
+    const auto after = transform(cascades.getCascades()[0].viewProjection, point);
+
+    for (u32 axis = 0; axis < 2u; ++axis) {
+        const auto texels =
+          (after[axis] - before[axis]) * properties.resolution * 0.5f;
+        EXPECT_NEAR(texels, std::round(texels), 1e-2f);
+    }
+}
+
+TEST_F(
+  ShadowCascadesTests, givenCameraMovedWithinTexel_whenUpdating_shouldKeepMatrices
+) {
+    update(makeInverseView(2.0f, 1.0f, 3.0f, 0.0f));
+    const auto before = cascades.getCascades()[3];
+
+    update(makeInverseView(2.0f, 1.0f, 3.00001f, 0.0f));
+    const auto after = cascades.getCascades()[3];
+
+    for (u32 i = 0; i < 16u; ++i)
+        EXPECT_EQ(before.viewProjection[i], after.viewProjection[i]);
+}